@@ -3,16 +3,33 @@
 #include "state.h"
 #include "linked_list.h"
 
-// Estrutura do que contem o estado do nosso puzzle 8
+// Estrutura do que contem o estado do nosso puzzle 8. A posição do espaço vazio e a heurística
+// dependem apenas do tabuleiro, são guardadas para que cada movimento as atualize sem percorrer o
+// tabuleiro
 typedef struct 
 {
     char board[3][3];
+    char blank; // Posição do espaço vazio, linha * 3 + coluna
+    char h; // Distância de Manhattan com conflitos lineares
 } puzzle_state;
 
+// Calcula a posição do espaço vazio e a heurística de um tabuleiro, retorna falso se o tabuleiro não
+// tiver as peças 1 a 8 e um espaço vazio
+bool puzzle_init(puzzle_state*);
+
+// Verifica se o tabuleiro tem solução: com largura ímpar um movimento nunca altera a paridade do
+// número de inversões das peças, que no objetivo é par
+bool puzzle_solvable(const puzzle_state*);
 
 // Implementa a heurística do problema 8 puzzle
 int heuristic(const state_t*, const state_t*);
 
+// Heurística inversa do problema 8 puzzle, distância de Manhattan até ao tabuleiro indicado
+int heuristic_reverse(const state_t*, const state_t*);
+
+// Copia o tabuleiro objetivo do problema 8 puzzle
+void goal_board(puzzle_state*);
+
 // Encontra os vizinhos de um estado no problema 8 puzzle
 void visit(state_t*, state_allocator_t*, linked_list_t*);
 
@@ -7,108 +7,262 @@
 #include <string.h>
 
 // Este é o objetivo do nosso problema
-static const puzzle_state goal_puzzle = { { { '1', '2', '3' }, { '4', '5', '6' }, { '7', '8', '-' } } };
+static const puzzle_state goal_puzzle = { { { '1', '2', '3' }, { '4', '5', '6' }, { '7', '8', '-' } }, 8, 0 };
 
 // Estrutura para ajudar no cálculo da heurística
 static const int heuristic_table[8][2] = { { 0, 0 }, { 0, 1 }, { 0, 2 }, { 1, 0 }, { 1, 1 }, { 1, 2 }, { 2, 0 }, { 2, 1 } };
 
-// Função de heurística para o puzzle 8
-int heuristic(const state_t* current_state, const state_t*)
-{
-  // Converter os estados para puzzle_state
-  puzzle_state* current_puzzle = (puzzle_state*)(current_state->data);
+// Posições para onde o espaço vazio se pode mover a partir de cada posição: cima, baixo, esquerda e
+// direita, terminadas por -1
+static const int moves_table[9][5] = { { 3, 1, -1 },    { 4, 0, 2, -1 },    { 5, 1, -1 },
+                                       { 0, 6, 4, -1 }, { 1, 7, 3, 5, -1 }, { 2, 8, 4, -1 },
+                                       { 3, 7, -1 },    { 4, 6, 8, -1 },    { 5, 7, -1 } };
 
-  int h = 0;
+// Variação da distância de Manhattan de cada peça ao passar de uma posição para outra
+static signed char delta_table[8][9][9];
+
+// Conflitos lineares de cada linha e de cada coluna, já multiplicados por 2, indexados pelas três peças
+// da linha (o espaço vazio é o 0) em base 9
+static unsigned char row_conflicts[3][729];
+static unsigned char col_conflicts[3][729];
+
+static bool tables_ready = false;
 
-  // Calcular a distância de Manhattan para cada peça
-  for(int x = 0; x < 3; x++)
+// Número mínimo de peças a retirar de uma linha para que as restantes fiquem pela ordem do objetivo,
+// dadas as posições no objetivo das peças que pertencem à linha
+static int line_removals(const int* order, int count)
+{
+  // Maior subsequência crescente, com no máximo 3 peças
+  int longest[3];
+  int best = 0;
+  for(int i = 0; i < count; i++)
   {
-    for(int y = 0; y < 3; y++)
+    longest[i] = 1;
+    for(int j = 0; j < i; j++)
     {
-      char current_piece = current_puzzle->board[y][x];
+      if(order[j] < order[i] && longest[j] + 1 > longest[i])
+        longest[i] = longest[j] + 1;
+    }
+    if(longest[i] > best)
+      best = longest[i];
+  }
+  return count - best;
+}
 
-      if(current_piece == '-')
+// Prepara as tabelas da heurística, chamada antes de existirem estados
+static void tables_init(void)
+{
+  if(tables_ready)
+  {
+    return;
+  }
+
+  for(int piece = 0; piece < 8; piece++)
+  {
+    for(int from = 0; from < 9; from++)
+    {
+      for(int to = 0; to < 9; to++)
       {
-        continue;
+        int before = abs(from / 3 - heuristic_table[piece][0]) + abs(from % 3 - heuristic_table[piece][1]);
+        int after = abs(to / 3 - heuristic_table[piece][0]) + abs(to % 3 - heuristic_table[piece][1]);
+        delta_table[piece][from][to] = (signed char)(after - before);
       }
+    }
+  }
 
-      // Converte os caracteres números 1,2,3,4,5,6,7 e 8 no seu valor numérico
-      int num = (current_piece - 49);
-      int goal_row = heuristic_table[num][0];
-      int goal_col = heuristic_table[num][1];
+  for(int line = 0; line < 3; line++)
+  {
+    for(int code = 0; code < 729; code++)
+    {
+      int pieces[3] = { code / 81, code / 9 % 9, code % 9 };
+      int row_order[3], col_order[3];
+      int row_count = 0, col_count = 0;
+      for(int i = 0; i < 3; i++)
+      {
+        if(pieces[i] == 0)
+          continue;
 
-      // Calcular a distância de Manhattan para a peça atual
-      h += abs(x - goal_col) + abs(y - goal_row);
+        // Na linha contam as peças do objetivo nessa linha, pela coluna do objetivo, e na coluna as
+        // peças dessa coluna, pela linha do objetivo
+        const int* target = heuristic_table[pieces[i] - 1];
+        if(target[0] == line)
+          row_order[row_count++] = target[1];
+        if(target[1] == line)
+          col_order[col_count++] = target[0];
+      }
+      row_conflicts[line][code] = (unsigned char)(2 * line_removals(row_order, row_count));
+      col_conflicts[line][code] = (unsigned char)(2 * line_removals(col_order, col_count));
     }
   }
 
-  return h;
+  tables_ready = true;
 }
 
-// Função para visitar um estado do puzzle 8, expandir vizinhos possíveis e armazená-los na lista ligada
-void visit(state_t* current_state, state_allocator_t* allocator, linked_list_t* neighbors)
+// Valor de uma posição nos índices das tabelas de conflitos
+static inline int piece_code(char piece)
 {
-  // Obtenha o ponteiro para a estrutura puzzle_state
-  puzzle_state* puzzle = (puzzle_state*)(current_state->data);
-  puzzle_state new_puzzle_up, new_puzzle_down, new_puzzle_left, new_puzzle_right;
+  return piece == '-' ? 0 : piece - '0';
+}
 
-  // Copia o tabuleiro para os novos possíveis estados
-  memcpy(&new_puzzle_up, puzzle, sizeof(puzzle_state));
-  memcpy(&new_puzzle_down, puzzle, sizeof(puzzle_state));
-  memcpy(&new_puzzle_left, puzzle, sizeof(puzzle_state));
-  memcpy(&new_puzzle_right, puzzle, sizeof(puzzle_state));
+static inline int row_conflict(const puzzle_state* puzzle, int row)
+{
+  return row_conflicts[row][piece_code(puzzle->board[row][0]) * 81 + piece_code(puzzle->board[row][1]) * 9 +
+                            piece_code(puzzle->board[row][2])];
+}
 
-  // Lógica para expandir o estado e adicionar os vizinhos à lista ligada
+static inline int col_conflict(const puzzle_state* puzzle, int col)
+{
+  return col_conflicts[col][piece_code(puzzle->board[0][col]) * 81 + piece_code(puzzle->board[1][col]) * 9 +
+                            piece_code(puzzle->board[2][col])];
+}
 
-  // Localizar a posição do espaço vazio no tabuleiro
-  int empty_row = 0;
-  int empty_col = 0;
+// Calcula a posição do espaço vazio e a heurística percorrendo o tabuleiro
+bool puzzle_init(puzzle_state* puzzle)
+{
+  tables_init();
 
-  for(int y = 0; y < 3; y++)
+  bool seen[9] = { false };
+  int h = 0;
+  for(int cell = 0; cell < 9; cell++)
   {
-    for(int x = 0; x < 3; x++)
+    char piece = puzzle->board[cell / 3][cell % 3];
+    int code = piece == '-' ? 0 : piece - '0';
+    if(code < 0 || code > 8 || (code == 0 && piece != '-'))
     {
-      if(puzzle->board[y][x] == '-')
-      {
-        empty_row = y;
-        empty_col = x;
-        break;
-      }
+      return false;
     }
+    seen[code] = true;
+
+    // A variação a partir da posição do objetivo da peça é a sua distância de Manhattan
+    if(code == 0)
+      puzzle->blank = (char)cell;
+    else
+      h += delta_table[code - 1][code - 1][cell];
   }
 
-  // Gerar novos estados vizinhos movendo o espaço vazio
+  for(int line = 0; line < 3; line++)
+  {
+    h += row_conflict(puzzle, line) + col_conflict(puzzle, line);
+  }
+  puzzle->h = (char)h;
+
+  // Um tabuleiro com peças repetidas tem os valores calculados mas não é válido
+  for(int code = 0; code < 9; code++)
+  {
+    if(!seen[code])
+      return false;
+  }
+  return true;
+}
 
-  // Movimento para cima do espaço vazio
-  if(empty_row > 0)
+// Conta os pares de peças pela ordem inversa à do objetivo, lidas linha a linha sem o espaço vazio
+bool puzzle_solvable(const puzzle_state* puzzle)
+{
+  const char* cells = &puzzle->board[0][0];
+  int inversions = 0;
+  for(int i = 0; i < 9; i++)
   {
-    new_puzzle_up.board[empty_row][empty_col] = new_puzzle_up.board[empty_row - 1][empty_col];
-    new_puzzle_up.board[empty_row - 1][empty_col] = '-';
-    linked_list_append(neighbors, state_allocator_new(allocator, &new_puzzle_up));
+    for(int j = i + 1; j < 9; j++)
+    {
+      if(cells[i] != '-' && cells[j] != '-' && cells[i] > cells[j])
+        inversions++;
+    }
   }
+  return inversions % 2 == 0;
+}
 
-  // Movimento para baixo do espaço vazio
-  if(empty_row < 2)
+// Função de heurística para o puzzle 8, distância de Manhattan com conflitos lineares: duas peças na
+// linha (ou coluna) do seu objetivo mas pela ordem inversa obrigam uma delas a sair da linha, pelo
+// que cada peça a retirar soma 2 movimentos. O valor é atualizado por cada movimento em visit
+int heuristic(const state_t* current_state, const state_t*)
+{
+  return ((const puzzle_state*)(current_state->data))->h;
+}
+
+// Heurística inversa do puzzle 8, distância de Manhattan de cada peça à sua posição no tabuleiro
+// indicado (utilizada pela procura para trás, em que o objetivo é o estado inicial)
+int heuristic_reverse(const state_t* current_state, const state_t* target_state)
+{
+  puzzle_state* current_puzzle = (puzzle_state*)(current_state->data);
+  puzzle_state* target_puzzle = (puzzle_state*)(target_state->data);
+
+  // Posição de cada peça no tabuleiro indicado
+  int target_row[9], target_col[9];
+  for(int y = 0; y < 3; y++)
   {
-    new_puzzle_down.board[empty_row][empty_col] = new_puzzle_down.board[empty_row + 1][empty_col];
-    new_puzzle_down.board[empty_row + 1][empty_col] = '-';
-    linked_list_append(neighbors, state_allocator_new(allocator, &new_puzzle_down));
+    for(int x = 0; x < 3; x++)
+    {
+      char piece = target_puzzle->board[y][x];
+      if(piece == '-')
+      {
+        continue;
+      }
+      target_row[piece - 49] = y;
+      target_col[piece - 49] = x;
+    }
   }
 
-  // Movimento para a esquerda
-  if(empty_col > 0)
+  int h = 0;
+  for(int y = 0; y < 3; y++)
   {
-    new_puzzle_left.board[empty_row][empty_col] = new_puzzle_left.board[empty_row][empty_col - 1];
-    new_puzzle_left.board[empty_row][empty_col - 1] = '-';
-    linked_list_append(neighbors, state_allocator_new(allocator, &new_puzzle_left));
+    for(int x = 0; x < 3; x++)
+    {
+      char piece = current_puzzle->board[y][x];
+      if(piece == '-')
+      {
+        continue;
+      }
+      h += abs(x - target_col[piece - 49]) + abs(y - target_row[piece - 49]);
+    }
   }
 
-  // Movimento para a direita
-  if(empty_col < 2)
+  return h;
+}
+
+// Copia o tabuleiro objetivo do puzzle 8, que pode ser expandido pela procura para trás
+void goal_board(puzzle_state* puzzle)
+{
+  tables_init();
+  memcpy(puzzle, &goal_puzzle, sizeof(puzzle_state));
+}
+
+// Função para visitar um estado do puzzle 8, expandir vizinhos possíveis e armazená-los na lista ligada.
+// Mover uma peça altera a sua distância de Manhattan pela tabela das variações e apenas os conflitos
+// da linha (ou coluna) do objetivo da peça, caso seja a linha que a peça deixa ou onde entra
+void visit(state_t* current_state, state_allocator_t* allocator, linked_list_t* neighbors)
+{
+  const puzzle_state* puzzle = (const puzzle_state*)(current_state->data);
+  int blank = puzzle->blank;
+
+  for(const int* move = moves_table[blank]; *move >= 0; move++)
   {
-    new_puzzle_right.board[empty_row][empty_col] = new_puzzle_right.board[empty_row][empty_col + 1];
-    new_puzzle_right.board[empty_row][empty_col + 1] = '-';
-    linked_list_append(neighbors, state_allocator_new(allocator, &new_puzzle_right));
+    int cell = *move;
+    puzzle_state new_puzzle = *puzzle;
+    char piece = puzzle->board[cell / 3][cell % 3];
+    int target = piece - '1';
+    new_puzzle.board[blank / 3][blank % 3] = piece;
+    new_puzzle.board[cell / 3][cell % 3] = '-';
+    new_puzzle.blank = (char)cell;
+
+    // A peça passa da posição cell para a posição do espaço vazio
+    int h = puzzle->h + delta_table[target][cell][blank];
+    if(cell / 3 != blank / 3)
+    {
+      // Movimento vertical, a ordem das colunas não muda
+      int row = heuristic_table[target][0];
+      if(row == cell / 3 || row == blank / 3)
+        h += row_conflict(&new_puzzle, row) - row_conflict(puzzle, row);
+    }
+    else
+    {
+      // Movimento horizontal, a ordem das linhas não muda
+      int col = heuristic_table[target][1];
+      if(col == cell % 3 || col == blank % 3)
+        h += col_conflict(&new_puzzle, col) - col_conflict(puzzle, col);
+    }
+    new_puzzle.h = (char)h;
+
+    linked_list_append(neighbors, state_allocator_new(allocator, &new_puzzle));
   }
 }
 
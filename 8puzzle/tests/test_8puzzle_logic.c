@@ -8,13 +8,16 @@
 START_TEST(test_visit_case_1)
 {
   // Criação do estado inicial do puzzle
-  puzzle_state initial_state = { { { '1', '2', '3' }, { '4', '5', '6' }, { '7', '8', '-' } } };
+  puzzle_state initial_state = { { { '1', '2', '3' }, { '4', '5', '6' }, { '7', '8', '-' } }, 0, 0 };
+  puzzle_init(&initial_state);
 
   // Espaço moveu para cima
-  puzzle_state expected_1 = { { { '1', '2', '3' }, { '4', '5', '-' }, { '7', '8', '6' } } };
+  puzzle_state expected_1 = { { { '1', '2', '3' }, { '4', '5', '-' }, { '7', '8', '6' } }, 0, 0 };
+  puzzle_init(&expected_1);
 
   // Espaço moveu para a esquerda
-  puzzle_state expected_2 = { { { '1', '2', '3' }, { '4', '5', '6' }, { '7', '-', '8' } } };
+  puzzle_state expected_2 = { { { '1', '2', '3' }, { '4', '5', '6' }, { '7', '-', '8' } }, 0, 0 };
+  puzzle_init(&expected_2);
 
   // Criação do alocador de estados
   state_allocator_t* allocator = state_allocator_create(sizeof(puzzle_state));
@@ -54,19 +57,24 @@ END_TEST
 START_TEST(test_visit_case_2)
 {
   // Criação do estado inicial do puzzle
-  puzzle_state initial_state = { { { '1', '2', '3' }, { '4', '-', '5' }, { '6', '7', '8' } } };
+  puzzle_state initial_state = { { { '1', '2', '3' }, { '4', '-', '5' }, { '6', '7', '8' } }, 0, 0 };
+  puzzle_init(&initial_state);
 
   // Espaço moveu para cima
-  puzzle_state expected_1 = { { { '1', '-', '3' }, { '4', '2', '5' }, { '6', '7', '8' } } };
+  puzzle_state expected_1 = { { { '1', '-', '3' }, { '4', '2', '5' }, { '6', '7', '8' } }, 0, 0 };
+  puzzle_init(&expected_1);
 
   // Espaço moveu para baixo
-  puzzle_state expected_2 = { { { '1', '2', '3' }, { '4', '7', '5' }, { '6', '-', '8' } } };
+  puzzle_state expected_2 = { { { '1', '2', '3' }, { '4', '7', '5' }, { '6', '-', '8' } }, 0, 0 };
+  puzzle_init(&expected_2);
 
   // Espaço moveu para a esquerda
-  puzzle_state expected_3 = { { { '1', '2', '3' }, { '-', '4', '5' }, { '6', '7', '8' } } };
+  puzzle_state expected_3 = { { { '1', '2', '3' }, { '-', '4', '5' }, { '6', '7', '8' } }, 0, 0 };
+  puzzle_init(&expected_3);
 
   // Espaço moveu para a direita
-  puzzle_state expected_4 = { { { '1', '2', '3' }, { '4', '5', '-' }, { '6', '7', '8' } } };
+  puzzle_state expected_4 = { { { '1', '2', '3' }, { '4', '5', '-' }, { '6', '7', '8' } }, 0, 0 };
+  puzzle_init(&expected_4);
 
   // Criação do alocador de estados
   state_allocator_t* allocator = state_allocator_create(sizeof(puzzle_state));
@@ -116,13 +124,16 @@ END_TEST
 START_TEST(test_visit_case_3)
 {
   // Criação do estado inicial do puzzle
-  puzzle_state initial_state = { { { '-', '1', '2' }, { '3', '4', '5' }, { '6', '7', '8' } } };
+  puzzle_state initial_state = { { { '-', '1', '2' }, { '3', '4', '5' }, { '6', '7', '8' } }, 0, 0 };
+  puzzle_init(&initial_state);
 
   // Espaço moveu para baixo
-  puzzle_state expected_1 = { { { '3', '1', '2' }, { '-', '4', '5' }, { '6', '7', '8' } } };
+  puzzle_state expected_1 = { { { '3', '1', '2' }, { '-', '4', '5' }, { '6', '7', '8' } }, 0, 0 };
+  puzzle_init(&expected_1);
 
   // Espaço moveu para a direita
-  puzzle_state expected_2 = { { { '1', '-', '2' }, { '3', '4', '5' }, { '6', '7', '8' } } };
+  puzzle_state expected_2 = { { { '1', '-', '2' }, { '3', '4', '5' }, { '6', '7', '8' } }, 0, 0 };
+  puzzle_init(&expected_2);
 
   // Criação do alocador de estados
   state_allocator_t* allocator = state_allocator_create(sizeof(puzzle_state));
@@ -162,13 +173,16 @@ END_TEST
 START_TEST(test_visit_case_4)
 {
   // Criação do estado inicial do puzzle
-  puzzle_state initial_state = { { { '1', '2', '-' }, { '3', '4', '5' }, { '6', '7', '8' } } };
+  puzzle_state initial_state = { { { '1', '2', '-' }, { '3', '4', '5' }, { '6', '7', '8' } }, 0, 0 };
+  puzzle_init(&initial_state);
 
   // Espaço moveu para baixo
-  puzzle_state expected_1 = { { { '1', '2', '5' }, { '3', '4', '-' }, { '6', '7', '8' } } };
+  puzzle_state expected_1 = { { { '1', '2', '5' }, { '3', '4', '-' }, { '6', '7', '8' } }, 0, 0 };
+  puzzle_init(&expected_1);
 
   // Espaço moveu para a esquerda
-  puzzle_state expected_2 = { { { '1', '-', '2' }, { '3', '4', '5' }, { '6', '7', '8' } } };
+  puzzle_state expected_2 = { { { '1', '-', '2' }, { '3', '4', '5' }, { '6', '7', '8' } }, 0, 0 };
+  puzzle_init(&expected_2);
 
   // Criação do alocador de estados
   state_allocator_t* allocator = state_allocator_create(sizeof(puzzle_state));
@@ -208,13 +222,16 @@ END_TEST
 START_TEST(test_visit_case_5)
 {
   // Criação do estado inicial do puzzle
-  puzzle_state initial_state = { { { '1', '2', '3' }, { '3', '4', '5' }, { '-', '7', '8' } } };
+  puzzle_state initial_state = { { { '1', '2', '3' }, { '3', '4', '5' }, { '-', '7', '8' } }, 0, 0 };
+  puzzle_init(&initial_state);
 
   // Espaço moveu para cima
-  puzzle_state expected_1 = { { { '1', '2', '3' }, { '-', '4', '5' }, { '3', '7', '8' } } };
+  puzzle_state expected_1 = { { { '1', '2', '3' }, { '-', '4', '5' }, { '3', '7', '8' } }, 0, 0 };
+  puzzle_init(&expected_1);
 
   // Espaço moveu para a direita
-  puzzle_state expected_2 = { { { '1', '2', '3' }, { '3', '4', '5' }, { '7', '-', '8' } } };
+  puzzle_state expected_2 = { { { '1', '2', '3' }, { '3', '4', '5' }, { '7', '-', '8' } }, 0, 0 };
+  puzzle_init(&expected_2);
 
   // Criação do alocador de estados
   state_allocator_t* allocator = state_allocator_create(sizeof(puzzle_state));
@@ -253,8 +270,8 @@ END_TEST
 
 START_TEST(test_goal)
 {
-  puzzle_state ok_state_data = { { { '1', '2', '3' }, { '4', '-', '5' }, { '6', '7', '8' } } };
-  puzzle_state nok_state_data = { { { '1', '2', '3' }, { '-', '4', '5' }, { '3', '7', '8' } } };
+  puzzle_state ok_state_data = { { { '1', '2', '3' }, { '4', '-', '5' }, { '6', '7', '8' } }, 0, 0 };
+  puzzle_state nok_state_data = { { { '1', '2', '3' }, { '-', '4', '5' }, { '3', '7', '8' } }, 0, 0 };
 
   state_t ok_state = { 0, sizeof(puzzle_state), &ok_state_data };
   state_t nok_state = { 0, sizeof(puzzle_state), &nok_state_data };
@@ -267,8 +284,8 @@ END_TEST
 START_TEST(test_distance)
 {
   // Criação do estado inicial do puzzle
-  puzzle_state ok_state_data = { { { '1', '2', '3' }, { '4', '-', '5' }, { '6', '7', '8' } } };
-  puzzle_state nok_state_data = { { { '1', '2', '3' }, { '-', '4', '5' }, { '3', '7', '8' } } };
+  puzzle_state ok_state_data = { { { '1', '2', '3' }, { '4', '-', '5' }, { '6', '7', '8' } }, 0, 0 };
+  puzzle_state nok_state_data = { { { '1', '2', '3' }, { '-', '4', '5' }, { '3', '7', '8' } }, 0, 0 };
 
   state_t ok_state = { 0, sizeof(puzzle_state), &ok_state_data };
   state_t nok_state = { 0, sizeof(puzzle_state), &nok_state_data };
@@ -281,8 +298,10 @@ END_TEST
 START_TEST(test_heuristic)
 {
   // Criação dos estados de teste
-  puzzle_state current_puzzle = { { { '1', '2', '3' }, { '4', '5', '6' }, { '7', '8', '-' } } };
-  puzzle_state goal_puzzle = { { { '1', '2', '3' }, { '4', '5', '6' }, { '7', '8', '-' } } };
+  puzzle_state current_puzzle = { { { '1', '2', '3' }, { '4', '5', '6' }, { '7', '8', '-' } }, 0, 0 };
+  puzzle_state goal_puzzle = { { { '1', '2', '3' }, { '4', '5', '6' }, { '7', '8', '-' } }, 0, 0 };
+  puzzle_init(&current_puzzle);
+  puzzle_init(&goal_puzzle);
 
   // Criação dos objetos state_t para os estados de teste
   state_t current_state = { 0, sizeof(puzzle_state), &current_puzzle };
@@ -295,8 +314,10 @@ START_TEST(test_heuristic)
   ck_assert_int_eq(h, 0); // O estado atual é igual ao estado objetivo, portanto, a heurística deve ser 0
 
   // Alteração do estado atual para um estado diferente do objetivo
-  current_puzzle.board[2][2] = '3';
   current_puzzle.board[2][0] = '-';
+  current_puzzle.board[2][1] = '7';
+  current_puzzle.board[2][2] = '8';
+  puzzle_init(&current_puzzle);
 
   // Chamada da função heuristic novamente
   h = heuristic(&current_state, &goal_state);
@@ -306,6 +327,90 @@ START_TEST(test_heuristic)
 }
 END_TEST
 
+// Teste unitário dos conflitos lineares e da atualização da heurística em visit
+START_TEST(test_linear_conflict)
+{
+  // As peças 1 e 2 estão na linha do objetivo pela ordem inversa, uma delas tem de sair da linha
+  puzzle_state conflict_puzzle = { { { '2', '1', '3' }, { '4', '5', '6' }, { '7', '8', '-' } }, 0, 0 };
+  ck_assert(puzzle_init(&conflict_puzzle));
+  ck_assert_int_eq(conflict_puzzle.blank, 8);
+  ck_assert_int_eq(conflict_puzzle.h, 4);
+
+  // Peças repetidas ou desconhecidas não formam um tabuleiro válido
+  puzzle_state invalid_puzzle = { { { '1', '1', '3' }, { '4', '5', '6' }, { '7', '8', '-' } }, 0, 0 };
+  ck_assert(!puzzle_init(&invalid_puzzle));
+  invalid_puzzle.board[0][1] = '9';
+  ck_assert(!puzzle_init(&invalid_puzzle));
+
+  // A heurística e o espaço vazio de cada vizinho são os do tabuleiro calculado de novo
+  puzzle_state puzzle = { { { '8', '6', '7' }, { '2', '5', '4' }, { '3', '-', '1' } }, 0, 0 };
+  ck_assert(puzzle_init(&puzzle));
+  state_allocator_t* allocator = state_allocator_create(sizeof(puzzle_state));
+  state_t* current = state_allocator_new(allocator, &puzzle);
+  for(int step = 0; step < 200; step++)
+  {
+    linked_list_t* neighbors = linked_list_create();
+    visit(current, allocator, neighbors);
+    size_t num_neighbors = linked_list_size(neighbors);
+    for(size_t i = 0; i < num_neighbors; i++)
+    {
+      puzzle_state* neighbor = (puzzle_state*)((state_t*)linked_list_get(neighbors, i))->data;
+      puzzle_state expected = *neighbor;
+      ck_assert(puzzle_init(&expected));
+      ck_assert_int_eq(neighbor->h, expected.h);
+      ck_assert_int_eq(neighbor->blank, expected.blank);
+    }
+    current = linked_list_get(neighbors, (size_t)(step * 7) % num_neighbors);
+    linked_list_destroy(neighbors);
+  }
+  state_allocator_destroy(allocator);
+}
+END_TEST
+
+// Teste unitário da verificação de solução pela paridade das inversões
+START_TEST(test_solvable)
+{
+  puzzle_state hard_puzzle = { { { '8', '6', '7' }, { '2', '5', '4' }, { '3', '-', '1' } }, 0, 0 };
+  puzzle_state impossible_puzzle = { { { '2', '3', '5' }, { '-', '8', '7' }, { '1', '4', '6' } }, 0, 0 };
+  puzzle_state goal_puzzle;
+  goal_board(&goal_puzzle);
+  ck_assert(puzzle_solvable(&goal_puzzle));
+  ck_assert(puzzle_solvable(&hard_puzzle));
+  ck_assert(!puzzle_solvable(&impossible_puzzle));
+
+  // Trocar duas peças altera a paridade, mover o espaço vazio não
+  goal_puzzle.board[0][0] = '2';
+  goal_puzzle.board[0][1] = '1';
+  ck_assert(!puzzle_solvable(&goal_puzzle));
+  goal_puzzle.board[2][2] = goal_puzzle.board[1][2];
+  goal_puzzle.board[1][2] = '-';
+  ck_assert(!puzzle_solvable(&goal_puzzle));
+}
+END_TEST
+
+// Teste unitário para a função heuristic_reverse
+START_TEST(test_heuristic_reverse)
+{
+  // O tabuleiro alvo é um estado inicial arbitrário e não o objetivo do problema
+  puzzle_state current_puzzle = { { { '1', '2', '3' }, { '4', '5', '6' }, { '7', '8', '-' } }, 0, 0 };
+  puzzle_state target_puzzle = { { { '1', '2', '3' }, { '4', '5', '6' }, { '7', '-', '8' } }, 0, 0 };
+
+  state_t current_state = { 0, sizeof(puzzle_state), &current_puzzle };
+  puzzle_init(&target_puzzle);
+  state_t target_state = { 0, sizeof(puzzle_state), &target_puzzle };
+
+  // Apenas a peça 8 está fora do lugar
+  ck_assert_int_eq(heuristic_reverse(&current_state, &target_state), 1);
+  ck_assert_int_eq(heuristic_reverse(&target_state, &target_state), 0);
+
+  // Com o tabuleiro objetivo é igual à heurística da procura para a frente
+  puzzle_state goal_puzzle;
+  goal_board(&goal_puzzle);
+  state_t goal_state = { 0, sizeof(puzzle_state), &goal_puzzle };
+  ck_assert_int_eq(heuristic_reverse(&target_state, &goal_state), heuristic(&target_state, NULL));
+}
+END_TEST
+
 // Função auxiliar para criação da suíte de testes
 Suite* create_suite()
 {
@@ -319,6 +424,9 @@ Suite* create_suite()
   tcase_add_test(tcase, test_goal);
   tcase_add_test(tcase, test_distance);
   tcase_add_test(tcase, test_heuristic);
+  tcase_add_test(tcase, test_linear_conflict);
+  tcase_add_test(tcase, test_solvable);
+  tcase_add_test(tcase, test_heuristic_reverse);
   suite_add_tcase(suite, tcase);
   return suite;
 }
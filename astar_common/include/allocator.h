@@ -9,6 +9,7 @@
 
    - `allocator_create`: Inicializa o alocador de memória com o tamanho da estrutura a ser alocada.
    - `allocator_destroy`: Liberta o alocador de memória e todas as páginas alocadas.
+   - `allocator_free`: Devolve uma estrutura ao alocador, a posição é reutilizada pela próxima alocação.
 
    Estrutura do Alocador:
 
@@ -18,6 +19,7 @@
    - `num_pages`: Número total de páginas alocadas.
    - `current_page`: Índice da página atual.
    - `offset`: Deslocamento atual dentro da página.
+   - `free_list`: Lista das posições devolvidas, ligadas através do início de cada posição.
 
    Utilização:
 
@@ -28,6 +30,9 @@
 
    Limitações e Considerações:
 
+   - As posições devolvidas guardam a ligação para a posição seguinte no seu início, pelo que para
+     reutilizar posições a estrutura tem de ter pelo menos o tamanho de um ponteiro. As páginas
+     nunca são devolvidas ao sistema antes de `allocator_destroy`.
    - O alocador atualmente não verifica se a estrutura alocada é maior do que o tamanho da página,
      o que pode resultar em comportamento indefinido se o tamanho da estrutura exceder o tamanho da página.
 
@@ -65,6 +70,8 @@ typedef struct
   size_t num_pages; // Número total de páginas alocadas
   size_t current_page; // Índice da página atual
   size_t offset; // Deslocamento atual dentro da página
+  void* free_list; // Posições devolvidas, reutilizadas antes de avançar na página
+  size_t num_free; // Número de posições na lista de posições devolvidas
   pthread_mutex_t mutex; // Mutex para garantir exclusão mútua
 } allocator_t;
 
@@ -77,4 +84,7 @@ void allocator_destroy(allocator_t* allocator);
 // Aloca uma estrutura de memória no alocador
 void* allocator_alloc(allocator_t* allocator);
 
+// Devolve uma estrutura alocada ao alocador para ser reutilizada
+void allocator_free(allocator_t* allocator, void* ptr);
+
 #endif // ALLOCATOR_H
@@ -3,6 +3,8 @@
 #include "linked_list.h"
 #include "node.h"
 #include "state.h"
+#include <stdatomic.h>
+#include <stdint.h>
 #include <time.h>
 #ifdef STATS_GEN
 #  include "search_data.h"
@@ -14,6 +16,18 @@ typedef struct a_star_t a_star_t;
 // Um nó do nosso algoritmo
 typedef struct a_star_node_t a_star_node_t;
 
+// Bits menos significativos da prioridade dos nós ocupados pelo critério de desempate, o custo f
+// ocupa os restantes e h (no máximo INT_MAX) cabe sem ser truncado
+#define TIE_BREAK_SHIFT 32
+
+// Critério de desempate entre nós com o mesmo custo f
+typedef enum
+{
+  TIE_BREAK_NONE = 0, // Sem desempate, ordem de inserção na min_heap
+  TIE_BREAK_DEEP = 1, // Menor h primeiro, favorece os nós mais próximos do objetivo
+  TIE_BREAK_SHALLOW = 2 // Maior h primeiro, favorece os nós mais próximos do início
+} tie_breaker_e;
+
 // Tipo para funções que calculam a heurística
 typedef int (*heuristic_function)(const state_t*, const state_t*);
 
@@ -26,6 +40,17 @@ typedef bool (*goal_function)(const state_t*, const state_t*);
 // Tipo para funções que devolvem a distancia de um estado para o seu vizinho
 typedef int (*distance_function)(const state_t*, const state_t*);
 
+// Tipo para funções que escrevem os índices vizinhos de um índice, retornam o número de vizinhos.
+// As funções sobre índices descrevem um espaço de estados denso (por exemplo as células de um
+// labirinto), para os algoritmos que guardam a informação de cada índice em vetores
+typedef size_t (*index_neighbors_function)(size_t, size_t*, void*);
+
+// Tipo para funções que calculam a heurística de um índice até ao destino da procura
+typedef int (*index_heuristic_function)(size_t, void*);
+
+// Tipo para funções que convertem um índice nos dados do estado correspondente
+typedef void (*index_state_function)(size_t, void*, void*);
+
 // Estrutura que contem o estado do algoritmo A*
 struct a_star_t
 {
@@ -43,6 +68,26 @@ struct a_star_t
   a_star_node_t* solution;
   state_t* goal_state;
 
+  // Critério de desempate e pedido externo de cancelamento (partilhado com outras procuras)
+  tie_breaker_e tie_breaker;
+  atomic_bool* cancel;
+  bool cancelled; // A procura terminou por ter sido cancelada
+
+  // A heurística do problema é consistente: um nó fechado nunca é reaberto e o objetivo é aceite
+  // quando é gerado se o seu custo não exceder o f do nó expandido
+  bool consistent;
+
+  // Resumo do estado objetivo, os restantes estados são excluídos sem invocar a função objetivo
+  bool goal_hash_set;
+  size_t goal_hash;
+
+  // Limite superior do custo da solução, os nós com f acima do limite não são inseridos (0: sem limite)
+  int upper_bound;
+
+  // Motivo pelo qual a procura não foi executada, por exemplo uma instância provada sem solução pelo
+  // problema (NULL: a procura foi executada)
+  const char* skipped;
+
   // Informação estatística
   int generated;
   int expanded;
@@ -69,6 +114,39 @@ a_star_t* a_star_create(size_t struct_size,
 // Liberta uma instância do algoritmo A* sequencial
 void a_star_destroy(a_star_t* a_star);
 
+// Limpa os estados, nós, solução e estatísticas para que a instância possa resolver um novo problema
+bool a_star_reset(a_star_t* a_star);
+
+// Define o critério de desempate entre nós com o mesmo custo f
+void a_star_set_tie_breaker(a_star_t* a_star, tie_breaker_e tie_breaker);
+
+// Indica se a heurística do problema é consistente, permite ao A* sequencial não reabrir nós
+// fechados e testar o objetivo na geração dos nós
+void a_star_set_consistent(a_star_t* a_star, bool consistent);
+
+// Define o estado objetivo de um problema com um único objetivo, o teste do objetivo passa a
+// comparar primeiro o resumo do estado
+void a_star_set_goal_hash(a_star_t* a_star, const void* goal);
+
+// Define o limite superior do custo da solução, utilizado pelo A* sequencial (0: sem limite)
+void a_star_set_upper_bound(a_star_t* a_star, int upper_bound);
+
+// Indica que a procura não foi executada e o motivo, apresentado com as estatísticas
+void a_star_set_skipped(a_star_t* a_star, const char* reason);
+
+// Verifica se um estado é o objetivo, com o resumo do objetivo definido a maioria dos estados é
+// excluída por uma comparação de inteiros
+bool a_star_goal(a_star_t* a_star, const state_t* state);
+
+// Associa uma variável de cancelamento, a procura termina quando esta passar a verdadeiro
+void a_star_set_cancel(a_star_t* a_star, atomic_bool* cancel);
+
+// Verifica se foi pedido o cancelamento da procura
+bool a_star_cancel_requested(a_star_t* a_star);
+
+// Prioridade de um nó na lista aberta: o custo f com o critério de desempate codificado
+int64_t a_star_priority(a_star_t* a_star, a_star_node_t* node);
+
 // Imprime as estatísticas possíveis
 void a_star_print_statistics(a_star_t* a_star, bool csv, bool show_solution);
 
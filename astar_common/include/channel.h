@@ -9,8 +9,7 @@
   de especificar em qual fila quer colocar a mensagem. As fila de mensagens são FIFO.
 
   As operações de colocar mensagens e de retirar mensagens são thread-safe com recurso ao uso de mutexes. Por uma
-  questão de performance é possível também colocar um bloco de mensagens para filas diferentes e o canal deve
-  distribuir as mensagens para a fila correta.
+  questão de performance é possível também colocar um bloco de mensagens numa fila com uma única operação.
 */
 
 #ifndef CHANNEL_H
@@ -38,6 +37,9 @@ channel_t* channel_create(size_t num_queues, size_t struct_size);
 // Envia uma mensagem para uma fila específica no canal
 void channel_send(channel_t* channel, size_t queue_index, void* data);
 
+// Envia um bloco de mensagens para uma fila específica no canal
+void channel_send_batch(channel_t* channel, size_t queue_index, void* data, size_t count);
+
 // Recebe uma mensagem da fila específica no canal (bloqueante)
 void* channel_receive(channel_t* channel, size_t queue_index, size_t* len);
 
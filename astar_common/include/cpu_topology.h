@@ -0,0 +1,84 @@
+/*
+   Topologia do CPU e afinidade de tarefas
+
+   Este módulo lê a topologia dos processadores lógicos disponíveis a partir de
+   /sys/devices/system/cpu (pacote físico e núcleo de cada CPU lógico) e calcula o
+   mapeamento de trabalhadores para CPUs de acordo com uma política de colocação.
+
+   Políticas suportadas:
+
+   - `AFFINITY_NONE`: não fixa as tarefas, o escalonador do sistema decide.
+   - `AFFINITY_COMPACT`: preenche um núcleo físico (incluindo os seus irmãos SMT) e um
+     pacote antes de passar para o seguinte, os trabalhadores ficam próximos entre si.
+   - `AFFINITY_SCATTER`: distribui os trabalhadores pelos pacotes e núcleos físicos,
+     apenas reutiliza irmãos SMT quando todos os núcleos físicos já têm um trabalhador.
+
+   Funcionalidades:
+
+   - `cpu_topology_create`: Lê a topologia dos CPUs em que o processo pode correr.
+   - `cpu_topology_destroy`: Liberta a memória utilizada pela topologia.
+   - `cpu_topology_physical_cores`: Número de núcleos físicos disponíveis.
+   - `cpu_topology_map`: Calcula o CPU lógico atribuído a cada trabalhador.
+   - `cpu_topology_pin`: Fixa uma tarefa a um CPU lógico.
+
+   Limitações e Considerações:
+
+   - Caso /sys não esteja disponível considera-se que cada CPU lógico é um núcleo físico
+     num único pacote.
+   - Apenas suportado em Linux (utiliza sched_getaffinity e pthread_setaffinity_np).
+*/
+#ifndef CPU_TOPOLOGY_H
+#define CPU_TOPOLOGY_H
+
+#include <pthread.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+// Políticas de colocação dos trabalhadores
+typedef enum
+{
+  AFFINITY_NONE = 0,
+  AFFINITY_COMPACT = 1,
+  AFFINITY_SCATTER = 2
+} affinity_policy_e;
+
+// Informação de um CPU lógico
+typedef struct
+{
+  int cpu; // Identificador do CPU lógico
+  int core; // Identificador do núcleo físico (core_id)
+  int package; // Identificador do pacote físico (socket)
+  int smt_index; // Posição do CPU lógico dentro do seu núcleo físico
+} cpu_info_t;
+
+// Topologia dos CPUs disponíveis para o processo
+typedef struct
+{
+  cpu_info_t* cpus; // CPUs lógicos ordenados por pacote, núcleo e CPU
+  size_t num_cpus; // Número de CPUs lógicos
+  size_t num_cores; // Número de núcleos físicos
+  size_t num_packages; // Número de pacotes físicos
+} cpu_topology_t;
+
+// Lê a topologia dos CPUs disponíveis
+cpu_topology_t* cpu_topology_create();
+
+// Liberta a memória utilizada pela topologia
+void cpu_topology_destroy(cpu_topology_t* topology);
+
+// Retorna o número de núcleos físicos disponíveis
+size_t cpu_topology_physical_cores(cpu_topology_t* topology);
+
+// Preenche mapping[i] com o índice (em topology->cpus) do CPU atribuído ao trabalhador i
+void cpu_topology_map(cpu_topology_t* topology, affinity_policy_e policy, size_t num_workers, int* mapping);
+
+// Fixa uma tarefa a um CPU lógico, retorna falso em caso de erro
+bool cpu_topology_pin(pthread_t thread, int cpu);
+
+// Converte o nome de uma política ("compact", "scatter" ou "none") para o seu valor
+bool affinity_from_str(const char* name, affinity_policy_e* policy);
+
+// Converte uma política para o seu nome
+const char* affinity_to_str(affinity_policy_e policy);
+
+#endif // CPU_TOPOLOGY_H
@@ -5,6 +5,7 @@
    - Inicializar uma nova hashtable com um tamanho de struct especificado.
    - Inserir uma struct na hashtable usando uma chave gerada a partir dos dados da struct.
    - Verificar se uma struct está presente na hashtable.
+   - Retirar uma struct da hashtable.
    - Libertar a memória utilizada pela hashtable.
 
    Estrutura da HashTable:
@@ -60,6 +61,7 @@
 #include <pthread.h>
 #include <stdbool.h>
 #include <stddef.h>
+#include <stdint.h>
 #define HASH_MAX_MUTEXES 8192
 #define HASH_CAPACITY 65533
 
@@ -100,12 +102,20 @@ void hashtable_insert(hashtable_t* hashtable, void* data);
 // ou o ponteiro para a zona de memória onde se encontra os dados
 void* hashtable_contains(hashtable_t* hashtable, const void* data);
 
+// Retira uma struct da hashtable, retorna o ponteiro para os dados que estavam guardados ou NULL se
+// os dados não foram encontrados. Os dados não são libertados
+void* hashtable_remove(hashtable_t* hashtable, const void* data);
+
 // Liberta a memória utilizada pela hashtable, atenção, não liberta os dados apenas a hashtable
 void hashtable_destroy(hashtable_t* hashtable, bool free_data);
 
 // Função de hashing utilizada
 size_t hash_function(const void* data, size_t size, size_t mod);
 
+// Resumo FNV-1a de 64 bits de uma zona de memória, para tabelas próprias dos algoritmos com um
+// número de posições potência de 2 e para identificar dados guardados em ficheiros
+uint64_t hash_fnv1a(const void* data, size_t size);
+
 // Insere uma struct na hashtable
 entry_t* hashtable_reserve(hashtable_t* hashtable, void* data);
 
@@ -0,0 +1,67 @@
+/*
+   Heurística ALT (A*, Landmarks, Triangle inequality) para espaços de índices densos
+
+   São escolhidos k marcos e guardada a distância de cada índice a cada marco. Pela desigualdade
+   triangular, |d(L, objetivo) - d(L, n)| nunca excede a distância de n ao objetivo, pelo que o
+   máximo sobre os marcos é uma heurística admissível e consistente para qualquer objetivo, não
+   apenas para o objetivo conhecido quando as tabelas foram calculadas.
+
+   - Os marcos são escolhidos pelo ponto mais afastado: o primeiro é o índice mais afastado do índice
+     de partida, cada um dos seguintes é o índice com a maior distância ao marco mais próximo. A
+     escolha de cada marco depende das distâncias dos anteriores, pelo que as procuras em largura são
+     feitas uma a uma e cada uma é também a tabela do seu marco.
+   - As distâncias de um índice a todos os marcos estão seguidas em memória, com 16 bits por valor
+     quando a maior distância cabe em 16 bits e 32 bits caso contrário. Os índices sem caminho até
+     um marco têm o valor máximo e esse marco é ignorado.
+   - As tabelas podem ser guardadas num ficheiro e lidas através de mmap, sem copiar os dados, com uma
+     chave indicada pelo problema para recusar ficheiros de outra instância.
+
+   Requer um problema não dirigido de custo unitário, como as funções de vizinhos por índice.
+*/
+#ifndef LANDMARKS_H
+#define LANDMARKS_H
+#include "astar.h"
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+// Estrutura com os marcos e as distâncias de cada índice a cada marco
+typedef struct
+{
+  size_t num_indices;
+  size_t num_landmarks;
+  size_t width; // Bytes por distância, 2 ou 4
+  uint64_t* landmarks; // Índice de cada marco
+  void* distances; // num_indices * num_landmarks distâncias, agrupadas por índice
+
+  // Ficheiro mapeado em memória, NULL quando as tabelas foram calculadas
+  void* mapping;
+  size_t mapping_size;
+} landmarks_t;
+
+// Escolhe num_landmarks marcos a partir do índice seed e calcula as suas distâncias. O número de
+// marcos pode ser menor se não existirem índices alcançáveis suficientes
+landmarks_t* landmarks_create(size_t num_indices,
+                              size_t max_neighbors,
+                              index_neighbors_function neighbors_func,
+                              void* context,
+                              size_t num_landmarks,
+                              size_t seed);
+
+// Lê as tabelas de um ficheiro guardado por landmarks_save, retorna NULL se o ficheiro não existir ou
+// não for do problema com num_indices índices e a chave indicada
+landmarks_t* landmarks_load(const char* filename, size_t num_indices, uint64_t key);
+
+// Guarda as tabelas num ficheiro que pode ser mapeado em memória
+bool landmarks_save(const landmarks_t* landmarks, const char* filename, uint64_t key);
+
+// Liberta a memória ou o mapeamento das tabelas
+void landmarks_destroy(landmarks_t* landmarks);
+
+// Distância de um índice a um marco, UINT32_MAX se não existe caminho
+uint32_t landmarks_distance(const landmarks_t* landmarks, size_t landmark, size_t index);
+
+// Heurística de um índice até ao objetivo, o maior |d(L, objetivo) - d(L, índice)| dos marcos
+int landmarks_heuristic(const landmarks_t* landmarks, size_t index, size_t goal);
+
+#endif // LANDMARKS_H
@@ -50,11 +50,12 @@
 #ifndef MIN_HEAP_H
 #define MIN_HEAP_H
 #include <stddef.h>
+#include <stdint.h>
 
 // Estrutura para representar um nó do heap
 typedef struct
 {
-  int cost;
+  int64_t cost; // 64 bits para caber o custo f com o critério de desempate
   void* data;
 } heap_node_t;
 
@@ -73,19 +74,19 @@ min_heap_t* min_heap_create();\
 void min_heap_destroy(min_heap_t* heap);
 
 // Insere um novo elemento no heap
-size_t min_heap_insert(min_heap_t* heap, int cost, void* data);
+size_t min_heap_insert(min_heap_t* heap, int64_t cost, void* data);
 
 // Extrai e retorna o elemento de custo mínimo do heap
 heap_node_t min_heap_pop(min_heap_t* heap);
 
 // Remove um elemento específico do heap
-void min_heap_remove(min_heap_t* heap, int cost, void* data);
+void min_heap_remove(min_heap_t* heap, int64_t cost, void* data);
 
 // Atualiza o custo de um nó específico no heap
-void min_heap_update(min_heap_t* heap, int old_cost, int new_cost, void* data);
+void min_heap_update(min_heap_t* heap, int64_t old_cost, int64_t new_cost, void* data);
 
 // Atualiza o custo de um nó específico no heap
-void min_heap_update_cost(min_heap_t* heap, int index, int cost);
+void min_heap_update_cost(min_heap_t* heap, int index, int64_t cost);
 
 // Limpa a min_heap
 void min_heap_clean(min_heap_t* heap);
@@ -12,6 +12,12 @@
    3. Aloque novos estados ou obtenha acesso estados existentes com a função state_allocator_new().
    5. Liberte a memória utilizada pelo alocador com a função state_allocator_destroy().
 
+   Modo temporário:
+   - Criado com state_allocator_create_scratch(), os estados não são indexados nem guardados de forma
+     permanente, ocupam uma de capacity posições que são reutilizadas de forma circular.
+   - Útil para algoritmos que não guardam os estados gerados (ex: IDA*), que devem copiar os dados
+     de que precisam antes de gerar mais estados do que a capacidade.
+
    Limitações e Considerações:
    - Esta implementação não lida com situações de concorrência.
    - Esta estrutura foi desenvolvida como parte de um projeto universitário com o objetivo de
@@ -46,11 +52,23 @@ typedef struct
   size_t struct_size;
   allocator_t* allocator;
   hashtable_t* states;
+
+  // Modo temporário, posições reutilizáveis em vez de estados indexados
+  state_t* scratch_states;
+  char* scratch_data;
+  size_t scratch_capacity;
+  size_t scratch_next;
 } state_allocator_t;
 
 // Cria e inicializa um novo gestor de estados.
 state_allocator_t* state_allocator_create(size_t struct_size);
 
+// Cria um gestor de estados temporário, que não indexa os estados e reutiliza capacity posições
+state_allocator_t* state_allocator_create_scratch(size_t struct_size, size_t capacity);
+
+// Volta a utilizar as posições de um gestor temporário desde o início
+void state_allocator_scratch_reset(state_allocator_t* allocator);
+
 // Liberta um gestor de estado (incluindo a memória)
 void state_allocator_destroy(state_allocator_t* allocator);
 
@@ -16,6 +16,8 @@ allocator_t* allocator_create(size_t struct_size)
   allocator->num_pages = 0;
   allocator->current_page = 0;
   allocator->offset = 0;
+  allocator->free_list = NULL;
+  allocator->num_free = 0;
   pthread_mutex_init(&allocator->mutex, NULL);
 
   return allocator;
@@ -43,6 +45,16 @@ void* allocator_alloc(allocator_t* allocator)
   // Bloqueia o acesso ao alocador
   pthread_mutex_lock(&allocator->mutex);
 
+  // Reutilizamos primeiro as posições devolvidas
+  if(allocator->free_list != NULL)
+  {
+    void* slot = allocator->free_list;
+    allocator->free_list = *(void**)slot;
+    allocator->num_free--;
+    pthread_mutex_unlock(&allocator->mutex);
+    return slot;
+  }
+
   // Se não houver páginas alocadas, alocar a primeira página
   if(allocator->num_pages == 0)
   {
@@ -75,3 +87,18 @@ void* allocator_alloc(allocator_t* allocator)
 
   return ptr;
 }
+
+// Devolve uma estrutura ao alocador, a posição passa para o início da lista de posições livres
+void allocator_free(allocator_t* allocator, void* ptr)
+{
+  if(ptr == NULL || allocator->struct_size < sizeof(void*))
+  {
+    return;
+  }
+
+  pthread_mutex_lock(&allocator->mutex);
+  *(void**)ptr = allocator->free_list;
+  allocator->free_list = ptr;
+  allocator->num_free++;
+  pthread_mutex_unlock(&allocator->mutex);
+}
@@ -1,4 +1,5 @@
 #include "astar.h"
+#include <limits.h>
 #include <stdint.h>
 #include <stdio.h>
 #include <stdlib.h>
@@ -47,9 +48,20 @@ a_star_t* a_star_create(size_t struct_size,
   a_star->solution = NULL;
   a_star->goal_state = NULL;
 
+  // Sem desempate e sem cancelamento externo
+  a_star->tie_breaker = TIE_BREAK_NONE;
+  a_star->cancel = NULL;
+  a_star->cancelled = false;
+  a_star->consistent = false;
+  a_star->goal_hash_set = false;
+  a_star->goal_hash = 0;
+  a_star->upper_bound = 0;
+  a_star->skipped = NULL;
+
   // Reinicia as estatísticas
   a_star->generated = 0;
   a_star->expanded = 0;
+  a_star->execution_time = 0;
   a_star->max_min_heap_size = 0;
   a_star->nodes_new = 0;
   a_star->nodes_reinserted = 0;
@@ -76,6 +88,150 @@ void a_star_destroy(a_star_t* a_star)
   free(a_star);
 }
 
+// Limpa os estados, nós, solução e estatísticas para que a instância possa resolver um novo problema
+bool a_star_reset(a_star_t* a_star)
+{
+  if(a_star == NULL)
+  {
+    return false;
+  }
+
+  // Os estados e nós da procura anterior deixam de ser necessários, recriamos os gestores
+  size_t struct_size = a_star->state_allocator->struct_size;
+  print_function print_func = a_star->node_allocator->print_func;
+
+  state_allocator_destroy(a_star->state_allocator);
+  node_allocator_destroy(a_star->node_allocator);
+  a_star->state_allocator = state_allocator_create(struct_size);
+  a_star->node_allocator = node_allocator_create(print_func);
+  if(a_star->state_allocator == NULL || a_star->node_allocator == NULL)
+  {
+    return false;
+  }
+
+  // Limpa solução e estado a atingir
+  a_star->solution = NULL;
+  a_star->goal_state = NULL;
+  a_star->cancelled = false;
+  a_star->skipped = NULL;
+
+  // Reinicia as estatísticas
+  a_star->generated = 0;
+  a_star->expanded = 0;
+  a_star->execution_time = 0;
+  a_star->max_min_heap_size = 0;
+  a_star->nodes_new = 0;
+  a_star->nodes_reinserted = 0;
+  a_star->paths_better = 0;
+  a_star->paths_worst_or_equals = 0;
+  a_star->num_solutions = 0;
+  a_star->num_worst_solutions = 0;
+  a_star->num_better_solutions = 0;
+
+  return true;
+}
+
+// Define o critério de desempate entre nós com o mesmo custo f
+void a_star_set_tie_breaker(a_star_t* a_star, tie_breaker_e tie_breaker)
+{
+  if(a_star == NULL)
+  {
+    return;
+  }
+
+  a_star->tie_breaker = tie_breaker;
+}
+
+// Indica se a heurística do problema é consistente
+void a_star_set_consistent(a_star_t* a_star, bool consistent)
+{
+  if(a_star == NULL)
+  {
+    return;
+  }
+
+  a_star->consistent = consistent;
+}
+
+// Define o estado objetivo, o resumo é calculado tal como o do gestor de estados
+void a_star_set_goal_hash(a_star_t* a_star, const void* goal)
+{
+  if(a_star == NULL)
+  {
+    return;
+  }
+
+  a_star->goal_hash_set = goal != NULL;
+  a_star->goal_hash = goal != NULL ? hash_function(goal, a_star->state_allocator->struct_size, HASH_CAPACITY) : 0;
+}
+
+// Define o limite superior do custo da solução
+void a_star_set_upper_bound(a_star_t* a_star, int upper_bound)
+{
+  if(a_star == NULL)
+  {
+    return;
+  }
+
+  a_star->upper_bound = upper_bound;
+}
+
+// Indica que a procura não foi executada e o motivo
+void a_star_set_skipped(a_star_t* a_star, const char* reason)
+{
+  if(a_star == NULL)
+  {
+    return;
+  }
+
+  a_star->skipped = reason;
+}
+
+// Verifica se um estado é o objetivo, comparando primeiro o resumo do estado quando é conhecido
+bool a_star_goal(a_star_t* a_star, const state_t* state)
+{
+  if(a_star->goal_hash_set && state->hash != a_star->goal_hash)
+  {
+    return false;
+  }
+
+  return a_star->goal_func(state, a_star->goal_state);
+}
+
+// Associa uma variável de cancelamento, a procura termina quando esta passar a verdadeiro
+void a_star_set_cancel(a_star_t* a_star, atomic_bool* cancel)
+{
+  if(a_star == NULL)
+  {
+    return;
+  }
+
+  a_star->cancel = cancel;
+}
+
+// Verifica se foi pedido o cancelamento da procura
+bool a_star_cancel_requested(a_star_t* a_star)
+{
+  return a_star->cancel != NULL && atomic_load_explicit(a_star->cancel, memory_order_relaxed);
+}
+
+// Prioridade de um nó na lista aberta, o desempate ocupa os bits menos significativos pelo
+// que a ordem pelo custo f se mantém
+int64_t a_star_priority(a_star_t* a_star, a_star_node_t* node)
+{
+  int64_t f = (int64_t)node->g + node->h;
+
+  switch(a_star->tie_breaker)
+  {
+    case TIE_BREAK_DEEP:
+      return (f << TIE_BREAK_SHIFT) + node->h;
+    case TIE_BREAK_SHALLOW:
+      return (f << TIE_BREAK_SHIFT) + (INT_MAX - node->h);
+    default:
+      return f;
+  }
+}
+
 // Imprime estatísticas do algoritmo sequencial no formato desejado
 void a_star_print_statistics(a_star_t* a_star, bool csv, bool show_solution)
 {
@@ -102,6 +258,14 @@ void a_star_print_statistics(a_star_t* a_star, bool csv, bool show_solution)
     {
       printf("Resultado do algoritmo: Solução não encontrada.\n");
     }
+    if(a_star->cancelled)
+    {
+      printf("Procura cancelada antes de terminar.\n");
+    }
+    if(a_star->skipped != NULL)
+    {
+      printf("Procura não executada: %s.\n", a_star->skipped);
+    }
     printf("Estatísticas Globais:\n");
     printf("- Estados gerados: %d\n", a_star->generated);
     printf("- Estados expandidos: %d\n", a_star->expanded);
@@ -116,7 +280,8 @@ void a_star_print_statistics(a_star_t* a_star, bool csv, bool show_solution)
   }
   else
   {
-    printf("\"%s\";%d;%d;%d;%ld;%d;%d;%d;%d;%d;%d;%d;%.6f\n",
+    // A última coluna é o motivo pelo qual a procura não foi executada, vazia quando foi executada
+    printf("\"%s\";%d;%d;%d;%ld;%d;%d;%d;%d;%d;%d;%d;%.6f;\"%s\"\n",
            a_star->solution ? "sim" : "não",
            a_star->solution ? a_star->solution->g : 0,
            a_star->generated,
@@ -129,6 +294,7 @@ void a_star_print_statistics(a_star_t* a_star, bool csv, bool show_solution)
            a_star->num_solutions,
            a_star->num_worst_solutions,
            a_star->num_better_solutions,
-           a_star->execution_time);
+           a_star->execution_time,
+           a_star->skipped != NULL ? a_star->skipped : "");
   }
 }
@@ -102,6 +102,38 @@ void channel_send(channel_t* channel, size_t queue_index, void* data)
   pthread_mutex_unlock(&(channel->queue_lock[queue_index]));
 }
 
+// Envia um bloco de mensagens para uma fila específica no canal
+void channel_send_batch(channel_t* channel, size_t queue_index, void* data, size_t count)
+{
+  // Verifica se o índice da fila é válido
+  if(queue_index >= channel->num_queues || count == 0)
+  {
+    return; // Índice inválido
+  }
+
+  pthread_mutex_lock(&(channel->queue_lock[queue_index]));
+
+  if(channel->queues[queue_index])
+  {
+    if(channel->queue_pos[queue_index] + count > channel->queue_size[queue_index])
+    {
+      while(channel->queue_pos[queue_index] + count > channel->queue_size[queue_index])
+      {
+        channel->queue_size[queue_index] *= 2;
+      }
+      channel->queues[queue_index] =
+          realloc(channel->queues[queue_index], channel->struct_size * channel->queue_size[queue_index]);
+    }
+
+    memcpy((char*)channel->queues[queue_index] + channel->queue_pos[queue_index] * channel->struct_size,
+           data,
+           channel->struct_size * count);
+    channel->queue_pos[queue_index] += count;
+  }
+
+  pthread_mutex_unlock(&(channel->queue_lock[queue_index]));
+}
+
 void* channel_receive(channel_t* channel, size_t queue_index, size_t* len)
 {
   if(channel == NULL)
@@ -120,6 +152,7 @@ void* channel_receive(channel_t* channel, size_t queue_index, size_t* len)
   *len = channel->queue_pos[queue_index];
   if( channel->queue_pos[queue_index] == 0)
   {
+    pthread_mutex_unlock(&(channel->queue_lock[queue_index]));
     return NULL;
   }
 
@@ -128,6 +161,7 @@ void* channel_receive(channel_t* channel, size_t queue_index, size_t* len)
   if(!queue_data)
   {
     *len = 0;
+    pthread_mutex_unlock(&(channel->queue_lock[queue_index]));
     return NULL;
   }
 
@@ -0,0 +1,250 @@
+#define _GNU_SOURCE
+#include "cpu_topology.h"
+#include <sched.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#define SYSFS_CPU_PATH "/sys/devices/system/cpu"
+
+static const char* affinity_labels[] = { "none", "compact", "scatter" };
+
+// Lê um inteiro de um ficheiro do sysfs, retorna -1 caso não seja possível
+static int read_sysfs_int(int cpu, const char* entry)
+{
+  char path[256];
+  snprintf(path, sizeof(path), SYSFS_CPU_PATH "/cpu%d/topology/%s", cpu, entry);
+
+  FILE* file = fopen(path, "r");
+  if(file == NULL)
+  {
+    return -1;
+  }
+
+  int value = -1;
+  if(fscanf(file, "%d", &value) != 1)
+  {
+    value = -1;
+  }
+  fclose(file);
+
+  return value;
+}
+
+// Ordena os CPUs por pacote, núcleo e CPU lógico
+static int compare_cpu_info(const void* a, const void* b)
+{
+  const cpu_info_t* cpu_a = (const cpu_info_t*)a;
+  const cpu_info_t* cpu_b = (const cpu_info_t*)b;
+
+  if(cpu_a->package != cpu_b->package)
+    return cpu_a->package - cpu_b->package;
+  if(cpu_a->core != cpu_b->core)
+    return cpu_a->core - cpu_b->core;
+  return cpu_a->cpu - cpu_b->cpu;
+}
+
+// Lê a topologia dos CPUs disponíveis
+cpu_topology_t* cpu_topology_create()
+{
+  cpu_topology_t* topology = (cpu_topology_t*)malloc(sizeof(cpu_topology_t));
+  if(topology == NULL)
+  {
+    return NULL; // Erro de alocação
+  }
+
+  // Apenas consideramos os CPUs em que este processo pode correr
+  cpu_set_t allowed;
+  CPU_ZERO(&allowed);
+  if(sched_getaffinity(0, sizeof(cpu_set_t), &allowed) != 0)
+  {
+    long configured = sysconf(_SC_NPROCESSORS_ONLN);
+    for(long i = 0; i < configured && i < CPU_SETSIZE; i++)
+    {
+      CPU_SET(i, &allowed);
+    }
+  }
+
+  topology->num_cpus = CPU_COUNT(&allowed);
+  topology->cpus = (cpu_info_t*)malloc(topology->num_cpus * sizeof(cpu_info_t));
+  if(topology->cpus == NULL)
+  {
+    free(topology);
+    return NULL; // Erro de alocação
+  }
+
+  size_t n = 0;
+  for(int cpu = 0; cpu < CPU_SETSIZE && n < topology->num_cpus; cpu++)
+  {
+    if(!CPU_ISSET(cpu, &allowed))
+    {
+      continue;
+    }
+
+    // Sem informação no sysfs cada CPU lógico é considerado um núcleo físico
+    int core = read_sysfs_int(cpu, "core_id");
+    int package = read_sysfs_int(cpu, "physical_package_id");
+    topology->cpus[n].cpu = cpu;
+    topology->cpus[n].core = core < 0 ? cpu : core;
+    topology->cpus[n].package = package < 0 ? 0 : package;
+    topology->cpus[n].smt_index = 0;
+    n++;
+  }
+  topology->num_cpus = n;
+
+  qsort(topology->cpus, topology->num_cpus, sizeof(cpu_info_t), compare_cpu_info);
+
+  // Após ordenar, CPUs do mesmo núcleo ficam consecutivos, numeramos os irmãos SMT
+  // e contamos os núcleos e pacotes
+  topology->num_cores = 0;
+  topology->num_packages = 0;
+  for(size_t i = 0; i < topology->num_cpus; i++)
+  {
+    cpu_info_t* info = &topology->cpus[i];
+    if(i > 0 && info->package == topology->cpus[i - 1].package && info->core == topology->cpus[i - 1].core)
+    {
+      info->smt_index = topology->cpus[i - 1].smt_index + 1;
+      continue;
+    }
+
+    topology->num_cores++;
+    if(i == 0 || info->package != topology->cpus[i - 1].package)
+    {
+      topology->num_packages++;
+    }
+  }
+
+  return topology;
+}
+
+// Liberta a memória utilizada pela topologia
+void cpu_topology_destroy(cpu_topology_t* topology)
+{
+  if(topology == NULL)
+  {
+    return;
+  }
+
+  free(topology->cpus);
+  free(topology);
+}
+
+// Retorna o número de núcleos físicos disponíveis
+size_t cpu_topology_physical_cores(cpu_topology_t* topology)
+{
+  if(topology == NULL || topology->num_cores == 0)
+  {
+    return 1;
+  }
+
+  return topology->num_cores;
+}
+
+// Preenche mapping[i] com o índice do CPU atribuído ao trabalhador i
+void cpu_topology_map(cpu_topology_t* topology, affinity_policy_e policy, size_t num_workers, int* mapping)
+{
+  if(topology == NULL || mapping == NULL || topology->num_cpus == 0)
+  {
+    return;
+  }
+
+  if(policy != AFFINITY_SCATTER)
+  {
+    // A topologia já se encontra ordenada por pacote, núcleo e irmão SMT, basta percorrer
+    for(size_t i = 0; i < num_workers; i++)
+    {
+      mapping[i] = (int)(i % topology->num_cpus);
+    }
+    return;
+  }
+
+  // Para espalhar os trabalhadores percorremos por nível SMT, depois pela posição do núcleo
+  // dentro do pacote e por fim alternamos os pacotes
+  int* order = (int*)malloc(topology->num_cpus * sizeof(int));
+  int* core_rank = (int*)malloc(topology->num_cpus * sizeof(int));
+  if(order == NULL || core_rank == NULL)
+  {
+    free(order);
+    free(core_rank);
+    cpu_topology_map(topology, AFFINITY_COMPACT, num_workers, mapping);
+    return;
+  }
+
+  int max_rank = 0;
+  int max_smt = 0;
+  for(size_t i = 0; i < topology->num_cpus; i++)
+  {
+    cpu_info_t* info = &topology->cpus[i];
+    if(i == 0 || info->package != topology->cpus[i - 1].package)
+    {
+      core_rank[i] = 0;
+    }
+    else if(info->smt_index == 0)
+    {
+      core_rank[i] = core_rank[i - 1] + 1;
+    }
+    else
+    {
+      core_rank[i] = core_rank[i - 1];
+    }
+
+    if(core_rank[i] > max_rank)
+      max_rank = core_rank[i];
+    if(info->smt_index > max_smt)
+      max_smt = info->smt_index;
+  }
+
+  size_t n = 0;
+  for(int smt = 0; smt <= max_smt; smt++)
+  {
+    for(int rank = 0; rank <= max_rank; rank++)
+    {
+      for(size_t i = 0; i < topology->num_cpus; i++)
+      {
+        if(topology->cpus[i].smt_index == smt && core_rank[i] == rank)
+        {
+          order[n++] = (int)i;
+        }
+      }
+    }
+  }
+
+  for(size_t i = 0; i < num_workers; i++)
+  {
+    mapping[i] = order[i % n];
+  }
+
+  free(core_rank);
+  free(order);
+}
+
+// Fixa uma tarefa a um CPU lógico
+bool cpu_topology_pin(pthread_t thread, int cpu)
+{
+  cpu_set_t set;
+  CPU_ZERO(&set);
+  CPU_SET(cpu, &set);
+  return pthread_setaffinity_np(thread, sizeof(cpu_set_t), &set) == 0;
+}
+
+// Converte o nome de uma política para o seu valor
+bool affinity_from_str(const char* name, affinity_policy_e* policy)
+{
+  for(int i = 0; i < (int)(sizeof(affinity_labels) / sizeof(affinity_labels[0])); i++)
+  {
+    if(strcmp(name, affinity_labels[i]) == 0)
+    {
+      *policy = (affinity_policy_e)i;
+      return true;
+    }
+  }
+
+  return false;
+}
+
+// Converte uma política para o seu nome
+const char* affinity_to_str(affinity_policy_e policy)
+{
+  return affinity_labels[(int)policy];
+}
@@ -20,6 +20,19 @@ size_t hash_function(const void* data, size_t size, size_t mod)
   return hash_value % mod;
 }
 
+// Resumo FNV-1a de 64 bits de uma zona de memória
+uint64_t hash_fnv1a(const void* data, size_t size)
+{
+  const unsigned char* bytes = (const unsigned char*)data;
+  uint64_t hash = 14695981039346656037ULL;
+  for(size_t i = 0; i < size; i++)
+  {
+    hash ^= bytes[i];
+    hash *= 1099511628211ULL;
+  }
+  return hash;
+}
+
 // Função para calcular o índice do bucket na hashtable
 static size_t hash(hashtable_t* hashtable, const void* data)
 {
@@ -156,6 +169,45 @@ void* hashtable_contains(hashtable_t* hashtable, const void* data)
   return NULL;
 }
 
+// Retira uma struct da hashtable, retorna o ponteiro para os dados ou NULL caso não exista
+void* hashtable_remove(hashtable_t* hashtable, const void* data)
+{
+  // Calcula o índice do bucket
+  size_t index = hashtable->hash_func(hashtable, data);
+
+  // Calcula o mutex para este índice
+  int mutex_id = index % HASH_MAX_MUTEXES;
+
+  // bloqueia o respetivo bucket
+  pthread_mutex_lock(&hashtable->mutexes[mutex_id]);
+
+  // Procuramos a ligação que aponta para a entrada, para a retirar da lista
+  entry_t** link = &hashtable->buckets[index];
+  while(*link != NULL)
+  {
+    entry_t* entry = *link;
+    bool equal = hashtable->cmp_func == NULL ? memcmp(entry->data, data, hashtable->struct_size) == 0
+                                             : hashtable->cmp_func(entry->data, data);
+    if(equal)
+    {
+      *link = entry->next;
+
+      // Desbloqueia o bucket
+      pthread_mutex_unlock(&hashtable->mutexes[mutex_id]);
+
+      void* removed = entry->data;
+      free(entry);
+      return removed;
+    }
+    link = &entry->next;
+  }
+
+  // Desbloqueia o bucket
+  pthread_mutex_unlock(&hashtable->mutexes[mutex_id]);
+
+  return NULL;
+}
+
 // Liberta a memória utilizada pela hashtable, atenção, não liberta os dados apenas a hashtable
 void hashtable_destroy(hashtable_t* hashtable, bool free_data)
 {
@@ -0,0 +1,273 @@
+#include "landmarks.h"
+#include <fcntl.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+// Cabeçalho do ficheiro das tabelas, seguido dos índices dos marcos e das distâncias
+typedef struct
+{
+  char magic[8];
+  uint64_t key;
+  uint64_t num_indices;
+  uint64_t num_landmarks;
+  uint64_t width;
+} landmarks_header_t;
+
+static const char LANDMARKS_MAGIC[8] = "ALTLMK1";
+
+// Procura em largura a partir de um índice, as distâncias são escritas em distances[i * stride] e os
+// índices sem caminho ficam com UINT32_MAX. Retorna o último índice alcançado, o mais afastado
+static size_t landmarks_bfs(size_t num_indices,
+                            index_neighbors_function neighbors_func,
+                            void* context,
+                            size_t* queue,
+                            size_t* neighbors,
+                            size_t from,
+                            uint32_t* distances,
+                            size_t stride)
+{
+  for(size_t i = 0; i < num_indices; i++)
+    distances[i * stride] = UINT32_MAX;
+
+  size_t head = 0, tail = 0;
+  distances[from * stride] = 0;
+  queue[tail++] = from;
+  while(head < tail)
+  {
+    size_t index = queue[head++];
+    size_t count = neighbors_func(index, neighbors, context);
+    for(size_t i = 0; i < count; i++)
+    {
+      if(distances[neighbors[i] * stride] == UINT32_MAX)
+      {
+        distances[neighbors[i] * stride] = distances[index * stride] + 1;
+        queue[tail++] = neighbors[i];
+      }
+    }
+  }
+
+  return queue[tail - 1];
+}
+
+// Escolhe os marcos pelo ponto mais afastado e calcula as suas distâncias
+landmarks_t* landmarks_create(size_t num_indices,
+                              size_t max_neighbors,
+                              index_neighbors_function neighbors_func,
+                              void* context,
+                              size_t num_landmarks,
+                              size_t seed)
+{
+  if(num_indices == 0 || num_landmarks == 0 || seed >= num_indices)
+  {
+    return NULL;
+  }
+
+  landmarks_t* landmarks = (landmarks_t*)calloc(1, sizeof(landmarks_t));
+  size_t* queue = (size_t*)malloc(num_indices * sizeof(size_t));
+  size_t* neighbors = (size_t*)malloc(max_neighbors * sizeof(size_t));
+  uint32_t* closest = (uint32_t*)malloc(num_indices * sizeof(uint32_t));
+  uint32_t* distances = (uint32_t*)malloc(num_indices * num_landmarks * sizeof(uint32_t));
+  uint64_t* indices = (uint64_t*)malloc(num_landmarks * sizeof(uint64_t));
+  if(landmarks == NULL || queue == NULL || neighbors == NULL || closest == NULL || distances == NULL || indices == NULL)
+  {
+    free(landmarks);
+    free(queue);
+    free(neighbors);
+    free(closest);
+    free(distances);
+    free(indices);
+    return NULL; // Erro de alocação
+  }
+
+  // O primeiro marco é o índice mais afastado da partida, a distância ao marco mais próximo de cada
+  // índice começa pela distância à partida e só os índices alcançáveis podem ser marcos
+  size_t next = landmarks_bfs(num_indices, neighbors_func, context, queue, neighbors, seed, closest, 1);
+  size_t count = 0;
+  uint32_t max_distance = 0;
+  while(count < num_landmarks)
+  {
+    indices[count] = next;
+    landmarks_bfs(num_indices, neighbors_func, context, queue, neighbors, next, distances + count, num_landmarks);
+
+    // O próximo marco é o índice mais afastado de todos os marcos escolhidos
+    uint32_t farthest = 0;
+    for(size_t i = 0; i < num_indices; i++)
+    {
+      uint32_t d = distances[i * num_landmarks + count];
+      if(d == UINT32_MAX)
+        continue;
+      if(d > max_distance)
+        max_distance = d;
+      if(count == 0 || d < closest[i])
+        closest[i] = d;
+      if(closest[i] > farthest)
+      {
+        farthest = closest[i];
+        next = i;
+      }
+    }
+    count++;
+
+    // Todos os índices alcançáveis já são marcos
+    if(farthest == 0)
+      break;
+  }
+  free(queue);
+  free(neighbors);
+  free(closest);
+
+  // Compactamos as tabelas no mesmo bloco, com os marcos escolhidos e 16 bits por distância se
+  // possível. A posição escrita nunca está à frente da posição lida
+  size_t width = max_distance < UINT16_MAX ? sizeof(uint16_t) : sizeof(uint32_t);
+  for(size_t i = 0; i < num_indices; i++)
+  {
+    for(size_t l = 0; l < count; l++)
+    {
+      uint32_t d = distances[i * num_landmarks + l];
+      if(width == sizeof(uint16_t))
+        ((uint16_t*)distances)[i * count + l] = d == UINT32_MAX ? UINT16_MAX : (uint16_t)d;
+      else
+        distances[i * count + l] = d;
+    }
+  }
+  void* packed = realloc(distances, num_indices * count * width);
+
+  landmarks->num_indices = num_indices;
+  landmarks->num_landmarks = count;
+  landmarks->width = width;
+  landmarks->landmarks = indices;
+  landmarks->distances = packed != NULL ? packed : distances;
+  return landmarks;
+}
+
+// Lê as tabelas mapeando o ficheiro em memória
+landmarks_t* landmarks_load(const char* filename, size_t num_indices, uint64_t key)
+{
+  int fd = open(filename, O_RDONLY);
+  if(fd < 0)
+  {
+    return NULL;
+  }
+
+  struct stat st;
+  if(fstat(fd, &st) != 0 || (size_t)st.st_size < sizeof(landmarks_header_t))
+  {
+    close(fd);
+    return NULL;
+  }
+
+  size_t size = (size_t)st.st_size;
+  void* mapping = mmap(NULL, size, PROT_READ, MAP_SHARED, fd, 0);
+  close(fd);
+  if(mapping == MAP_FAILED)
+  {
+    return NULL;
+  }
+
+  // O cabeçalho tem de ser desta versão e deste problema, e o tamanho o das tabelas indicadas
+  const landmarks_header_t* header = (const landmarks_header_t*)mapping;
+  bool valid = memcmp(header->magic, LANDMARKS_MAGIC, sizeof(header->magic)) == 0 && header->key == key &&
+               header->num_indices == num_indices && header->num_landmarks > 0 &&
+               (header->width == sizeof(uint16_t) || header->width == sizeof(uint32_t)) &&
+               size == sizeof(landmarks_header_t) + header->num_landmarks * sizeof(uint64_t) +
+                           num_indices * header->num_landmarks * header->width;
+  landmarks_t* landmarks = valid ? (landmarks_t*)calloc(1, sizeof(landmarks_t)) : NULL;
+  if(landmarks == NULL)
+  {
+    munmap(mapping, size);
+    return NULL;
+  }
+
+  landmarks->num_indices = num_indices;
+  landmarks->num_landmarks = header->num_landmarks;
+  landmarks->width = header->width;
+  landmarks->landmarks = (uint64_t*)((char*)mapping + sizeof(landmarks_header_t));
+  landmarks->distances = landmarks->landmarks + landmarks->num_landmarks;
+  landmarks->mapping = mapping;
+  landmarks->mapping_size = size;
+  return landmarks;
+}
+
+// Guarda o cabeçalho, os marcos e as distâncias tal como estão em memória
+bool landmarks_save(const landmarks_t* landmarks, const char* filename, uint64_t key)
+{
+  FILE* file = fopen(filename, "wb");
+  if(file == NULL)
+  {
+    return false;
+  }
+
+  landmarks_header_t header;
+  memset(&header, 0, sizeof(header));
+  memcpy(header.magic, LANDMARKS_MAGIC, sizeof(header.magic));
+  header.key = key;
+  header.num_indices = landmarks->num_indices;
+  header.num_landmarks = landmarks->num_landmarks;
+  header.width = landmarks->width;
+
+  size_t num_distances = landmarks->num_indices * landmarks->num_landmarks;
+  bool ok = fwrite(&header, sizeof(header), 1, file) == 1 &&
+            fwrite(landmarks->landmarks, sizeof(uint64_t), landmarks->num_landmarks, file) == landmarks->num_landmarks &&
+            fwrite(landmarks->distances, landmarks->width, num_distances, file) == num_distances;
+  ok = fclose(file) == 0 && ok;
+  if(!ok)
+  {
+    remove(filename);
+  }
+  return ok;
+}
+
+// Liberta a memória ou o mapeamento das tabelas
+void landmarks_destroy(landmarks_t* landmarks)
+{
+  if(landmarks == NULL)
+  {
+    return;
+  }
+
+  if(landmarks->mapping != NULL)
+  {
+    munmap(landmarks->mapping, landmarks->mapping_size);
+  }
+  else
+  {
+    free(landmarks->landmarks);
+    free(landmarks->distances);
+  }
+
+  free(landmarks);
+}
+
+// Distância de um índice a um marco, UINT32_MAX se não existe caminho
+uint32_t landmarks_distance(const landmarks_t* landmarks, size_t landmark, size_t index)
+{
+  size_t position = index * landmarks->num_landmarks + landmark;
+  if(landmarks->width == sizeof(uint16_t))
+  {
+    uint16_t d = ((const uint16_t*)landmarks->distances)[position];
+    return d == UINT16_MAX ? UINT32_MAX : d;
+  }
+  return ((const uint32_t*)landmarks->distances)[position];
+}
+
+// Heurística ALT, os marcos sem caminho até um dos índices não contribuem
+int landmarks_heuristic(const landmarks_t* landmarks, size_t index, size_t goal)
+{
+  uint32_t h = 0;
+  for(size_t l = 0; l < landmarks->num_landmarks; l++)
+  {
+    uint32_t d_index = landmarks_distance(landmarks, l, index);
+    uint32_t d_goal = landmarks_distance(landmarks, l, goal);
+    if(d_index == UINT32_MAX || d_goal == UINT32_MAX)
+      continue;
+
+    uint32_t diff = d_index > d_goal ? d_index - d_goal : d_goal - d_index;
+    if(diff > h)
+      h = diff;
+  }
+  return (int)h;
+}
@@ -104,7 +104,7 @@ void heapify_down(min_heap_t* heap, size_t index)
   }
 }
 
-size_t min_heap_insert(min_heap_t* heap, int cost, void* data)
+size_t min_heap_insert(min_heap_t* heap, int64_t cost, void* data)
 {
   if(heap == NULL)
   {
@@ -162,7 +162,7 @@ heap_node_t min_heap_pop(min_heap_t* heap)
   return min_node;
 }
 
-void min_heap_remove(min_heap_t* heap, int cost, void* data)
+void min_heap_remove(min_heap_t* heap, int64_t cost, void* data)
 {
   if(heap == NULL)
   {
@@ -193,7 +193,7 @@ void min_heap_remove(min_heap_t* heap, int cost, void* data)
   heapify_up(heap, index);
 }
 
-void min_heap_update(min_heap_t* heap, int old_cost, int new_cost, void* data)
+void min_heap_update(min_heap_t* heap, int64_t old_cost, int64_t new_cost, void* data)
 {
   if(heap == NULL)
   {
@@ -224,7 +224,7 @@ void min_heap_update(min_heap_t* heap, int old_cost, int new_cost, void* data)
   heapify_up(heap, index);
 }
 
-void min_heap_update_cost(min_heap_t* heap, int index, int cost)
+void min_heap_update_cost(min_heap_t* heap, int index, int64_t cost)
 {
   if(heap == NULL)
   {
@@ -39,9 +39,53 @@ state_allocator_t* state_allocator_create(size_t struct_size)
   // Para indexarmos os estados que já existem
   allocator->states = hashtable_create(struct_size, compare_state_t, NULL);
 
+  // Não é um gestor temporário
+  allocator->scratch_states = NULL;
+  allocator->scratch_data = NULL;
+  allocator->scratch_capacity = 0;
+  allocator->scratch_next = 0;
+
+  return allocator;
+}
+
+// Cria um gestor de estados temporário, que não indexa os estados e reutiliza capacity posições
+state_allocator_t* state_allocator_create_scratch(size_t struct_size, size_t capacity)
+{
+  state_allocator_t* allocator = (state_allocator_t*)malloc(sizeof(state_allocator_t));
+
+  if(allocator == NULL)
+  {
+    return NULL; // Erro de alocação
+  }
+
+  allocator->struct_size = struct_size;
+  allocator->allocator = NULL;
+  allocator->states = NULL;
+  allocator->scratch_capacity = capacity < 1 ? 1 : capacity;
+  allocator->scratch_next = 0;
+  allocator->scratch_states = (state_t*)malloc(allocator->scratch_capacity * sizeof(state_t));
+  allocator->scratch_data = (char*)malloc(allocator->scratch_capacity * struct_size);
+
+  if(allocator->scratch_states == NULL || allocator->scratch_data == NULL)
+  {
+    state_allocator_destroy(allocator);
+    return NULL;
+  }
+
   return allocator;
 }
 
+// Volta a utilizar as posições de um gestor temporário desde o início
+void state_allocator_scratch_reset(state_allocator_t* allocator)
+{
+  if(allocator == NULL)
+  {
+    return;
+  }
+
+  allocator->scratch_next = 0;
+}
+
 // Liberta o gestor de estados e todos os estados gerados
 void state_allocator_destroy(state_allocator_t* allocator)
 {
@@ -51,8 +95,16 @@ void state_allocator_destroy(state_allocator_t* allocator)
   }
 
   // Limpamos a nossa memória
-  hashtable_destroy(allocator->states, true);
-  allocator_destroy(allocator->allocator);
+  if(allocator->states != NULL)
+  {
+    hashtable_destroy(allocator->states, true);
+  }
+  if(allocator->allocator != NULL)
+  {
+    allocator_destroy(allocator->allocator);
+  }
+  free(allocator->scratch_states);
+  free(allocator->scratch_data);
 
   // Libertamos o alocador
   free(allocator);
@@ -67,6 +119,18 @@ state_t* state_allocator_new(state_allocator_t* allocator, void* state_data)
     return NULL;
   }
 
+  // No modo temporário o estado ocupa a próxima posição livre, sem ser indexado
+  if(allocator->scratch_states != NULL)
+  {
+    size_t slot = allocator->scratch_next++ % allocator->scratch_capacity;
+    state_t* scratch_state = &allocator->scratch_states[slot];
+    scratch_state->struct_size = allocator->struct_size;
+    scratch_state->hash = hash_function(state_data, allocator->struct_size, HASH_CAPACITY);
+    scratch_state->data = allocator->scratch_data + slot * allocator->struct_size;
+    memcpy(scratch_state->data, state_data, allocator->struct_size);
+    return scratch_state;
+  }
+
   state_t* new_state = (state_t*)malloc(sizeof(state_t));
   if(new_state == NULL)
   {
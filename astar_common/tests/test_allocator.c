@@ -30,12 +30,37 @@ START_TEST(test_allocator_alloc)
 }
 END_TEST
 
+START_TEST(test_allocator_free)
+{
+  allocator_t* allocator = allocator_create(sizeof(my_struct_t));
+
+  my_struct_t* struct1 = (my_struct_t*)allocator_alloc(allocator);
+  my_struct_t* struct2 = (my_struct_t*)allocator_alloc(allocator);
+  allocator_free(allocator, struct1);
+  allocator_free(allocator, struct2);
+  ck_assert_uint_eq(allocator->num_free, 2);
+
+  // As posições devolvidas são reutilizadas pela ordem inversa da devolução
+  ck_assert_ptr_eq(allocator_alloc(allocator), struct2);
+  ck_assert_ptr_eq(allocator_alloc(allocator), struct1);
+  ck_assert_uint_eq(allocator->num_free, 0);
+
+  // Sem posições devolvidas a alocação continua na página
+  my_struct_t* struct3 = (my_struct_t*)allocator_alloc(allocator);
+  ck_assert_ptr_ne(struct3, struct1);
+  ck_assert_ptr_ne(struct3, struct2);
+
+  allocator_destroy(allocator);
+}
+END_TEST
+
 Suite* allocator_suite()
 {
   Suite* suite = suite_create("allocator_t");
   TCase* test_case = tcase_create("allocation");
 
   tcase_add_test(test_case, test_allocator_alloc);
+  tcase_add_test(test_case, test_allocator_free);
 
   suite_add_tcase(suite, test_case);
 
@@ -1,5 +1,7 @@
 #include "astar.h"
+#include "min_heap.h"
 #include <check.h>
+#include <limits.h>
 #include <stdlib.h>
 #include <stdint.h>
 
@@ -74,12 +76,160 @@ START_TEST(test_astar)
 }
 END_TEST
 
+START_TEST(test_astar_reset)
+{
+  a_star_t* a_star = a_star_create(sizeof(my_struct_t), NULL, NULL, NULL, NULL, NULL);
+
+  my_struct_t state_data = { 2, 2 };
+  state_t* state = state_allocator_new(a_star->state_allocator, &state_data);
+  a_star_node_t* node = node_allocator_new(a_star->node_allocator, state);
+  a_star->solution = node;
+  a_star->expanded = 10;
+  a_star->generated = 20;
+
+  ck_assert(a_star_reset(a_star));
+
+  ck_assert_ptr_null(a_star->solution);
+  ck_assert_ptr_null(a_star->goal_state);
+  ck_assert_int_eq(a_star->expanded, 0);
+  ck_assert_int_eq(a_star->generated, 0);
+  ck_assert_uint_eq(a_star->state_allocator->struct_size, sizeof(my_struct_t));
+
+  // Os nós da procura anterior já não existem
+  state = state_allocator_new(a_star->state_allocator, &state_data);
+  ck_assert_ptr_null(node_allocator_get(a_star->node_allocator, state));
+
+  a_star_destroy(a_star);
+}
+END_TEST
+
+START_TEST(test_astar_priority)
+{
+  a_star_t* a_star = a_star_create(sizeof(my_struct_t), NULL, NULL, NULL, NULL, NULL);
+
+  a_star_node_t near = { 8, 2, NULL, NULL, SIZE_MAX };
+  a_star_node_t far = { 4, 6, NULL, NULL, SIZE_MAX };
+  a_star_node_t worse = { 9, 2, NULL, NULL, SIZE_MAX };
+
+  // Sem desempate a prioridade é o custo f
+  ck_assert_int_eq(a_star_priority(a_star, &near), 10);
+  ck_assert_int_eq(a_star_priority(a_star, &far), 10);
+
+  // Com o mesmo f o nó mais próximo do objetivo sai primeiro, sem alterar a ordem pelo f
+  a_star_set_tie_breaker(a_star, TIE_BREAK_DEEP);
+  ck_assert_int_lt(a_star_priority(a_star, &near), a_star_priority(a_star, &far));
+  ck_assert_int_lt(a_star_priority(a_star, &far), a_star_priority(a_star, &worse));
+
+  a_star_set_tie_breaker(a_star, TIE_BREAK_SHALLOW);
+  ck_assert_int_gt(a_star_priority(a_star, &near), a_star_priority(a_star, &far));
+  ck_assert_int_lt(a_star_priority(a_star, &near), a_star_priority(a_star, &worse));
+
+  a_star_destroy(a_star);
+}
+END_TEST
+
+// Custos f de labirintos grandes, acima do limite de uma prioridade de 32 bits com desempate
+START_TEST(test_astar_priority_limit)
+{
+  a_star_t* a_star = a_star_create(sizeof(my_struct_t), NULL, NULL, NULL, NULL, NULL);
+
+  // f = 524288 e 524289, com h acima de 4096 para que o desempate não seja truncado
+  a_star_node_t near = { 500000, 24288, NULL, NULL, SIZE_MAX };
+  a_star_node_t far = { 480000, 44288, NULL, NULL, SIZE_MAX };
+  a_star_node_t worse = { 500001, 24288, NULL, NULL, SIZE_MAX };
+  a_star_node_t huge = { INT_MAX - 5, 5, NULL, NULL, SIZE_MAX };
+
+  ck_assert_int_eq(a_star_priority(a_star, &huge), INT_MAX);
+
+  a_star_set_tie_breaker(a_star, TIE_BREAK_DEEP);
+  ck_assert_int_lt(a_star_priority(a_star, &near), a_star_priority(a_star, &far));
+  ck_assert_int_lt(a_star_priority(a_star, &far), a_star_priority(a_star, &worse));
+  ck_assert_int_lt(a_star_priority(a_star, &worse), a_star_priority(a_star, &huge));
+
+  a_star_set_tie_breaker(a_star, TIE_BREAK_SHALLOW);
+  ck_assert_int_gt(a_star_priority(a_star, &near), a_star_priority(a_star, &far));
+  ck_assert_int_lt(a_star_priority(a_star, &near), a_star_priority(a_star, &worse));
+  ck_assert_int_lt(a_star_priority(a_star, &worse), a_star_priority(a_star, &huge));
+
+  // A min_heap ordena pelos 64 bits da prioridade
+  min_heap_t* heap = min_heap_create();
+  min_heap_insert(heap, a_star_priority(a_star, &huge), &huge);
+  min_heap_insert(heap, a_star_priority(a_star, &worse), &worse);
+  min_heap_insert(heap, a_star_priority(a_star, &near), &near);
+  min_heap_insert(heap, a_star_priority(a_star, &far), &far);
+  ck_assert_ptr_eq(min_heap_pop(heap).data, &far);
+  ck_assert_ptr_eq(min_heap_pop(heap).data, &near);
+  ck_assert_ptr_eq(min_heap_pop(heap).data, &worse);
+  ck_assert_ptr_eq(min_heap_pop(heap).data, &huge);
+  min_heap_destroy(heap);
+
+  a_star_destroy(a_star);
+}
+END_TEST
+
+START_TEST(test_astar_cancel)
+{
+  a_star_t* a_star = a_star_create(sizeof(my_struct_t), NULL, NULL, NULL, NULL, NULL);
+  atomic_bool cancel;
+  atomic_init(&cancel, false);
+
+  ck_assert(!a_star_cancel_requested(a_star));
+
+  a_star_set_cancel(a_star, &cancel);
+  ck_assert(!a_star_cancel_requested(a_star));
+
+  atomic_store(&cancel, true);
+  ck_assert(a_star_cancel_requested(a_star));
+
+  a_star_destroy(a_star);
+}
+END_TEST
+
+// Objetivo de teste, conta as invocações
+static int goal_calls = 0;
+static bool my_goal(const state_t* state, const state_t*)
+{
+  goal_calls++;
+  return ((my_struct_t*)state->data)->x == 5;
+}
+
+START_TEST(test_astar_goal_hash)
+{
+  a_star_t* a_star = a_star_create(sizeof(my_struct_t), my_goal, NULL, NULL, NULL, NULL);
+
+  my_struct_t data_goal = { 5, 5 };
+  my_struct_t data_other = { 2, 2 };
+  state_t* goal_state = state_allocator_new(a_star->state_allocator, &data_goal);
+  state_t* other_state = state_allocator_new(a_star->state_allocator, &data_other);
+
+  // Sem resumo a função objetivo é sempre invocada
+  goal_calls = 0;
+  ck_assert(a_star_goal(a_star, goal_state));
+  ck_assert(!a_star_goal(a_star, other_state));
+  ck_assert_int_eq(goal_calls, 2);
+
+  // Com o resumo do objetivo um estado com outro resumo é excluído sem a invocar
+  a_star_set_goal_hash(a_star, &data_goal);
+  goal_calls = 0;
+  ck_assert(a_star_goal(a_star, goal_state));
+  ck_assert(!a_star_goal(a_star, other_state));
+  ck_assert_int_eq(goal_calls, 1);
+
+  a_star_destroy(a_star);
+}
+END_TEST
+
 Suite* allocator_suite()
 {
   Suite* suite = suite_create("astar_t");
   TCase* test_case = tcase_create("astar test");
 
   tcase_add_test(test_case, test_astar);
+  tcase_add_test(test_case, test_astar_reset);
+  tcase_add_test(test_case, test_astar_priority);
+  tcase_add_test(test_case, test_astar_priority_limit);
+  tcase_add_test(test_case, test_astar_cancel);
+  tcase_add_test(test_case, test_astar_goal_hash);
 
   suite_add_tcase(suite, test_case);
 
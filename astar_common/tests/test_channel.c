@@ -47,6 +47,48 @@ START_TEST(test_channel_send_receive)
 }
 END_TEST
 
+// Teste de envio de um bloco de mensagens, maior do que o buffer inicial da fila
+START_TEST(test_channel_send_batch)
+{
+  size_t num_queues = 2;
+  size_t count = QUEUE_BUFFER_SIZE * 3;
+  channel_t* channel = channel_create(num_queues, sizeof(int));
+
+  int* batch = (int*)malloc(count * sizeof(int));
+  for(size_t i = 0; i < count; i++)
+  {
+    batch[i] = (int)i;
+  }
+
+  int first = -1;
+  channel_send(channel, 1, &first);
+  channel_send_batch(channel, 1, batch, count);
+
+  ck_assert_int_eq(channel_has_messages(channel, 0), 0);
+  ck_assert_int_eq(channel_has_messages(channel, 1), 1);
+
+  size_t len;
+  int* data = (int*)channel_receive(channel, 1, &len);
+
+  ck_assert_ptr_nonnull(data);
+  ck_assert_uint_eq(len, count + 1);
+  ck_assert_int_eq(data[0], first);
+  for(size_t i = 0; i < count; i++)
+  {
+    ck_assert_int_eq(data[i + 1], (int)i);
+  }
+
+  // Uma fila vazia não tem mensagens para receber
+  ck_assert_ptr_null(channel_receive(channel, 1, &len));
+  ck_assert_uint_eq(len, 0);
+
+  free(data);
+  free(batch);
+
+  channel_destroy(channel);
+}
+END_TEST
+
 // Função principal de teste
 int main(void)
 {
@@ -56,6 +98,7 @@ int main(void)
   // Adiciona os testes ao caso de teste
   tcase_add_test(testcase, test_channel_create);
   tcase_add_test(testcase, test_channel_send_receive);
+  tcase_add_test(testcase, test_channel_send_batch);
 
   // Adiciona o caso de teste à suíte
   suite_add_tcase(suite, testcase);
@@ -0,0 +1,107 @@
+#include "cpu_topology.h"
+#include <check.h>
+#include <stdlib.h>
+
+// Teste de leitura da topologia
+START_TEST(test_cpu_topology_create)
+{
+  cpu_topology_t* topology = cpu_topology_create();
+
+  ck_assert_ptr_nonnull(topology);
+  ck_assert_uint_ge(topology->num_cpus, 1);
+  ck_assert_uint_ge(topology->num_packages, 1);
+  ck_assert_uint_ge(topology->num_cores, topology->num_packages);
+  ck_assert_uint_le(topology->num_cores, topology->num_cpus);
+  ck_assert_uint_eq(cpu_topology_physical_cores(topology), topology->num_cores);
+
+  cpu_topology_destroy(topology);
+}
+END_TEST
+
+// Teste do mapeamento compacto, os trabalhadores ocupam os CPUs pela ordem da topologia
+START_TEST(test_cpu_topology_map_compact)
+{
+  cpu_topology_t* topology = cpu_topology_create();
+  size_t num_workers = topology->num_cpus * 2;
+  int* mapping = (int*)malloc(num_workers * sizeof(int));
+
+  cpu_topology_map(topology, AFFINITY_COMPACT, num_workers, mapping);
+
+  for(size_t i = 0; i < num_workers; i++)
+  {
+    ck_assert_int_eq(mapping[i], (int)(i % topology->num_cpus));
+  }
+
+  free(mapping);
+  cpu_topology_destroy(topology);
+}
+END_TEST
+
+// Teste do mapeamento espalhado, os primeiros trabalhadores ficam em núcleos físicos diferentes
+START_TEST(test_cpu_topology_map_scatter)
+{
+  cpu_topology_t* topology = cpu_topology_create();
+  size_t num_workers = topology->num_cpus;
+  int* mapping = (int*)malloc(num_workers * sizeof(int));
+
+  cpu_topology_map(topology, AFFINITY_SCATTER, num_workers, mapping);
+
+  for(size_t i = 0; i < topology->num_cores; i++)
+  {
+    ck_assert_int_lt(mapping[i], (int)topology->num_cpus);
+    ck_assert_int_eq(topology->cpus[mapping[i]].smt_index, 0);
+    for(size_t j = 0; j < i; j++)
+    {
+      ck_assert_int_ne(mapping[i], mapping[j]);
+    }
+  }
+
+  free(mapping);
+  cpu_topology_destroy(topology);
+}
+END_TEST
+
+// Teste da conversão dos nomes das políticas
+START_TEST(test_affinity_from_str)
+{
+  affinity_policy_e policy = AFFINITY_NONE;
+
+  ck_assert(affinity_from_str("compact", &policy));
+  ck_assert_int_eq(policy, AFFINITY_COMPACT);
+  ck_assert(affinity_from_str("scatter", &policy));
+  ck_assert_int_eq(policy, AFFINITY_SCATTER);
+  ck_assert(!affinity_from_str("unknown", &policy));
+  ck_assert_str_eq(affinity_to_str(AFFINITY_SCATTER), "scatter");
+}
+END_TEST
+
+// Função principal de teste
+int main(void)
+{
+  Suite* suite = suite_create("cpu_topology_t");
+  TCase* testcase = tcase_create("Core");
+
+  // Adiciona os testes ao caso de teste
+  tcase_add_test(testcase, test_cpu_topology_create);
+  tcase_add_test(testcase, test_cpu_topology_map_compact);
+  tcase_add_test(testcase, test_cpu_topology_map_scatter);
+  tcase_add_test(testcase, test_affinity_from_str);
+
+  // Adiciona o caso de teste à suíte
+  suite_add_tcase(suite, testcase);
+
+  // Cria um corredor de teste
+  SRunner* runner = srunner_create(suite);
+
+  // Executa os testes
+  srunner_run_all(runner, CK_NORMAL);
+
+  // Armazena o número de falhas
+  int num_failed = srunner_ntests_failed(runner);
+
+  // Liberta o teste runner
+  srunner_free(runner);
+
+  // Retorna o código de saída com base no número de falhas
+  return (num_failed == 0) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
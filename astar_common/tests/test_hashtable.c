@@ -42,6 +42,36 @@ START_TEST(test_hashtable)
 }
 END_TEST
 
+// Teste da remoção, apenas a entrada pedida deixa a hashtable
+START_TEST(test_hashtable_remove)
+{
+  hashtable_t* hashtable = hashtable_create(sizeof(Person), NULL, NULL);
+
+  Person person1 = { 1, "Alice" };
+  Person person2 = { 2, "Bob" };
+  hashtable_insert(hashtable, &person1);
+  hashtable_insert(hashtable, &person2);
+
+  // A remoção retorna o ponteiro guardado, mesmo quando procuramos com uma cópia
+  Person copy = person1;
+  ck_assert_ptr_eq(hashtable_remove(hashtable, &copy), &person1);
+  ck_assert(!hashtable_contains(hashtable, &person1));
+  ck_assert(hashtable_contains(hashtable, &person2));
+  ck_assert_ptr_null(hashtable_remove(hashtable, &person1));
+
+  hashtable_destroy(hashtable, false);
+}
+END_TEST
+
+// Valores de referência do FNV-1a de 64 bits
+START_TEST(test_hash_fnv1a)
+{
+  ck_assert_uint_eq(hash_fnv1a("", 0), 14695981039346656037ULL);
+  ck_assert_uint_eq(hash_fnv1a("a", 1), 0xaf63dc4c8601ec8cULL);
+  ck_assert_uint_eq(hash_fnv1a("foobar", 6), 0x85944171f73967e8ULL);
+}
+END_TEST
+
 // TODO: Escrever teste para quando se usam ponteiros e precisamos de libertar dados
 
 // TODO: Escrever teste para testar uso de comparador
@@ -55,6 +85,8 @@ int main(void)
   // Adiciona o teste à suite
   TCase* tcase = tcase_create("Core");
   tcase_add_test(tcase, test_hashtable);
+  tcase_add_test(tcase, test_hashtable_remove);
+  tcase_add_test(tcase, test_hash_fnv1a);
   suite_add_tcase(suite, tcase);
 
   // Cria um objeto de retorno do teste
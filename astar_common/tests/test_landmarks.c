@@ -0,0 +1,85 @@
+#include "landmarks.h"
+#include <check.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+
+// Caminho 0 - 1 - 2 - 3 - 4 e um índice 5 isolado
+static size_t line_neighbors(size_t index, size_t* neighbors, void* context)
+{
+  (void)context;
+  size_t count = 0;
+  if(index >= 5)
+    return 0;
+  if(index > 0)
+    neighbors[count++] = index - 1;
+  if(index < 4)
+    neighbors[count++] = index + 1;
+  return count;
+}
+
+START_TEST(test_landmarks)
+{
+  landmarks_t* landmarks = landmarks_create(6, 2, line_neighbors, NULL, 2, 2);
+  ck_assert_msg(landmarks != NULL, "Falha na criação dos marcos");
+
+  // Os marcos são as duas pontas do caminho, a mais afastada da partida primeiro
+  ck_assert_uint_eq(landmarks->num_landmarks, 2);
+  ck_assert_uint_eq(landmarks->width, sizeof(uint16_t));
+  ck_assert_uint_eq(landmarks->landmarks[0], 4);
+  ck_assert_uint_eq(landmarks->landmarks[1], 0);
+  ck_assert_uint_eq(landmarks_distance(landmarks, 0, 1), 3);
+  ck_assert_uint_eq(landmarks_distance(landmarks, 1, 1), 1);
+  ck_assert_uint_eq(landmarks_distance(landmarks, 0, 5), UINT32_MAX);
+
+  // Num caminho a heurística é exata, um índice sem caminho não tem informação
+  ck_assert_int_eq(landmarks_heuristic(landmarks, 1, 3), 2);
+  ck_assert_int_eq(landmarks_heuristic(landmarks, 4, 0), 4);
+  ck_assert_int_eq(landmarks_heuristic(landmarks, 5, 0), 0);
+
+  // O ficheiro é lido com a mesma chave e recusado com outra
+  char filename[] = "/tmp/test_landmarks_XXXXXX";
+  int fd = mkstemp(filename);
+  ck_assert_int_ne(fd, -1);
+  close(fd);
+  ck_assert(landmarks_save(landmarks, filename, 42));
+
+  landmarks_t* loaded = landmarks_load(filename, 6, 42);
+  ck_assert_msg(loaded != NULL, "Falha na leitura dos marcos");
+  ck_assert_uint_eq(loaded->num_landmarks, 2);
+  ck_assert_uint_eq(loaded->landmarks[0], 4);
+  ck_assert_int_eq(landmarks_heuristic(loaded, 1, 3), 2);
+  ck_assert(landmarks_load(filename, 6, 43) == NULL);
+  ck_assert(landmarks_load(filename, 7, 42) == NULL);
+  remove(filename);
+
+  // Com mais marcos do que índices alcançáveis param quando todos são marcos
+  landmarks_t* all = landmarks_create(6, 2, line_neighbors, NULL, 8, 2);
+  ck_assert_uint_eq(all->num_landmarks, 5);
+  ck_assert_int_eq(landmarks_heuristic(all, 1, 2), 1);
+
+  landmarks_destroy(all);
+  landmarks_destroy(loaded);
+  landmarks_destroy(landmarks);
+}
+END_TEST
+
+Suite* landmarks_suite()
+{
+  Suite* suite = suite_create("landmarks_t");
+  TCase* tc_core = tcase_create("Core");
+  tcase_add_test(tc_core, test_landmarks);
+  suite_add_tcase(suite, tc_core);
+  return suite;
+}
+
+int main()
+{
+  Suite* suite = landmarks_suite();
+  SRunner* runner = srunner_create(suite);
+  srunner_run_all(runner, CK_NORMAL);
+  int failures = srunner_ntests_failed(runner);
+  srunner_free(runner);
+  return (failures == 0) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -60,12 +60,39 @@ START_TEST(test_state_allocator)
 }
 END_TEST
 
+START_TEST(test_state_allocator_scratch)
+{
+  state_allocator_t* allocator = state_allocator_create_scratch(sizeof(my_struct_t), 2);
+
+  my_struct_t state_data_1 = {2,2};
+  my_struct_t state_data_2 = {3,3};
+
+  // Os estados não são indexados, o mesmo valor ocupa uma nova posição
+  state_t* state_1 = state_allocator_new(allocator, &state_data_1);
+  state_t* state_2 = state_allocator_new(allocator, &state_data_1);
+  ck_assert_ptr_ne(state_1, state_2);
+  ck_assert_uint_eq(state_1->hash, state_2->hash);
+  ck_assert_int_eq(((my_struct_t*)state_2->data)->x, 2);
+
+  // Após a capacidade as posições são reutilizadas
+  state_t* state_3 = state_allocator_new(allocator, &state_data_2);
+  ck_assert_ptr_eq(state_3, state_1);
+  ck_assert_int_eq(((my_struct_t*)state_1->data)->x, 3);
+
+  state_allocator_scratch_reset(allocator);
+  ck_assert_ptr_eq(state_allocator_new(allocator, &state_data_1), state_1);
+
+  state_allocator_destroy(allocator);
+}
+END_TEST
+
 Suite* allocator_suite()
 {
   Suite* suite = suite_create("state_allocator_t");
   TCase* test_case = tcase_create("state allocation");
 
   tcase_add_test(test_case, test_state_allocator);
+  tcase_add_test(test_case, test_state_allocator_scratch);
 
   suite_add_tcase(suite, test_case);
 
@@ -0,0 +1,115 @@
+/*
+   Algoritmo A* Distribuído
+
+   Versão do A* paralelo em que os trabalhadores são processos separados em vez de tarefas. Cada
+   estado pertence ao processo indicado pelo hash dos seus bytes serializados, tal como no A*
+   paralelo, mas os estados viajam entre processos como bytes através de um transporte
+   (memória partilhada, sockets Unix ou TCP). Cada processo tem os seus próprios gestores de
+   estados e nós, pelo que o pai de um estado recebido é guardado localmente como um nó
+   "fantasma" que apenas serve para reconstruir o caminho.
+
+   O coordenador (processo que chama `a_star_distributed_solve`) lança os trabalhadores com fork,
+   envia o estado inicial e trata de:
+
+   - Detetar o fim da procura com o algoritmo de Safra: um testemunho percorre os trabalhadores
+     em anel somando as mensagens enviadas menos as recebidas. A procura termina quando o
+     testemunho volta sem nenhum processo ter recebido mensagens e com a soma a zero.
+   - Difundir a melhor solução: o trabalhador que encontra um objetivo envia o custo a todos os
+     processos, que deixam de expandir nós com custo igual ou superior.
+   - Reconstruir o caminho: a mensagem de recolha percorre os donos dos estados do caminho, do
+     objetivo até ao estado inicial, e o coordenador recria a solução nos seus gestores.
+
+   Estados com ponteiros para dados internos do problema (por exemplo o number link) têm de
+   indicar funções de serialização com `a_star_distributed_set_codec`. Por omissão os bytes da
+   estrutura do estado são copiados, o que é válido porque os processos resultam de um fork e
+   partilham os mesmos endereços dos dados globais do problema.
+*/
+#ifndef ASTAR_DISTRIBUTED_H
+#define ASTAR_DISTRIBUTED_H
+#include "astar.h"
+#include "state.h"
+#include "transport.h"
+#include <stdbool.h>
+#include <stddef.h>
+#include <sys/types.h>
+
+typedef struct a_star_process_t a_star_process_t;
+typedef struct a_star_distributed_t a_star_distributed_t;
+
+// Tipo para funções que convertem um estado em bytes, retorna o número de bytes escritos
+typedef size_t (*serialize_function)(const state_t* state, void* buffer, void* context);
+
+// Tipo para funções que convertem bytes nos dados de um estado (struct_size bytes)
+typedef void (*deserialize_function)(const void* buffer, size_t len, void* state_data, void* context);
+
+// Estatísticas de um processo trabalhador, enviadas ao coordenador no fim da procura
+struct a_star_process_t
+{
+  pid_t pid;
+  int generated;
+  int expanded;
+  size_t max_min_heap_size;
+  int nodes_new;
+  int nodes_reinserted;
+  int paths_worst_or_equals;
+  int paths_better;
+  int num_solutions;
+  long messages_sent;
+  long messages_received;
+  size_t bytes_sent;
+  size_t bytes_received;
+};
+
+// Estrutura que contem o estado do algoritmo A* distribuído
+struct a_star_distributed_t
+{
+  // Configuração comum do algoritmo, os trabalhadores recebem uma cópia no fork
+  a_star_t* common;
+
+  size_t num_workers;
+  bool stop_on_first_solution;
+  bool solved; // Já foi realizada uma procura, é necessário limpar antes da próxima
+
+  // Transporte utilizado entre processos, o coordenador é o último ponto
+  transport_kind_e transport_kind;
+  transport_t* transport;
+
+  // Conversão dos estados para bytes
+  serialize_function serialize_func;
+  deserialize_function deserialize_func;
+  void* codec_context;
+  size_t max_state_size;
+
+  // Estatísticas dos trabalhadores e da deteção de fim
+  a_star_process_t* workers;
+  int waves; // Voltas do testemunho de Safra
+};
+
+// Cria uma nova instância do algoritmo A* distribuído por num_workers processos
+a_star_distributed_t* a_star_distributed_create(size_t struct_size,
+                                                goal_function goal_func,
+                                                visit_function visit_func,
+                                                heuristic_function h_func,
+                                                distance_function d_func,
+                                                print_function print_func,
+                                                int num_workers,
+                                                bool stop_on_first_solution,
+                                                transport_kind_e transport_kind);
+
+// Define as funções de serialização dos estados, max_state_size é o tamanho máximo serializado
+void a_star_distributed_set_codec(a_star_distributed_t* a_star,
+                                  serialize_function serialize_func,
+                                  deserialize_function deserialize_func,
+                                  void* context,
+                                  size_t max_state_size);
+
+// Liberta uma instância do algoritmo A* distribuído
+void a_star_distributed_destroy(a_star_distributed_t* a_star);
+
+// Resolve o problema lançando os processos trabalhadores, pode ser chamado várias vezes
+void a_star_distributed_solve(a_star_distributed_t* a_star, void* initial, void* goal);
+
+// Imprime estatísticas sobre o algoritmo distribuído
+void a_star_distributed_print_statistics(a_star_distributed_t* a_star, bool csv, bool show_solution);
+
+#endif // ASTAR_DISTRIBUTED_H
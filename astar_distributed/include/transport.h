@@ -0,0 +1,107 @@
+/*
+   Transporte de mensagens entre processos
+
+   Este módulo liga um conjunto de pontos (processos) entre si e permite enviar mensagens de tamanho
+   variável de qualquer ponto para qualquer outro. O transporte é criado antes dos processos serem
+   lançados (fork), depois cada processo indica qual o seu ponto através de `transport_attach`.
+
+   Implementações disponíveis:
+
+   - `TRANSPORT_SHM`: memória partilhada POSIX (shm_open), um anel de bytes por ponto protegido por um
+     mutex partilhado entre processos. É a opção mais rápida para processos na mesma máquina.
+   - `TRANSPORT_UNIX`: sockets de domínio Unix, uma ligação por cada par de pontos.
+   - `TRANSPORT_TCP`: sockets TCP sobre a interface de loopback, servem de substituto para uma rede
+     real entre máquinas.
+
+   Funcionalidades:
+
+   - `transport_create`: Cria o transporte para um número de pontos.
+   - `transport_attach`: Indica qual o ponto utilizado pelo processo atual.
+   - `transport_send`: Envia uma mensagem, caso o destino não tenha espaço a mensagem fica em espera local.
+   - `transport_flush`: Tenta enviar as mensagens em espera.
+   - `transport_receive`: Recebe a próxima mensagem disponível, sem bloquear.
+   - `transport_destroy`: Liberta os recursos do transporte.
+
+   Limitações e Considerações:
+
+   - As mensagens entre dois pontos são entregues pela ordem de envio, não existe ordem entre
+     mensagens de pontos diferentes.
+   - O envio nunca bloqueia, o que evita que dois processos fiquem à espera um do outro, mas o
+     processo tem de chamar `transport_flush` ou `transport_receive` regularmente.
+*/
+#ifndef TRANSPORT_H
+#define TRANSPORT_H
+
+#include <stdbool.h>
+#include <stddef.h>
+
+// Tamanho do anel de memória partilhada de cada ponto
+#define TRANSPORT_RING_SIZE (8 * 1024 * 1024)
+
+// Implementações do transporte
+typedef enum
+{
+  TRANSPORT_SHM = 0,
+  TRANSPORT_UNIX = 1,
+  TRANSPORT_TCP = 2
+} transport_kind_e;
+
+// Buffer de bytes utilizado para mensagens em espera e dados recebidos
+typedef struct
+{
+  char* data;
+  size_t start;
+  size_t len;
+  size_t capacity;
+} transport_buffer_t;
+
+typedef struct
+{
+  transport_kind_e kind;
+  size_t num_endpoints;
+  size_t self; // Ponto do processo atual
+
+  // Memória partilhada
+  void* shm;
+  size_t shm_size;
+
+  // Sockets, fds[i * num_endpoints + j] liga o ponto i ao ponto j
+  int* fds;
+  size_t next_peer;
+
+  // Mensagens em espera por destino, dados recebidos por origem e mensagens para o próprio ponto
+  transport_buffer_t* outgoing;
+  transport_buffer_t* incoming;
+  transport_buffer_t loopback;
+
+  // Última mensagem recebida
+  char* message;
+  size_t message_capacity;
+} transport_t;
+
+// Cria o transporte para um número de pontos, deve ser chamado antes de lançar os processos
+transport_t* transport_create(transport_kind_e kind, size_t num_endpoints);
+
+// Indica qual o ponto utilizado pelo processo atual
+void transport_attach(transport_t* transport, size_t endpoint);
+
+// Envia uma mensagem para outro ponto
+void transport_send(transport_t* transport, size_t destination, const void* data, size_t len);
+
+// Tenta enviar as mensagens em espera, retorna verdadeiro caso não tenha ficado nada por enviar
+bool transport_flush(transport_t* transport);
+
+// Recebe a próxima mensagem disponível, retorna NULL caso não exista nenhuma.
+// A mensagem é válida até à próxima chamada
+void* transport_receive(transport_t* transport, size_t* len);
+
+// Liberta os recursos do transporte
+void transport_destroy(transport_t* transport);
+
+// Converte o nome de um transporte ("shm", "unix" ou "tcp") para o seu valor
+bool transport_from_str(const char* name, transport_kind_e* kind);
+
+// Converte um transporte para o seu nome
+const char* transport_to_str(transport_kind_e kind);
+
+#endif // TRANSPORT_H
@@ -0,0 +1,878 @@
+#include "astar_distributed.h"
+#include "hashtable.h"
+#include "min_heap.h"
+#include <limits.h>
+#include <sched.h>
+#include <signal.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+// Nós expandidos por um trabalhador antes de voltar a verificar as mensagens recebidas
+#define EXPANSIONS_PER_POLL 32
+
+// Cores do algoritmo de Safra
+#define COLOR_WHITE 0
+#define COLOR_BLACK 1
+
+// Tipos de mensagem trocados entre processos
+typedef enum
+{
+  MESSAGE_STATE, // Estado a processar pelo seu dono, acompanhado do estado pai
+  MESSAGE_TOKEN, // Testemunho de Safra para a deteção do fim da procura
+  MESSAGE_INCUMBENT, // Custo de uma solução encontrada
+  MESSAGE_STOP, // Pedido para terminar a procura
+  MESSAGE_STATS, // Estatísticas de um trabalhador
+  MESSAGE_TRACE, // Recolha do caminho da solução, percorre os donos dos estados do caminho
+  MESSAGE_PATH, // Caminho completo da solução, enviado ao coordenador
+  MESSAGE_SHUTDOWN // Pedido para o processo terminar
+} a_star_message_type_e;
+
+// Cabeçalho das mensagens, seguido de first_len bytes e de second_len bytes
+typedef struct
+{
+  int32_t type;
+  int32_t source;
+  int32_t color;
+  int32_t g; // Custo do estado pai (STATE) ou da solução (INCUMBENT)
+  int64_t value; // Soma do testemunho (TOKEN) ou número de entradas do caminho (TRACE e PATH)
+  uint32_t first_len; // Estado pai (STATE) ou entradas do caminho (TRACE e PATH)
+  uint32_t second_len; // Estado (STATE, INCUMBENT e TRACE) ou estatísticas (STATS)
+} a_star_wire_t;
+
+// Buffer onde são compostas as mensagens
+typedef struct
+{
+  char* data;
+  size_t len;
+  size_t capacity;
+} byte_buffer_t;
+
+// Estado de um processo trabalhador
+typedef struct
+{
+  a_star_distributed_t* a_star;
+  size_t rank;
+  transport_t* transport;
+  min_heap_t* open_set;
+  linked_list_t* neighbors;
+  a_star_process_t stats;
+
+  // Algoritmo de Safra: mensagens enviadas menos recebidas, cor e testemunho por reencaminhar
+  long counter;
+  int color;
+  bool has_token;
+  a_star_wire_t token;
+
+  // Custo da melhor solução conhecida
+  int incumbent;
+  bool stopped;
+  bool shutdown;
+
+  // Buffers de trabalho
+  byte_buffer_t message;
+  byte_buffer_t path;
+  char* state_data;
+  char* parent_bytes;
+  char* child_bytes;
+} a_star_worker_context_t;
+
+// Acrescenta bytes a um buffer
+static void byte_buffer_append(byte_buffer_t* buffer, const void* data, size_t len)
+{
+  if(buffer->len + len > buffer->capacity)
+  {
+    size_t capacity = buffer->capacity == 0 ? 256 : buffer->capacity;
+    while(buffer->len + len > capacity)
+    {
+      capacity *= 2;
+    }
+    buffer->data = (char*)realloc(buffer->data, capacity);
+    buffer->capacity = capacity;
+  }
+
+  memcpy(buffer->data + buffer->len, data, len);
+  buffer->len += len;
+}
+
+// Serialização por omissão, copia os bytes da estrutura do estado
+static size_t default_serialize(const state_t* state, void* buffer, void*)
+{
+  memcpy(buffer, state->data, state->struct_size);
+  return state->struct_size;
+}
+
+// Deserialização por omissão, copia os bytes da estrutura do estado
+static void default_deserialize(const void* buffer, size_t len, void* state_data, void*)
+{
+  memcpy(state_data, buffer, len);
+}
+
+// Processo dono de um estado, calculado a partir dos bytes serializados
+static size_t a_star_distributed_owner(a_star_distributed_t* a_star, const void* bytes, size_t len)
+{
+  return hash_function(bytes, len, HASH_CAPACITY) % a_star->num_workers;
+}
+
+// Converte bytes num estado gerido pelo alocador do processo atual
+static state_t* a_star_distributed_decode(a_star_distributed_t* a_star, const void* bytes, size_t len, char* state_data)
+{
+  // Os bytes de alinhamento da estrutura também são comparados pelo gestor de estados
+  memset(state_data, 0, a_star->common->state_allocator->struct_size);
+  a_star->deserialize_func(bytes, len, state_data, a_star->codec_context);
+  return state_allocator_new(a_star->common->state_allocator, state_data);
+}
+
+// Compõe e envia uma mensagem, retorna o tamanho enviado
+static size_t a_star_distributed_send(transport_t* transport,
+                                      byte_buffer_t* buffer,
+                                      size_t destination,
+                                      a_star_wire_t* header,
+                                      const void* first,
+                                      const void* second)
+{
+  buffer->len = 0;
+  byte_buffer_append(buffer, header, sizeof(a_star_wire_t));
+  if(header->first_len > 0)
+    byte_buffer_append(buffer, first, header->first_len);
+  if(header->second_len > 0)
+    byte_buffer_append(buffer, second, header->second_len);
+
+  transport_send(transport, destination, buffer->data, buffer->len);
+  return buffer->len;
+}
+
+// Trata um estado recebido pelo trabalhador, criando ou atualizando o respetivo nó
+static void a_star_worker_receive_state(a_star_worker_context_t* worker, a_star_wire_t* header, char* payload)
+{
+  a_star_distributed_t* a_star = worker->a_star;
+
+  // Algoritmo de Safra: uma mensagem recebida torna o processo preto
+  worker->counter--;
+  worker->color = COLOR_BLACK;
+  worker->stats.messages_received++;
+  worker->stats.bytes_received += sizeof(a_star_wire_t) + header->first_len + header->second_len;
+
+  if(worker->stopped)
+  {
+    return;
+  }
+
+  state_t* state = a_star_distributed_decode(a_star, payload + header->first_len, header->second_len, worker->state_data);
+
+  // Sem estado pai estamos a lidar com o estado inicial
+  if(header->first_len == 0)
+  {
+    a_star_node_t* initial_node = node_allocator_get(a_star->common->node_allocator, state);
+    if(initial_node == NULL)
+    {
+      initial_node = node_allocator_new(a_star->common->node_allocator, state);
+      initial_node->g = 0;
+      initial_node->h = a_star->common->h_func(initial_node->state, a_star->common->goal_state);
+      initial_node->index_in_open_set = min_heap_insert(worker->open_set, initial_node->h, initial_node);
+    }
+    return;
+  }
+
+  // O pai pertence ao processo que enviou a mensagem, guardamos um nó fantasma com o custo recebido
+  // que apenas serve para reconstruir o caminho da solução
+  state_t* parent_state = a_star_distributed_decode(a_star, payload, header->first_len, worker->state_data);
+  a_star_node_t* parent_node = node_allocator_get(a_star->common->node_allocator, parent_state);
+  if(parent_node == NULL)
+  {
+    parent_node = node_allocator_new(a_star->common->node_allocator, parent_state);
+    parent_node->g = header->g;
+  }
+  else if((size_t)header->source != worker->rank && header->g < parent_node->g)
+  {
+    parent_node->g = header->g;
+  }
+
+  int g_attempt = header->g + a_star->common->d_func(parent_state, state);
+  a_star_node_t* child_node = node_allocator_get(a_star->common->node_allocator, state);
+
+  if(child_node == NULL)
+  {
+    // Este nó ainda não existe, criamos um novo nó para este estado
+    child_node = node_allocator_new(a_star->common->node_allocator, state);
+    child_node->parent = parent_node;
+    child_node->g = g_attempt;
+    child_node->h = a_star->common->h_func(child_node->state, a_star->common->goal_state);
+    child_node->index_in_open_set = min_heap_insert(worker->open_set, child_node->g + child_node->h, child_node);
+    worker->stats.generated++;
+    worker->stats.nodes_new++;
+    return;
+  }
+
+  // Existe outro caminho mais curto para este estado
+  if(g_attempt >= child_node->g)
+  {
+    worker->stats.paths_worst_or_equals++;
+    return;
+  }
+
+  // Encontrámos um caminho melhor, a entrada antiga fica na fila e é ignorada quando for retirada
+  child_node->parent = parent_node;
+  child_node->g = g_attempt;
+  worker->stats.paths_better++;
+  if(child_node->index_in_open_set == SIZE_MAX)
+  {
+    worker->stats.nodes_reinserted++;
+  }
+  child_node->index_in_open_set = min_heap_insert(worker->open_set, child_node->g + child_node->h, child_node);
+}
+
+// Continua a recolha do caminho da solução a partir de um estado deste trabalhador
+static void a_star_worker_trace(a_star_worker_context_t* worker, a_star_wire_t* header, char* payload)
+{
+  a_star_distributed_t* a_star = worker->a_star;
+
+  worker->path.len = 0;
+  byte_buffer_append(&worker->path, payload, header->first_len);
+  int64_t entries = header->value;
+
+  state_t* state = a_star_distributed_decode(a_star, payload + header->first_len, header->second_len, worker->state_data);
+  a_star_node_t* node = node_allocator_get(a_star->common->node_allocator, state);
+
+  // Percorremos os nós deste trabalhador até chegar ao estado inicial ou a um nó fantasma
+  while(node != NULL)
+  {
+    uint32_t len = (uint32_t)a_star->serialize_func(node->state, worker->child_bytes, a_star->codec_context);
+    size_t owner = a_star_distributed_owner(a_star, worker->child_bytes, len);
+
+    if(owner != worker->rank)
+    {
+      // O resto do caminho é conhecido pelo dono deste estado
+      a_star_wire_t trace = { MESSAGE_TRACE, (int32_t)worker->rank, COLOR_WHITE, 0, entries, (uint32_t)worker->path.len, len };
+      a_star_distributed_send(worker->transport, &worker->message, owner, &trace, worker->path.data, worker->child_bytes);
+      return;
+    }
+
+    int32_t g = node->g;
+    byte_buffer_append(&worker->path, &g, sizeof(int32_t));
+    byte_buffer_append(&worker->path, &len, sizeof(uint32_t));
+    byte_buffer_append(&worker->path, worker->child_bytes, len);
+    entries++;
+
+    node = node->parent;
+  }
+
+  a_star_wire_t path = { MESSAGE_PATH, (int32_t)worker->rank, COLOR_WHITE, 0, entries, (uint32_t)worker->path.len, 0 };
+  a_star_distributed_send(worker->transport, &worker->message, a_star->num_workers, &path, worker->path.data, NULL);
+}
+
+// Trata uma mensagem recebida pelo trabalhador
+static void a_star_worker_handle(a_star_worker_context_t* worker, char* data)
+{
+  a_star_distributed_t* a_star = worker->a_star;
+  a_star_wire_t header;
+  memcpy(&header, data, sizeof(a_star_wire_t));
+  char* payload = data + sizeof(a_star_wire_t);
+
+  switch(header.type)
+  {
+    case MESSAGE_STATE:
+      a_star_worker_receive_state(worker, &header, payload);
+      break;
+
+    case MESSAGE_TOKEN:
+      // O testemunho fica guardado até o trabalhador ficar sem trabalho
+      if(!worker->stopped)
+      {
+        worker->has_token = true;
+        worker->token = header;
+      }
+      break;
+
+    case MESSAGE_INCUMBENT:
+      if(header.g < worker->incumbent)
+      {
+        worker->incumbent = header.g;
+      }
+      break;
+
+    case MESSAGE_STOP:
+    {
+      // Deixamos de procurar e enviamos as estatísticas ao coordenador, as soluções enviadas
+      // anteriormente chegam primeiro porque as mensagens de cada ligação mantêm a ordem
+      worker->stopped = true;
+      worker->has_token = false;
+      min_heap_clean(worker->open_set);
+
+      a_star_wire_t stats = { MESSAGE_STATS, (int32_t)worker->rank, COLOR_WHITE, 0, 0, 0, sizeof(a_star_process_t) };
+      a_star_distributed_send(worker->transport, &worker->message, a_star->num_workers, &stats, NULL, &worker->stats);
+      break;
+    }
+
+    case MESSAGE_TRACE:
+      a_star_worker_trace(worker, &header, payload);
+      break;
+
+    case MESSAGE_SHUTDOWN:
+      worker->shutdown = true;
+      break;
+
+    default:
+      break;
+  }
+}
+
+// Expande um nó da lista aberta do trabalhador
+static void a_star_worker_expand(a_star_worker_context_t* worker)
+{
+  a_star_distributed_t* a_star = worker->a_star;
+
+  heap_node_t top_element = min_heap_pop(worker->open_set);
+
+  // As entradas substituídas por um caminho melhor são ignoradas
+  a_star_node_t* current_node = (a_star_node_t*)top_element.data;
+  if(top_element.cost != current_node->g + current_node->h)
+  {
+    return;
+  }
+  current_node->index_in_open_set = SIZE_MAX;
+
+  // Já existe uma solução melhor do que qualquer nó desta lista aberta
+  if(top_element.cost > worker->incumbent)
+  {
+    min_heap_clean(worker->open_set);
+    return;
+  }
+  worker->stats.expanded++;
+
+  uint32_t parent_len = (uint32_t)a_star->serialize_func(current_node->state, worker->parent_bytes, a_star->codec_context);
+
+  // Encontrámos um objetivo, informamos todos os processos do novo custo
+  if(a_star->common->goal_func(current_node->state, a_star->common->goal_state))
+  {
+    worker->stats.num_solutions++;
+    if(current_node->g < worker->incumbent)
+    {
+      worker->incumbent = current_node->g;
+
+      a_star_wire_t incumbent = { MESSAGE_INCUMBENT, (int32_t)worker->rank, COLOR_WHITE, current_node->g, 0, 0, 0 };
+      for(size_t i = 0; i < a_star->num_workers; i++)
+      {
+        if(i != worker->rank)
+        {
+          a_star_distributed_send(worker->transport, &worker->message, i, &incumbent, NULL, NULL);
+        }
+      }
+
+      // O coordenador recebe também o estado objetivo para iniciar a recolha do caminho
+      incumbent.second_len = parent_len;
+      a_star_distributed_send(worker->transport, &worker->message, a_star->num_workers, &incumbent, NULL, worker->parent_bytes);
+    }
+    return;
+  }
+
+  // Enviamos cada vizinho ao seu dono juntamente com o estado atual e o seu custo
+  a_star->common->visit_func(current_node->state, a_star->common->state_allocator, worker->neighbors);
+  while(linked_list_size(worker->neighbors))
+  {
+    state_t* neighbor = (state_t*)linked_list_pop_back(worker->neighbors);
+    uint32_t child_len = (uint32_t)a_star->serialize_func(neighbor, worker->child_bytes, a_star->codec_context);
+    size_t owner = a_star_distributed_owner(a_star, worker->child_bytes, child_len);
+
+    a_star_wire_t message = { MESSAGE_STATE, (int32_t)worker->rank, COLOR_WHITE, current_node->g, 0, parent_len, child_len };
+    worker->stats.bytes_sent +=
+      a_star_distributed_send(worker->transport, &worker->message, owner, &message, worker->parent_bytes, worker->child_bytes);
+    worker->stats.messages_sent++;
+    worker->counter++;
+  }
+}
+
+// Função executada por cada processo trabalhador
+static void a_star_worker_process(a_star_distributed_t* a_star, size_t rank)
+{
+  a_star_worker_context_t worker;
+  memset(&worker, 0, sizeof(a_star_worker_context_t));
+  worker.a_star = a_star;
+  worker.rank = rank;
+  worker.transport = a_star->transport;
+  worker.open_set = min_heap_create();
+  worker.neighbors = linked_list_create();
+  worker.stats.pid = getpid();
+  worker.color = COLOR_WHITE;
+  worker.incumbent = INT_MAX;
+  worker.state_data = (char*)malloc(a_star->common->state_allocator->struct_size);
+  worker.parent_bytes = (char*)malloc(a_star->max_state_size);
+  worker.child_bytes = (char*)malloc(a_star->max_state_size);
+
+  while(!worker.shutdown)
+  {
+    // Processamos todas as mensagens recebidas
+    size_t len = 0;
+    char* data = NULL;
+    while(!worker.shutdown && (data = (char*)transport_receive(worker.transport, &len)) != NULL)
+    {
+      a_star_worker_handle(&worker, data);
+    }
+    if(worker.shutdown)
+    {
+      break;
+    }
+
+    if(worker.stats.max_min_heap_size < worker.open_set->size)
+      worker.stats.max_min_heap_size = worker.open_set->size;
+
+    if(!worker.stopped && worker.open_set->size > 0)
+    {
+      for(int i = 0; i < EXPANSIONS_PER_POLL && worker.open_set->size > 0; i++)
+      {
+        a_star_worker_expand(&worker);
+      }
+      continue;
+    }
+
+    // Sem trabalho, reencaminhamos o testemunho depois de enviar todas as mensagens pendentes
+    if(worker.has_token && transport_flush(worker.transport))
+    {
+      worker.token.source = (int32_t)rank;
+      worker.token.value += worker.counter;
+      worker.token.color = worker.token.color == COLOR_BLACK || worker.color == COLOR_BLACK ? COLOR_BLACK : COLOR_WHITE;
+      worker.color = COLOR_WHITE;
+      worker.has_token = false;
+
+      // O último trabalhador devolve o testemunho ao coordenador, que é o ponto seguinte
+      a_star_distributed_send(worker.transport, &worker.message, rank + 1, &worker.token, NULL, NULL);
+      continue;
+    }
+
+    sched_yield();
+  }
+
+  // Garantimos que as últimas mensagens chegam ao destino antes de terminar
+  while(!transport_flush(worker.transport))
+  {
+    sched_yield();
+  }
+}
+
+// Envia uma mensagem sem dados a todos os trabalhadores
+static void a_star_distributed_broadcast(a_star_distributed_t* a_star, byte_buffer_t* buffer, a_star_message_type_e type)
+{
+  a_star_wire_t header = { type, (int32_t)a_star->num_workers, COLOR_WHITE, 0, 0, 0, 0 };
+  for(size_t i = 0; i < a_star->num_workers; i++)
+  {
+    a_star_distributed_send(a_star->transport, buffer, i, &header, NULL, NULL);
+  }
+}
+
+// Recria o caminho da solução nos gestores do coordenador, as entradas vão do objetivo ao estado inicial
+static void a_star_distributed_rebuild(a_star_distributed_t* a_star, a_star_wire_t* header, char* payload)
+{
+  size_t num_entries = (size_t)header->value;
+  char** entries = (char**)malloc(num_entries * sizeof(char*));
+  char* state_data = (char*)malloc(a_star->common->state_allocator->struct_size);
+  if(entries == NULL || state_data == NULL)
+  {
+    free(entries);
+    free(state_data);
+    return;
+  }
+
+  char* entry = payload;
+  for(size_t i = 0; i < num_entries; i++)
+  {
+    uint32_t len;
+    entries[i] = entry;
+    memcpy(&len, entry + sizeof(int32_t), sizeof(uint32_t));
+    entry += sizeof(int32_t) + sizeof(uint32_t) + len;
+  }
+
+  a_star_node_t* previous = NULL;
+  for(size_t i = num_entries; i > 0; i--)
+  {
+    int32_t g;
+    uint32_t len;
+    memcpy(&g, entries[i - 1], sizeof(int32_t));
+    memcpy(&len, entries[i - 1] + sizeof(int32_t), sizeof(uint32_t));
+
+    state_t* state = a_star_distributed_decode(a_star, entries[i - 1] + sizeof(int32_t) + sizeof(uint32_t), len, state_data);
+    a_star_node_t* node = node_allocator_get(a_star->common->node_allocator, state);
+    if(node == NULL)
+    {
+      node = node_allocator_new(a_star->common->node_allocator, state);
+    }
+    node->parent = previous;
+    node->g = g;
+    node->h = a_star->common->h_func(state, a_star->common->goal_state);
+    previous = node;
+  }
+  a_star->common->solution = previous;
+
+  free(state_data);
+  free(entries);
+}
+
+// Lógica do coordenador: deteção do fim da procura, soluções, estatísticas e recolha do caminho
+static void a_star_distributed_coordinate(a_star_distributed_t* a_star, state_t* initial_state)
+{
+  enum
+  {
+    PHASE_SEARCH,
+    PHASE_STOPPING,
+    PHASE_TRACING,
+    PHASE_DONE
+  } phase = PHASE_SEARCH;
+
+  transport_t* transport = a_star->transport;
+  byte_buffer_t buffer = { NULL, 0, 0 };
+  byte_buffer_t best_goal = { NULL, 0, 0 };
+  int best_cost = INT_MAX;
+  int best_source = -1;
+  size_t stats_received = 0;
+
+  // Enviamos o estado inicial ao seu dono, é a única mensagem de estado enviada pelo coordenador
+  char* initial_bytes = (char*)malloc(a_star->max_state_size);
+  uint32_t initial_len = (uint32_t)a_star->serialize_func(initial_state, initial_bytes, a_star->codec_context);
+  a_star_wire_t initial = { MESSAGE_STATE, (int32_t)a_star->num_workers, COLOR_WHITE, 0, 0, 0, initial_len };
+  a_star_distributed_send(transport, &buffer, a_star_distributed_owner(a_star, initial_bytes, initial_len), &initial, NULL, initial_bytes);
+  long counter = 1;
+  free(initial_bytes);
+
+  // Primeira volta do testemunho
+  a_star_wire_t token = { MESSAGE_TOKEN, (int32_t)a_star->num_workers, COLOR_WHITE, 0, 0, 0, 0 };
+  a_star_distributed_send(transport, &buffer, 0, &token, NULL, NULL);
+  a_star->waves = 1;
+
+  while(phase != PHASE_DONE)
+  {
+    size_t len = 0;
+    char* data = (char*)transport_receive(transport, &len);
+    if(data == NULL)
+    {
+      sched_yield();
+      continue;
+    }
+
+    a_star_wire_t header;
+    memcpy(&header, data, sizeof(a_star_wire_t));
+    char* payload = data + sizeof(a_star_wire_t);
+
+    switch(header.type)
+    {
+      case MESSAGE_INCUMBENT:
+        if(header.g < best_cost)
+        {
+          best_cost = header.g;
+          best_source = header.source;
+          best_goal.len = 0;
+          byte_buffer_append(&best_goal, payload, header.second_len);
+          a_star->common->num_better_solutions++;
+        }
+
+        // Queremos apenas a primeira solução, pedimos aos trabalhadores para pararem
+        if(a_star->stop_on_first_solution && phase == PHASE_SEARCH)
+        {
+          a_star_distributed_broadcast(a_star, &buffer, MESSAGE_STOP);
+          phase = PHASE_STOPPING;
+        }
+        break;
+
+      case MESSAGE_TOKEN:
+        if(phase != PHASE_SEARCH)
+        {
+          break;
+        }
+
+        // Nenhum processo recebeu mensagens durante a volta e não existem mensagens em trânsito
+        if(header.color == COLOR_WHITE && header.value + counter == 0)
+        {
+          a_star_distributed_broadcast(a_star, &buffer, MESSAGE_STOP);
+          phase = PHASE_STOPPING;
+        }
+        else
+        {
+          token.color = COLOR_WHITE;
+          token.value = 0;
+          a_star_distributed_send(transport, &buffer, 0, &token, NULL, NULL);
+          a_star->waves++;
+        }
+        break;
+
+      case MESSAGE_STATS:
+        memcpy(&a_star->workers[header.source], payload, sizeof(a_star_process_t));
+        stats_received++;
+
+        // Todas as soluções já chegaram, iniciamos a recolha do caminho no dono do objetivo
+        if(stats_received == a_star->num_workers)
+        {
+          if(best_source >= 0)
+          {
+            a_star_wire_t trace = { MESSAGE_TRACE, (int32_t)a_star->num_workers, COLOR_WHITE, 0, 0, 0, (uint32_t)best_goal.len };
+            a_star_distributed_send(transport, &buffer, (size_t)best_source, &trace, NULL, best_goal.data);
+            phase = PHASE_TRACING;
+          }
+          else
+          {
+            phase = PHASE_DONE;
+          }
+        }
+        break;
+
+      case MESSAGE_PATH:
+        a_star_distributed_rebuild(a_star, &header, payload);
+        phase = PHASE_DONE;
+        break;
+
+      default:
+        break;
+    }
+  }
+
+  free(buffer.data);
+  free(best_goal.data);
+}
+
+// Cria uma nova instância para resolver um problema
+a_star_distributed_t* a_star_distributed_create(size_t struct_size,
+                                                goal_function goal_func,
+                                                visit_function visit_func,
+                                                heuristic_function h_func,
+                                                distance_function d_func,
+                                                print_function print_func,
+                                                int num_workers,
+                                                bool stop_on_first_solution,
+                                                transport_kind_e transport_kind)
+{
+  a_star_distributed_t* a_star = (a_star_distributed_t*)malloc(sizeof(a_star_distributed_t));
+  if(a_star == NULL)
+  {
+    return NULL; // Erro de alocação
+  }
+
+  // Garante que a memória esteja limpa
+  a_star->workers = NULL;
+  a_star->transport = NULL;
+  a_star->num_workers = num_workers < 1 ? 1 : (size_t)num_workers;
+  a_star->stop_on_first_solution = stop_on_first_solution;
+  a_star->solved = false;
+  a_star->transport_kind = transport_kind;
+  a_star->serialize_func = default_serialize;
+  a_star->deserialize_func = default_deserialize;
+  a_star->codec_context = NULL;
+  a_star->max_state_size = struct_size;
+  a_star->waves = 0;
+
+  // Inicializamos a parte comum do nosso algoritmo
+  a_star->common = a_star_create(struct_size, goal_func, visit_func, h_func, d_func, print_func);
+  if(a_star->common == NULL)
+  {
+    a_star_distributed_destroy(a_star);
+    return NULL;
+  }
+
+  a_star->workers = (a_star_process_t*)calloc(a_star->num_workers, sizeof(a_star_process_t));
+  if(a_star->workers == NULL)
+  {
+    a_star_distributed_destroy(a_star);
+    return NULL;
+  }
+
+  return a_star;
+}
+
+// Define as funções de serialização dos estados
+void a_star_distributed_set_codec(a_star_distributed_t* a_star,
+                                  serialize_function serialize_func,
+                                  deserialize_function deserialize_func,
+                                  void* context,
+                                  size_t max_state_size)
+{
+  if(a_star == NULL || serialize_func == NULL || deserialize_func == NULL)
+  {
+    return;
+  }
+
+  a_star->serialize_func = serialize_func;
+  a_star->deserialize_func = deserialize_func;
+  a_star->codec_context = context;
+  a_star->max_state_size = max_state_size;
+}
+
+// Liberta uma instância do algoritmo A* distribuído
+void a_star_distributed_destroy(a_star_distributed_t* a_star)
+{
+  if(a_star == NULL)
+  {
+    return;
+  }
+
+  transport_destroy(a_star->transport);
+  free(a_star->workers);
+  a_star_destroy(a_star->common);
+  free(a_star);
+}
+
+// Resolve o problema lançando os processos trabalhadores
+void a_star_distributed_solve(a_star_distributed_t* a_star, void* initial, void* goal)
+{
+  if(a_star == NULL)
+  {
+    return;
+  }
+
+  // A instância já foi utilizada, limpamos a procura anterior
+  if(a_star->solved && !a_star_reset(a_star->common))
+  {
+    return;
+  }
+  a_star->solved = true;
+  memset(a_star->workers, 0, a_star->num_workers * sizeof(a_star_process_t));
+  a_star->waves = 0;
+
+  // Guarda os nossos estados inicial e objetivo, os trabalhadores recebem uma cópia no fork
+  state_t* initial_state = state_allocator_new(a_star->common->state_allocator, initial);
+  if(initial_state == NULL)
+  {
+    return;
+  }
+
+  if(goal)
+  {
+    a_star->common->goal_state = state_allocator_new(a_star->common->state_allocator, goal);
+    if(a_star->common->goal_state == NULL)
+    {
+      return;
+    }
+  }
+
+  clock_gettime(CLOCK_MONOTONIC, &(a_star->common->start_time));
+
+  // O coordenador é o último ponto do transporte
+  a_star->transport = transport_create(a_star->transport_kind, a_star->num_workers + 1);
+  if(a_star->transport == NULL)
+  {
+    fprintf(stderr, "Não foi possível criar o transporte %s\n", transport_to_str(a_star->transport_kind));
+    return;
+  }
+
+  // Evitamos que os processos filho herdem texto por escrever
+  fflush(stdout);
+  fflush(stderr);
+
+  for(size_t i = 0; i < a_star->num_workers; i++)
+  {
+    pid_t pid = fork();
+    if(pid == 0)
+    {
+      transport_attach(a_star->transport, i);
+      a_star_worker_process(a_star, i);
+      _exit(0);
+    }
+
+    if(pid < 0)
+    {
+      // Terminamos os processos que já foram lançados
+      fprintf(stderr, "Não foi possível lançar o trabalhador %ld\n", i + 1);
+      for(size_t j = 0; j < i; j++)
+      {
+        kill(a_star->workers[j].pid, SIGKILL);
+        waitpid(a_star->workers[j].pid, NULL, 0);
+      }
+      transport_destroy(a_star->transport);
+      a_star->transport = NULL;
+      return;
+    }
+
+    a_star->workers[i].pid = pid;
+  }
+  transport_attach(a_star->transport, a_star->num_workers);
+
+  a_star_distributed_coordinate(a_star, initial_state);
+
+  clock_gettime(CLOCK_MONOTONIC, &(a_star->common->end_time));
+
+  // Terminamos os trabalhadores
+  byte_buffer_t buffer = { NULL, 0, 0 };
+  a_star_distributed_broadcast(a_star, &buffer, MESSAGE_SHUTDOWN);
+  while(!transport_flush(a_star->transport))
+  {
+    sched_yield();
+  }
+  free(buffer.data);
+
+  for(size_t i = 0; i < a_star->num_workers; i++)
+  {
+    waitpid(a_star->workers[i].pid, NULL, 0);
+  }
+  transport_destroy(a_star->transport);
+  a_star->transport = NULL;
+
+  // Calculamos o tempo de execução e outras estatísticas
+  for(size_t i = 0; i < a_star->num_workers; i++)
+  {
+    a_star->common->expanded += a_star->workers[i].expanded;
+    a_star->common->generated += a_star->workers[i].generated;
+    a_star->common->max_min_heap_size += a_star->workers[i].max_min_heap_size;
+    a_star->common->nodes_new += a_star->workers[i].nodes_new;
+    a_star->common->nodes_reinserted += a_star->workers[i].nodes_reinserted;
+    a_star->common->paths_better += a_star->workers[i].paths_better;
+    a_star->common->paths_worst_or_equals += a_star->workers[i].paths_worst_or_equals;
+    a_star->common->num_solutions += a_star->workers[i].num_solutions;
+  }
+  a_star->common->num_worst_solutions = a_star->common->num_solutions - a_star->common->num_better_solutions;
+  a_star->common->execution_time = (a_star->common->end_time.tv_sec - a_star->common->start_time.tv_sec);
+  a_star->common->execution_time += (a_star->common->end_time.tv_nsec - a_star->common->start_time.tv_nsec) / 1000000000.0;
+}
+
+// Imprime estatísticas sobre o algoritmo distribuído
+void a_star_distributed_print_statistics(a_star_distributed_t* a_star, bool csv, bool show_solution)
+{
+  if(a_star == NULL)
+  {
+    return;
+  }
+
+  if(show_solution)
+  {
+    a_star_print_statistics(a_star->common, csv, true);
+    return;
+  }
+
+  if(!csv)
+  {
+    if(a_star->stop_on_first_solution)
+    {
+      printf("Método: Primeira solução\n");
+    }
+    else
+    {
+      printf("Método: Melhor solução\n");
+    }
+    printf("Transporte: %s, Processos: %ld, Voltas do testemunho: %d\n",
+           transport_to_str(a_star->transport_kind),
+           a_star->num_workers,
+           a_star->waves);
+  }
+
+  a_star_print_statistics(a_star->common, csv, false);
+
+  if(!csv)
+  {
+    printf("Estatísticas Trabalhadores:\n");
+    for(size_t i = 0; i < a_star->num_workers; i++)
+    {
+      a_star_process_t* worker = &a_star->workers[i];
+      printf("- Trabalhador #%ld (pid %d)\n", i + 1, (int)worker->pid);
+      printf("  * Estados gerados: %d, Estados expandidos: %d\n", worker->generated, worker->expanded);
+      printf("  * Max nós min_heap: %ld, Novos nós: %d, Nós reinseridos: %d, Caminhos piores (ignorados): %d, Caminhos "
+             "melhores (atualizados): %d\n",
+             worker->max_min_heap_size,
+             worker->nodes_new,
+             worker->nodes_reinserted,
+             worker->paths_worst_or_equals,
+             worker->paths_better);
+      printf("  * Mensagens enviadas: %ld (%ld bytes), Mensagens recebidas: %ld (%ld bytes)\n",
+             worker->messages_sent,
+             worker->bytes_sent,
+             worker->messages_received,
+             worker->bytes_received);
+    }
+  }
+}
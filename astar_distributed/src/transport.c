@@ -0,0 +1,584 @@
+#include "transport.h"
+#include <arpa/inet.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <pthread.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+// Tamanho do cabeçalho de cada mensagem (tamanho dos dados)
+#define FRAME_HEADER sizeof(uint32_t)
+
+static const char* transport_labels[] = { "shm", "unix", "tcp" };
+
+// Anel de bytes de um ponto, fica em memória partilhada seguido dos dados
+typedef struct
+{
+  pthread_mutex_t lock;
+  size_t head; // Bytes lidos desde o início
+  size_t tail; // Bytes escritos desde o início
+  size_t capacity;
+} shm_ring_t;
+
+// Tamanho ocupado por um anel, o cabeçalho fica alinhado à linha de cache
+static size_t shm_ring_stride()
+{
+  return ((sizeof(shm_ring_t) + 63) & ~(size_t)63) + TRANSPORT_RING_SIZE;
+}
+
+// Retorna o anel de um ponto
+static shm_ring_t* shm_ring_get(transport_t* transport, size_t endpoint)
+{
+  return (shm_ring_t*)((char*)transport->shm + endpoint * shm_ring_stride());
+}
+
+// Retorna a zona de dados de um anel
+static char* shm_ring_data(shm_ring_t* ring)
+{
+  return (char*)ring + ((sizeof(shm_ring_t) + 63) & ~(size_t)63);
+}
+
+// Copia bytes para o anel, dando a volta ao fim do buffer
+static void shm_ring_write(shm_ring_t* ring, size_t position, const void* data, size_t len)
+{
+  char* buffer = shm_ring_data(ring);
+  size_t offset = position % ring->capacity;
+  size_t first = len < ring->capacity - offset ? len : ring->capacity - offset;
+
+  memcpy(buffer + offset, data, first);
+  memcpy(buffer, (const char*)data + first, len - first);
+}
+
+// Copia bytes do anel, dando a volta ao fim do buffer
+static void shm_ring_read(shm_ring_t* ring, size_t position, void* data, size_t len)
+{
+  char* buffer = shm_ring_data(ring);
+  size_t offset = position % ring->capacity;
+  size_t first = len < ring->capacity - offset ? len : ring->capacity - offset;
+
+  memcpy(data, buffer + offset, first);
+  memcpy((char*)data + first, buffer, len - first);
+}
+
+// Garante espaço para mais len bytes num buffer
+static void buffer_reserve(transport_buffer_t* buffer, size_t len)
+{
+  // Descartamos os bytes já consumidos antes de crescer
+  if(buffer->start > 0 && buffer->start == buffer->len)
+  {
+    buffer->start = buffer->len = 0;
+  }
+  else if(buffer->start > buffer->capacity / 2)
+  {
+    memmove(buffer->data, buffer->data + buffer->start, buffer->len - buffer->start);
+    buffer->len -= buffer->start;
+    buffer->start = 0;
+  }
+
+  if(buffer->len + len <= buffer->capacity)
+  {
+    return;
+  }
+
+  size_t capacity = buffer->capacity == 0 ? 4096 : buffer->capacity;
+  while(buffer->len + len > capacity)
+  {
+    capacity *= 2;
+  }
+  buffer->data = (char*)realloc(buffer->data, capacity);
+  buffer->capacity = capacity;
+}
+
+// Acrescenta uma mensagem (cabeçalho e dados) a um buffer
+static void buffer_push_frame(transport_buffer_t* buffer, const void* data, size_t len)
+{
+  uint32_t header = (uint32_t)len;
+
+  buffer_reserve(buffer, FRAME_HEADER + len);
+  memcpy(buffer->data + buffer->len, &header, FRAME_HEADER);
+  memcpy(buffer->data + buffer->len + FRAME_HEADER, data, len);
+  buffer->len += FRAME_HEADER + len;
+}
+
+// Retira uma mensagem completa de um buffer, caso exista
+static bool buffer_pop_frame(transport_t* transport, transport_buffer_t* buffer, size_t* len)
+{
+  if(buffer->len - buffer->start < FRAME_HEADER)
+  {
+    return false;
+  }
+
+  uint32_t header;
+  memcpy(&header, buffer->data + buffer->start, FRAME_HEADER);
+  if(buffer->len - buffer->start < FRAME_HEADER + header)
+  {
+    return false;
+  }
+
+  if(transport->message_capacity < header)
+  {
+    transport->message = (char*)realloc(transport->message, header);
+    transport->message_capacity = header;
+  }
+  memcpy(transport->message, buffer->data + buffer->start + FRAME_HEADER, header);
+  buffer->start += FRAME_HEADER + header;
+  *len = header;
+
+  return true;
+}
+
+// Cria a memória partilhada com um anel por ponto
+static bool transport_create_shm(transport_t* transport)
+{
+  char name[64];
+  snprintf(name, sizeof(name), "/astar_transport_%d_%p", getpid(), (void*)transport);
+
+  int fd = shm_open(name, O_CREAT | O_EXCL | O_RDWR, 0600);
+  if(fd < 0)
+  {
+    return false;
+  }
+
+  // O nome deixa de ser necessário, a memória continua disponível para os processos filho
+  transport->shm_size = transport->num_endpoints * shm_ring_stride();
+  bool ok = ftruncate(fd, (off_t)transport->shm_size) == 0;
+  if(ok)
+  {
+    transport->shm = mmap(NULL, transport->shm_size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    ok = transport->shm != MAP_FAILED;
+  }
+  close(fd);
+  shm_unlink(name);
+
+  if(!ok)
+  {
+    transport->shm = NULL;
+    return false;
+  }
+
+  pthread_mutexattr_t attr;
+  pthread_mutexattr_init(&attr);
+  pthread_mutexattr_setpshared(&attr, PTHREAD_PROCESS_SHARED);
+  for(size_t i = 0; i < transport->num_endpoints; i++)
+  {
+    shm_ring_t* ring = shm_ring_get(transport, i);
+    pthread_mutex_init(&ring->lock, &attr);
+    ring->head = 0;
+    ring->tail = 0;
+    ring->capacity = TRANSPORT_RING_SIZE;
+  }
+  pthread_mutexattr_destroy(&attr);
+
+  return true;
+}
+
+// Cria um par de sockets TCP ligados através da interface de loopback
+static bool tcp_socketpair(int listener, struct sockaddr_in* address, int pair[2])
+{
+  pair[0] = socket(AF_INET, SOCK_STREAM, 0);
+  if(pair[0] < 0)
+  {
+    return false;
+  }
+
+  if(connect(pair[0], (struct sockaddr*)address, sizeof(*address)) != 0)
+  {
+    close(pair[0]);
+    return false;
+  }
+
+  pair[1] = accept(listener, NULL, NULL);
+  if(pair[1] < 0)
+  {
+    close(pair[0]);
+    return false;
+  }
+
+  // As mensagens são pequenas, não queremos esperar para juntar pacotes
+  int flag = 1;
+  setsockopt(pair[0], IPPROTO_TCP, TCP_NODELAY, &flag, sizeof(flag));
+  setsockopt(pair[1], IPPROTO_TCP, TCP_NODELAY, &flag, sizeof(flag));
+
+  return true;
+}
+
+// Cria uma ligação por cada par de pontos
+static bool transport_create_sockets(transport_t* transport)
+{
+  size_t n = transport->num_endpoints;
+  transport->fds = (int*)malloc(n * n * sizeof(int));
+  if(transport->fds == NULL)
+  {
+    return false;
+  }
+  for(size_t i = 0; i < n * n; i++)
+  {
+    transport->fds[i] = -1;
+  }
+
+  int listener = -1;
+  struct sockaddr_in address;
+  if(transport->kind == TRANSPORT_TCP)
+  {
+    // Escutamos numa porta escolhida pelo sistema na interface de loopback
+    memset(&address, 0, sizeof(address));
+    address.sin_family = AF_INET;
+    address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    address.sin_port = 0;
+
+    socklen_t address_len = sizeof(address);
+    listener = socket(AF_INET, SOCK_STREAM, 0);
+    if(listener < 0 || bind(listener, (struct sockaddr*)&address, sizeof(address)) != 0 || listen(listener, (int)n) != 0
+       || getsockname(listener, (struct sockaddr*)&address, &address_len) != 0)
+    {
+      if(listener >= 0)
+        close(listener);
+      return false;
+    }
+  }
+
+  bool ok = true;
+  for(size_t i = 0; i < n && ok; i++)
+  {
+    for(size_t j = i + 1; j < n && ok; j++)
+    {
+      int pair[2];
+      if(transport->kind == TRANSPORT_TCP)
+      {
+        ok = tcp_socketpair(listener, &address, pair);
+      }
+      else
+      {
+        ok = socketpair(AF_UNIX, SOCK_STREAM, 0, pair) == 0;
+      }
+
+      if(ok)
+      {
+        transport->fds[i * n + j] = pair[0];
+        transport->fds[j * n + i] = pair[1];
+      }
+    }
+  }
+
+  if(listener >= 0)
+  {
+    close(listener);
+  }
+
+  return ok;
+}
+
+// Cria o transporte para um número de pontos, deve ser chamado antes de lançar os processos
+transport_t* transport_create(transport_kind_e kind, size_t num_endpoints)
+{
+  transport_t* transport = (transport_t*)calloc(1, sizeof(transport_t));
+  if(transport == NULL)
+  {
+    return NULL; // Erro de alocação
+  }
+
+  transport->kind = kind;
+  transport->num_endpoints = num_endpoints;
+  transport->self = SIZE_MAX;
+  transport->outgoing = (transport_buffer_t*)calloc(num_endpoints, sizeof(transport_buffer_t));
+  transport->incoming = (transport_buffer_t*)calloc(num_endpoints, sizeof(transport_buffer_t));
+  if(transport->outgoing == NULL || transport->incoming == NULL)
+  {
+    transport_destroy(transport);
+    return NULL;
+  }
+
+  bool ok = kind == TRANSPORT_SHM ? transport_create_shm(transport) : transport_create_sockets(transport);
+  if(!ok)
+  {
+    transport_destroy(transport);
+    return NULL;
+  }
+
+  return transport;
+}
+
+// Indica qual o ponto utilizado pelo processo atual
+void transport_attach(transport_t* transport, size_t endpoint)
+{
+  transport->self = endpoint;
+
+  if(transport->fds == NULL)
+  {
+    return;
+  }
+
+  // Fechamos as ligações dos outros pontos e colocamos as nossas em modo não bloqueante
+  size_t n = transport->num_endpoints;
+  for(size_t i = 0; i < n * n; i++)
+  {
+    if(transport->fds[i] < 0)
+    {
+      continue;
+    }
+
+    if(i / n != endpoint)
+    {
+      close(transport->fds[i]);
+      transport->fds[i] = -1;
+    }
+    else
+    {
+      fcntl(transport->fds[i], F_SETFL, fcntl(transport->fds[i], F_GETFL) | O_NONBLOCK);
+    }
+  }
+}
+
+// Envia para o anel de destino as mensagens em espera que couberem
+static void transport_flush_shm(transport_t* transport, size_t destination)
+{
+  transport_buffer_t* buffer = &transport->outgoing[destination];
+  shm_ring_t* ring = shm_ring_get(transport, destination);
+
+  pthread_mutex_lock(&ring->lock);
+  while(buffer->len - buffer->start >= FRAME_HEADER)
+  {
+    uint32_t header;
+    memcpy(&header, buffer->data + buffer->start, FRAME_HEADER);
+    size_t frame = FRAME_HEADER + header;
+
+    if(ring->capacity - (ring->tail - ring->head) < frame)
+    {
+      break;
+    }
+
+    shm_ring_write(ring, ring->tail, buffer->data + buffer->start, frame);
+    ring->tail += frame;
+    buffer->start += frame;
+  }
+  pthread_mutex_unlock(&ring->lock);
+}
+
+// Escreve no socket de destino o que for possível sem bloquear
+static void transport_flush_socket(transport_t* transport, size_t destination)
+{
+  transport_buffer_t* buffer = &transport->outgoing[destination];
+  int fd = transport->fds[transport->self * transport->num_endpoints + destination];
+
+  while(buffer->start < buffer->len)
+  {
+    ssize_t written = write(fd, buffer->data + buffer->start, buffer->len - buffer->start);
+    if(written <= 0)
+    {
+      break; // Socket cheio (EAGAIN), tentamos mais tarde
+    }
+    buffer->start += (size_t)written;
+  }
+}
+
+// Envia uma mensagem para outro ponto
+void transport_send(transport_t* transport, size_t destination, const void* data, size_t len)
+{
+  if(transport == NULL || destination >= transport->num_endpoints)
+  {
+    return;
+  }
+
+  // As mensagens para o próprio ponto não passam pelo transporte
+  if(destination == transport->self)
+  {
+    buffer_push_frame(&transport->loopback, data, len);
+    return;
+  }
+
+  buffer_push_frame(&transport->outgoing[destination], data, len);
+  if(transport->kind == TRANSPORT_SHM)
+  {
+    transport_flush_shm(transport, destination);
+  }
+  else
+  {
+    transport_flush_socket(transport, destination);
+  }
+}
+
+// Tenta enviar as mensagens em espera, retorna verdadeiro caso não tenha ficado nada por enviar
+bool transport_flush(transport_t* transport)
+{
+  bool empty = true;
+
+  for(size_t i = 0; i < transport->num_endpoints; i++)
+  {
+    if(transport->outgoing[i].start == transport->outgoing[i].len)
+    {
+      continue;
+    }
+
+    if(transport->kind == TRANSPORT_SHM)
+    {
+      transport_flush_shm(transport, i);
+    }
+    else
+    {
+      transport_flush_socket(transport, i);
+    }
+
+    empty = empty && transport->outgoing[i].start == transport->outgoing[i].len;
+  }
+
+  return empty;
+}
+
+// Recebe a próxima mensagem do anel do ponto atual
+static void* transport_receive_shm(transport_t* transport, size_t* len)
+{
+  shm_ring_t* ring = shm_ring_get(transport, transport->self);
+  void* message = NULL;
+
+  pthread_mutex_lock(&ring->lock);
+  if(ring->tail - ring->head >= FRAME_HEADER)
+  {
+    uint32_t header;
+    shm_ring_read(ring, ring->head, &header, FRAME_HEADER);
+
+    if(transport->message_capacity < header)
+    {
+      transport->message = (char*)realloc(transport->message, header);
+      transport->message_capacity = header;
+    }
+    shm_ring_read(ring, ring->head + FRAME_HEADER, transport->message, header);
+    ring->head += FRAME_HEADER + header;
+
+    *len = header;
+    message = transport->message;
+  }
+  pthread_mutex_unlock(&ring->lock);
+
+  return message;
+}
+
+// Recebe a próxima mensagem das ligações, percorrendo as origens de forma circular
+static void* transport_receive_socket(transport_t* transport, size_t* len)
+{
+  size_t n = transport->num_endpoints;
+
+  for(size_t k = 0; k < n; k++)
+  {
+    size_t peer = (transport->next_peer + k) % n;
+    int fd = transport->fds[transport->self * n + peer];
+    if(fd < 0)
+    {
+      continue;
+    }
+
+    transport_buffer_t* buffer = &transport->incoming[peer];
+    if(!buffer_pop_frame(transport, buffer, len))
+    {
+      // Lemos o que estiver disponível e tentamos novamente
+      buffer_reserve(buffer, 65536);
+      ssize_t received = read(fd, buffer->data + buffer->len, buffer->capacity - buffer->len);
+      if(received <= 0)
+      {
+        continue;
+      }
+      buffer->len += (size_t)received;
+
+      if(!buffer_pop_frame(transport, buffer, len))
+      {
+        continue;
+      }
+    }
+
+    transport->next_peer = (peer + 1) % n;
+    return transport->message;
+  }
+
+  return NULL;
+}
+
+// Recebe a próxima mensagem disponível, retorna NULL caso não exista nenhuma
+void* transport_receive(transport_t* transport, size_t* len)
+{
+  if(transport == NULL)
+  {
+    return NULL;
+  }
+
+  // Aproveitamos para enviar o que ficou em espera
+  transport_flush(transport);
+
+  if(buffer_pop_frame(transport, &transport->loopback, len))
+  {
+    return transport->message;
+  }
+
+  if(transport->kind == TRANSPORT_SHM)
+  {
+    return transport_receive_shm(transport, len);
+  }
+
+  return transport_receive_socket(transport, len);
+}
+
+// Liberta os recursos do transporte
+void transport_destroy(transport_t* transport)
+{
+  if(transport == NULL)
+  {
+    return;
+  }
+
+  if(transport->shm != NULL)
+  {
+    munmap(transport->shm, transport->shm_size);
+  }
+
+  if(transport->fds != NULL)
+  {
+    for(size_t i = 0; i < transport->num_endpoints * transport->num_endpoints; i++)
+    {
+      if(transport->fds[i] >= 0)
+      {
+        close(transport->fds[i]);
+      }
+    }
+    free(transport->fds);
+  }
+
+  for(size_t i = 0; transport->outgoing != NULL && i < transport->num_endpoints; i++)
+  {
+    free(transport->outgoing[i].data);
+  }
+  for(size_t i = 0; transport->incoming != NULL && i < transport->num_endpoints; i++)
+  {
+    free(transport->incoming[i].data);
+  }
+  free(transport->outgoing);
+  free(transport->incoming);
+  free(transport->loopback.data);
+  free(transport->message);
+  free(transport);
+}
+
+// Converte o nome de um transporte para o seu valor
+bool transport_from_str(const char* name, transport_kind_e* kind)
+{
+  for(int i = 0; i < (int)(sizeof(transport_labels) / sizeof(transport_labels[0])); i++)
+  {
+    if(strcmp(name, transport_labels[i]) == 0)
+    {
+      *kind = (transport_kind_e)i;
+      return true;
+    }
+  }
+
+  return false;
+}
+
+// Converte um transporte para o seu nome
+const char* transport_to_str(transport_kind_e kind)
+{
+  return transport_labels[(int)kind];
+}
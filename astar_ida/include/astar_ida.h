@@ -0,0 +1,105 @@
+/*
+   Algoritmo IDA* (A* com aprofundamento iterativo)
+
+   Procura em profundidade limitada pelo custo f = g + h, repetida com limites crescentes: cada
+   iteração começa com o menor f que excedeu o limite da iteração anterior. Utiliza as mesmas
+   funções do problema que o A* sequencial, mas não guarda os estados gerados: o caminho atual
+   é mantido numa pilha e a memória necessária é proporcional à profundidade da solução.
+
+   Adequado a problemas de permutação (ex: 8puzzle) em que o número de estados não cabe em
+   memória e o custo das arestas é uniforme. Em grafos com muitos caminhos para o mesmo estado
+   (ex: labirintos) os estados são revisitados muitas vezes.
+
+   - Os vizinhos são gerados num gestor de estados temporário e copiados para a pilha.
+   - O vizinho igual ao pai do estado atual (movimento inverso) é ignorado.
+   - Opcionalmente utiliza uma tabela de transposições de tamanho fixo, indexada pelo hash do
+     estado, que corta os estados já visitados na mesma iteração com um custo g igual ou menor.
+
+   Sem lista fechada o IDA* não deteta que uma instância não tem solução quando o espaço de
+   estados tem ciclos: o limite cresce indefinidamente até a procura ser cancelada.
+
+   No fim da procura o caminho encontrado é recriado nos gestores da parte comum, pelo que a
+   solução e as estatísticas são impressas tal como no A* sequencial.
+*/
+#ifndef ASTAR_IDA_H
+#define ASTAR_IDA_H
+#include "astar.h"
+#include "state.h"
+#include <stdbool.h>
+#include <stddef.h>
+
+typedef struct a_star_ida_t a_star_ida_t;
+
+// Um nível da pilha da procura em profundidade
+typedef struct
+{
+  int g;
+  int h;
+  size_t state; // Posição do estado na pilha de estados
+  size_t first_child; // Posição do primeiro filho na pilha de estados
+  size_t num_children;
+  size_t next_child;
+  bool expanded;
+} a_star_ida_frame_t;
+
+// Entrada da tabela de transposições
+typedef struct
+{
+  int g;
+  int iteration;
+} a_star_ida_entry_t;
+
+// Estrutura que contem o estado do algoritmo IDA*
+struct a_star_ida_t
+{
+  // Informação comum do nosso algoritmo
+  a_star_t* common;
+
+  // Gestor temporário onde são gerados os vizinhos
+  state_allocator_t* scratch;
+  linked_list_t* neighbors;
+
+  // Pilha do caminho atual
+  a_star_ida_frame_t* frames;
+  size_t frames_capacity;
+
+  // Pilha com os dados dos estados do caminho e dos seus irmãos por visitar
+  char* pool;
+  size_t* pool_hash;
+  size_t pool_capacity;
+  size_t pool_size;
+
+  // Tabela de transposições (opcional)
+  a_star_ida_entry_t* table;
+  char* table_data;
+  size_t table_size;
+
+  // Informação estatística
+  int iterations;
+  int threshold;
+  size_t max_depth;
+  long parent_pruned;
+  long table_hits;
+};
+
+// Cria uma nova instância do algoritmo IDA* para resolver um problema
+a_star_ida_t* a_star_ida_create(size_t struct_size,
+                                goal_function goal_func,
+                                visit_function visit_func,
+                                heuristic_function h_func,
+                                distance_function d_func,
+                                print_function print_func);
+
+// Define o número de entradas da tabela de transposições (0 desativa a tabela)
+bool a_star_ida_set_transposition(a_star_ida_t* a_star, size_t table_size);
+
+// Liberta uma instância do algoritmo IDA*
+void a_star_ida_destroy(a_star_ida_t* a_star);
+
+// Resolve o problema através do uso do algoritmo IDA*
+void a_star_ida_solve(a_star_ida_t* a_star, void* initial, void* goal);
+
+// Imprime estatísticas sobre o algoritmo IDA*
+void a_star_ida_print_statistics(a_star_ida_t* a_star, bool csv, bool show_solution);
+
+#endif // ASTAR_IDA_H
@@ -0,0 +1,457 @@
+#include "astar_ida.h"
+#include <limits.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// Número de posições do gestor temporário, tem de ser maior que o número de vizinhos de um estado
+#define IDA_SCRATCH_CAPACITY 256
+
+// Capacidade inicial das pilhas
+#define IDA_INITIAL_CAPACITY 64
+
+// Número de expansões entre verificações do pedido de cancelamento
+#define IDA_CANCEL_INTERVAL 1024
+
+// Cria uma nova instância para resolver um problema
+a_star_ida_t* a_star_ida_create(size_t struct_size,
+                                goal_function goal_func,
+                                visit_function visit_func,
+                                heuristic_function h_func,
+                                distance_function d_func,
+                                print_function print_func)
+{
+  a_star_ida_t* a_star = (a_star_ida_t*)calloc(1, sizeof(a_star_ida_t));
+  if(a_star == NULL)
+  {
+    return NULL; // Erro de alocação
+  }
+
+  // Inicializamos a parte comum do nosso algoritmo
+  a_star->common = a_star_create(struct_size, goal_func, visit_func, h_func, d_func, print_func);
+  a_star->scratch = state_allocator_create_scratch(struct_size, IDA_SCRATCH_CAPACITY);
+  a_star->neighbors = linked_list_create();
+  a_star->frames = (a_star_ida_frame_t*)malloc(IDA_INITIAL_CAPACITY * sizeof(a_star_ida_frame_t));
+  a_star->pool = (char*)malloc(IDA_INITIAL_CAPACITY * struct_size);
+  a_star->pool_hash = (size_t*)malloc(IDA_INITIAL_CAPACITY * sizeof(size_t));
+  a_star->frames_capacity = IDA_INITIAL_CAPACITY;
+  a_star->pool_capacity = IDA_INITIAL_CAPACITY;
+
+  if(a_star->common == NULL || a_star->scratch == NULL || a_star->neighbors == NULL || a_star->frames == NULL ||
+     a_star->pool == NULL || a_star->pool_hash == NULL)
+  {
+    a_star_ida_destroy(a_star);
+    return NULL;
+  }
+
+  return a_star;
+}
+
+// Define o número de entradas da tabela de transposições (0 desativa a tabela)
+bool a_star_ida_set_transposition(a_star_ida_t* a_star, size_t table_size)
+{
+  if(a_star == NULL)
+  {
+    return false;
+  }
+
+  free(a_star->table);
+  free(a_star->table_data);
+  a_star->table = NULL;
+  a_star->table_data = NULL;
+  a_star->table_size = 0;
+
+  if(table_size == 0)
+  {
+    return true;
+  }
+
+  a_star->table = (a_star_ida_entry_t*)calloc(table_size, sizeof(a_star_ida_entry_t));
+  a_star->table_data = (char*)malloc(table_size * a_star->common->state_allocator->struct_size);
+  if(a_star->table == NULL || a_star->table_data == NULL)
+  {
+    free(a_star->table);
+    free(a_star->table_data);
+    a_star->table = NULL;
+    a_star->table_data = NULL;
+    return false;
+  }
+
+  a_star->table_size = table_size;
+  return true;
+}
+
+// Liberta uma instância do algoritmo IDA*
+void a_star_ida_destroy(a_star_ida_t* a_star)
+{
+  if(a_star == NULL)
+  {
+    return;
+  }
+
+  free(a_star->table);
+  free(a_star->table_data);
+  free(a_star->pool_hash);
+  free(a_star->pool);
+  free(a_star->frames);
+  if(a_star->neighbors != NULL)
+    linked_list_destroy(a_star->neighbors);
+  state_allocator_destroy(a_star->scratch);
+
+  // Invocamos o destroy da parte comum
+  a_star_destroy(a_star->common);
+
+  free(a_star);
+}
+
+// Preenche um estado que aponta para os dados de uma posição da pilha de estados
+static state_t* a_star_ida_view(a_star_ida_t* a_star, size_t index, state_t* view)
+{
+  view->struct_size = a_star->common->state_allocator->struct_size;
+  view->hash = a_star->pool_hash[index];
+  view->data = a_star->pool + index * view->struct_size;
+  return view;
+}
+
+// Acrescenta os dados de um estado à pilha de estados
+static bool a_star_ida_push_state(a_star_ida_t* a_star, const state_t* state)
+{
+  size_t struct_size = a_star->common->state_allocator->struct_size;
+  if(a_star->pool_size == a_star->pool_capacity)
+  {
+    size_t capacity = a_star->pool_capacity * 2;
+    char* pool = (char*)realloc(a_star->pool, capacity * struct_size);
+    if(pool == NULL)
+    {
+      return false;
+    }
+    a_star->pool = pool;
+
+    size_t* pool_hash = (size_t*)realloc(a_star->pool_hash, capacity * sizeof(size_t));
+    if(pool_hash == NULL)
+    {
+      return false;
+    }
+    a_star->pool_hash = pool_hash;
+    a_star->pool_capacity = capacity;
+  }
+
+  memcpy(a_star->pool + a_star->pool_size * struct_size, state->data, struct_size);
+  a_star->pool_hash[a_star->pool_size] = state->hash;
+  a_star->pool_size++;
+  return true;
+}
+
+// Acrescenta um nível à pilha do caminho atual
+static a_star_ida_frame_t* a_star_ida_push_frame(a_star_ida_t* a_star, size_t depth)
+{
+  if(depth == a_star->frames_capacity)
+  {
+    size_t capacity = a_star->frames_capacity * 2;
+    a_star_ida_frame_t* frames = (a_star_ida_frame_t*)realloc(a_star->frames, capacity * sizeof(a_star_ida_frame_t));
+    if(frames == NULL)
+    {
+      return NULL;
+    }
+    a_star->frames = frames;
+    a_star->frames_capacity = capacity;
+  }
+
+  if(depth + 1 > a_star->max_depth)
+    a_star->max_depth = depth + 1;
+
+  return &a_star->frames[depth];
+}
+
+// Verifica a tabela de transposições, retorna verdadeiro se o estado já foi visitado nesta
+// iteração com um custo igual ou menor, caso contrário guarda o estado na tabela se store for verdadeiro
+static bool a_star_ida_transposition(a_star_ida_t* a_star, const state_t* state, int g, bool store)
+{
+  size_t slot = state->hash % a_star->table_size;
+  a_star_ida_entry_t* entry = &a_star->table[slot];
+  char* data = a_star->table_data + slot * state->struct_size;
+
+  bool found = entry->iteration == a_star->iterations && memcmp(data, state->data, state->struct_size) == 0;
+  if(found && entry->g <= g)
+  {
+    a_star->table_hits++;
+    return true;
+  }
+
+  if(store)
+  {
+    // Substituímos sempre a entrada anterior
+    entry->iteration = a_star->iterations;
+    entry->g = g;
+    if(!found)
+      memcpy(data, state->data, state->struct_size);
+  }
+  return false;
+}
+
+// Gera os vizinhos do estado no topo da pilha, ignorando o movimento inverso
+static bool a_star_ida_expand(a_star_ida_t* a_star, size_t depth)
+{
+  a_star_t* common = a_star->common;
+  state_t current, grandparent;
+  a_star_ida_view(a_star, a_star->frames[depth].state, &current);
+
+  common->visit_func(&current, a_star->scratch, a_star->neighbors);
+
+  a_star->frames[depth].first_child = a_star->pool_size;
+  a_star->frames[depth].num_children = 0;
+  a_star->frames[depth].next_child = 0;
+  a_star->frames[depth].expanded = true;
+
+  while(linked_list_size(a_star->neighbors))
+  {
+    state_t* neighbor = (state_t*)linked_list_pop_back(a_star->neighbors);
+
+    // O pai do estado atual não pode fazer parte de um caminho ótimo
+    if(depth > 0)
+    {
+      a_star_ida_view(a_star, a_star->frames[depth - 1].state, &grandparent);
+      if(neighbor->hash == grandparent.hash && memcmp(neighbor->data, grandparent.data, neighbor->struct_size) == 0)
+      {
+        a_star->parent_pruned++;
+        continue;
+      }
+    }
+
+    if(!a_star_ida_push_state(a_star, neighbor))
+    {
+      while(linked_list_size(a_star->neighbors))
+        linked_list_pop_back(a_star->neighbors);
+      state_allocator_scratch_reset(a_star->scratch);
+      return false;
+    }
+    a_star->frames[depth].num_children++;
+  }
+
+  // Os vizinhos já foram copiados, as posições temporárias podem ser reutilizadas
+  state_allocator_scratch_reset(a_star->scratch);
+  common->generated += (int)a_star->frames[depth].num_children;
+  return true;
+}
+
+// Procura em profundidade limitada pelo custo f, retorna a profundidade do objetivo ou -1,
+// next_threshold recebe o menor f que excedeu o limite
+static long a_star_ida_search(a_star_ida_t* a_star, int root_h, int* next_threshold)
+{
+  a_star_t* common = a_star->common;
+  *next_threshold = INT_MAX;
+
+  a_star->pool_size = 1;
+  a_star_ida_frame_t* root = &a_star->frames[0];
+  root->g = 0;
+  root->h = root_h;
+  root->state = 0;
+  root->expanded = false;
+
+  size_t depth = 0;
+  while(true)
+  {
+    a_star_ida_frame_t* frame = &a_star->frames[depth];
+
+    if(!frame->expanded)
+    {
+      state_t current;
+      a_star_ida_view(a_star, frame->state, &current);
+
+      // Se encontramos o objetivo terminamos a procura
+      if(common->goal_func(&current, common->goal_state))
+      {
+        return (long)depth;
+      }
+
+      if(common->expanded % IDA_CANCEL_INTERVAL == 0 && a_star_cancel_requested(common))
+      {
+        common->cancelled = true;
+        return -1;
+      }
+
+      common->expanded++;
+      if(!a_star_ida_expand(a_star, depth))
+      {
+        return -1;
+      }
+      frame = &a_star->frames[depth];
+    }
+
+    if(frame->next_child == frame->num_children)
+    {
+      // Todos os filhos foram visitados, recuamos um nível
+      a_star->pool_size = frame->first_child;
+      if(depth == 0)
+      {
+        return -1;
+      }
+      depth--;
+      continue;
+    }
+
+    size_t child_index = frame->first_child + frame->next_child++;
+    state_t current, child;
+    a_star_ida_view(a_star, frame->state, &current);
+    a_star_ida_view(a_star, child_index, &child);
+
+    int g = frame->g + common->d_func(&current, &child);
+    int h = common->h_func(&child, common->goal_state);
+    int f = g + h;
+
+    // Estado já visitado nesta iteração por um caminho igual ou melhor
+    bool exceeds = f > a_star->threshold;
+    if(a_star->table_size > 0 && a_star_ida_transposition(a_star, &child, g, !exceeds))
+    {
+      common->paths_worst_or_equals++;
+      continue;
+    }
+
+    // O filho excede o limite, guardamos o menor custo para a próxima iteração
+    if(exceeds)
+    {
+      if(f < *next_threshold)
+        *next_threshold = f;
+      continue;
+    }
+
+    a_star_ida_frame_t* next = a_star_ida_push_frame(a_star, depth + 1);
+    if(next == NULL)
+    {
+      return -1;
+    }
+
+    next->g = g;
+    next->h = h;
+    next->state = child_index;
+    next->expanded = false;
+    depth++;
+  }
+}
+
+// Recria o caminho da pilha nos gestores da parte comum para guardar a solução
+static void a_star_ida_build_solution(a_star_ida_t* a_star, size_t depth)
+{
+  a_star_t* common = a_star->common;
+  a_star_node_t* parent = NULL;
+
+  for(size_t i = 0; i <= depth; i++)
+  {
+    a_star_ida_frame_t* frame = &a_star->frames[i];
+    state_t view;
+    a_star_ida_view(a_star, frame->state, &view);
+
+    state_t* state = state_allocator_new(common->state_allocator, view.data);
+    a_star_node_t* node = node_allocator_new(common->node_allocator, state);
+    if(node == NULL)
+    {
+      return;
+    }
+
+    node->parent = parent;
+    node->g = frame->g;
+    node->h = frame->h;
+    node->index_in_open_set = SIZE_MAX;
+    parent = node;
+  }
+
+  common->solution = parent;
+  common->num_solutions = common->num_better_solutions = 1;
+}
+
+// Resolve o problema através do uso do algoritmo IDA*
+void a_star_ida_solve(a_star_ida_t* a_star, void* initial, void* goal)
+{
+  if(a_star == NULL)
+  {
+    return;
+  }
+
+  // Limpamos a procura anterior
+  if(a_star->common->expanded > 0 || a_star->common->goal_state != NULL || a_star->common->solution != NULL)
+  {
+    if(!a_star_reset(a_star->common))
+    {
+      return;
+    }
+  }
+
+  a_star->iterations = 0;
+  a_star->threshold = 0;
+  a_star->max_depth = 1;
+  a_star->parent_pruned = 0;
+  a_star->table_hits = 0;
+
+  // Invalidamos a tabela de transposições da procura anterior
+  if(a_star->table_size > 0)
+  {
+    memset(a_star->table, 0, a_star->table_size * sizeof(a_star_ida_entry_t));
+  }
+
+  if(goal)
+  {
+    a_star->common->goal_state = state_allocator_new(a_star->common->state_allocator, goal);
+    if(a_star->common->goal_state == NULL)
+    {
+      return;
+    }
+  }
+
+  // O estado inicial é a base da pilha de estados
+  a_star->pool_size = 0;
+  state_t* initial_state = state_allocator_new(a_star->scratch, initial);
+  if(initial_state == NULL || !a_star_ida_push_state(a_star, initial_state))
+  {
+    return;
+  }
+  state_allocator_scratch_reset(a_star->scratch);
+
+  state_t root;
+  int root_h = a_star->common->h_func(a_star_ida_view(a_star, 0, &root), a_star->common->goal_state);
+  a_star->threshold = root_h;
+
+  clock_gettime(CLOCK_MONOTONIC, &(a_star->common->start_time));
+
+  while(true)
+  {
+    // As iterações começam em 1 para que as entradas vazias da tabela nunca sejam válidas
+    a_star->iterations++;
+
+    int next_threshold;
+    long depth = a_star_ida_search(a_star, root_h, &next_threshold);
+    if(depth >= 0)
+    {
+      a_star_ida_build_solution(a_star, (size_t)depth);
+      break;
+    }
+
+    // Cancelada ou sem estados acima do limite, não existe solução
+    if(a_star->common->cancelled || next_threshold == INT_MAX)
+    {
+      break;
+    }
+
+    a_star->threshold = next_threshold;
+  }
+
+  clock_gettime(CLOCK_MONOTONIC, &(a_star->common->end_time));
+  // Calculamos o tempo de execução
+  a_star->common->execution_time = (a_star->common->end_time.tv_sec - a_star->common->start_time.tv_sec);
+  a_star->common->execution_time += (a_star->common->end_time.tv_nsec - a_star->common->start_time.tv_nsec) / 1000000000.0;
+}
+
+// Imprime estatísticas do algoritmo IDA* no formato desejado
+void a_star_ida_print_statistics(a_star_ida_t* a_star, bool csv, bool show_solution)
+{
+  if(!csv && !show_solution)
+  {
+    printf("Iterações: %d, Limite final: %d, Profundidade máxima: %ld\n", a_star->iterations, a_star->threshold, a_star->max_depth);
+    printf("Movimentos inversos ignorados: %ld, Cortes da tabela de transposições: %ld (%ld entradas)\n",
+           a_star->parent_pruned,
+           a_star->table_hits,
+           a_star->table_size);
+  }
+
+  a_star_print_statistics(a_star->common, csv, show_solution);
+}
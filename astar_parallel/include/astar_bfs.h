@@ -0,0 +1,105 @@
+/*
+   Procura em Largura Paralela Sincronizada por Camadas
+
+   Para problemas de custo unitário sobre um espaço de índices denso (por exemplo as células de um
+   labirinto), onde a lista aberta do A* não compensa: os nós são expandidos camada a camada, todos
+   os nós de uma camada estão à mesma distância do início.
+
+   - A fronteira atual, a próxima fronteira e os estados visitados são conjuntos de bits sobre o
+     espaço de índices, não existem tabelas de dispersão nem gestores de nós durante a procura.
+   - Cada camada é dividida pelos trabalhadores em blocos de palavras da fronteira. Um vizinho é
+     reclamado com um OU atómico sobre o conjunto dos visitados, apenas o trabalhador que o
+     reclamou o coloca na próxima fronteira. As camadas são separadas por uma barreira.
+   - Opcionalmente os nós com g + h acima de um limite superior não são gerados (procura em largura
+     com poda heurística), o que reduz a largura das camadas quando a heurística é admissível.
+   - De cada índice visitado guarda-se apenas a profundidade módulo 3. No fim o caminho é
+     recuperado do objetivo para o início, escolhendo em cada passo um vizinho visitado da camada
+     anterior. Requer um problema não dirigido.
+
+   O caminho final é convertido em estados e nós da parte comum, pelo que a solução é impressa e as
+   estatísticas são apresentadas como no A* sequencial.
+*/
+#ifndef ASTAR_BFS_H
+#define ASTAR_BFS_H
+#include "astar.h"
+#include "state.h"
+#include <pthread.h>
+#include <stdatomic.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+typedef struct a_star_bfs_t a_star_bfs_t;
+
+// Estrutura que contem o estado da procura em largura paralela
+struct a_star_bfs_t
+{
+  // Informação comum do nosso algoritmo, utilizada apenas para a solução e estatísticas
+  a_star_t* common;
+
+  // Espaço de índices do problema
+  size_t num_indices;
+  size_t num_words;
+  size_t max_neighbors;
+  index_neighbors_function neighbors_func;
+  index_state_function state_func;
+  index_heuristic_function h_func;
+  void* context;
+
+  // Conjuntos de bits dos visitados e das fronteiras, profundidade módulo 3 de cada índice
+  _Atomic uint64_t* visited;
+  _Atomic uint64_t* frontier;
+  _Atomic uint64_t* next;
+  uint8_t* layer;
+
+  // Palavras não nulas de cada fronteira, as camadas estreitas não percorrem todo o conjunto de bits
+  size_t* frontier_words;
+  size_t frontier_count;
+  size_t* next_words;
+  atomic_size_t next_count;
+
+  // Trabalhadores e sincronização entre camadas
+  int num_workers;
+  pthread_t* threads;
+  pthread_barrier_t barrier;
+
+  // Estado da procura em curso
+  size_t initial_index;
+  size_t goal_index;
+  int upper_bound; // Limite de g + h (0 sem poda)
+  int depth;
+  atomic_bool found;
+  bool stop;
+
+  // Informação estatística
+  atomic_int expanded;
+  atomic_int generated;
+  atomic_int pruned;
+  int layers;
+  size_t generated_before; // Gerados até à camada anterior, para o tamanho de cada camada
+};
+
+// Cria uma nova instância da procura em largura paralela sobre num_indices índices
+a_star_bfs_t* a_star_bfs_create(size_t struct_size,
+                                size_t num_indices,
+                                size_t max_neighbors,
+                                index_neighbors_function neighbors_func,
+                                index_state_function state_func,
+                                index_heuristic_function h_func,
+                                void* context,
+                                print_function print_func,
+                                int num_workers);
+
+// Define o limite superior de g + h, os nós acima do limite são podados (0 desativa a poda)
+void a_star_bfs_set_upper_bound(a_star_bfs_t* a_star, int upper_bound);
+
+// Liberta uma instância da procura em largura paralela
+void a_star_bfs_destroy(a_star_bfs_t* a_star);
+
+// Resolve o problema entre o índice inicial e o índice objetivo
+void a_star_bfs_solve(a_star_bfs_t* a_star, size_t initial, size_t goal);
+
+// Imprime estatísticas sobre a procura em largura paralela
+void a_star_bfs_print_statistics(a_star_bfs_t* a_star, bool csv, bool show_solution);
+
+#endif // ASTAR_BFS_H
@@ -1,16 +1,39 @@
 /*
    Algoritmo A* Paralelo
+
+   Os trabalhadores formam uma reserva de tarefas persistentes: são criados na primeira procura
+   e ficam estacionados entre procuras, à espera de serem acordados pela procura seguinte. Desta
+   forma resolver várias instâncias com a mesma estrutura não paga o custo de criar as tarefas.
+   Cada procura limpa os estados, nós e estatísticas da procura anterior.
+
+   Opcionalmente a procura começa por uma fase de aquecimento: o coordenador executa o A*
+   sequencial até a lista aberta ter k nós por trabalhador e distribui essa fronteira, com os
+   custos e pais de cada nó, pelos trabalhadores donos de cada estado. Assim todos os
+   trabalhadores começam com trabalho em vez de esperarem que a fronteira se expanda.
+
+   Cada trabalhador pode expandir um lote de k nós por iteração (K-best-first), enviando os
+   sucessores de todo o lote de uma só vez. O lote pode ser fixo ou adaptar-se ao tamanho da
+   lista aberta do trabalhador, até um máximo de k nós.
+
+   A procura termina quando o contador de trabalho pendente chega a zero. O contador inclui as
+   mensagens por processar, os nós nas listas abertas e os nós em expansão, pelo que chega a
+   zero apenas quando todos os trabalhadores ficaram sem trabalho.
 */
 #ifndef ASTAR_PARALLEL_H
 #define ASTAR_PARALLEL_H
 #include "astar.h"
 #include "channel.h"
+#include "cpu_topology.h"
 #include "min_heap.h"
 #include "state.h"
 #include <pthread.h>
+#include <stdatomic.h>
 #include <stdbool.h>
 #include <stddef.h>
 
+// Tamanho máximo de lote sugerido para o modo adaptativo
+#define BATCH_AUTO_MAX 64
+
 typedef struct a_star_worker_t a_star_worker_t;
 typedef struct a_star_scheduler_t a_star_scheduler_t;
 typedef struct a_star_parallel_t a_star_parallel_t;
@@ -36,7 +59,30 @@ struct a_star_parallel_t
 
   // Variáveis necessárias para controlar a execução do algoritmo em paralelo
   bool stop_on_first_solution;
-  bool running;
+  atomic_bool running;
+  atomic_long pending; // Mensagens por processar, nós nas listas abertas e nós em expansão
+
+  // Reserva de trabalhadores persistentes
+  pthread_mutex_t pool_lock;
+  pthread_cond_t pool_wake; // Acorda os trabalhadores para uma nova procura
+  pthread_cond_t pool_done; // Informa que um trabalhador terminou a procura
+  size_t generation; // Número da procura atual
+  size_t workers_done; // Trabalhadores que já terminaram a procura atual
+  bool pool_started;
+  bool shutdown;
+  bool solved; // Já foi realizada uma procura, é necessário limpar antes da próxima
+
+  // Nós expandidos por iteração de cada trabalhador, no modo adaptativo é o valor máximo
+  size_t batch_size;
+  bool batch_adaptive;
+
+  // Fase de aquecimento, nós por trabalhador a gerar antes de iniciar os trabalhadores (0 desativa)
+  size_t warmup_factor;
+  double warmup_time;
+
+  // Política de colocação dos trabalhadores nos CPUs e topologia utilizada
+  affinity_policy_e affinity;
+  cpu_topology_t* topology;
 };
 
 // Estrutura que guarda o estado de um trabalhador
@@ -48,6 +94,7 @@ struct a_star_worker_t
   pthread_t thread;
   int thread_id;
   bool idle;
+  int cpu; // Índice em topology->cpus onde o trabalhador está fixado (-1 caso não esteja)
 
   // Nós abertos locais
   min_heap_t* open_set;
@@ -60,6 +107,8 @@ struct a_star_worker_t
   int nodes_reinserted;
   int paths_worst_or_equals;
   int paths_better;
+  int seeded; // Nós recebidos na fase de aquecimento
+  int batches; // Iterações em que foi expandido um lote de nós
 };
 
 // Cria uma nova instância do algoritmo A* para resolver um problema
@@ -72,10 +121,20 @@ a_star_parallel_t* a_star_parallel_create(size_t struct_size,
                                           int num_workers,
                                           bool stop_on_first_solution);
 
+// Fixa os trabalhadores aos CPUs de acordo com a política escolhida
+void a_star_parallel_set_affinity(a_star_parallel_t* a_star, affinity_policy_e policy);
+
+// Ativa a fase de aquecimento, que gera nodes_per_worker nós por trabalhador antes da procura paralela
+void a_star_parallel_set_warmup(a_star_parallel_t* a_star, size_t nodes_per_worker);
+
+// Define quantos nós cada trabalhador expande por iteração, no modo adaptativo batch_size é o máximo
+void a_star_parallel_set_batch(a_star_parallel_t* a_star, size_t batch_size, bool adaptive);
+
 // Liberta uma instância do algoritmo A* paralelo
 void a_star_parallel_destroy(a_star_parallel_t* a_star);
 
-// Resolve o problema através do uso do algoritmo A* paralelo
+// Resolve o problema através do uso do algoritmo A* paralelo, pode ser chamado várias vezes
+// sobre a mesma instância para resolver problemas diferentes
 void a_star_parallel_solve(a_star_parallel_t* a_star, void* initial, void* goal);
 
 // Imprime estatísticas sobre o algoritmo paralelo
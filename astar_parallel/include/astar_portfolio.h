@@ -0,0 +1,113 @@
+/*
+   Portfólio de configurações do algoritmo A*
+
+   Executa várias configurações do A* (sequencial, paralelo exaustivo, paralelo até à primeira
+   solução, com diferentes critérios de desempate) ao mesmo tempo sobre a mesma instância, cada
+   uma na sua tarefa. A primeira configuração que prova a solução ótima (ou que prova que não
+   existe solução) cancela as restantes através da variável de cancelamento partilhada.
+
+   As configurações que terminam à primeira solução não provam que esta é ótima, pelo que não
+   cancelam as restantes. Caso nenhuma configuração prove a solução, vence a primeira que
+   terminou sem ser cancelada.
+
+   Os trabalhadores são distribuídos por um orçamento de núcleos: cada configuração sequencial
+   ocupa um núcleo e os núcleos restantes são divididos pelas configurações paralelas.
+
+   Configurações disponíveis (`a_star_portfolio_parse`):
+
+   - `seq`: A* sequencial.
+   - `seq-deep`: A* sequencial, desempate pelo menor h.
+   - `par`: A* paralelo exaustivo.
+   - `par-first`: A* paralelo, termina à primeira solução.
+   - `par-deep`: A* paralelo exaustivo, desempate pelo menor h.
+   - `auto`: equivalente a `seq,par-first,par-deep`.
+*/
+#ifndef ASTAR_PORTFOLIO_H
+#define ASTAR_PORTFOLIO_H
+#include "astar.h"
+#include "astar_parallel.h"
+#include "astar_sequential.h"
+#include <pthread.h>
+#include <stdatomic.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+// Número máximo de configurações de um portfólio
+#define PORTFOLIO_MAX_CONFIGS 8
+
+typedef struct a_star_portfolio_t a_star_portfolio_t;
+
+// Configuração de uma procura do portfólio
+typedef struct
+{
+  char name[16];
+  bool parallel;
+  bool stop_on_first_solution;
+  tie_breaker_e tie_breaker;
+  int num_workers; // Calculado a partir do orçamento de núcleos
+} a_star_portfolio_config_t;
+
+// Estado de uma configuração durante a procura
+typedef struct
+{
+  a_star_portfolio_t* portfolio;
+  size_t index;
+  pthread_t thread;
+  a_star_sequential_t* sequential;
+  a_star_parallel_t* parallel;
+  a_star_t* common; // Parte comum da procura, sequencial ou paralela
+  int finish_order; // Ordem pela qual a configuração terminou (-1 caso não tenha terminado)
+} a_star_portfolio_runner_t;
+
+struct a_star_portfolio_t
+{
+  // Configuração do problema, partilhada por todas as procuras
+  size_t struct_size;
+  goal_function goal_func;
+  visit_function visit_func;
+  heuristic_function h_func;
+  distance_function d_func;
+  print_function print_func;
+
+  a_star_portfolio_config_t configs[PORTFOLIO_MAX_CONFIGS];
+  a_star_portfolio_runner_t runners[PORTFOLIO_MAX_CONFIGS];
+  size_t num_configs;
+  size_t core_budget;
+
+  // Estados a resolver durante a procura
+  void* initial;
+  void* goal;
+
+  // Cancelamento partilhado e resultado
+  atomic_bool cancel;
+  pthread_mutex_t lock;
+  int finished;
+  int winner;
+  double execution_time;
+};
+
+// Converte uma lista de nomes separados por vírgulas em configurações, retorna falso caso algum
+// nome não seja conhecido
+bool a_star_portfolio_parse(const char* spec, a_star_portfolio_config_t* configs, size_t* num_configs);
+
+// Cria um portfólio com as configurações indicadas e um orçamento de núcleos
+a_star_portfolio_t* a_star_portfolio_create(size_t struct_size,
+                                            goal_function goal_func,
+                                            visit_function visit_func,
+                                            heuristic_function h_func,
+                                            distance_function d_func,
+                                            print_function print_func,
+                                            const a_star_portfolio_config_t* configs,
+                                            size_t num_configs,
+                                            size_t core_budget);
+
+// Liberta o portfólio e as procuras da última execução
+void a_star_portfolio_destroy(a_star_portfolio_t* portfolio);
+
+// Resolve o problema com todas as configurações em simultâneo
+void a_star_portfolio_solve(a_star_portfolio_t* portfolio, void* initial, void* goal);
+
+// Imprime a configuração vencedora e as estatísticas da sua procura
+void a_star_portfolio_print_statistics(a_star_portfolio_t* portfolio, bool csv, bool show_solution);
+
+#endif // ASTAR_PORTFOLIO_H
@@ -0,0 +1,397 @@
+#include "astar_bfs.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// Camadas com menos palavras do que este valor são expandidas apenas pelo coordenador, sem
+// acordar os restantes trabalhadores
+#define BFS_SERIAL_WORDS 64
+
+// Contadores de uma camada, acumulados por cada trabalhador e somados no fim da camada
+typedef struct
+{
+  int expanded;
+  int generated;
+  int pruned;
+} a_star_bfs_counters_t;
+
+// Argumentos de cada trabalhador
+typedef struct
+{
+  a_star_bfs_t* a_star;
+  int id;
+} a_star_bfs_worker_args_t;
+
+// Cria uma nova instância para resolver um problema
+a_star_bfs_t* a_star_bfs_create(size_t struct_size,
+                                size_t num_indices,
+                                size_t max_neighbors,
+                                index_neighbors_function neighbors_func,
+                                index_state_function state_func,
+                                index_heuristic_function h_func,
+                                void* context,
+                                print_function print_func,
+                                int num_workers)
+{
+  a_star_bfs_t* a_star = (a_star_bfs_t*)calloc(1, sizeof(a_star_bfs_t));
+  if(a_star == NULL)
+  {
+    return NULL; // Erro de alocação
+  }
+
+  a_star->num_indices = num_indices;
+  a_star->num_words = (num_indices + 63) / 64;
+  a_star->max_neighbors = max_neighbors;
+  a_star->neighbors_func = neighbors_func;
+  a_star->state_func = state_func;
+  a_star->h_func = h_func;
+  a_star->context = context;
+  a_star->num_workers = num_workers > 0 ? num_workers : 1;
+
+  // A parte comum apenas guarda a solução, a procura não utiliza as funções sobre estados
+  a_star->common = a_star_create(struct_size, NULL, NULL, NULL, NULL, print_func);
+  a_star->visited = calloc(a_star->num_words, sizeof(uint64_t));
+  a_star->frontier = calloc(a_star->num_words, sizeof(uint64_t));
+  a_star->next = calloc(a_star->num_words, sizeof(uint64_t));
+  a_star->frontier_words = malloc(a_star->num_words * sizeof(size_t));
+  a_star->next_words = malloc(a_star->num_words * sizeof(size_t));
+  a_star->layer = malloc(num_indices);
+  a_star->threads = malloc(a_star->num_workers * sizeof(pthread_t));
+
+  if(a_star->common == NULL || a_star->visited == NULL || a_star->frontier == NULL || a_star->next == NULL ||
+     a_star->frontier_words == NULL || a_star->next_words == NULL || a_star->layer == NULL || a_star->threads == NULL)
+  {
+    a_star_bfs_destroy(a_star);
+    return NULL;
+  }
+
+  return a_star;
+}
+
+// Define o limite superior de g + h utilizado na poda
+void a_star_bfs_set_upper_bound(a_star_bfs_t* a_star, int upper_bound)
+{
+  if(a_star == NULL)
+  {
+    return;
+  }
+
+  a_star->upper_bound = upper_bound > 0 ? upper_bound : 0;
+}
+
+// Liberta uma instância da procura em largura paralela
+void a_star_bfs_destroy(a_star_bfs_t* a_star)
+{
+  if(a_star == NULL)
+  {
+    return;
+  }
+
+  free(a_star->visited);
+  free(a_star->frontier);
+  free(a_star->next);
+  free(a_star->frontier_words);
+  free(a_star->next_words);
+  free(a_star->layer);
+  free(a_star->threads);
+
+  // Invocamos o destroy da parte comum
+  a_star_destroy(a_star->common);
+
+  free(a_star);
+}
+
+// Expande as palavras [begin, end) da lista de palavras da fronteira atual
+static void a_star_bfs_expand(a_star_bfs_t* a_star, size_t begin, size_t end, size_t* neighbors, a_star_bfs_counters_t* counters)
+{
+  uint8_t next_layer = (uint8_t)((a_star->depth + 1) % 3);
+  int next_depth = a_star->depth + 1;
+  bool prune = a_star->upper_bound > 0 && a_star->h_func != NULL;
+
+  for(size_t w = begin; w < end; w++)
+  {
+    size_t word_index = a_star->frontier_words[w];
+    uint64_t word = atomic_load_explicit(&a_star->frontier[word_index], memory_order_relaxed);
+
+    // Cada palavra da fronteira pertence a um único trabalhador, que a deixa limpa para a camada seguinte
+    atomic_store_explicit(&a_star->frontier[word_index], 0, memory_order_relaxed);
+
+    while(word)
+    {
+      size_t index = word_index * 64 + (size_t)__builtin_ctzll(word);
+      word &= word - 1;
+      counters->expanded++;
+
+      size_t num_neighbors = a_star->neighbors_func(index, neighbors, a_star->context);
+      for(size_t i = 0; i < num_neighbors; i++)
+      {
+        size_t neighbor = neighbors[i];
+        size_t neighbor_word = neighbor / 64;
+        uint64_t mask = (uint64_t)1 << (neighbor % 64);
+
+        // Leitura sem escrita primeiro, a maioria dos vizinhos já foi visitada
+        if(atomic_load_explicit(&a_star->visited[neighbor_word], memory_order_relaxed) & mask)
+        {
+          continue;
+        }
+
+        if(prune && next_depth + a_star->h_func(neighbor, a_star->context) > a_star->upper_bound)
+        {
+          counters->pruned++;
+          continue;
+        }
+
+        // Apenas o trabalhador que reclama o vizinho o coloca na próxima fronteira
+        if(atomic_fetch_or_explicit(&a_star->visited[neighbor_word], mask, memory_order_relaxed) & mask)
+        {
+          continue;
+        }
+
+        a_star->layer[neighbor] = next_layer;
+        counters->generated++;
+
+        // O primeiro bit de uma palavra acrescenta a palavra à lista da próxima fronteira
+        if(atomic_fetch_or_explicit(&a_star->next[neighbor_word], mask, memory_order_relaxed) == 0)
+        {
+          size_t position = atomic_fetch_add_explicit(&a_star->next_count, 1, memory_order_relaxed);
+          a_star->next_words[position] = neighbor_word;
+        }
+
+        if(neighbor == a_star->goal_index)
+        {
+          atomic_store_explicit(&a_star->found, true, memory_order_relaxed);
+        }
+      }
+    }
+  }
+}
+
+// Soma os contadores de uma camada às estatísticas
+static void a_star_bfs_add_counters(a_star_bfs_t* a_star, a_star_bfs_counters_t* counters)
+{
+  atomic_fetch_add_explicit(&a_star->expanded, counters->expanded, memory_order_relaxed);
+  atomic_fetch_add_explicit(&a_star->generated, counters->generated, memory_order_relaxed);
+  atomic_fetch_add_explicit(&a_star->pruned, counters->pruned, memory_order_relaxed);
+  counters->expanded = counters->generated = counters->pruned = 0;
+}
+
+// Passa à camada seguinte, executado apenas pelo coordenador entre duas barreiras
+static void a_star_bfs_advance(a_star_bfs_t* a_star)
+{
+  // A próxima fronteira passa a ser a atual, a atual já foi limpa por quem a expandiu
+  _Atomic uint64_t* bits = a_star->frontier;
+  a_star->frontier = a_star->next;
+  a_star->next = bits;
+
+  size_t* words = a_star->frontier_words;
+  a_star->frontier_words = a_star->next_words;
+  a_star->next_words = words;
+  a_star->frontier_count = atomic_exchange_explicit(&a_star->next_count, 0, memory_order_relaxed);
+
+  a_star->depth++;
+  a_star->layers++;
+
+  size_t generated = (size_t)atomic_load_explicit(&a_star->generated, memory_order_relaxed);
+  size_t layer_size = generated - a_star->generated_before;
+  a_star->generated_before = generated;
+  if(a_star->common->max_min_heap_size < layer_size)
+    a_star->common->max_min_heap_size = layer_size;
+
+  if(a_star_cancel_requested(a_star->common))
+  {
+    a_star->common->cancelled = true;
+  }
+
+  a_star->stop = atomic_load_explicit(&a_star->found, memory_order_relaxed) || a_star->frontier_count == 0 ||
+                 a_star->common->cancelled;
+}
+
+// Ciclo de cada trabalhador, o trabalhador 0 é o coordenador e corre na tarefa que chamou a procura
+static void* a_star_bfs_worker(void* arg)
+{
+  a_star_bfs_worker_args_t* args = (a_star_bfs_worker_args_t*)arg;
+  a_star_bfs_t* a_star = args->a_star;
+  int id = args->id;
+  size_t* neighbors = malloc(a_star->max_neighbors * sizeof(size_t));
+  a_star_bfs_counters_t counters = { 0 };
+
+  while(true)
+  {
+    // Cada trabalhador expande um bloco contíguo da lista de palavras da fronteira
+    size_t begin = a_star->frontier_count * id / a_star->num_workers;
+    size_t end = a_star->frontier_count * (id + 1) / a_star->num_workers;
+    a_star_bfs_expand(a_star, begin, end, neighbors, &counters);
+    a_star_bfs_add_counters(a_star, &counters);
+
+    pthread_barrier_wait(&a_star->barrier);
+
+    if(id == 0)
+    {
+      a_star_bfs_advance(a_star);
+
+      // Camadas estreitas são expandidas pelo coordenador enquanto os restantes esperam na barreira
+      while(!a_star->stop && a_star->frontier_count < BFS_SERIAL_WORDS)
+      {
+        a_star_bfs_expand(a_star, 0, a_star->frontier_count, neighbors, &counters);
+        a_star_bfs_add_counters(a_star, &counters);
+        a_star_bfs_advance(a_star);
+      }
+    }
+
+    pthread_barrier_wait(&a_star->barrier);
+
+    if(a_star->stop)
+    {
+      break;
+    }
+  }
+
+  free(neighbors);
+  return NULL;
+}
+
+// Recupera o caminho do objetivo até ao início e converte-o em nós da parte comum
+static void a_star_bfs_build_solution(a_star_bfs_t* a_star)
+{
+  a_star_t* common = a_star->common;
+  int length = a_star->depth;
+  size_t* path = malloc((length + 1) * sizeof(size_t));
+  size_t* neighbors = malloc(a_star->max_neighbors * sizeof(size_t));
+  void* state_data = malloc(common->state_allocator->struct_size);
+
+  // Num problema não dirigido um vizinho visitado da camada anterior está à distância d - 1 do
+  // início. O primeiro passo liga sempre ao índice inicial, que pode não ser vizinho de nenhum outro
+  path[0] = a_star->initial_index;
+  path[length] = a_star->goal_index;
+  for(int d = length; d > 1; d--)
+  {
+    size_t num_neighbors = a_star->neighbors_func(path[d], neighbors, a_star->context);
+    uint8_t previous_layer = (uint8_t)((d - 1) % 3);
+    path[d - 1] = SIZE_MAX;
+    for(size_t i = 0; i < num_neighbors; i++)
+    {
+      size_t neighbor = neighbors[i];
+      if((atomic_load_explicit(&a_star->visited[neighbor / 64], memory_order_relaxed) & ((uint64_t)1 << (neighbor % 64))) &&
+         a_star->layer[neighbor] == previous_layer)
+      {
+        path[d - 1] = neighbor;
+        break;
+      }
+    }
+
+    if(path[d - 1] == SIZE_MAX)
+    {
+      // Só acontece se o problema for dirigido
+      free(path);
+      free(neighbors);
+      free(state_data);
+      return;
+    }
+  }
+
+  a_star_node_t* parent = NULL;
+  for(int d = 0; d <= length; d++)
+  {
+    a_star->state_func(path[d], state_data, a_star->context);
+    state_t* state = state_allocator_new(common->state_allocator, state_data);
+    a_star_node_t* node = node_allocator_new(common->node_allocator, state);
+    node->g = d;
+    node->h = a_star->h_func != NULL ? a_star->h_func(path[d], a_star->context) : 0;
+    node->parent = parent;
+    parent = node;
+  }
+  common->solution = parent;
+  common->num_solutions = common->num_better_solutions = 1;
+
+  free(path);
+  free(neighbors);
+  free(state_data);
+}
+
+// Resolve o problema através da procura em largura paralela
+void a_star_bfs_solve(a_star_bfs_t* a_star, size_t initial, size_t goal)
+{
+  if(a_star == NULL || initial >= a_star->num_indices || goal >= a_star->num_indices)
+  {
+    return;
+  }
+
+  // Limpamos a procura anterior
+  if(a_star->common->expanded > 0 || a_star->common->solution != NULL)
+  {
+    if(!a_star_reset(a_star->common))
+    {
+      return;
+    }
+  }
+  memset((void*)a_star->visited, 0, a_star->num_words * sizeof(uint64_t));
+  memset((void*)a_star->frontier, 0, a_star->num_words * sizeof(uint64_t));
+  memset((void*)a_star->next, 0, a_star->num_words * sizeof(uint64_t));
+  atomic_store(&a_star->expanded, 0);
+  atomic_store(&a_star->generated, 0);
+  atomic_store(&a_star->pruned, 0);
+  atomic_store(&a_star->next_count, 0);
+  atomic_store(&a_star->found, initial == goal);
+  a_star->generated_before = 0;
+  a_star->initial_index = initial;
+  a_star->goal_index = goal;
+  a_star->depth = 0;
+  a_star->layers = 0;
+
+  // O índice inicial forma a primeira camada
+  a_star->visited[initial / 64] = (uint64_t)1 << (initial % 64);
+  a_star->frontier[initial / 64] = (uint64_t)1 << (initial % 64);
+  a_star->frontier_words[0] = initial / 64;
+  a_star->frontier_count = 1;
+  a_star->layer[initial] = 0;
+  a_star->stop = initial == goal;
+
+  clock_gettime(CLOCK_MONOTONIC, &(a_star->common->start_time));
+
+  if(!a_star->stop)
+  {
+    a_star_bfs_worker_args_t* args = malloc(a_star->num_workers * sizeof(a_star_bfs_worker_args_t));
+    pthread_barrier_init(&a_star->barrier, NULL, (unsigned)a_star->num_workers);
+    for(int i = 0; i < a_star->num_workers; i++)
+    {
+      args[i].a_star = a_star;
+      args[i].id = i;
+      if(i > 0)
+        pthread_create(&a_star->threads[i], NULL, a_star_bfs_worker, &args[i]);
+    }
+
+    a_star_bfs_worker(&args[0]);
+
+    for(int i = 1; i < a_star->num_workers; i++)
+    {
+      pthread_join(a_star->threads[i], NULL);
+    }
+    pthread_barrier_destroy(&a_star->barrier);
+    free(args);
+  }
+
+  a_star->common->expanded = atomic_load(&a_star->expanded);
+  a_star->common->generated = atomic_load(&a_star->generated);
+  a_star->common->nodes_new = a_star->common->generated;
+
+  if(atomic_load(&a_star->found) && !a_star->common->cancelled)
+  {
+    a_star_bfs_build_solution(a_star);
+  }
+
+  clock_gettime(CLOCK_MONOTONIC, &(a_star->common->end_time));
+  // Calculamos o tempo de execução
+  a_star->common->execution_time = (a_star->common->end_time.tv_sec - a_star->common->start_time.tv_sec);
+  a_star->common->execution_time += (a_star->common->end_time.tv_nsec - a_star->common->start_time.tv_nsec) / 1000000000.0;
+}
+
+// Imprime estatísticas da procura em largura no formato desejado
+void a_star_bfs_print_statistics(a_star_bfs_t* a_star, bool csv, bool show_solution)
+{
+  if(!csv && !show_solution)
+  {
+    printf("Camadas: %d, trabalhadores: %d, nós podados: %d\n", a_star->layers, a_star->num_workers, atomic_load(&a_star->pruned));
+  }
+
+  a_star_print_statistics(a_star->common, csv, show_solution);
+}
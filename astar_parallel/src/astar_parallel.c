@@ -1,10 +1,12 @@
 #include "astar_parallel.h"
+#include <sched.h>
 #include <stdint.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
 
-#define MAX_IDLE_TIME 100000
+// No modo adaptativo o lote é uma fração da lista aberta do trabalhador
+#define BATCH_ADAPTIVE_RATIO 16
 
 // Estrutura que contem a mensagem a ser passada nas queues
 typedef struct
@@ -13,6 +15,42 @@ typedef struct
   state_t* state;
 } a_star_message_t;
 
+// Mensagens acumuladas para um trabalhador durante a expansão de um lote
+typedef struct
+{
+  a_star_message_t* messages;
+  size_t count;
+  size_t capacity;
+} a_star_outbox_t;
+
+// Guarda uma mensagem para ser enviada no fim do lote
+static void a_star_outbox_push(a_star_outbox_t* outbox, a_star_message_t* message)
+{
+  if(outbox->count == outbox->capacity)
+  {
+    outbox->capacity = outbox->capacity == 0 ? 64 : outbox->capacity * 2;
+    outbox->messages = (a_star_message_t*)realloc(outbox->messages, outbox->capacity * sizeof(a_star_message_t));
+  }
+
+  outbox->messages[outbox->count++] = *message;
+}
+
+// Número de nós a expandir por iteração, no modo adaptativo depende do tamanho da lista aberta
+static size_t a_star_parallel_batch_size(a_star_parallel_t* a_star, a_star_worker_t* worker)
+{
+  if(!a_star->batch_adaptive)
+  {
+    return a_star->batch_size;
+  }
+
+  size_t batch_size = worker->open_set->size / BATCH_ADAPTIVE_RATIO;
+  if(batch_size < 1)
+    return 1;
+  if(batch_size > a_star->batch_size)
+    return a_star->batch_size;
+  return batch_size;
+}
+
 // Função para encontrar o next worker baseada na posição de memória do estado
 // Isto garante uma distribuição balanceada entre os trabalhadores e ao mesmo
 // tempo garante que os nós processam sempre os mesmos estados
@@ -24,37 +62,28 @@ static size_t assign_to_worker(a_star_parallel_t* a_star, state_t* state)
   // return hash % a_star->scheduler.num_workers;
 }
 
-// Função que implementa a lógica de um trabalhador, aqui se processa o algoritmo A*
-void* a_star_worker_function(void* arg)
+// Função que implementa a lógica de um trabalhador durante uma procura, aqui se processa o algoritmo A*
+static void a_star_worker_search(a_star_worker_t* worker, linked_list_t* neighbors, a_star_outbox_t* outbox)
 {
-  a_star_worker_t* worker = (a_star_worker_t*)arg;
   a_star_parallel_t* a_star = worker->a_star;
 
-  // Reinicia as estatísticas para este trabalhador
-  worker->generated = 0;
-  worker->expanded = 0;
-  worker->max_min_heap_size = 0;
-  worker->nodes_new = 0;
-  worker->nodes_reinserted = 0;
-  worker->paths_better = 0;
-  worker->paths_worst_or_equals = 0;
-
   worker->idle = false;
 
-  // Esta lista para receber os vizinhos de um nó
-  linked_list_t* neighbors = linked_list_create();
-
-  while(a_star->running)
+  while(atomic_load(&a_star->running))
   {
-    // Este trabalhador considera-se ocioso caso não existam nós a explorar ou mensagens destinadas a si
-    worker->idle = worker->open_set->size == 0 && !channel_has_messages(a_star->channel, worker->thread_id);
+    // Foi pedido o cancelamento da procura, paramos todos os trabalhadores
+    if(a_star_cancel_requested(a_star->common))
+    {
+      atomic_store(&a_star->running, false);
+      break;
+    }
 
     // Processamos todos os estados que estão no canal para esta tarefa
     // Aqui que ocorre a atualização do custo do estado
     if(channel_has_messages(a_star->channel, worker->thread_id))
     {
-      worker->idle = false;
       size_t messages_count = 0;
+      long discarded = 0;
       a_star_message_t* messages = channel_receive(a_star->channel, worker->thread_id, &messages_count);
 
       for(size_t i = 0; i < messages_count; i++)
@@ -63,17 +92,22 @@ void* a_star_worker_function(void* arg)
         a_star_node_t* parent_node = messages[i].parent;
         state_t* state = messages[i].state;
 
-        // Se o nó pai não foi enviado é porque estamos a lidar com o estado inicial
+        // Se o nó pai não foi enviado é porque estamos a lidar com o estado inicial ou com um nó
+        // da fase de aquecimento, que já tem o seu custo e pai
         if(parent_node == NULL)
         {
-          a_star_node_t* initial_node = node_allocator_new(a_star->common->node_allocator, state);
-          // Atribui ao nó inicial um custo total de 0
-          initial_node->g = 0;
-          initial_node->h = a_star->common->h_func(initial_node->state, a_star->common->goal_state);
+          a_star_node_t* seed_node = node_allocator_get(a_star->common->node_allocator, state);
+          if(seed_node == NULL)
+          {
+            seed_node = node_allocator_new(a_star->common->node_allocator, state);
+            // Atribui ao nó inicial um custo total de 0
+            seed_node->g = 0;
+            seed_node->h = a_star->common->h_func(seed_node->state, a_star->common->goal_state);
+          }
 
-          // Inserimos o nó na nossa fila e saímos já que não existem mais mensagens
-          initial_node->index_in_open_set = min_heap_insert(worker->open_set, initial_node->h, initial_node);
-          break;
+          // Inserimos o nó na nossa fila
+          seed_node->index_in_open_set = min_heap_insert(worker->open_set, a_star_priority(a_star->common, seed_node), seed_node);
+          continue;
         }
 
         // Recebemos um estado para ser processado, verificamos se já existe um nó para este estado
@@ -96,7 +130,7 @@ void* a_star_worker_function(void* arg)
           child_node->h = a_star->common->h_func(child_node->state, a_star->common->goal_state);
 
           // Calculamos o custo
-          int cost = child_node->g + child_node->h;
+          int64_t cost = a_star_priority(a_star->common, child_node);
 
           // Inserimos o nó na nossa fila
           child_node->index_in_open_set = min_heap_insert(worker->open_set, cost, child_node);
@@ -112,31 +146,28 @@ void* a_star_worker_function(void* arg)
           if(g_attempt >= child_node->g)
           {
             worker->paths_worst_or_equals++;
+            discarded++;
             continue;
           }
 
           // O estado pai é o caminho mais curto para este estado, atualizamos o pai deste estado
           child_node->parent = parent_node;
 
-          // Atualizamos os parâmetros do nó
+          // Atualizamos os parâmetros do nó, a heurística depende apenas do estado e mantém-se
           child_node->g = g_attempt;
-          child_node->h = a_star->common->h_func(child_node->state, a_star->common->goal_state);
 
           // Calculamos o novo custo
-          int cost = child_node->g + child_node->h;
+          int64_t cost = a_star_priority(a_star->common, child_node);
 
           worker->paths_better++;
           if(child_node->index_in_open_set == SIZE_MAX)
           {
-            // Inserimos o nó na nossa fila novamente
-            child_node->index_in_open_set = min_heap_insert(worker->open_set, cost, child_node);
             worker->nodes_reinserted++;
           }
-          else
-          {
-            // Atualizamos a nossa fila prioritária
-            min_heap_update_cost(worker->open_set, child_node->index_in_open_set, cost);
-          }
+
+          // Inserimos o nó na nossa fila com o novo custo, o índice devolvido pela min_heap deixa de ser válido
+          // após as trocas internas, pelo que a entrada antiga fica na fila e é ignorada quando for retirada
+          child_node->index_in_open_set = min_heap_insert(worker->open_set, cost, child_node);
         }
       }
 
@@ -144,21 +175,46 @@ void* a_star_worker_function(void* arg)
       {
         free(messages);
       }
+
+      // As mensagens que não originaram um novo nó na lista aberta deixam de ser trabalho pendente
+      if(discarded > 0)
+      {
+        atomic_fetch_sub(&a_star->pending, discarded);
+      }
     }
 
     if(worker->max_min_heap_size < worker->open_set->size)
       worker->max_min_heap_size = worker->open_set->size;
 
-    // Temos pelo menos um nó na nossa lista aberta que podemos processar
-    if(worker->open_set->size)
+    // Sem nós para processar, a procura termina quando não existir trabalho pendente em nenhum trabalhador
+    if(worker->open_set->size == 0)
+    {
+      if(atomic_load(&a_star->pending) == 0)
+      {
+        break;
+      }
+      sched_yield();
+      continue;
+    }
+
+    // Temos pelo menos um nó na nossa lista aberta que podemos processar, retiramos até k nós
+    // e expandimos todos antes de voltar a verificar o canal
+    size_t batch_size = a_star_parallel_batch_size(a_star, worker);
+    worker->batches++;
+    for(size_t b = 0; b < batch_size && worker->open_set->size && atomic_load(&a_star->running); b++)
     {
-      worker->idle = false;
       // A seguinte operação pode ocorrer em O(log(N))
       // se nosAbertos é um min-heap ou uma queue prioritária
       heap_node_t top_element = min_heap_pop(worker->open_set);
 
-      // Nó atual na nossa árvore
+      // Nó atual na nossa árvore, caso o custo já não corresponda ao do nó esta entrada foi
+      // substituída por um caminho melhor e é ignorada
       a_star_node_t* current_node = (a_star_node_t*)top_element.data;
+      if(top_element.cost != a_star_priority(a_star->common, current_node))
+      {
+        atomic_fetch_sub(&a_star->pending, 1);
+        continue;
+      }
       current_node->index_in_open_set = SIZE_MAX;
       worker->expanded++;
 
@@ -176,8 +232,9 @@ void* a_star_worker_function(void* arg)
 
         if(f_current > f_solution || current_node->g > a_star->common->solution->g)
         {
+          atomic_fetch_sub(&a_star->pending, 1 + (long)worker->open_set->size);
           min_heap_clean(worker->open_set);
-          continue;
+          break;
         }
       }
 
@@ -228,30 +285,279 @@ void* a_star_worker_function(void* arg)
           }
         }
         pthread_mutex_unlock(&(a_star->lock));
+
+        // Queremos sair à primeira solução, informamos os restantes trabalhadores
+        if(a_star->stop_on_first_solution)
+        {
+          atomic_store(&a_star->running, false);
+        }
+        atomic_fetch_sub(&a_star->pending, 1);
       }
       else
       {
         // Executa a função que visita os vizinhos deste nó
         a_star->common->visit_func(current_node->state, a_star->common->state_allocator, neighbors);
 
-        // Itera por todos os vizinhos gerados e envia para a devida tarefa
+        // Os vizinhos passam a ser trabalho pendente antes de serem enviados e o nó atual deixa de o ser
+        atomic_fetch_add(&a_star->pending, (long)linked_list_size(neighbors) - 1);
+
+        // Itera por todos os vizinhos gerados e guarda a mensagem para a devida tarefa
         while(linked_list_size(neighbors))
         {
           // Compomos a mensagem com os dados necessários e identificamos qual
           // o trabalhador que vai tratar deste estado
           a_star_message_t message = { current_node, (state_t*)linked_list_pop_back(neighbors) };
           size_t worker_id = assign_to_worker(a_star, message.state);
-          // Enviamos a mensagem para o respetivo trabalhador
-          channel_send(a_star->channel, worker_id, (void*)&message);
+          a_star_outbox_push(&outbox[worker_id], &message);
         }
       }
     }
+
+    // Enviamos os sucessores de todo o lote, uma única operação por trabalhador de destino
+    for(size_t i = 0; i < a_star->scheduler.num_workers; i++)
+    {
+      if(outbox[i].count > 0)
+      {
+        channel_send_batch(a_star->channel, i, outbox[i].messages, outbox[i].count);
+        outbox[i].count = 0;
+      }
+    }
   }
 
-  // Liberta a lista de vizinhos
+  worker->idle = true;
+}
+
+// Função executada pelas tarefas da reserva, estaciona o trabalhador entre procuras
+void* a_star_worker_function(void* arg)
+{
+  a_star_worker_t* worker = (a_star_worker_t*)arg;
+  a_star_parallel_t* a_star = worker->a_star;
+  size_t generation = 0;
+
+  // Esta lista para receber os vizinhos de um nó
+  linked_list_t* neighbors = linked_list_create();
+
+  // Mensagens por enviar para cada trabalhador durante a expansão de um lote
+  a_star_outbox_t* outbox = (a_star_outbox_t*)calloc(a_star->scheduler.num_workers, sizeof(a_star_outbox_t));
+
+  while(true)
+  {
+    // Esperamos por uma nova procura ou pelo pedido para terminar
+    pthread_mutex_lock(&a_star->pool_lock);
+    while(!a_star->shutdown && a_star->generation == generation)
+    {
+      pthread_cond_wait(&a_star->pool_wake, &a_star->pool_lock);
+    }
+    if(a_star->shutdown)
+    {
+      pthread_mutex_unlock(&a_star->pool_lock);
+      break;
+    }
+    generation = a_star->generation;
+    pthread_mutex_unlock(&a_star->pool_lock);
+
+    a_star_worker_search(worker, neighbors, outbox);
+
+    // Informamos que este trabalhador terminou a procura
+    pthread_mutex_lock(&a_star->pool_lock);
+    a_star->workers_done++;
+    pthread_cond_signal(&a_star->pool_done);
+    pthread_mutex_unlock(&a_star->pool_lock);
+  }
+
+  // Liberta a lista de vizinhos e as mensagens por enviar
   linked_list_destroy(neighbors);
+  for(size_t i = 0; i < a_star->scheduler.num_workers; i++)
+  {
+    free(outbox[i].messages);
+  }
+  free(outbox);
+
+  return NULL;
+}
+
+// Cria as tarefas da reserva de trabalhadores
+static bool a_star_parallel_start_workers(a_star_parallel_t* a_star)
+{
+  for(size_t i = 0; i < a_star->scheduler.num_workers; i++)
+  {
+    a_star_worker_t* worker = &(a_star->scheduler.workers[i]);
 
-  pthread_exit(NULL);
+    if(pthread_create(&(worker->thread), NULL, a_star_worker_function, worker) != 0)
+    {
+      // Terminamos as tarefas que já foram criadas
+      pthread_mutex_lock(&a_star->pool_lock);
+      a_star->shutdown = true;
+      pthread_cond_broadcast(&a_star->pool_wake);
+      pthread_mutex_unlock(&a_star->pool_lock);
+      for(size_t j = 0; j < i; j++)
+      {
+        pthread_join(a_star->scheduler.workers[j].thread, NULL);
+      }
+      a_star->shutdown = false;
+      return false;
+    }
+
+    // Caso o trabalhador tenha um CPU atribuído fixamos a tarefa nesse CPU
+    if(worker->cpu >= 0)
+    {
+      cpu_topology_pin(worker->thread, a_star->topology->cpus[worker->cpu].cpu);
+    }
+  }
+
+  a_star->pool_started = true;
+  return true;
+}
+
+// Fase de aquecimento: o coordenador executa o A* sequencial até a lista aberta ter nós suficientes para
+// todos os trabalhadores e distribui essa fronteira pelos trabalhadores donos de cada estado.
+// Retorna verdadeiro caso a procura tenha terminado durante o aquecimento
+static bool a_star_parallel_warmup(a_star_parallel_t* a_star, state_t* initial_state)
+{
+  struct timespec start_time, end_time;
+  clock_gettime(CLOCK_MONOTONIC, &start_time);
+
+  size_t target = a_star->warmup_factor * a_star->scheduler.num_workers;
+  min_heap_t* open_set = min_heap_create();
+  linked_list_t* neighbors = linked_list_create();
+  bool finished = false;
+
+  a_star_node_t* initial_node = node_allocator_new(a_star->common->node_allocator, initial_state);
+
+  // Atribui ao nó inicial um custo total de 0
+  initial_node->g = 0;
+  initial_node->h = a_star->common->h_func(initial_node->state, a_star->common->goal_state);
+  initial_node->index_in_open_set = min_heap_insert(open_set, a_star_priority(a_star->common, initial_node), initial_node);
+
+  while(open_set->size > 0 && open_set->size < target && !a_star_cancel_requested(a_star->common))
+  {
+    if(a_star->common->max_min_heap_size < open_set->size)
+      a_star->common->max_min_heap_size = open_set->size;
+
+    heap_node_t top_element = min_heap_pop(open_set);
+
+    // Nó atual na nossa árvore, as entradas substituídas por um caminho melhor são ignoradas
+    a_star_node_t* current_node = (a_star_node_t*)top_element.data;
+    if(top_element.cost != a_star_priority(a_star->common, current_node))
+    {
+      continue;
+    }
+    current_node->index_in_open_set = SIZE_MAX;
+    a_star->common->expanded++;
+#ifdef STATS_GEN
+    search_data_add_entry(0, current_node->state, ACTION_VISITED);
+#endif
+
+    // A solução encontrada pelo A* sequencial já é a melhor, não é necessária a fase paralela
+    if(a_star->common->goal_func(current_node->state, a_star->common->goal_state))
+    {
+      a_star->common->num_solutions = a_star->common->num_better_solutions = 1;
+      a_star->common->solution = current_node;
+      finished = true;
+      break;
+    }
+
+    // Executa a função que visita os vizinhos deste nó
+    a_star->common->visit_func(current_node->state, a_star->common->state_allocator, neighbors);
+    while(linked_list_size(neighbors))
+    {
+      state_t* neighbor = (state_t*)linked_list_pop_back(neighbors);
+      a_star_node_t* child_node = node_allocator_get(a_star->common->node_allocator, neighbor);
+      int g_attempt = current_node->g + a_star->common->d_func(current_node->state, neighbor);
+
+      if(!child_node)
+      {
+        // Este nó ainda não existe, criamos um novo nó
+        child_node = node_allocator_new(a_star->common->node_allocator, neighbor);
+        child_node->parent = current_node;
+#ifdef STATS_GEN
+        search_data_add_entry(0, child_node->state, ACTION_SUCESSOR);
+#endif
+        child_node->g = g_attempt;
+        child_node->h = a_star->common->h_func(child_node->state, a_star->common->goal_state);
+        child_node->index_in_open_set = min_heap_insert(open_set, a_star_priority(a_star->common, child_node), child_node);
+        a_star->common->generated++;
+        a_star->common->nodes_new++;
+        continue;
+      }
+
+      // Existe outro caminho mais curto para este nó
+      if(g_attempt >= child_node->g)
+      {
+        a_star->common->paths_worst_or_equals++;
+        continue;
+      }
+
+      // O nó atual é o caminho mais curto para este vizinho, atualizamos
+      child_node->parent = current_node;
+      child_node->g = g_attempt;
+      a_star->common->paths_better++;
+      if(child_node->index_in_open_set == SIZE_MAX)
+      {
+        a_star->common->nodes_reinserted++;
+      }
+      child_node->index_in_open_set = min_heap_insert(open_set, a_star_priority(a_star->common, child_node), child_node);
+    }
+  }
+
+  // Sem nós na lista aberta não existe solução
+  if(open_set->size == 0)
+  {
+    finished = true;
+  }
+
+  // Distribuímos a fronteira pelos trabalhadores, cada nó mantém o seu custo e o seu pai
+  if(!finished)
+  {
+    atomic_store(&a_star->pending, 0);
+    while(open_set->size)
+    {
+      heap_node_t top_element = min_heap_pop(open_set);
+      a_star_node_t* node = (a_star_node_t*)top_element.data;
+      if(top_element.cost != a_star_priority(a_star->common, node))
+      {
+        continue;
+      }
+      node->index_in_open_set = SIZE_MAX;
+      atomic_fetch_add(&a_star->pending, 1);
+
+      a_star_message_t message = { NULL, node->state };
+      size_t worker_id = assign_to_worker(a_star, node->state);
+      a_star->scheduler.workers[worker_id].seeded++;
+      channel_send(a_star->channel, worker_id, (void*)&message);
+    }
+  }
+
+  linked_list_destroy(neighbors);
+  min_heap_destroy(open_set);
+
+  clock_gettime(CLOCK_MONOTONIC, &end_time);
+  a_star->warmup_time = (end_time.tv_sec - start_time.tv_sec);
+  a_star->warmup_time += (end_time.tv_nsec - start_time.tv_nsec) / 1000000000.0;
+
+  return finished;
+}
+
+// Limpa o resultado da procura anterior: estados, nós, listas abertas e mensagens por entregar
+static bool a_star_parallel_reset(a_star_parallel_t* a_star)
+{
+  for(size_t i = 0; i < a_star->scheduler.num_workers; i++)
+  {
+    min_heap_clean(a_star->scheduler.workers[i].open_set);
+
+    // Ao terminar na primeira solução podem ter ficado mensagens no canal
+    while(channel_has_messages(a_star->channel, i))
+    {
+      size_t messages_count = 0;
+      void* messages = channel_receive(a_star->channel, i, &messages_count);
+      if(messages_count > 0)
+      {
+        free(messages);
+      }
+    }
+  }
+
+  return a_star_reset(a_star->common);
 }
 
 // Cria uma nova instância para resolver um problema
@@ -274,9 +580,23 @@ a_star_parallel_t* a_star_parallel_create(size_t struct_size,
   a_star->scheduler.workers = NULL;
   a_star->channel = NULL;
   a_star->common = NULL;
+  a_star->topology = NULL;
+  a_star->affinity = AFFINITY_NONE;
 
   pthread_mutex_init(&a_star->lock, NULL);
 
+  // Inicializamos a reserva de trabalhadores, as tarefas apenas são criadas na primeira procura
+  pthread_mutex_init(&a_star->pool_lock, NULL);
+  pthread_cond_init(&a_star->pool_wake, NULL);
+  pthread_cond_init(&a_star->pool_done, NULL);
+  a_star->generation = 0;
+  a_star->workers_done = 0;
+  a_star->pool_started = false;
+  a_star->shutdown = false;
+  a_star->solved = false;
+  atomic_init(&a_star->pending, 0);
+  atomic_init(&a_star->running, false);
+
   // Inicializamos a parte comum do nosso algoritmo
   a_star->common = a_star_create(struct_size, goal_func, visit_func, h_func, d_func, print_func);
   if(a_star->common == NULL)
@@ -312,10 +632,13 @@ a_star_parallel_t* a_star_parallel_create(size_t struct_size,
     a_star->scheduler.workers[i].thread_id = i;
     a_star->scheduler.workers[i].open_set = min_heap_create();
     a_star->scheduler.workers[i].idle = true;
+    a_star->scheduler.workers[i].cpu = -1;
 
     // Reiniciamos as estatísticas internas do trabalhador
     a_star->scheduler.workers[i].expanded = 0;
     a_star->scheduler.workers[i].generated = 0;
+    a_star->scheduler.workers[i].seeded = 0;
+    a_star->scheduler.workers[i].batches = 0;
   }
 
   // Reiniciamos a variável utilizada para round-robin
@@ -324,11 +647,81 @@ a_star_parallel_t* a_star_parallel_create(size_t struct_size,
 
   // Inicializa as funções necessárias para o algoritmo funcionar
   a_star->stop_on_first_solution = stop_on_first_solution;
-  a_star->running = false;
+  a_star->warmup_factor = 0;
+  a_star->warmup_time = 0;
+  a_star->batch_size = 1;
+  a_star->batch_adaptive = false;
 
   return a_star;
 }
 
+// Fixa os trabalhadores aos CPUs de acordo com a política escolhida
+void a_star_parallel_set_affinity(a_star_parallel_t* a_star, affinity_policy_e policy)
+{
+  if(a_star == NULL)
+  {
+    return;
+  }
+
+  a_star->affinity = policy;
+  for(size_t i = 0; i < a_star->scheduler.num_workers; i++)
+  {
+    a_star->scheduler.workers[i].cpu = -1;
+  }
+
+  if(policy == AFFINITY_NONE)
+  {
+    return;
+  }
+
+  // A topologia apenas é lida uma vez por instância
+  if(a_star->topology == NULL)
+  {
+    a_star->topology = cpu_topology_create();
+    if(a_star->topology == NULL)
+    {
+      a_star->affinity = AFFINITY_NONE;
+      return;
+    }
+  }
+
+  int mapping[a_star->scheduler.num_workers];
+  cpu_topology_map(a_star->topology, policy, a_star->scheduler.num_workers, mapping);
+  for(size_t i = 0; i < a_star->scheduler.num_workers; i++)
+  {
+    a_star->scheduler.workers[i].cpu = mapping[i];
+
+    // As tarefas da reserva já existem, fixamos já no novo CPU
+    if(a_star->pool_started)
+    {
+      cpu_topology_pin(a_star->scheduler.workers[i].thread, a_star->topology->cpus[mapping[i]].cpu);
+    }
+  }
+}
+
+// Ativa a fase de aquecimento, que gera nodes_per_worker nós por trabalhador antes da procura paralela
+void a_star_parallel_set_warmup(a_star_parallel_t* a_star, size_t nodes_per_worker)
+{
+  if(a_star == NULL)
+  {
+    return;
+  }
+
+  a_star->warmup_factor = nodes_per_worker;
+}
+
+// Define quantos nós cada trabalhador expande por iteração, no modo adaptativo batch_size é o máximo
+void a_star_parallel_set_batch(a_star_parallel_t* a_star, size_t batch_size, bool adaptive)
+{
+  if(a_star == NULL)
+  {
+    return;
+  }
+
+  a_star->batch_size = batch_size < 1 ? 1 : batch_size;
+  a_star->batch_adaptive = adaptive;
+}
+
 // Liberta uma instância do algoritmo A*
 void a_star_parallel_destroy(a_star_parallel_t* a_star)
 {
@@ -337,6 +730,24 @@ void a_star_parallel_destroy(a_star_parallel_t* a_star)
     return;
   }
 
+  // Acordamos os trabalhadores estacionados para que terminem
+  if(a_star->pool_started)
+  {
+    pthread_mutex_lock(&a_star->pool_lock);
+    a_star->shutdown = true;
+    pthread_cond_broadcast(&a_star->pool_wake);
+    pthread_mutex_unlock(&a_star->pool_lock);
+
+    for(size_t i = 0; i < a_star->scheduler.num_workers; i++)
+    {
+      pthread_join(a_star->scheduler.workers[i].thread, NULL);
+    }
+  }
+  pthread_cond_destroy(&a_star->pool_wake);
+  pthread_cond_destroy(&a_star->pool_done);
+  pthread_mutex_destroy(&a_star->pool_lock);
+  pthread_mutex_destroy(&a_star->lock);
+
   // Limpamos os nosso trabalhadores e canal de comunicação
   if(a_star->scheduler.workers != NULL)
   {
@@ -347,6 +758,7 @@ void a_star_parallel_destroy(a_star_parallel_t* a_star)
     free(a_star->scheduler.workers);
   }
   channel_destroy(a_star->channel);
+  cpu_topology_destroy(a_star->topology);
 
   // Invocamos o destroy da parte comum
   a_star_destroy(a_star->common);
@@ -363,6 +775,13 @@ void a_star_parallel_solve(a_star_parallel_t* a_star, void* initial, void* goal)
     return;
   }
 
+  // A instância já foi utilizada, limpamos a procura anterior
+  if(a_star->solved && !a_star_parallel_reset(a_star))
+  {
+    return;
+  }
+  a_star->solved = true;
+
   // Guarda os nossos estados inicial e objetivo
   state_t* initial_state = state_allocator_new(a_star->common->state_allocator, initial);
 
@@ -383,85 +802,79 @@ void a_star_parallel_solve(a_star_parallel_t* a_star, void* initial, void* goal)
     }
   }
 
-  // Com recurso a esta variável podemos enviar uma mensagem para os nossos trabalhadores
-  // pararem
-  a_star->running = true;
-  // Iniciamos cada trabalhador
+  // Na primeira procura criamos as tarefas da reserva
+  if(!a_star->pool_started && !a_star_parallel_start_workers(a_star))
+  {
+    return;
+  }
+
+  // Reiniciamos as estatísticas dos trabalhadores
   for(size_t i = 0; i < a_star->scheduler.num_workers; i++)
   {
-    a_star->scheduler.workers[i].idle = false;
-    int result =
-        pthread_create(&(a_star->scheduler.workers[i].thread), NULL, a_star_worker_function, &(a_star->scheduler.workers[i]));
-    if(result != 0)
-    {
-      return;
-    }
+    a_star_worker_t* worker = &(a_star->scheduler.workers[i]);
+    worker->generated = 0;
+    worker->expanded = 0;
+    worker->max_min_heap_size = 0;
+    worker->nodes_new = 0;
+    worker->nodes_reinserted = 0;
+    worker->paths_better = 0;
+    worker->paths_worst_or_equals = 0;
+    worker->seeded = 0;
+    worker->batches = 0;
   }
-  a_star_message_t message = { NULL, initial_state };
-  size_t worker_id = assign_to_worker(a_star, message.state);
-  // Enviamos o estado inicial para o respetivo trabalhador
-  channel_send(a_star->channel, worker_id, (void*)&message);
+  a_star->warmup_time = 0;
 
-  // Ciclo de execução que espera pela solução ou que todos os trabalhadores fiquem
-  // sem nós para processar
   clock_gettime(CLOCK_MONOTONIC, &(a_star->common->start_time));
-  int idle_tries = MAX_IDLE_TIME;
 #ifdef STATS_GEN
   search_data_start();
 #endif
-  while(a_star->running)
-  {
-#ifdef STATS_GEN
-    search_data_tick();
-#endif
-    // Solução já foi encontrada e queremos sair à primeira solução
-    if(a_star->common->solution != NULL && a_star->stop_on_first_solution)
-    {
-      clock_gettime(CLOCK_MONOTONIC, &(a_star->common->end_time));
-      a_star->running = false;
-      break;
-    }
-
-    // Verificamos quantos workers estão ociosos, caso todos estejam ociosos assumimos que não existem mais nós a explorar
-    // ou a solução já foi encontrada
-    size_t idle_workers = 0;
-    for(size_t i = 0; i < a_star->scheduler.num_workers; i++)
-    {
-
-      a_star_worker_t* worker = &(a_star->scheduler.workers[i]);
 
-      if(!worker->idle)
-      {
-        idle_tries = MAX_IDLE_TIME;
-        continue;
-      }
+  bool finished = false;
+  if(a_star->warmup_factor > 0)
+  {
+    // A fase de aquecimento envia a fronteira inicial aos trabalhadores
+    finished = a_star_parallel_warmup(a_star, initial_state);
+  }
+  else
+  {
+    // O estado inicial é o único trabalho pendente
+    atomic_store(&a_star->pending, 1);
 
-      idle_workers++;
-    }
+    a_star_message_t message = { NULL, initial_state };
+    size_t worker_id = assign_to_worker(a_star, message.state);
+    // Enviamos o estado inicial para o respetivo trabalhador
+    channel_send(a_star->channel, worker_id, (void*)&message);
+  }
 
-    if(idle_workers == a_star->scheduler.num_workers)
+  // Acordamos os trabalhadores e esperamos que todos terminem a procura, ou porque ficaram
+  // sem trabalho pendente ou porque foi encontrada a primeira solução
+  if(!finished)
+  {
+    // Com recurso a esta variável podemos enviar uma mensagem para os nossos trabalhadores pararem
+    atomic_store(&a_star->running, true);
+
+    pthread_mutex_lock(&a_star->pool_lock);
+    a_star->workers_done = 0;
+    a_star->generation++;
+    pthread_cond_broadcast(&a_star->pool_wake);
+    while(a_star->workers_done < a_star->scheduler.num_workers)
     {
-      if(idle_tries == MAX_IDLE_TIME)
-      {
-        clock_gettime(CLOCK_MONOTONIC, &(a_star->common->end_time));
-      }
-      idle_tries--;
+#ifdef STATS_GEN
+      // O tempo da recolha de dados avança enquanto os trabalhadores procuram
+      pthread_mutex_unlock(&a_star->pool_lock);
+      search_data_tick();
+      pthread_mutex_lock(&a_star->pool_lock);
+#else
+      pthread_cond_wait(&a_star->pool_done, &a_star->pool_lock);
+#endif
     }
+    pthread_mutex_unlock(&a_star->pool_lock);
+  }
 
-    if(idle_tries <= 0)
-    {
-      a_star->running = false;
-      break;
-    }
+  atomic_store(&a_star->running, false);
+  a_star->common->cancelled = a_star_cancel_requested(a_star->common);
+  clock_gettime(CLOCK_MONOTONIC, &(a_star->common->end_time));
 
-    // O algoritmo deve continuar a correr enquanto houver trabalhadores que não estejam ociosos
-    a_star->running = true;
-  }
-  // Esperamos que todas os trabalhadores terminem
-  for(size_t i = 0; i < a_star->scheduler.num_workers; i++)
-  {
-    pthread_join(a_star->scheduler.workers[i].thread, NULL);
-  }
   // Calculamos o tempo de execução e outras estatísticas
   for(size_t i = 0; i < a_star->scheduler.num_workers; i++)
   {
@@ -501,6 +914,19 @@ void a_star_parallel_print_statistics(a_star_parallel_t* a_star, bool csv, bool
     {
       printf("Método: Melhor solução\n");
     }
+    printf("Afinidade: %s\n", affinity_to_str(a_star->affinity));
+    if(a_star->batch_adaptive)
+    {
+      printf("Lotes: adaptativo, máximo %ld nós por iteração\n", a_star->batch_size);
+    }
+    else if(a_star->batch_size > 1)
+    {
+      printf("Lotes: %ld nós por iteração\n", a_star->batch_size);
+    }
+    if(a_star->warmup_factor > 0)
+    {
+      printf("Aquecimento: %ld nós por trabalhador, tempo: %.6f s\n", a_star->warmup_factor, a_star->warmup_time);
+    }
   }
 
   a_star_print_statistics(a_star->common, csv, false);
@@ -521,6 +947,21 @@ void a_star_parallel_print_statistics(a_star_parallel_t* a_star, bool csv, bool
              a_star->scheduler.workers[i].nodes_reinserted,
              a_star->scheduler.workers[i].paths_worst_or_equals,
              a_star->scheduler.workers[i].paths_better);
+      if(a_star->batch_adaptive || a_star->batch_size > 1)
+      {
+        printf("  * Lotes: %d, Nós por lote (média): %.2f\n",
+               a_star->scheduler.workers[i].batches,
+               a_star->scheduler.workers[i].batches ? (double)a_star->scheduler.workers[i].expanded / a_star->scheduler.workers[i].batches : 0.0);
+      }
+      if(a_star->warmup_factor > 0)
+      {
+        printf("  * Nós recebidos no aquecimento: %d\n", a_star->scheduler.workers[i].seeded);
+      }
+      if(a_star->scheduler.workers[i].cpu >= 0)
+      {
+        cpu_info_t* info = &(a_star->topology->cpus[a_star->scheduler.workers[i].cpu]);
+        printf("  * CPU: %d (núcleo %d, pacote %d)\n", info->cpu, info->core, info->package);
+      }
     }
   }
 }
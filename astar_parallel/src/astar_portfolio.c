@@ -0,0 +1,302 @@
+#include "astar_portfolio.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// Configurações conhecidas pelo portfólio
+static const a_star_portfolio_config_t portfolio_known_configs[] = {
+  { "seq", false, false, TIE_BREAK_NONE, 1 },
+  { "seq-deep", false, false, TIE_BREAK_DEEP, 1 },
+  { "par", true, false, TIE_BREAK_NONE, 1 },
+  { "par-first", true, true, TIE_BREAK_NONE, 1 },
+  { "par-deep", true, false, TIE_BREAK_DEEP, 1 },
+};
+
+// Portfólio utilizado quando não são indicadas configurações
+#define PORTFOLIO_AUTO "seq,par-first,par-deep"
+
+// Converte uma lista de nomes separados por vírgulas em configurações
+bool a_star_portfolio_parse(const char* spec, a_star_portfolio_config_t* configs, size_t* num_configs)
+{
+  if(strcmp(spec, "auto") == 0)
+  {
+    spec = PORTFOLIO_AUTO;
+  }
+
+  char buffer[256];
+  strncpy(buffer, spec, sizeof(buffer) - 1);
+  buffer[sizeof(buffer) - 1] = '\0';
+
+  *num_configs = 0;
+  char* saveptr = NULL;
+  for(char* name = strtok_r(buffer, ",", &saveptr); name != NULL; name = strtok_r(NULL, ",", &saveptr))
+  {
+    if(*num_configs == PORTFOLIO_MAX_CONFIGS)
+    {
+      return false;
+    }
+
+    bool found = false;
+    for(size_t i = 0; i < sizeof(portfolio_known_configs) / sizeof(portfolio_known_configs[0]); i++)
+    {
+      if(strcmp(name, portfolio_known_configs[i].name) == 0)
+      {
+        configs[(*num_configs)++] = portfolio_known_configs[i];
+        found = true;
+        break;
+      }
+    }
+
+    if(!found)
+    {
+      return false;
+    }
+  }
+
+  return *num_configs > 0;
+}
+
+// Liberta as procuras da última execução
+static void a_star_portfolio_clean(a_star_portfolio_t* portfolio)
+{
+  for(size_t i = 0; i < portfolio->num_configs; i++)
+  {
+    a_star_portfolio_runner_t* runner = &portfolio->runners[i];
+    a_star_sequential_destroy(runner->sequential);
+    a_star_parallel_destroy(runner->parallel);
+    runner->sequential = NULL;
+    runner->parallel = NULL;
+    runner->common = NULL;
+  }
+}
+
+// Função executada pela tarefa de cada configuração
+static void* a_star_portfolio_run(void* arg)
+{
+  a_star_portfolio_runner_t* runner = (a_star_portfolio_runner_t*)arg;
+  a_star_portfolio_t* portfolio = runner->portfolio;
+  a_star_portfolio_config_t* config = &portfolio->configs[runner->index];
+
+  if(config->parallel)
+  {
+    a_star_parallel_solve(runner->parallel, portfolio->initial, portfolio->goal);
+  }
+  else
+  {
+    a_star_sequential_solve(runner->sequential, portfolio->initial, portfolio->goal);
+  }
+
+  // A primeira configuração a provar o resultado vence e cancela as restantes
+  pthread_mutex_lock(&portfolio->lock);
+  runner->finish_order = portfolio->finished++;
+  if(!runner->common->cancelled && !config->stop_on_first_solution && portfolio->winner < 0)
+  {
+    portfolio->winner = (int)runner->index;
+    atomic_store(&portfolio->cancel, true);
+  }
+  pthread_mutex_unlock(&portfolio->lock);
+
+  return NULL;
+}
+
+// Cria um portfólio com as configurações indicadas e um orçamento de núcleos
+a_star_portfolio_t* a_star_portfolio_create(size_t struct_size,
+                                            goal_function goal_func,
+                                            visit_function visit_func,
+                                            heuristic_function h_func,
+                                            distance_function d_func,
+                                            print_function print_func,
+                                            const a_star_portfolio_config_t* configs,
+                                            size_t num_configs,
+                                            size_t core_budget)
+{
+  if(num_configs == 0 || num_configs > PORTFOLIO_MAX_CONFIGS)
+  {
+    return NULL;
+  }
+
+  a_star_portfolio_t* portfolio = (a_star_portfolio_t*)calloc(1, sizeof(a_star_portfolio_t));
+  if(portfolio == NULL)
+  {
+    return NULL; // Erro de alocação
+  }
+
+  portfolio->struct_size = struct_size;
+  portfolio->goal_func = goal_func;
+  portfolio->visit_func = visit_func;
+  portfolio->h_func = h_func;
+  portfolio->d_func = d_func;
+  portfolio->print_func = print_func;
+  portfolio->num_configs = num_configs;
+  portfolio->core_budget = core_budget < 1 ? 1 : core_budget;
+  portfolio->winner = -1;
+  atomic_init(&portfolio->cancel, false);
+  pthread_mutex_init(&portfolio->lock, NULL);
+  memcpy(portfolio->configs, configs, num_configs * sizeof(a_star_portfolio_config_t));
+
+  // Cada configuração sequencial ocupa um núcleo, os restantes são divididos pelas paralelas
+  size_t num_sequential = 0;
+  for(size_t i = 0; i < num_configs; i++)
+  {
+    if(!configs[i].parallel)
+      num_sequential++;
+  }
+
+  size_t num_parallel = num_configs - num_sequential;
+  size_t remaining = portfolio->core_budget > num_sequential ? portfolio->core_budget - num_sequential : 0;
+  int workers_per_config = num_parallel > 0 && remaining / num_parallel > 1 ? (int)(remaining / num_parallel) : 1;
+  for(size_t i = 0; i < num_configs; i++)
+  {
+    portfolio->configs[i].num_workers = portfolio->configs[i].parallel ? workers_per_config : 1;
+  }
+
+  return portfolio;
+}
+
+// Liberta o portfólio e as procuras da última execução
+void a_star_portfolio_destroy(a_star_portfolio_t* portfolio)
+{
+  if(portfolio == NULL)
+  {
+    return;
+  }
+
+  a_star_portfolio_clean(portfolio);
+  pthread_mutex_destroy(&portfolio->lock);
+  free(portfolio);
+}
+
+// Resolve o problema com todas as configurações em simultâneo
+void a_star_portfolio_solve(a_star_portfolio_t* portfolio, void* initial, void* goal)
+{
+  if(portfolio == NULL)
+  {
+    return;
+  }
+
+  // As procuras sequenciais não podem ser reutilizadas, criamos novas procuras em cada execução
+  a_star_portfolio_clean(portfolio);
+  atomic_store(&portfolio->cancel, false);
+  portfolio->finished = 0;
+  portfolio->winner = -1;
+  portfolio->initial = initial;
+  portfolio->goal = goal;
+
+  for(size_t i = 0; i < portfolio->num_configs; i++)
+  {
+    a_star_portfolio_config_t* config = &portfolio->configs[i];
+    a_star_portfolio_runner_t* runner = &portfolio->runners[i];
+    runner->portfolio = portfolio;
+    runner->index = i;
+    runner->finish_order = -1;
+
+    if(config->parallel)
+    {
+      runner->parallel = a_star_parallel_create(portfolio->struct_size,
+                                                portfolio->goal_func,
+                                                portfolio->visit_func,
+                                                portfolio->h_func,
+                                                portfolio->d_func,
+                                                portfolio->print_func,
+                                                config->num_workers,
+                                                config->stop_on_first_solution);
+      runner->common = runner->parallel != NULL ? runner->parallel->common : NULL;
+    }
+    else
+    {
+      runner->sequential = a_star_sequential_create(portfolio->struct_size,
+                                                    portfolio->goal_func,
+                                                    portfolio->visit_func,
+                                                    portfolio->h_func,
+                                                    portfolio->d_func,
+                                                    portfolio->print_func);
+      runner->common = runner->sequential != NULL ? runner->sequential->common : NULL;
+    }
+
+    if(runner->common == NULL)
+    {
+      a_star_portfolio_clean(portfolio);
+      return;
+    }
+
+    a_star_set_tie_breaker(runner->common, config->tie_breaker);
+    a_star_set_cancel(runner->common, &portfolio->cancel);
+  }
+
+  struct timespec start_time, end_time;
+  clock_gettime(CLOCK_MONOTONIC, &start_time);
+
+  size_t started = 0;
+  for(; started < portfolio->num_configs; started++)
+  {
+    a_star_portfolio_runner_t* runner = &portfolio->runners[started];
+    if(pthread_create(&runner->thread, NULL, a_star_portfolio_run, runner) != 0)
+    {
+      // Cancelamos as configurações que já foram lançadas
+      atomic_store(&portfolio->cancel, true);
+      break;
+    }
+  }
+
+  for(size_t i = 0; i < started; i++)
+  {
+    pthread_join(portfolio->runners[i].thread, NULL);
+  }
+
+  clock_gettime(CLOCK_MONOTONIC, &end_time);
+  portfolio->execution_time = (end_time.tv_sec - start_time.tv_sec);
+  portfolio->execution_time += (end_time.tv_nsec - start_time.tv_nsec) / 1000000000.0;
+
+  // Nenhuma configuração provou o resultado, vence a primeira que terminou sem ser cancelada
+  if(portfolio->winner < 0)
+  {
+    for(size_t i = 0; i < started; i++)
+    {
+      a_star_portfolio_runner_t* runner = &portfolio->runners[i];
+      if(runner->common->cancelled)
+        continue;
+      if(portfolio->winner < 0 || runner->finish_order < portfolio->runners[portfolio->winner].finish_order)
+        portfolio->winner = (int)i;
+    }
+  }
+}
+
+// Imprime a configuração vencedora e as estatísticas da sua procura
+void a_star_portfolio_print_statistics(a_star_portfolio_t* portfolio, bool csv, bool show_solution)
+{
+  if(portfolio == NULL || portfolio->winner < 0)
+  {
+    return;
+  }
+
+  a_star_portfolio_runner_t* winner = &portfolio->runners[portfolio->winner];
+
+  if(!csv && !show_solution)
+  {
+    printf("Portfólio: %ld configurações, orçamento: %ld núcleos, tempo total: %.6f s\n",
+           portfolio->num_configs,
+           portfolio->core_budget,
+           portfolio->execution_time);
+    for(size_t i = 0; i < portfolio->num_configs; i++)
+    {
+      a_star_portfolio_runner_t* runner = &portfolio->runners[i];
+      a_star_portfolio_config_t* config = &portfolio->configs[i];
+      printf("- %s (%d trabalhadores): %s", config->name, config->num_workers, runner->common->cancelled ? "cancelada" : "terminou");
+      if(runner->common->solution != NULL)
+      {
+        printf(", custo: %d", runner->common->solution->g);
+      }
+      printf(", estados expandidos: %d, tempo: %.6f s\n", runner->common->expanded, runner->common->execution_time);
+    }
+    printf("Vencedor: %s\n", portfolio->configs[portfolio->winner].name);
+  }
+
+  if(winner->parallel != NULL)
+  {
+    a_star_parallel_print_statistics(winner->parallel, csv, show_solution);
+  }
+  else
+  {
+    a_star_sequential_print_statistics(winner->sequential, csv, show_solution);
+  }
+}
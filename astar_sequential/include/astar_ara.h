@@ -0,0 +1,98 @@
+/*
+   Algoritmo ARA* (A* ponderado incremental)
+
+   Versão "anytime" do A* sequencial: a primeira procura utiliza a prioridade g + w * h com um
+   peso w > 1, o que encontra rapidamente uma solução com custo no máximo w vezes o ótimo. Depois
+   de cada solução o peso é reduzido e a procura continua sobre a mesma árvore de procura, em vez
+   de recomeçar do estado inicial, até o peso chegar a 1 e a solução ser provadamente ótima.
+
+   - Os nós expandidos na iteração atual formam a lista fechada. Um nó fechado que recebe um
+     caminho melhor não volta à lista aberta, fica na lista de inconsistentes até à próxima
+     iteração, o que garante que cada nó é expandido no máximo uma vez por iteração.
+   - No fim de cada iteração é calculado o limite de sub-otimalidade da melhor solução:
+     min(w, custo / min(g + h)) sobre os nós abertos e inconsistentes.
+   - Cada solução melhor é registada com o peso, o limite e o instante em que foi encontrada, e
+     contabilizada nas estatísticas comuns (num_solutions, num_better_solutions, ...).
+   - Com um limite de tempo (ou um pedido de cancelamento) a procura termina com a melhor solução
+     encontrada até esse momento e o respetivo limite.
+
+   As prioridades dos nós são inteiras: o peso é representado em centésimas (ARA_WEIGHT_SCALE).
+*/
+#ifndef ASTAR_ARA_H
+#define ASTAR_ARA_H
+#include "astar.h"
+#include "min_heap.h"
+#include "state.h"
+#include <stdbool.h>
+#include <stddef.h>
+
+// Escala do peso da heurística nas prioridades dos nós
+#define ARA_WEIGHT_SCALE 100
+
+// Redução do peso por omissão depois de cada iteração
+#define ARA_DEFAULT_WEIGHT_STEP 0.5
+
+// Número máximo de soluções registadas
+#define ARA_MAX_SOLUTIONS 64
+
+typedef struct a_star_ara_t a_star_ara_t;
+
+// Registo de uma solução melhor encontrada durante a procura
+typedef struct
+{
+  int cost;
+  double weight; // Peso da iteração que a encontrou
+  double bound; // Limite de sub-otimalidade no fim da iteração
+  double time; // Segundos desde o início da procura
+} a_star_ara_solution_t;
+
+// Estrutura que contem o estado do algoritmo ARA*
+struct a_star_ara_t
+{
+  // Informação comum do nosso algoritmo
+  a_star_t* common;
+
+  // Lista aberta (com reinserção preguiçosa), nós fechados na iteração e nós inconsistentes
+  min_heap_t* open_set;
+  linked_list_t* closed;
+  linked_list_t* incons;
+
+  // Escalonamento do peso e limite de tempo (0 sem limite)
+  double initial_weight;
+  double weight_step;
+  double time_limit;
+  int weight; // Peso da iteração atual em centésimas
+
+  // Soluções encontradas e limite de sub-otimalidade atual
+  a_star_ara_solution_t solutions[ARA_MAX_SOLUTIONS];
+  size_t num_solutions;
+  double bound;
+  int iterations;
+  bool timed_out;
+};
+
+// Cria uma nova instância do algoritmo ARA* com o peso inicial indicado (>= 1)
+a_star_ara_t* a_star_ara_create(size_t struct_size,
+                                goal_function goal_func,
+                                visit_function visit_func,
+                                heuristic_function h_func,
+                                distance_function d_func,
+                                print_function print_func,
+                                double initial_weight);
+
+// Define a redução do peso entre iterações
+void a_star_ara_set_weight_step(a_star_ara_t* a_star, double weight_step);
+
+// Define o tempo máximo da procura em segundos (0 sem limite)
+void a_star_ara_set_time_limit(a_star_ara_t* a_star, double seconds);
+
+// Liberta uma instância do algoritmo ARA*
+void a_star_ara_destroy(a_star_ara_t* a_star);
+
+// Resolve o problema através do uso do algoritmo ARA*
+void a_star_ara_solve(a_star_ara_t* a_star, void* initial, void* goal);
+
+// Imprime estatísticas sobre o algoritmo ARA*
+void a_star_ara_print_statistics(a_star_ara_t* a_star, bool csv, bool show_solution);
+
+#endif // ASTAR_ARA_H
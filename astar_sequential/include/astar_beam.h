@@ -0,0 +1,82 @@
+/*
+   Procura em Feixe (Beam Search)
+
+   Versão não ótima do A* para respostas rápidas em instâncias grandes: a procura avança camada a
+   camada e de cada camada ficam apenas os W melhores nós (a largura do feixe).
+
+   - Os sucessores de todos os nós da camada são candidatos à camada seguinte. Os W melhores, por f
+     e desempatando pelo menor h, são escolhidos com uma seleção parcial sobre os candidatos (os
+     restantes não são ordenados).
+   - Os nós escolhidos são guardados nos gestores da parte comum, com o pai para a recuperação do
+     caminho, pelo que a memória é O(W x profundidade) e o trabalho de cada camada é
+     O(W x ramificação). Um sucessor que já esteve no feixe é descartado, o que impede ciclos e
+     garante que a procura termina num espaço de estados finito.
+   - A procura termina ao gerar o primeiro objetivo (o de menor g da camada) ou quando uma camada
+     fica vazia. A solução não é necessariamente ótima e podem não ser encontradas soluções que
+     existem, a largura controla o compromisso entre qualidade, tempo e memória.
+
+   A solução é o caminho de nós da parte comum, pelo que é impressa como no A* sequencial.
+*/
+#ifndef ASTAR_BEAM_H
+#define ASTAR_BEAM_H
+#include "astar.h"
+#include "state.h"
+#include <stdbool.h>
+#include <stddef.h>
+
+typedef struct a_star_beam_t a_star_beam_t;
+
+// Sucessor candidato à próxima camada, o estado está na posição data_index dos candidatos
+typedef struct
+{
+  a_star_node_t* parent;
+  int g;
+  int h;
+  size_t data_index;
+} a_star_beam_candidate_t;
+
+// Estrutura que contem o estado da procura em feixe
+struct a_star_beam_t
+{
+  // Informação comum do nosso algoritmo
+  a_star_t* common;
+
+  // Largura do feixe e nós da camada atual
+  size_t width;
+  a_star_node_t** layer;
+  size_t layer_size;
+
+  // Gestor temporário e candidatos da camada em construção
+  state_allocator_t* scratch;
+  linked_list_t* neighbors;
+  a_star_beam_candidate_t* candidates;
+  char* candidate_data;
+  size_t num_candidates;
+  size_t candidates_capacity;
+
+  // Informação estatística
+  int depth;
+  size_t max_candidates;
+  long candidates_discarded;
+  long duplicates_removed;
+};
+
+// Cria uma nova instância da procura em feixe com a largura indicada
+a_star_beam_t* a_star_beam_create(size_t struct_size,
+                                  goal_function goal_func,
+                                  visit_function visit_func,
+                                  heuristic_function h_func,
+                                  distance_function d_func,
+                                  print_function print_func,
+                                  size_t width);
+
+// Liberta uma instância da procura em feixe
+void a_star_beam_destroy(a_star_beam_t* a_star);
+
+// Resolve o problema através da procura em feixe
+void a_star_beam_solve(a_star_beam_t* a_star, void* initial, void* goal);
+
+// Imprime estatísticas sobre a procura em feixe
+void a_star_beam_print_statistics(a_star_beam_t* a_star, bool csv, bool show_solution);
+
+#endif // ASTAR_BEAM_H
@@ -0,0 +1,80 @@
+/*
+   Algoritmo A* Bidirecional (MM)
+
+   Procura em simultâneo a partir do estado inicial (para a frente) e a partir do estado objetivo
+   (para trás) e termina quando as duas procuras se encontram com um custo provadamente ótimo.
+   Segue o algoritmo MM: a prioridade de um nó é max(g + h, 2g), o que garante que nenhuma das
+   procuras vai além de metade do custo da solução, e expande-se sempre a direção com a menor
+   prioridade. A procura termina quando o custo do melhor encontro U é menor ou igual à menor
+   prioridade das duas listas abertas.
+
+   - Os estados são guardados uma única vez no gestor de estados comum, cada direção tem o seu
+     gestor de nós (com o seu custo g e o seu pai). Um encontro é detetado quando um estado gerado
+     numa direção já tem nó na outra.
+   - Só é aplicável a problemas com um estado objetivo explícito, indicado em `goal`.
+   - A procura para trás utiliza a função de vizinhos inversa e a heurística inversa (distância de
+     um estado ao estado inicial), indicadas com `a_star_bidirectional_set_reverse`. Por omissão
+     é utilizada a função de vizinhos da procura para a frente (problemas não dirigidos) e uma
+     heurística nula.
+   - No fim o caminho da procura para trás é invertido e ligado ao caminho da procura para a
+     frente, pelo que a solução é impressa como no A* sequencial.
+*/
+#ifndef ASTAR_BIDIRECTIONAL_H
+#define ASTAR_BIDIRECTIONAL_H
+#include "astar.h"
+#include "min_heap.h"
+#include "state.h"
+#include <stdbool.h>
+#include <stddef.h>
+
+typedef struct a_star_bidirectional_t a_star_bidirectional_t;
+
+// Estrutura que contem o estado do algoritmo A* bidirecional
+struct a_star_bidirectional_t
+{
+  // Informação comum do nosso algoritmo, os nós da procura para a frente ficam no gestor comum
+  a_star_t* common;
+
+  // Procura para trás: nós, funções inversas e estado onde termina
+  node_allocator_t* backward_nodes;
+  visit_function reverse_visit_func;
+  heuristic_function reverse_h_func;
+  state_t* initial_state;
+
+  // Listas abertas das duas direções (com reinserção preguiçosa)
+  min_heap_t* open_forward;
+  min_heap_t* open_backward;
+
+  // Melhor encontro entre as duas procuras
+  int best_cost;
+  state_t* meeting;
+
+  // Informação estatística de cada direção
+  int expanded_forward;
+  int expanded_backward;
+};
+
+// Cria uma nova instância do algoritmo A* bidirecional para resolver um problema
+a_star_bidirectional_t* a_star_bidirectional_create(size_t struct_size,
+                                                    goal_function goal_func,
+                                                    visit_function visit_func,
+                                                    heuristic_function h_func,
+                                                    distance_function d_func,
+                                                    print_function print_func);
+
+// Define a função de vizinhos inversa (NULL: a mesma da procura para a frente) e a heurística
+// inversa, que recebe o estado e o estado inicial (NULL: heurística nula)
+void a_star_bidirectional_set_reverse(a_star_bidirectional_t* a_star,
+                                      visit_function reverse_visit_func,
+                                      heuristic_function reverse_h_func);
+
+// Liberta uma instância do algoritmo A* bidirecional
+void a_star_bidirectional_destroy(a_star_bidirectional_t* a_star);
+
+// Resolve o problema entre o estado inicial e o estado objetivo (obrigatório)
+void a_star_bidirectional_solve(a_star_bidirectional_t* a_star, void* initial, void* goal);
+
+// Imprime estatísticas sobre o algoritmo bidirecional
+void a_star_bidirectional_print_statistics(a_star_bidirectional_t* a_star, bool csv, bool show_solution);
+
+#endif // ASTAR_BIDIRECTIONAL_H
@@ -0,0 +1,120 @@
+/*
+   Algoritmo A* em Memória Externa
+
+   Versão do A* para problemas em que as listas aberta e fechada não cabem em memória. Os nós são
+   agrupados em baldes pelo par (g, h) e cada balde é guardado em disco num ficheiro sequencial.
+
+   - Os baldes são expandidos por ordem de f = g + h e, dentro do mesmo f, por ordem de g. Um balde
+     só recebe nós de baldes com g menor, pelo que está completo quando é expandido.
+   - Não existe tabela de estados: os duplicados são removidos em bloco quando o balde é expandido,
+     ordenando os seus estados e subtraindo os estados dos baldes fechados (g - 1, h) e (g - 2, h).
+     Num problema não dirigido de custo unitário com heurística consistente um estado repetido só
+     pode aparecer nestes baldes, noutros problemas podem ficar duplicados por remover (a solução
+     continua ótima, com mais expansões). A heurística tem de ser consistente, os nós gerados
+     para um balde já expandido são descartados.
+   - Os nós são escritos num buffer de memória por balde e passam para o ficheiro do balde quando
+     o buffer enche, pelo que todas as leituras e escritas são de blocos grandes. Um balde é lido
+     por inteiro para memória quando é expandido, o maior balde tem de caber em memória.
+   - Os estados expandidos são acrescentados a um ficheiro de registo com o pai e o custo g. No
+     fim o caminho é recuperado percorrendo esse ficheiro uma única vez, do fim para o início.
+
+   Os estados são os bytes de `state_t::data`, copiados tal como estão, o que exige que o estado não
+   dependa de memória libertada durante a procura. O caminho final é convertido em estados e nós da
+   parte comum, pelo que a solução é impressa como no A* sequencial.
+*/
+#ifndef ASTAR_EXTERNAL_H
+#define ASTAR_EXTERNAL_H
+#include "astar.h"
+#include "state.h"
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdio.h>
+
+// Tamanho por omissão do buffer de escrita de cada balde (em bytes)
+#define EXTERNAL_BUFFER_SIZE (4 * 1024 * 1024)
+
+typedef struct a_star_external_t a_star_external_t;
+typedef struct a_star_external_bucket_t a_star_external_bucket_t;
+
+// Balde de nós com o mesmo custo g e heurística h
+struct a_star_external_bucket_t
+{
+  a_star_external_bucket_t* next; // Próximo balde na mesma posição da tabela
+  a_star_external_bucket_t* next_closed; // Próximo balde fechado, pela ordem de expansão
+  int g;
+  int h;
+  bool closed; // Já expandido, contém os estados ordenados sem duplicados
+  char* buffer; // Registos ainda por escrever no ficheiro
+  size_t used;
+  size_t capacity;
+  size_t disk_bytes; // Bytes já escritos no ficheiro do balde
+};
+
+// Estrutura que contem o estado do algoritmo A* em memória externa
+struct a_star_external_t
+{
+  // Informação comum do nosso algoritmo
+  a_star_t* common;
+
+  // Gestor temporário de estados para os vizinhos gerados
+  state_allocator_t* scratch;
+  linked_list_t* neighbors;
+
+  // Diretório dos ficheiros da procura e tamanho do buffer de cada balde
+  char* directory;
+  char* work_directory;
+  size_t buffer_size;
+
+  // Tabela de baldes e lista de baldes por expandir, ordenada por (f, g)
+  a_star_external_bucket_t** buckets;
+  size_t num_buckets;
+  a_star_external_bucket_t** open;
+  size_t open_size;
+  size_t open_capacity;
+
+  // Baldes fechados pela ordem de expansão, libertados quando deixam de ser precisos
+  a_star_external_bucket_t* closed_first;
+  a_star_external_bucket_t* closed_last;
+
+  // Registo dos estados expandidos, com o pai de cada estado
+  FILE* trace;
+  size_t trace_records;
+
+  // A procura foi interrompida por falta de memória ou erro de leitura/escrita em disco
+  bool failed;
+
+  // Informação estatística
+  size_t disk_in_use;
+  size_t max_disk_in_use;
+  size_t bytes_written;
+  size_t bytes_read;
+  size_t max_layer_io;
+  size_t layer_io_start;
+  int num_layers;
+  int files_created;
+  long duplicates_removed;
+};
+
+// Cria uma nova instância do algoritmo A* em memória externa, com os ficheiros no diretório indicado
+// (NULL: a variável de ambiente TMPDIR ou /tmp)
+a_star_external_t* a_star_external_create(size_t struct_size,
+                                          goal_function goal_func,
+                                          visit_function visit_func,
+                                          heuristic_function h_func,
+                                          distance_function d_func,
+                                          print_function print_func,
+                                          const char* directory);
+
+// Define o tamanho do buffer de escrita de cada balde
+void a_star_external_set_buffer_size(a_star_external_t* a_star, size_t buffer_size);
+
+// Liberta uma instância do algoritmo A* em memória externa
+void a_star_external_destroy(a_star_external_t* a_star);
+
+// Resolve o problema através do uso do algoritmo A* em memória externa
+void a_star_external_solve(a_star_external_t* a_star, void* initial, void* goal);
+
+// Imprime estatísticas sobre o algoritmo A* em memória externa
+void a_star_external_print_statistics(a_star_external_t* a_star, bool csv, bool show_solution);
+
+#endif // ASTAR_EXTERNAL_H
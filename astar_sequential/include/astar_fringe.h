@@ -0,0 +1,74 @@
+/*
+   Algoritmo Fringe Search
+
+   Alternativa ao A* sem fila prioritária: a fronteira é uma lista duplamente ligada percorrida em
+   passagens sucessivas com um limite de f, como no IDA*, mas sem repetir o trabalho das iterações
+   anteriores porque os nós ficam guardados.
+
+   - Em cada passagem a lista é percorrida do início para o fim. Um nó com f acima do limite fica
+     na lista para a próxima passagem (parte "depois"), um nó dentro do limite é expandido e os
+     filhos são inseridos logo a seguir a ele, pelo que ainda são visitados na passagem atual
+     (parte "agora").
+   - No fim da passagem o limite sobe para o menor f que ficou acima do limite.
+   - Os nós e os estados são os dos gestores da parte comum, tal como no A* sequencial. Um nó
+     alcançado por um caminho melhor é movido para a posição a seguir ao nó que o melhorou. A
+     posição de cada nó na lista é guardada em `index_in_open_set`.
+   - Com uma heurística admissível a primeira solução encontrada é ótima. O custo de escolher o
+     próximo nó é O(1), em troca de nós visitados várias vezes em passagens diferentes.
+*/
+#ifndef ASTAR_FRINGE_H
+#define ASTAR_FRINGE_H
+#include "astar.h"
+#include "state.h"
+#include <stdbool.h>
+#include <stddef.h>
+
+typedef struct a_star_fringe_t a_star_fringe_t;
+
+// Posição da lista da fronteira, ligada às posições vizinhas pelos seus índices
+typedef struct
+{
+  a_star_node_t* node;
+  size_t prev;
+  size_t next;
+} a_star_fringe_link_t;
+
+// Estrutura que contem o estado do algoritmo Fringe Search
+struct a_star_fringe_t
+{
+  // Informação comum do nosso algoritmo
+  a_star_t* common;
+
+  // Lista da fronteira, as posições removidas são reutilizadas
+  a_star_fringe_link_t* links;
+  size_t links_capacity;
+  size_t links_used;
+  size_t free_link;
+  size_t head;
+  size_t tail;
+  size_t size;
+
+  // Informação estatística
+  int passes;
+  long revisits;
+  int final_threshold;
+};
+
+// Cria uma nova instância do algoritmo Fringe Search para resolver um problema
+a_star_fringe_t* a_star_fringe_create(size_t struct_size,
+                                      goal_function goal_func,
+                                      visit_function visit_func,
+                                      heuristic_function h_func,
+                                      distance_function d_func,
+                                      print_function print_func);
+
+// Liberta uma instância do algoritmo Fringe Search
+void a_star_fringe_destroy(a_star_fringe_t* a_star);
+
+// Resolve o problema através do uso do algoritmo Fringe Search
+void a_star_fringe_solve(a_star_fringe_t* a_star, void* initial, void* goal);
+
+// Imprime estatísticas sobre o algoritmo Fringe Search
+void a_star_fringe_print_statistics(a_star_fringe_t* a_star, bool csv, bool show_solution);
+
+#endif // ASTAR_FRINGE_H
@@ -0,0 +1,116 @@
+/*
+   Algoritmo A* de Fronteira
+
+   Versão do A* sequencial que não guarda a lista fechada: um nó expandido é libertado e apenas os
+   nós abertos ficam em memória, pelo que a memória cresce com a fronteira e não com todos os
+   estados explorados.
+
+   - Para não voltar a gerar os nós já libertados, cada nó aberto guarda os operadores usados:
+     um bit por vizinho (pela ordem em que a função de vizinhos os gera) que leva a um nó já
+     expandido. Quando um nó é expandido, cada vizinho aberto ou novo marca o operador que leva de
+     volta a esse nó. A posição desse operador é obtida gerando os vizinhos do filho.
+   - Requer um problema não dirigido e uma heurística consistente, tal como o A* sequencial sem
+     reabertura de nós. Nós com mais de 64 vizinhos não marcam os operadores além do 64º, que
+     podem voltar a gerar nós já expandidos (a solução continua ótima, com mais expansões).
+   - O caminho é recuperado com camadas de retransmissão esparsas: os nós expandidos com uma
+     profundidade múltipla de relay_interval são guardados, e cada nó conhece o último destes
+     antecessores. No fim cada troço entre dois nós de retransmissão é reconstruído por uma
+     procura em profundidade limitada pelo custo e pelo número de passos do troço.
+
+   Os estados da fronteira são guardados numa tabela própria, os gestores da parte comum apenas
+   recebem o caminho final, pelo que a solução é impressa como no A* sequencial.
+*/
+#ifndef ASTAR_FRONTIER_H
+#define ASTAR_FRONTIER_H
+#include "astar.h"
+#include "state.h"
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+// Distância por omissão entre camadas de retransmissão
+#define FRONTIER_RELAY_INTERVAL 8
+
+typedef struct a_star_frontier_t a_star_frontier_t;
+typedef struct a_star_frontier_entry_t a_star_frontier_entry_t;
+
+// Nó aberto da fronteira, os dados do estado seguem a estrutura
+struct a_star_frontier_entry_t
+{
+  a_star_frontier_entry_t* next; // Próximo nó na mesma posição da tabela
+  size_t hash;
+  int g;
+  int h;
+  int depth;
+  size_t relay; // Último antecessor de retransmissão (SIZE_MAX se não existir)
+  size_t heap_index;
+  uint64_t used; // Operadores que levam a nós já expandidos
+  char data[];
+};
+
+// Nó de retransmissão, um nó expandido numa profundidade múltipla do intervalo
+typedef struct
+{
+  size_t parent; // Nó de retransmissão anterior (SIZE_MAX na raiz)
+  int g;
+  int depth;
+} a_star_frontier_relay_t;
+
+// Estrutura que contem o estado do algoritmo A* de fronteira
+struct a_star_frontier_t
+{
+  // Informação comum do nosso algoritmo
+  a_star_t* common;
+
+  // Gestor temporário e memória para os vizinhos gerados
+  state_allocator_t* scratch;
+  linked_list_t* neighbors;
+  char* children;
+  size_t children_capacity;
+  char* reverse_children;
+  size_t reverse_capacity;
+
+  // Tabela de nós abertos
+  a_star_frontier_entry_t** buckets;
+  size_t num_buckets;
+  size_t num_entries;
+
+  // Lista aberta, com a posição de cada nó guardada no próprio nó
+  a_star_frontier_entry_t** heap;
+  size_t heap_size;
+  size_t heap_capacity;
+
+  // Camadas de retransmissão
+  int relay_interval;
+  a_star_frontier_relay_t* relays;
+  char* relay_data;
+  size_t num_relays;
+  size_t relays_capacity;
+
+  // Informação estatística
+  size_t max_entries;
+  long operators_skipped;
+  size_t solution_length;
+};
+
+// Cria uma nova instância do algoritmo A* de fronteira para resolver um problema
+a_star_frontier_t* a_star_frontier_create(size_t struct_size,
+                                          goal_function goal_func,
+                                          visit_function visit_func,
+                                          heuristic_function h_func,
+                                          distance_function d_func,
+                                          print_function print_func);
+
+// Define a distância (em passos) entre camadas de retransmissão
+void a_star_frontier_set_relay_interval(a_star_frontier_t* a_star, int relay_interval);
+
+// Liberta uma instância do algoritmo A* de fronteira
+void a_star_frontier_destroy(a_star_frontier_t* a_star);
+
+// Resolve o problema através do uso do algoritmo A* de fronteira
+void a_star_frontier_solve(a_star_frontier_t* a_star, void* initial, void* goal);
+
+// Imprime estatísticas sobre o algoritmo A* de fronteira
+void a_star_frontier_print_statistics(a_star_frontier_t* a_star, bool csv, bool show_solution);
+
+#endif // ASTAR_FRONTIER_H
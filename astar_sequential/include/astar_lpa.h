@@ -0,0 +1,110 @@
+/*
+   Algoritmo LPA* (Lifelong Planning A*) para Replaneamento Incremental
+
+   Para problemas que são resolvidos várias vezes com pequenas alterações (por exemplo células de um
+   labirinto que abrem ou fecham): em vez de repetir a procura desde o início, a árvore de procura é
+   mantida entre consultas e apenas os valores afetados pelas alterações são reparados.
+
+   - Cada índice tem o custo g e o valor rhs, o melhor custo calculado a partir dos vizinhos. Um
+     índice é inconsistente quando g != rhs e só os índices inconsistentes entram na lista aberta,
+     ordenada pela chave [min(g, rhs) + h, min(g, rhs)].
+   - A procura é feita do objetivo para o início, como no D* Lite: o valor g de um índice é o custo
+     até ao objetivo e a heurística é calculada até ao início. O caminho é recuperado a partir do
+     início, escolhendo em cada passo o vizinho com menor g.
+   - O problema é alterado através de `a_star_lpa_change`, que invoca a função de alteração do
+     problema sobre um índice e recalcula o rhs do índice e dos seus vizinhos de antes e de depois
+     da alteração. A consulta seguinte processa apenas os índices que ficaram inconsistentes, pelo
+     que o trabalho depende da dimensão da alteração e não da dimensão do problema.
+   - O espaço de índices é denso, g, rhs e a posição na lista aberta são vetores indexados. Requer
+     um problema não dirigido de custo unitário em que um índice bloqueado não tem vizinhos.
+
+   O caminho final é convertido em estados e nós da parte comum, pelo que a solução é impressa e as
+   estatísticas de cada consulta são apresentadas como no A* sequencial.
+*/
+#ifndef ASTAR_LPA_H
+#define ASTAR_LPA_H
+#include "astar.h"
+#include "state.h"
+#include <stdbool.h>
+#include <stddef.h>
+
+typedef struct a_star_lpa_t a_star_lpa_t;
+
+// Tipo para funções que alteram o problema num índice, retornam falso se a alteração não foi feita
+typedef bool (*index_change_function)(size_t, void*);
+
+// Entrada da lista aberta, a chave é guardada com o índice
+typedef struct
+{
+  int k1;
+  int k2;
+  size_t index;
+} a_star_lpa_entry_t;
+
+// Estrutura que contem o estado do algoritmo LPA*
+struct a_star_lpa_t
+{
+  // Informação comum do nosso algoritmo, utilizada apenas para a solução e estatísticas
+  a_star_t* common;
+
+  // Espaço de índices do problema
+  size_t num_indices;
+  size_t max_neighbors;
+  index_neighbors_function neighbors_func;
+  index_state_function state_func;
+  index_heuristic_function h_func;
+  void* context;
+
+  // Custos de cada índice, mantidos entre consultas
+  int* g;
+  int* rhs;
+  size_t* heap_position;
+
+  // Lista aberta com os índices inconsistentes
+  a_star_lpa_entry_t* heap;
+  size_t heap_size;
+
+  // Consulta atual, o início e o objetivo não mudam entre consultas incrementais
+  size_t initial_index;
+  size_t goal_index;
+  bool initialized;
+
+  // Memória para os vizinhos de um índice, antes e depois de uma alteração
+  size_t* neighbors;
+  size_t* changed_neighbors;
+  char* state_data;
+
+  // Informação estatística
+  int queries;
+  int changes;
+  long vertex_updates; // Total desde a criação
+  long vertex_updates_before; // Total no fim da consulta anterior
+  long query_vertex_updates; // Da última consulta, incluindo as alterações que a antecederam
+};
+
+// Cria uma nova instância do algoritmo LPA* sobre num_indices índices, a heurística de cada índice é
+// calculada até ao início da procura
+a_star_lpa_t* a_star_lpa_create(size_t struct_size,
+                                size_t num_indices,
+                                size_t max_neighbors,
+                                index_neighbors_function neighbors_func,
+                                index_state_function state_func,
+                                index_heuristic_function h_func,
+                                void* context,
+                                print_function print_func);
+
+// Liberta uma instância do algoritmo LPA*
+void a_star_lpa_destroy(a_star_lpa_t* a_star);
+
+// Altera o problema no índice indicado (por exemplo uma célula que abre ou fecha) e repara os valores
+// afetados na próxima consulta, retorna o resultado da função de alteração
+bool a_star_lpa_change(a_star_lpa_t* a_star, size_t index, index_change_function change_func);
+
+// Resolve o problema entre o índice inicial e o objetivo, reutilizando a procura anterior quando
+// ambos são os mesmos
+void a_star_lpa_solve(a_star_lpa_t* a_star, size_t initial, size_t goal);
+
+// Imprime estatísticas sobre a última consulta do algoritmo LPA*
+void a_star_lpa_print_statistics(a_star_lpa_t* a_star, bool csv, bool show_solution);
+
+#endif // ASTAR_LPA_H
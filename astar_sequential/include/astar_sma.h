@@ -0,0 +1,135 @@
+/*
+   Algoritmo SMA* (A* Simplificado com Memória Limitada)
+
+   Versão do A* que nunca guarda mais do que um número fixo de nós. A procura é feita sobre uma
+   árvore de nós, em que cada nó tem o custo f atualizado com o melhor custo conhecido das folhas
+   abaixo dele.
+
+   - Expande-se sempre o nó aberto com menor f, desempatando pelo mais profundo. Um nó é expandido
+     gerando todos os sucessores de uma vez, com exceção do estado do pai. O custo f de um filho
+     nunca é menor do que o do pai (pathmax).
+   - Quando não há memória para os sucessores é esquecida a pior folha (maior f, desempatando pela
+     menos profunda). O seu custo f passa para o pai, que volta à lista aberta com o menor f dos
+     filhos esquecidos. Quando for o melhor nó aberto, os filhos esquecidos são gerados de novo.
+   - Se nem assim houver memória para um sucessor, o caminho é abandonado (custo infinito). A
+     solução encontrada é ótima se o limite de nós for maior do que a profundidade da solução
+     mais os sucessores de cada nível.
+   - Os nós são guardados num alocador com reutilização de posições, os nós esquecidos são
+     devolvidos ao alocador. Os estados estão guardados no próprio nó e não são indexados no
+     gestor de estados comum, que nunca liberta memória.
+   - Os nós em memória estão numa tabela indexada pelo estado. Um sucessor cujo estado já está em
+     memória com custo g menor ou igual é descartado. Se o novo caminho for mais barato, o nó
+     antigo e a sua subárvore são descartados sem passar o custo ao pai, porque o estado volta a
+     ser alcançado pelo novo caminho.
+   - Problemas que associam memória aos estados (ex: tabuleiros indexados pelo number link) podem
+     indicar uma função de libertação, chamada sempre que um estado deixa de estar em memória,
+     para que essa memória também fique limitada pelo número de nós.
+
+   O caminho final é convertido em estados e nós da parte comum, pelo que a solução é impressa como
+   no A* sequencial.
+*/
+#ifndef ASTAR_SMA_H
+#define ASTAR_SMA_H
+#include "allocator.h"
+#include "astar.h"
+#include "state.h"
+#include <stdbool.h>
+#include <stddef.h>
+
+typedef struct a_star_sma_t a_star_sma_t;
+typedef struct a_star_sma_node_t a_star_sma_node_t;
+
+// Tipo para funções que libertam a memória que o problema associou a um estado
+typedef void (*release_function)(const state_t*);
+
+// Nó da árvore de procura, os dados do estado seguem a estrutura
+struct a_star_sma_node_t
+{
+  a_star_sma_node_t* parent;
+  a_star_sma_node_t* first_child;
+  a_star_sma_node_t* next_sibling;
+  a_star_sma_node_t* prev_sibling;
+  int g;
+  int h;
+  int f; // Melhor custo conhecido abaixo deste nó
+  int forgotten_f; // Menor custo dos filhos esquecidos (INT_MAX se não existirem)
+  int depth;
+  int num_children;
+  size_t open_index; // Posição na lista aberta (SIZE_MAX fora da lista)
+  size_t leaf_index; // Posição na lista de folhas (SIZE_MAX fora da lista)
+  size_t hash; // Hash do estado
+  a_star_sma_node_t* next_in_bucket; // Próximo nó na mesma posição da tabela de estados
+  char data[];
+};
+
+// Lista de prioridades com a posição de cada nó guardada no próprio nó
+typedef struct
+{
+  a_star_sma_node_t** data;
+  size_t size;
+  size_t capacity;
+} a_star_sma_heap_t;
+
+// Estrutura que contem o estado do algoritmo SMA*
+struct a_star_sma_t
+{
+  // Informação comum do nosso algoritmo
+  a_star_t* common;
+
+  // Nós da árvore e limite de nós em memória
+  allocator_t* nodes;
+  size_t max_nodes;
+  size_t num_nodes;
+
+  // Tabela dos nós em memória indexada pelo estado, o número de posições é uma potência de 2
+  a_star_sma_node_t** buckets;
+  size_t num_buckets;
+
+  // Libertação da memória associada aos estados (NULL se o problema não a utilizar)
+  release_function release_func;
+
+  // Lista aberta (menor f primeiro) e folhas que podem ser esquecidas (maior f primeiro)
+  a_star_sma_heap_t open;
+  a_star_sma_heap_t leaves;
+
+  // Gestor temporário e memória para os sucessores de uma expansão
+  state_allocator_t* scratch;
+  linked_list_t* neighbors;
+  char* children;
+  int* children_f;
+  size_t children_capacity;
+  a_star_sma_node_t** kept;
+  size_t kept_capacity;
+
+  // Informação estatística
+  size_t max_nodes_used;
+  int nodes_forgotten;
+  int nodes_regenerated;
+  int paths_abandoned;
+  int duplicates_dropped;
+  int duplicates_replaced;
+};
+
+// Cria uma nova instância do algoritmo SMA* que guarda no máximo max_nodes nós
+a_star_sma_t* a_star_sma_create(size_t struct_size,
+                                goal_function goal_func,
+                                visit_function visit_func,
+                                heuristic_function h_func,
+                                distance_function d_func,
+                                print_function print_func,
+                                size_t max_nodes);
+
+// Indica a função que liberta a memória associada a um estado quando o nó é esquecido ou descartado.
+// O estado inicial passa a pertencer ao algoritmo e é libertado na procura seguinte ou no destroy
+void a_star_sma_set_release(a_star_sma_t* a_star, release_function release_func);
+
+// Liberta uma instância do algoritmo SMA*
+void a_star_sma_destroy(a_star_sma_t* a_star);
+
+// Resolve o problema através do uso do algoritmo SMA*
+void a_star_sma_solve(a_star_sma_t* a_star, void* initial, void* goal);
+
+// Imprime estatísticas sobre o algoritmo SMA*
+void a_star_sma_print_statistics(a_star_sma_t* a_star, bool csv, bool show_solution);
+
+#endif // ASTAR_SMA_H
@@ -0,0 +1,455 @@
+#include "astar_ara.h"
+#include <limits.h>
+#include <math.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// Situação de um nó na iteração atual, guardada em index_in_open_set
+#define ARA_OPEN 0
+#define ARA_FREE SIZE_MAX // Nem aberto nem fechado
+#define ARA_CLOSED (SIZE_MAX - 1) // Expandido na iteração atual
+#define ARA_INCONS (SIZE_MAX - 2) // Fechado com um caminho melhor, aguarda a próxima iteração
+
+// Número de expansões entre verificações do tempo limite e do cancelamento
+#define ARA_CHECK_INTERVAL 1024
+
+// Cria uma nova instância para resolver um problema
+a_star_ara_t* a_star_ara_create(size_t struct_size,
+                                goal_function goal_func,
+                                visit_function visit_func,
+                                heuristic_function h_func,
+                                distance_function d_func,
+                                print_function print_func,
+                                double initial_weight)
+{
+  a_star_ara_t* a_star = (a_star_ara_t*)calloc(1, sizeof(a_star_ara_t));
+  if(a_star == NULL)
+  {
+    return NULL; // Erro de alocação
+  }
+
+  // Inicializamos a parte comum do nosso algoritmo e as listas da procura
+  a_star->common = a_star_create(struct_size, goal_func, visit_func, h_func, d_func, print_func);
+  a_star->open_set = min_heap_create();
+  a_star->closed = linked_list_create();
+  a_star->incons = linked_list_create();
+
+  if(a_star->common == NULL || a_star->open_set == NULL || a_star->closed == NULL || a_star->incons == NULL)
+  {
+    a_star_ara_destroy(a_star);
+    return NULL;
+  }
+
+  a_star->initial_weight = initial_weight < 1.0 ? 1.0 : initial_weight;
+  a_star->weight_step = ARA_DEFAULT_WEIGHT_STEP;
+  a_star->time_limit = 0;
+
+  return a_star;
+}
+
+// Define a redução do peso entre iterações
+void a_star_ara_set_weight_step(a_star_ara_t* a_star, double weight_step)
+{
+  if(a_star == NULL || weight_step <= 0)
+  {
+    return;
+  }
+
+  a_star->weight_step = weight_step;
+}
+
+// Define o tempo máximo da procura em segundos (0 sem limite)
+void a_star_ara_set_time_limit(a_star_ara_t* a_star, double seconds)
+{
+  if(a_star == NULL)
+  {
+    return;
+  }
+
+  a_star->time_limit = seconds > 0 ? seconds : 0;
+}
+
+// Liberta uma instância do algoritmo ARA*
+void a_star_ara_destroy(a_star_ara_t* a_star)
+{
+  if(a_star == NULL)
+  {
+    return;
+  }
+
+  min_heap_destroy(a_star->open_set);
+  if(a_star->closed != NULL)
+    linked_list_destroy(a_star->closed);
+  if(a_star->incons != NULL)
+    linked_list_destroy(a_star->incons);
+
+  // Invocamos o destroy da parte comum
+  a_star_destroy(a_star->common);
+
+  free(a_star);
+}
+
+// Prioridade de um nó com o peso da iteração atual
+static inline int a_star_ara_priority(a_star_ara_t* a_star, a_star_node_t* node)
+{
+  return node->g * ARA_WEIGHT_SCALE + a_star->weight * node->h;
+}
+
+// Segundos desde o início da procura
+static double a_star_ara_elapsed(a_star_ara_t* a_star)
+{
+  struct timespec now;
+  clock_gettime(CLOCK_MONOTONIC, &now);
+  return (now.tv_sec - a_star->common->start_time.tv_sec) + (now.tv_nsec - a_star->common->start_time.tv_nsec) / 1000000000.0;
+}
+
+// Insere um nó na lista aberta com a prioridade atual
+static void a_star_ara_open(a_star_ara_t* a_star, a_star_node_t* node)
+{
+  node->index_in_open_set = ARA_OPEN;
+  min_heap_insert(a_star->open_set, a_star_ara_priority(a_star, node), node);
+}
+
+// Retira da lista aberta as entradas que já não correspondem ao nó, retorna falso se ficar vazia
+static bool a_star_ara_skip_stale(a_star_ara_t* a_star)
+{
+  while(a_star->open_set->size)
+  {
+    heap_node_t top = a_star->open_set->data[0];
+    a_star_node_t* node = (a_star_node_t*)top.data;
+    if(node->index_in_open_set == ARA_OPEN && top.cost == a_star_ara_priority(a_star, node))
+    {
+      return true;
+    }
+    min_heap_pop(a_star->open_set);
+  }
+
+  return false;
+}
+
+// Guarda uma solução melhor do que a atual
+static void a_star_ara_publish(a_star_ara_t* a_star, a_star_node_t* goal_node)
+{
+  a_star_t* common = a_star->common;
+  common->num_solutions++;
+
+  if(common->solution != NULL && goal_node->g >= common->solution->g && goal_node != common->solution)
+  {
+    common->num_worst_solutions++;
+    return;
+  }
+
+  common->solution = goal_node;
+  common->num_better_solutions++;
+
+  if(a_star->num_solutions < ARA_MAX_SOLUTIONS)
+  {
+    a_star_ara_solution_t* record = &a_star->solutions[a_star->num_solutions++];
+    record->cost = goal_node->g;
+    record->weight = (double)a_star->weight / ARA_WEIGHT_SCALE;
+    record->bound = (double)a_star->weight / ARA_WEIGHT_SCALE;
+    record->time = a_star_ara_elapsed(a_star);
+  }
+}
+
+// Verifica o tempo limite e o pedido de cancelamento
+static bool a_star_ara_interrupted(a_star_ara_t* a_star)
+{
+  if(a_star_cancel_requested(a_star->common))
+  {
+    a_star->common->cancelled = true;
+    return true;
+  }
+
+  if(a_star->time_limit > 0 && a_star_ara_elapsed(a_star) >= a_star->time_limit)
+  {
+    a_star->timed_out = true;
+    return true;
+  }
+
+  return false;
+}
+
+// Expande nós até que nenhum nó aberto possa melhorar a solução com o peso atual,
+// retorna falso caso a procura tenha sido interrompida
+static bool a_star_ara_improve_path(a_star_ara_t* a_star, linked_list_t* neighbors, int* incons_min)
+{
+  a_star_t* common = a_star->common;
+
+  while(a_star_ara_skip_stale(a_star))
+  {
+    // Nenhum nó aberto tem prioridade inferior ao custo da solução atual
+    if(common->solution != NULL && common->solution->g * ARA_WEIGHT_SCALE <= a_star->open_set->data[0].cost)
+    {
+      break;
+    }
+
+    if(common->expanded % ARA_CHECK_INTERVAL == 0 && a_star_ara_interrupted(a_star))
+    {
+      return false;
+    }
+
+    if(common->max_min_heap_size < a_star->open_set->size)
+      common->max_min_heap_size = a_star->open_set->size;
+
+    heap_node_t top_element = min_heap_pop(a_star->open_set);
+    a_star_node_t* current_node = (a_star_node_t*)top_element.data;
+
+    // O nó fica fechado até ao fim da iteração
+    current_node->index_in_open_set = ARA_CLOSED;
+    linked_list_append(a_star->closed, current_node);
+    common->expanded++;
+
+    // Os filhos de um objetivo nunca melhoram a solução
+    if(current_node == common->solution)
+    {
+      continue;
+    }
+
+    common->visit_func(current_node->state, common->state_allocator, neighbors);
+    while(linked_list_size(neighbors))
+    {
+      state_t* neighbor = (state_t*)linked_list_pop_back(neighbors);
+      int g_attempt = current_node->g + common->d_func(current_node->state, neighbor);
+
+      a_star_node_t* child_node = node_allocator_get(common->node_allocator, neighbor);
+      bool is_new = child_node == NULL;
+      if(is_new)
+      {
+        // Este nó ainda não existe, criamos um novo nó
+        child_node = node_allocator_new(common->node_allocator, neighbor);
+        child_node->parent = current_node;
+        child_node->g = g_attempt;
+        child_node->h = common->h_func(child_node->state, common->goal_state);
+        common->generated++;
+        common->nodes_new++;
+      }
+      else
+      {
+        // Existe outro caminho igual ou mais curto para este nó
+        if(g_attempt >= child_node->g)
+        {
+          common->paths_worst_or_equals++;
+          continue;
+        }
+
+        child_node->parent = current_node;
+        child_node->g = g_attempt;
+        common->paths_better++;
+      }
+
+      // Solução melhor do que a atual
+      if(common->goal_func(child_node->state, common->goal_state))
+      {
+        a_star_ara_publish(a_star, child_node);
+      }
+
+      if(child_node->index_in_open_set == ARA_CLOSED || child_node->index_in_open_set == ARA_INCONS)
+      {
+        // Já foi expandido nesta iteração, fica inconsistente até à próxima
+        if(child_node->index_in_open_set == ARA_CLOSED)
+        {
+          child_node->index_in_open_set = ARA_INCONS;
+          linked_list_append(a_star->incons, child_node);
+        }
+        if(child_node->g + child_node->h < *incons_min)
+          *incons_min = child_node->g + child_node->h;
+        continue;
+      }
+
+      if(!is_new && child_node->index_in_open_set == ARA_FREE)
+        common->nodes_reinserted++;
+      a_star_ara_open(a_star, child_node);
+    }
+  }
+
+  return true;
+}
+
+// Limite de sub-otimalidade da solução atual: min(w, custo / min(g + h)) sobre os nós por expandir
+static double a_star_ara_bound(a_star_ara_t* a_star, int incons_min)
+{
+  if(a_star->common->solution == NULL)
+  {
+    return INFINITY;
+  }
+
+  int lower = incons_min;
+  for(size_t i = 0; i < a_star->open_set->size; i++)
+  {
+    heap_node_t entry = a_star->open_set->data[i];
+    a_star_node_t* node = (a_star_node_t*)entry.data;
+    if(node->index_in_open_set == ARA_OPEN && entry.cost == a_star_ara_priority(a_star, node) && node->g + node->h < lower)
+    {
+      lower = node->g + node->h;
+    }
+  }
+
+  double weight = (double)a_star->weight / ARA_WEIGHT_SCALE;
+  if(lower >= a_star->common->solution->g)
+  {
+    return 1.0;
+  }
+
+  double bound = lower > 0 ? (double)a_star->common->solution->g / lower : weight;
+  return bound < weight ? bound : weight;
+}
+
+// Prepara a próxima iteração: os nós inconsistentes voltam à lista aberta, todas as prioridades
+// são recalculadas com o novo peso e a lista fechada é esvaziada
+static void a_star_ara_next_iteration(a_star_ara_t* a_star, int weight)
+{
+  int old_weight = a_star->weight;
+  linked_list_t* pending = linked_list_create();
+  if(pending == NULL)
+  {
+    return;
+  }
+
+  // Guardamos apenas a entrada válida de cada nó aberto
+  for(size_t i = 0; i < a_star->open_set->size; i++)
+  {
+    heap_node_t entry = a_star->open_set->data[i];
+    a_star_node_t* node = (a_star_node_t*)entry.data;
+    if(node->index_in_open_set == ARA_OPEN && entry.cost == node->g * ARA_WEIGHT_SCALE + old_weight * node->h)
+    {
+      linked_list_append(pending, node);
+    }
+  }
+  min_heap_clean(a_star->open_set);
+
+  while(linked_list_size(a_star->closed))
+  {
+    a_star_node_t* node = (a_star_node_t*)linked_list_pop_back(a_star->closed);
+    if(node->index_in_open_set == ARA_CLOSED)
+      node->index_in_open_set = ARA_FREE;
+  }
+
+  while(linked_list_size(a_star->incons))
+  {
+    linked_list_append(pending, linked_list_pop_back(a_star->incons));
+  }
+
+  a_star->weight = weight;
+  while(linked_list_size(pending))
+  {
+    a_star_ara_open(a_star, (a_star_node_t*)linked_list_pop_back(pending));
+  }
+
+  linked_list_destroy(pending);
+}
+
+// Resolve o problema através do uso do algoritmo ARA*
+void a_star_ara_solve(a_star_ara_t* a_star, void* initial, void* goal)
+{
+  if(a_star == NULL)
+  {
+    return;
+  }
+
+  // Limpamos a procura anterior
+  if(a_star->common->expanded > 0 || a_star->common->goal_state != NULL || a_star->common->solution != NULL)
+  {
+    if(!a_star_reset(a_star->common))
+    {
+      return;
+    }
+  }
+  min_heap_clean(a_star->open_set);
+  while(linked_list_size(a_star->closed))
+    linked_list_pop_back(a_star->closed);
+  while(linked_list_size(a_star->incons))
+    linked_list_pop_back(a_star->incons);
+
+  a_star->num_solutions = 0;
+  a_star->iterations = 0;
+  a_star->timed_out = false;
+  a_star->bound = INFINITY;
+  a_star->weight = (int)lround(a_star->initial_weight * ARA_WEIGHT_SCALE);
+
+  if(goal)
+  {
+    a_star->common->goal_state = state_allocator_new(a_star->common->state_allocator, goal);
+    if(a_star->common->goal_state == NULL)
+    {
+      return;
+    }
+  }
+
+  state_t* initial_state = state_allocator_new(a_star->common->state_allocator, initial);
+  a_star_node_t* initial_node = node_allocator_new(a_star->common->node_allocator, initial_state);
+  initial_node->g = 0;
+  initial_node->h = a_star->common->h_func(initial_node->state, a_star->common->goal_state);
+
+  linked_list_t* neighbors = linked_list_create();
+
+  clock_gettime(CLOCK_MONOTONIC, &(a_star->common->start_time));
+
+  a_star_ara_open(a_star, initial_node);
+  a_star->common->generated++;
+  a_star->common->nodes_new++;
+  if(a_star->common->goal_func(initial_state, a_star->common->goal_state))
+  {
+    a_star_ara_publish(a_star, initial_node);
+  }
+
+  while(true)
+  {
+    a_star->iterations++;
+    size_t first_record = a_star->num_solutions;
+    int incons_min = INT_MAX;
+    bool finished = a_star_ara_improve_path(a_star, neighbors, &incons_min);
+
+    // O limite é válido mesmo que a iteração tenha sido interrompida
+    a_star->bound = a_star_ara_bound(a_star, incons_min);
+    // As soluções desta iteração ficam com o limite calculado no seu fim
+    for(size_t i = first_record; i < a_star->num_solutions; i++)
+    {
+      if(a_star->bound < a_star->solutions[i].bound)
+        a_star->solutions[i].bound = a_star->bound;
+    }
+
+    // Sem solução não existe caminho, com limite 1 a solução é ótima
+    if(!finished || a_star->common->solution == NULL || a_star->bound <= 1.0 || a_star->weight <= ARA_WEIGHT_SCALE)
+    {
+      break;
+    }
+
+    int weight = a_star->weight - (int)lround(a_star->weight_step * ARA_WEIGHT_SCALE);
+    a_star_ara_next_iteration(a_star, weight < ARA_WEIGHT_SCALE ? ARA_WEIGHT_SCALE : weight);
+  }
+
+  linked_list_destroy(neighbors);
+
+  clock_gettime(CLOCK_MONOTONIC, &(a_star->common->end_time));
+  // Calculamos o tempo de execução
+  a_star->common->execution_time = (a_star->common->end_time.tv_sec - a_star->common->start_time.tv_sec);
+  a_star->common->execution_time += (a_star->common->end_time.tv_nsec - a_star->common->start_time.tv_nsec) / 1000000000.0;
+}
+
+// Imprime estatísticas do algoritmo ARA* no formato desejado
+void a_star_ara_print_statistics(a_star_ara_t* a_star, bool csv, bool show_solution)
+{
+  if(!csv && !show_solution)
+  {
+    printf("Iterações: %d, Peso final: %.2f, Limite de sub-otimalidade: %.3f%s\n",
+           a_star->iterations,
+           (double)a_star->weight / ARA_WEIGHT_SCALE,
+           a_star->bound,
+           a_star->timed_out ? " (tempo limite atingido)" : "");
+    for(size_t i = 0; i < a_star->num_solutions; i++)
+    {
+      a_star_ara_solution_t* record = &a_star->solutions[i];
+      printf("- Solução %ld: custo: %d, peso: %.2f, limite: %.3f, tempo: %.6f s\n",
+             i + 1,
+             record->cost,
+             record->weight,
+             record->bound,
+             record->time);
+    }
+  }
+
+  a_star_print_statistics(a_star->common, csv, show_solution);
+}
@@ -0,0 +1,361 @@
+#include "astar_beam.h"
+#include <limits.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// Número de posições do gestor temporário de estados
+#define BEAM_SCRATCH_CAPACITY 256
+
+// Número de expansões entre verificações do pedido de cancelamento
+#define BEAM_CANCEL_INTERVAL 1024
+
+// Cria uma nova instância para resolver um problema
+a_star_beam_t* a_star_beam_create(size_t struct_size,
+                                  goal_function goal_func,
+                                  visit_function visit_func,
+                                  heuristic_function h_func,
+                                  distance_function d_func,
+                                  print_function print_func,
+                                  size_t width)
+{
+  a_star_beam_t* a_star = (a_star_beam_t*)calloc(1, sizeof(a_star_beam_t));
+  if(a_star == NULL)
+  {
+    return NULL; // Erro de alocação
+  }
+
+  // Inicializamos a parte comum do nosso algoritmo, que guarda os nós escolhidos para o feixe
+  a_star->width = width > 0 ? width : 1;
+  a_star->common = a_star_create(struct_size, goal_func, visit_func, h_func, d_func, print_func);
+  a_star->layer = (a_star_node_t**)malloc(a_star->width * sizeof(a_star_node_t*));
+  a_star->scratch = state_allocator_create_scratch(struct_size, BEAM_SCRATCH_CAPACITY);
+  a_star->neighbors = linked_list_create();
+
+  if(a_star->common == NULL || a_star->layer == NULL || a_star->scratch == NULL || a_star->neighbors == NULL)
+  {
+    a_star_beam_destroy(a_star);
+    return NULL;
+  }
+
+  return a_star;
+}
+
+// Liberta uma instância da procura em feixe
+void a_star_beam_destroy(a_star_beam_t* a_star)
+{
+  if(a_star == NULL)
+  {
+    return;
+  }
+
+  state_allocator_destroy(a_star->scratch);
+  linked_list_destroy(a_star->neighbors);
+  free(a_star->layer);
+  free(a_star->candidates);
+  free(a_star->candidate_data);
+
+  // Invocamos o destroy da parte comum
+  a_star_destroy(a_star->common);
+
+  free(a_star);
+}
+
+// Ordem dos candidatos no feixe: menor f e, no mesmo f, menor h
+static inline bool a_star_beam_better(const a_star_beam_candidate_t* a, const a_star_beam_candidate_t* b)
+{
+  return a->g + a->h < b->g + b->h || (a->g + a->h == b->g + b->h && a->h < b->h);
+}
+
+// Coloca os k melhores candidatos nas primeiras k posições, sem os ordenar (seleção parcial)
+static void a_star_beam_select(a_star_beam_candidate_t* candidates, size_t count, size_t k)
+{
+  size_t left = 0;
+  size_t right = count - 1;
+  while(left < right)
+  {
+    // Pivô a meio do intervalo, partição de Hoare
+    a_star_beam_candidate_t pivot = candidates[left + (right - left) / 2];
+    size_t i = left;
+    size_t j = right;
+    while(i <= j)
+    {
+      while(a_star_beam_better(&candidates[i], &pivot))
+        i++;
+      while(a_star_beam_better(&pivot, &candidates[j]))
+        j--;
+      if(i <= j)
+      {
+        a_star_beam_candidate_t tmp = candidates[i];
+        candidates[i] = candidates[j];
+        candidates[j] = tmp;
+        i++;
+        if(j == 0)
+          break;
+        j--;
+      }
+    }
+
+    // Continuamos apenas na parte que contém a posição k
+    if(k <= j)
+      right = j;
+    else if(k >= i)
+      left = i;
+    else
+      break;
+  }
+}
+
+// Acrescenta um sucessor aos candidatos da próxima camada
+static bool a_star_beam_add_candidate(a_star_beam_t* a_star, a_star_node_t* parent, state_t* state, int g, int h)
+{
+  size_t struct_size = a_star->common->state_allocator->struct_size;
+  if(a_star->num_candidates == a_star->candidates_capacity)
+  {
+    size_t new_capacity = a_star->candidates_capacity > 0 ? a_star->candidates_capacity * 2 : 4 * a_star->width;
+    a_star_beam_candidate_t* new_candidates =
+        (a_star_beam_candidate_t*)realloc(a_star->candidates, new_capacity * sizeof(a_star_beam_candidate_t));
+    if(new_candidates == NULL)
+    {
+      return false;
+    }
+    a_star->candidates = new_candidates;
+
+    char* new_data = (char*)realloc(a_star->candidate_data, new_capacity * struct_size);
+    if(new_data == NULL)
+    {
+      return false;
+    }
+    a_star->candidate_data = new_data;
+    a_star->candidates_capacity = new_capacity;
+  }
+
+  size_t index = a_star->num_candidates++;
+  memcpy(a_star->candidate_data + index * struct_size, state->data, struct_size);
+  a_star->candidates[index].parent = parent;
+  a_star->candidates[index].g = g;
+  a_star->candidates[index].h = h;
+  a_star->candidates[index].data_index = index;
+  return true;
+}
+
+// Guarda um nó escolhido para o feixe, retorna NULL se o estado já esteve no feixe
+static a_star_node_t* a_star_beam_new_node(a_star_beam_t* a_star, a_star_node_t* parent, void* data, int g, int h)
+{
+  a_star_t* common = a_star->common;
+  state_t* state = state_allocator_new(common->state_allocator, data);
+  if(state == NULL || node_allocator_get(common->node_allocator, state) != NULL)
+  {
+    return NULL;
+  }
+
+  a_star_node_t* node = node_allocator_new(common->node_allocator, state);
+  if(node == NULL)
+  {
+    return NULL;
+  }
+
+  node->parent = parent;
+  node->g = g;
+  node->h = h;
+  node->index_in_open_set = SIZE_MAX;
+  common->nodes_new++;
+  return node;
+}
+
+// Guarda a solução, o caminho é a cadeia de pais do nó objetivo
+static inline void a_star_beam_set_solution(a_star_beam_t* a_star, a_star_node_t* goal_node)
+{
+  a_star->common->solution = goal_node;
+  a_star->common->num_solutions = a_star->common->num_better_solutions = 1;
+}
+
+// Expande a camada atual, retorna o objetivo de menor g entre os sucessores ou NULL
+static a_star_beam_candidate_t* a_star_beam_expand_layer(a_star_beam_t* a_star)
+{
+  a_star_t* common = a_star->common;
+  a_star_beam_candidate_t* best_goal = NULL;
+  size_t best_goal_index = SIZE_MAX;
+
+  a_star->num_candidates = 0;
+  for(size_t i = 0; i < a_star->layer_size; i++)
+  {
+    a_star_node_t* current = a_star->layer[i];
+    common->expanded++;
+
+    common->visit_func(current->state, a_star->scratch, a_star->neighbors);
+    while(linked_list_size(a_star->neighbors))
+    {
+      state_t* neighbor = (state_t*)linked_list_pop_back(a_star->neighbors);
+
+      // Um estado que já esteve no feixe não volta a ser candidato
+      if(node_allocator_get(common->node_allocator, neighbor) != NULL)
+      {
+        common->paths_worst_or_equals++;
+        continue;
+      }
+
+      int g = current->g + common->d_func(current->state, neighbor);
+      int h = common->h_func(neighbor, common->goal_state);
+      if(!a_star_beam_add_candidate(a_star, current, neighbor, g, h))
+      {
+        continue;
+      }
+      common->generated++;
+
+      if(common->goal_func(neighbor, common->goal_state) &&
+         (best_goal_index == SIZE_MAX || a_star->candidates[a_star->num_candidates - 1].g < a_star->candidates[best_goal_index].g))
+      {
+        best_goal_index = a_star->num_candidates - 1;
+      }
+    }
+    state_allocator_scratch_reset(a_star->scratch);
+  }
+
+  if(best_goal_index != SIZE_MAX)
+    best_goal = &a_star->candidates[best_goal_index];
+  if(a_star->max_candidates < a_star->num_candidates)
+    a_star->max_candidates = a_star->num_candidates;
+
+  return best_goal;
+}
+
+// Escolhe os melhores candidatos para a próxima camada do feixe
+static void a_star_beam_next_layer(a_star_beam_t* a_star)
+{
+  size_t struct_size = a_star->common->state_allocator->struct_size;
+  size_t count = a_star->num_candidates;
+  size_t kept = count < a_star->width ? count : a_star->width;
+
+  if(count > kept)
+  {
+    a_star_beam_select(a_star->candidates, count, kept);
+    a_star->candidates_discarded += (long)(count - kept);
+  }
+
+  // O mesmo estado pode ter sido gerado por vários pais, fica o primeiro dos escolhidos
+  a_star->layer_size = 0;
+  for(size_t i = 0; i < kept; i++)
+  {
+    a_star_beam_candidate_t* candidate = &a_star->candidates[i];
+    a_star_node_t* node = a_star_beam_new_node(a_star,
+                                               candidate->parent,
+                                               a_star->candidate_data + candidate->data_index * struct_size,
+                                               candidate->g,
+                                               candidate->h);
+    if(node != NULL)
+      a_star->layer[a_star->layer_size++] = node;
+    else
+      a_star->duplicates_removed++;
+  }
+
+  if(a_star->common->max_min_heap_size < a_star->layer_size)
+    a_star->common->max_min_heap_size = a_star->layer_size;
+}
+
+// Resolve o problema através da procura em feixe
+void a_star_beam_solve(a_star_beam_t* a_star, void* initial, void* goal)
+{
+  if(a_star == NULL)
+  {
+    return;
+  }
+
+  // Limpamos a procura anterior
+  if(a_star->common->expanded > 0 || a_star->common->goal_state != NULL || a_star->common->solution != NULL)
+  {
+    if(!a_star_reset(a_star->common))
+    {
+      return;
+    }
+  }
+  a_star->layer_size = 0;
+  a_star->num_candidates = 0;
+  a_star->depth = 0;
+  a_star->max_candidates = 0;
+  a_star->candidates_discarded = 0;
+  a_star->duplicates_removed = 0;
+
+  if(goal)
+  {
+    a_star->common->goal_state = state_allocator_new(a_star->common->state_allocator, goal);
+    if(a_star->common->goal_state == NULL)
+    {
+      return;
+    }
+  }
+
+  // A primeira camada contém apenas o estado inicial
+  state_t* initial_state = state_allocator_new(a_star->common->state_allocator, initial);
+  if(initial_state == NULL)
+  {
+    return;
+  }
+  int initial_h = a_star->common->h_func(initial_state, a_star->common->goal_state);
+  a_star_node_t* root = a_star_beam_new_node(a_star, NULL, initial, 0, initial_h);
+  if(root == NULL)
+  {
+    return;
+  }
+  a_star->layer[a_star->layer_size++] = root;
+
+  clock_gettime(CLOCK_MONOTONIC, &(a_star->common->start_time));
+
+  if(a_star->common->goal_func(root->state, a_star->common->goal_state))
+  {
+    a_star_beam_set_solution(a_star, root);
+  }
+
+  int last_check = 0;
+  while(a_star->common->solution == NULL && a_star->layer_size > 0)
+  {
+    if(a_star->common->expanded - last_check >= BEAM_CANCEL_INTERVAL)
+    {
+      last_check = a_star->common->expanded;
+      if(a_star_cancel_requested(a_star->common))
+      {
+        a_star->common->cancelled = true;
+        break;
+      }
+    }
+
+    // O primeiro objetivo gerado termina a procura, com o caminho do candidato
+    a_star_beam_candidate_t* goal_candidate = a_star_beam_expand_layer(a_star);
+    a_star->depth++;
+    if(goal_candidate != NULL)
+    {
+      size_t struct_size = a_star->common->state_allocator->struct_size;
+      a_star_node_t* goal_node = a_star_beam_new_node(a_star,
+                                                      goal_candidate->parent,
+                                                      a_star->candidate_data + goal_candidate->data_index * struct_size,
+                                                      goal_candidate->g,
+                                                      goal_candidate->h);
+      if(goal_node != NULL)
+        a_star_beam_set_solution(a_star, goal_node);
+      break;
+    }
+
+    a_star_beam_next_layer(a_star);
+  }
+
+  clock_gettime(CLOCK_MONOTONIC, &(a_star->common->end_time));
+  // Calculamos o tempo de execução
+  a_star->common->execution_time = (a_star->common->end_time.tv_sec - a_star->common->start_time.tv_sec);
+  a_star->common->execution_time += (a_star->common->end_time.tv_nsec - a_star->common->start_time.tv_nsec) / 1000000000.0;
+}
+
+// Imprime estatísticas da procura em feixe no formato desejado
+void a_star_beam_print_statistics(a_star_beam_t* a_star, bool csv, bool show_solution)
+{
+  if(!csv && !show_solution)
+  {
+    printf("Feixe: largura %zu, %d camadas, máximo de %zu candidatos numa camada\n",
+           a_star->width,
+           a_star->depth,
+           a_star->max_candidates);
+    printf("Candidatos descartados: %ld, repetidos removidos: %ld\n", a_star->candidates_discarded, a_star->duplicates_removed);
+  }
+
+  a_star_print_statistics(a_star->common, csv, show_solution);
+}
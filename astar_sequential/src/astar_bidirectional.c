@@ -0,0 +1,319 @@
+#include "astar_bidirectional.h"
+#include <limits.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// Número de expansões entre verificações do pedido de cancelamento
+#define BIDIRECTIONAL_CANCEL_INTERVAL 1024
+
+// Cria uma nova instância para resolver um problema
+a_star_bidirectional_t* a_star_bidirectional_create(size_t struct_size,
+                                                    goal_function goal_func,
+                                                    visit_function visit_func,
+                                                    heuristic_function h_func,
+                                                    distance_function d_func,
+                                                    print_function print_func)
+{
+  a_star_bidirectional_t* a_star = (a_star_bidirectional_t*)calloc(1, sizeof(a_star_bidirectional_t));
+  if(a_star == NULL)
+  {
+    return NULL; // Erro de alocação
+  }
+
+  // Inicializamos a parte comum do nosso algoritmo e as estruturas da procura para trás
+  a_star->common = a_star_create(struct_size, goal_func, visit_func, h_func, d_func, print_func);
+  a_star->backward_nodes = node_allocator_create(print_func);
+  a_star->open_forward = min_heap_create();
+  a_star->open_backward = min_heap_create();
+
+  if(a_star->common == NULL || a_star->backward_nodes == NULL || a_star->open_forward == NULL || a_star->open_backward == NULL)
+  {
+    a_star_bidirectional_destroy(a_star);
+    return NULL;
+  }
+
+  // Problema não dirigido e sem heurística inversa por omissão
+  a_star->reverse_visit_func = visit_func;
+  a_star->reverse_h_func = NULL;
+
+  return a_star;
+}
+
+// Define a função de vizinhos e a heurística da procura para trás
+void a_star_bidirectional_set_reverse(a_star_bidirectional_t* a_star,
+                                      visit_function reverse_visit_func,
+                                      heuristic_function reverse_h_func)
+{
+  if(a_star == NULL)
+  {
+    return;
+  }
+
+  a_star->reverse_visit_func = reverse_visit_func != NULL ? reverse_visit_func : a_star->common->visit_func;
+  a_star->reverse_h_func = reverse_h_func;
+}
+
+// Liberta uma instância do algoritmo A* bidirecional
+void a_star_bidirectional_destroy(a_star_bidirectional_t* a_star)
+{
+  if(a_star == NULL)
+  {
+    return;
+  }
+
+  min_heap_destroy(a_star->open_forward);
+  min_heap_destroy(a_star->open_backward);
+  node_allocator_destroy(a_star->backward_nodes);
+
+  // Invocamos o destroy da parte comum
+  a_star_destroy(a_star->common);
+
+  free(a_star);
+}
+
+// Prioridade MM de um nó: max(g + h, 2g)
+static inline int a_star_bidirectional_priority(a_star_node_t* node)
+{
+  int f = node->g + node->h;
+  return f > 2 * node->g ? f : 2 * node->g;
+}
+
+// Retira da lista aberta as entradas que já não correspondem ao nó, retorna falso se ficar vazia
+static bool a_star_bidirectional_skip_stale(min_heap_t* open_set)
+{
+  while(open_set->size)
+  {
+    heap_node_t top = open_set->data[0];
+    a_star_node_t* node = (a_star_node_t*)top.data;
+    if(node->index_in_open_set != SIZE_MAX && top.cost == a_star_bidirectional_priority(node))
+    {
+      return true;
+    }
+    min_heap_pop(open_set);
+  }
+
+  return false;
+}
+
+// Heurística da direção indicada
+static int a_star_bidirectional_h(a_star_bidirectional_t* a_star, bool forward, state_t* state)
+{
+  if(forward)
+  {
+    return a_star->common->h_func(state, a_star->common->goal_state);
+  }
+
+  return a_star->reverse_h_func != NULL ? a_star->reverse_h_func(state, a_star->initial_state) : 0;
+}
+
+// Regista um encontro entre as duas procuras caso melhore o atual
+static void a_star_bidirectional_meet(a_star_bidirectional_t* a_star, state_t* state, int cost)
+{
+  a_star->common->num_solutions++;
+  if(cost >= a_star->best_cost)
+  {
+    a_star->common->num_worst_solutions++;
+    return;
+  }
+
+  a_star->best_cost = cost;
+  a_star->meeting = state;
+  a_star->common->num_better_solutions++;
+}
+
+// Expande o melhor nó de uma das direções
+static void a_star_bidirectional_expand(a_star_bidirectional_t* a_star, bool forward, linked_list_t* neighbors)
+{
+  a_star_t* common = a_star->common;
+  min_heap_t* open_set = forward ? a_star->open_forward : a_star->open_backward;
+  node_allocator_t* nodes = forward ? common->node_allocator : a_star->backward_nodes;
+  node_allocator_t* other_nodes = forward ? a_star->backward_nodes : common->node_allocator;
+
+  heap_node_t top_element = min_heap_pop(open_set);
+  a_star_node_t* current_node = (a_star_node_t*)top_element.data;
+  current_node->index_in_open_set = SIZE_MAX;
+  common->expanded++;
+  if(forward)
+    a_star->expanded_forward++;
+  else
+    a_star->expanded_backward++;
+
+  // Os vizinhos são guardados no gestor de estados comum às duas direções
+  if(forward)
+    common->visit_func(current_node->state, common->state_allocator, neighbors);
+  else
+    a_star->reverse_visit_func(current_node->state, common->state_allocator, neighbors);
+
+  while(linked_list_size(neighbors))
+  {
+    state_t* neighbor = (state_t*)linked_list_pop_back(neighbors);
+
+    // Na procura para trás a aresta vai do vizinho para o nó atual
+    int cost = forward ? common->d_func(current_node->state, neighbor) : common->d_func(neighbor, current_node->state);
+    int g_attempt = current_node->g + cost;
+
+    a_star_node_t* child_node = node_allocator_get(nodes, neighbor);
+    if(!child_node)
+    {
+      // Este nó ainda não existe, criamos um novo nó
+      child_node = node_allocator_new(nodes, neighbor);
+      child_node->h = a_star_bidirectional_h(a_star, forward, neighbor);
+      common->generated++;
+      common->nodes_new++;
+    }
+    else if(g_attempt >= child_node->g)
+    {
+      // Existe outro caminho igual ou mais curto para este nó
+      common->paths_worst_or_equals++;
+      continue;
+    }
+    else
+    {
+      common->paths_better++;
+      if(child_node->index_in_open_set == SIZE_MAX)
+        common->nodes_reinserted++;
+    }
+
+    child_node->parent = current_node;
+    child_node->g = g_attempt;
+    child_node->index_in_open_set = 0;
+    min_heap_insert(open_set, a_star_bidirectional_priority(child_node), child_node);
+
+    // O estado já foi alcançado pela outra direção, temos um caminho completo
+    a_star_node_t* other = node_allocator_get(other_nodes, neighbor);
+    if(other != NULL)
+    {
+      a_star_bidirectional_meet(a_star, neighbor, child_node->g + other->g);
+    }
+  }
+}
+
+// Liga o caminho da procura para trás, invertido, ao caminho da procura para a frente
+static void a_star_bidirectional_build_solution(a_star_bidirectional_t* a_star)
+{
+  a_star_t* common = a_star->common;
+  a_star_node_t* previous = node_allocator_get(common->node_allocator, a_star->meeting);
+  a_star_node_t* current = node_allocator_get(a_star->backward_nodes, a_star->meeting)->parent;
+
+  // A procura terminou, podemos reutilizar os nós da procura para trás
+  while(current != NULL)
+  {
+    a_star_node_t* next = current->parent;
+    current->g = previous->g + common->d_func(previous->state, current->state);
+    current->h = 0;
+    current->parent = previous;
+    previous = current;
+    current = next;
+  }
+
+  common->solution = previous;
+}
+
+// Resolve o problema através do uso do algoritmo A* bidirecional
+void a_star_bidirectional_solve(a_star_bidirectional_t* a_star, void* initial, void* goal)
+{
+  if(a_star == NULL || goal == NULL)
+  {
+    return;
+  }
+
+  // Limpamos a procura anterior
+  if(a_star->common->expanded > 0 || a_star->common->goal_state != NULL)
+  {
+    print_function print_func = a_star->backward_nodes->print_func;
+    node_allocator_destroy(a_star->backward_nodes);
+    a_star->backward_nodes = node_allocator_create(print_func);
+    if(!a_star_reset(a_star->common) || a_star->backward_nodes == NULL)
+    {
+      return;
+    }
+  }
+  min_heap_clean(a_star->open_forward);
+  min_heap_clean(a_star->open_backward);
+  a_star->best_cost = INT_MAX;
+  a_star->meeting = NULL;
+  a_star->expanded_forward = 0;
+  a_star->expanded_backward = 0;
+
+  // Os estados inicial e objetivo são as raízes das duas procuras
+  a_star->initial_state = state_allocator_new(a_star->common->state_allocator, initial);
+  a_star->common->goal_state = state_allocator_new(a_star->common->state_allocator, goal);
+  if(a_star->initial_state == NULL || a_star->common->goal_state == NULL)
+  {
+    return;
+  }
+
+  a_star_node_t* initial_node = node_allocator_new(a_star->common->node_allocator, a_star->initial_state);
+  initial_node->g = 0;
+  initial_node->h = a_star_bidirectional_h(a_star, true, a_star->initial_state);
+  initial_node->index_in_open_set = 0;
+  min_heap_insert(a_star->open_forward, a_star_bidirectional_priority(initial_node), initial_node);
+
+  a_star_node_t* goal_node = node_allocator_new(a_star->backward_nodes, a_star->common->goal_state);
+  goal_node->g = 0;
+  goal_node->h = a_star_bidirectional_h(a_star, false, a_star->common->goal_state);
+  goal_node->index_in_open_set = 0;
+  min_heap_insert(a_star->open_backward, a_star_bidirectional_priority(goal_node), goal_node);
+
+  // O estado inicial pode já ser o objetivo
+  if(a_star->initial_state == a_star->common->goal_state)
+  {
+    a_star_bidirectional_meet(a_star, a_star->initial_state, 0);
+  }
+
+  linked_list_t* neighbors = linked_list_create();
+
+  clock_gettime(CLOCK_MONOTONIC, &(a_star->common->start_time));
+
+  // Quando uma das direções fica sem nós todos os caminhos possíveis já foram encontrados
+  while(a_star_bidirectional_skip_stale(a_star->open_forward) && a_star_bidirectional_skip_stale(a_star->open_backward))
+  {
+    int forward_cost = a_star->open_forward->data[0].cost;
+    int backward_cost = a_star->open_backward->data[0].cost;
+    int lower_bound = forward_cost < backward_cost ? forward_cost : backward_cost;
+
+    // Nenhum caminho por explorar pode ser melhor do que o melhor encontro
+    if(a_star->best_cost <= lower_bound)
+    {
+      break;
+    }
+
+    if(a_star->common->expanded % BIDIRECTIONAL_CANCEL_INTERVAL == 0 && a_star_cancel_requested(a_star->common))
+    {
+      a_star->common->cancelled = true;
+      break;
+    }
+
+    size_t open_size = a_star->open_forward->size + a_star->open_backward->size;
+    if(a_star->common->max_min_heap_size < open_size)
+      a_star->common->max_min_heap_size = open_size;
+
+    a_star_bidirectional_expand(a_star, forward_cost <= backward_cost, neighbors);
+  }
+
+  // Liberta a lista de vizinhos
+  linked_list_destroy(neighbors);
+
+  if(a_star->meeting != NULL && !a_star->common->cancelled)
+  {
+    a_star_bidirectional_build_solution(a_star);
+  }
+
+  clock_gettime(CLOCK_MONOTONIC, &(a_star->common->end_time));
+  // Calculamos o tempo de execução
+  a_star->common->execution_time = (a_star->common->end_time.tv_sec - a_star->common->start_time.tv_sec);
+  a_star->common->execution_time += (a_star->common->end_time.tv_nsec - a_star->common->start_time.tv_nsec) / 1000000000.0;
+}
+
+// Imprime estatísticas do algoritmo bidirecional no formato desejado
+void a_star_bidirectional_print_statistics(a_star_bidirectional_t* a_star, bool csv, bool show_solution)
+{
+  if(!csv && !show_solution)
+  {
+    printf("Estados expandidos para a frente: %d, para trás: %d\n", a_star->expanded_forward, a_star->expanded_backward);
+  }
+
+  a_star_print_statistics(a_star->common, csv, show_solution);
+}
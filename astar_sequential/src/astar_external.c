@@ -0,0 +1,808 @@
+#include "astar_external.h"
+#include <limits.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/types.h>
+#include <unistd.h>
+
+// Número de posições do gestor temporário de estados
+#define EXTERNAL_SCRATCH_CAPACITY 256
+
+// Número de posições da tabela de baldes (potência de 2)
+#define EXTERNAL_TABLE_SIZE 4096
+
+// Número de registos lidos de cada vez ao percorrer o ficheiro de registo
+#define EXTERNAL_TRACE_CHUNK 65536
+
+// Número de baldes expandidos entre verificações do pedido de cancelamento
+#define EXTERNAL_CANCEL_INTERVAL 64
+
+// Tamanho dos estados comparados pela ordenação, a procura de cada tarefa tem o seu
+static _Thread_local size_t a_star_external_sort_size;
+
+// Cria uma nova instância para resolver um problema
+a_star_external_t* a_star_external_create(size_t struct_size,
+                                          goal_function goal_func,
+                                          visit_function visit_func,
+                                          heuristic_function h_func,
+                                          distance_function d_func,
+                                          print_function print_func,
+                                          const char* directory)
+{
+  a_star_external_t* a_star = (a_star_external_t*)calloc(1, sizeof(a_star_external_t));
+  if(a_star == NULL)
+  {
+    return NULL; // Erro de alocação
+  }
+
+  if(directory == NULL)
+  {
+    directory = getenv("TMPDIR") != NULL ? getenv("TMPDIR") : "/tmp";
+  }
+
+  // Inicializamos a parte comum do nosso algoritmo e as estruturas dos baldes
+  a_star->common = a_star_create(struct_size, goal_func, visit_func, h_func, d_func, print_func);
+  a_star->scratch = state_allocator_create_scratch(struct_size, EXTERNAL_SCRATCH_CAPACITY);
+  a_star->neighbors = linked_list_create();
+  a_star->directory = strdup(directory);
+  a_star->buckets = (a_star_external_bucket_t**)calloc(EXTERNAL_TABLE_SIZE, sizeof(a_star_external_bucket_t*));
+  a_star->num_buckets = EXTERNAL_TABLE_SIZE;
+  a_star->buffer_size = EXTERNAL_BUFFER_SIZE;
+
+  if(a_star->common == NULL || a_star->scratch == NULL || a_star->neighbors == NULL || a_star->directory == NULL ||
+     a_star->buckets == NULL)
+  {
+    a_star_external_destroy(a_star);
+    return NULL;
+  }
+
+  return a_star;
+}
+
+// Define o tamanho do buffer de escrita de cada balde
+void a_star_external_set_buffer_size(a_star_external_t* a_star, size_t buffer_size)
+{
+  if(a_star == NULL || buffer_size == 0)
+  {
+    return;
+  }
+
+  a_star->buffer_size = buffer_size;
+}
+
+// Caminho do ficheiro de um balde ou do registo (bucket NULL)
+static void a_star_external_path(a_star_external_t* a_star, a_star_external_bucket_t* bucket, char* path, size_t size)
+{
+  if(bucket == NULL)
+    snprintf(path, size, "%s/trace", a_star->work_directory);
+  else
+    snprintf(path, size, "%s/%d_%d", a_star->work_directory, bucket->g, bucket->h);
+}
+
+// Atualiza o espaço em disco utilizado
+static inline void a_star_external_disk(a_star_external_t* a_star, size_t added, size_t removed)
+{
+  a_star->disk_in_use += added;
+  a_star->disk_in_use -= removed;
+  if(a_star->max_disk_in_use < a_star->disk_in_use)
+    a_star->max_disk_in_use = a_star->disk_in_use;
+}
+
+// Remove o ficheiro de um balde
+static void a_star_external_unlink(a_star_external_t* a_star, a_star_external_bucket_t* bucket)
+{
+  if(bucket->disk_bytes == 0)
+  {
+    return;
+  }
+
+  char path[PATH_MAX];
+  a_star_external_path(a_star, bucket, path, sizeof(path));
+  unlink(path);
+  a_star_external_disk(a_star, 0, bucket->disk_bytes);
+  bucket->disk_bytes = 0;
+}
+
+// Retorna o balde (g, h), criando-o caso não exista e create seja verdadeiro
+static a_star_external_bucket_t* a_star_external_bucket(a_star_external_t* a_star, int g, int h, bool create)
+{
+  size_t position = ((size_t)g * 31 + (size_t)h) & (a_star->num_buckets - 1);
+  for(a_star_external_bucket_t* bucket = a_star->buckets[position]; bucket != NULL; bucket = bucket->next)
+  {
+    if(bucket->g == g && bucket->h == h)
+    {
+      return bucket;
+    }
+  }
+
+  if(!create)
+  {
+    return NULL;
+  }
+
+  a_star_external_bucket_t* bucket = (a_star_external_bucket_t*)calloc(1, sizeof(a_star_external_bucket_t));
+  if(bucket == NULL)
+  {
+    return NULL;
+  }
+
+  // Novo balde por expandir, entra na lista ordenada por (f, g)
+  if(a_star->open_size == a_star->open_capacity)
+  {
+    size_t new_capacity = a_star->open_capacity > 0 ? a_star->open_capacity * 2 : 64;
+    a_star_external_bucket_t** new_open =
+        (a_star_external_bucket_t**)realloc(a_star->open, new_capacity * sizeof(a_star_external_bucket_t*));
+    if(new_open == NULL)
+    {
+      free(bucket);
+      return NULL;
+    }
+    a_star->open = new_open;
+    a_star->open_capacity = new_capacity;
+  }
+
+  bucket->g = g;
+  bucket->h = h;
+  bucket->next = a_star->buckets[position];
+  a_star->buckets[position] = bucket;
+
+  size_t i = a_star->open_size++;
+  a_star->open[i] = bucket;
+  while(i > 0)
+  {
+    a_star_external_bucket_t* parent = a_star->open[(i - 1) / 2];
+    int f = g + h;
+    int parent_f = parent->g + parent->h;
+    if(parent_f < f || (parent_f == f && parent->g <= g))
+      break;
+    a_star->open[i] = parent;
+    a_star->open[(i - 1) / 2] = bucket;
+    i = (i - 1) / 2;
+  }
+
+  return bucket;
+}
+
+// Retira o próximo balde a expandir, o de menor f e, no mesmo f, de menor g
+static a_star_external_bucket_t* a_star_external_pop(a_star_external_t* a_star)
+{
+  a_star_external_bucket_t* top = a_star->open[0];
+  a_star->open[0] = a_star->open[--a_star->open_size];
+
+  size_t i = 0;
+  while(true)
+  {
+    size_t best = i;
+    for(size_t child = 2 * i + 1; child <= 2 * i + 2 && child < a_star->open_size; child++)
+    {
+      a_star_external_bucket_t* a = a_star->open[child];
+      a_star_external_bucket_t* b = a_star->open[best];
+      if(a->g + a->h < b->g + b->h || (a->g + a->h == b->g + b->h && a->g < b->g))
+        best = child;
+    }
+    if(best == i)
+      break;
+    a_star_external_bucket_t* tmp = a_star->open[i];
+    a_star->open[i] = a_star->open[best];
+    a_star->open[best] = tmp;
+    i = best;
+  }
+
+  return top;
+}
+
+// Escreve o buffer do balde no fim do seu ficheiro, numa única escrita
+static bool a_star_external_flush(a_star_external_t* a_star, a_star_external_bucket_t* bucket)
+{
+  if(bucket->used == 0)
+  {
+    return true;
+  }
+
+  char path[PATH_MAX];
+  a_star_external_path(a_star, bucket, path, sizeof(path));
+  FILE* file = fopen(path, "ab");
+  if(file == NULL)
+  {
+    return false;
+  }
+
+  size_t written = fwrite(bucket->buffer, 1, bucket->used, file);
+  fclose(file);
+  if(written != bucket->used)
+  {
+    return false;
+  }
+
+  if(bucket->disk_bytes == 0)
+    a_star->files_created++;
+  bucket->disk_bytes += written;
+  a_star->bytes_written += written;
+  a_star_external_disk(a_star, written, 0);
+  bucket->used = 0;
+  return true;
+}
+
+// Acrescenta um registo ao balde, o buffer cresce até ao tamanho configurado e depois passa para disco
+static bool a_star_external_append(a_star_external_t* a_star, a_star_external_bucket_t* bucket, const void* record, size_t size)
+{
+  if(bucket->used + size > bucket->capacity)
+  {
+    if(bucket->capacity >= a_star->buffer_size && !a_star_external_flush(a_star, bucket))
+    {
+      return false;
+    }
+
+    if(bucket->used + size > bucket->capacity)
+    {
+      size_t new_capacity = bucket->capacity > 0 ? bucket->capacity * 2 : 16 * size;
+      while(new_capacity < bucket->used + size)
+        new_capacity *= 2;
+      if(new_capacity > a_star->buffer_size && a_star->buffer_size >= bucket->used + size)
+        new_capacity = a_star->buffer_size;
+      char* new_buffer = (char*)realloc(bucket->buffer, new_capacity);
+      if(new_buffer == NULL)
+      {
+        return false;
+      }
+      bucket->buffer = new_buffer;
+      bucket->capacity = new_capacity;
+    }
+  }
+
+  memcpy(bucket->buffer + bucket->used, record, size);
+  bucket->used += size;
+  return true;
+}
+
+// Lê o conteúdo completo de um balde (ficheiro e buffer) para memória, size recebe o número de bytes
+static char* a_star_external_read(a_star_external_t* a_star, a_star_external_bucket_t* bucket, size_t* size)
+{
+  *size = bucket->disk_bytes + bucket->used;
+  char* data = (char*)malloc(*size > 0 ? *size : 1);
+  if(data == NULL)
+  {
+    return NULL;
+  }
+
+  if(bucket->disk_bytes > 0)
+  {
+    char path[PATH_MAX];
+    a_star_external_path(a_star, bucket, path, sizeof(path));
+    FILE* file = fopen(path, "rb");
+    size_t read = file != NULL ? fread(data, 1, bucket->disk_bytes, file) : 0;
+    if(file != NULL)
+      fclose(file);
+    if(read != bucket->disk_bytes)
+    {
+      free(data);
+      return NULL;
+    }
+    a_star->bytes_read += read;
+  }
+
+  memcpy(data + bucket->disk_bytes, bucket->buffer, bucket->used);
+  return data;
+}
+
+// Liberta um balde e o seu ficheiro
+static void a_star_external_release(a_star_external_t* a_star, a_star_external_bucket_t* bucket)
+{
+  size_t position = ((size_t)bucket->g * 31 + (size_t)bucket->h) & (a_star->num_buckets - 1);
+  a_star_external_bucket_t** link = &a_star->buckets[position];
+  while(*link != bucket)
+  {
+    link = &(*link)->next;
+  }
+  *link = bucket->next;
+
+  a_star_external_unlink(a_star, bucket);
+  free(bucket->buffer);
+  free(bucket);
+}
+
+// Liberta todos os baldes e ficheiros da procura
+static void a_star_external_clear(a_star_external_t* a_star)
+{
+  for(size_t i = 0; i < a_star->num_buckets; i++)
+  {
+    while(a_star->buckets[i] != NULL)
+    {
+      a_star_external_release(a_star, a_star->buckets[i]);
+    }
+  }
+  a_star->open_size = 0;
+  a_star->closed_first = a_star->closed_last = NULL;
+
+  if(a_star->trace != NULL)
+  {
+    char path[PATH_MAX];
+    a_star_external_path(a_star, NULL, path, sizeof(path));
+    fclose(a_star->trace);
+    unlink(path);
+    a_star->trace = NULL;
+  }
+
+  if(a_star->work_directory != NULL)
+  {
+    rmdir(a_star->work_directory);
+    free(a_star->work_directory);
+    a_star->work_directory = NULL;
+  }
+  a_star->disk_in_use = 0;
+}
+
+// Liberta uma instância do algoritmo A* em memória externa
+void a_star_external_destroy(a_star_external_t* a_star)
+{
+  if(a_star == NULL)
+  {
+    return;
+  }
+
+  if(a_star->buckets != NULL)
+    a_star_external_clear(a_star);
+  free(a_star->buckets);
+  free(a_star->open);
+  free(a_star->directory);
+  state_allocator_destroy(a_star->scratch);
+  linked_list_destroy(a_star->neighbors);
+
+  // Invocamos o destroy da parte comum
+  a_star_destroy(a_star->common);
+
+  free(a_star);
+}
+
+// Ordem dos registos pelos bytes do estado, o início de cada registo
+static int a_star_external_compare(const void* a, const void* b)
+{
+  return memcmp(a, b, a_star_external_sort_size);
+}
+
+// Estado guardado num registo para as funções do problema
+static inline state_t* a_star_external_view(a_star_external_t* a_star, const void* data, state_t* view)
+{
+  view->hash = 0;
+  view->struct_size = a_star->common->state_allocator->struct_size;
+  view->data = (void*)data;
+  return view;
+}
+
+// Remove dos registos ordenados os estados que existem no balde fechado (g, h), retorna quantos ficam
+static size_t a_star_external_subtract(a_star_external_t* a_star, char* records, size_t count, size_t record_size, int g, int h)
+{
+  a_star_external_bucket_t* closed = g >= 0 ? a_star_external_bucket(a_star, g, h, false) : NULL;
+  if(closed == NULL || !closed->closed || count == 0)
+  {
+    return count;
+  }
+
+  size_t struct_size = a_star->common->state_allocator->struct_size;
+  size_t closed_bytes;
+  char* closed_states = a_star_external_read(a_star, closed, &closed_bytes);
+  if(closed_states == NULL)
+  {
+    return count;
+  }
+
+  // Os dois conjuntos estão ordenados, percorremos ambos em simultâneo
+  size_t closed_count = closed_bytes / struct_size;
+  size_t kept = 0;
+  size_t j = 0;
+  for(size_t i = 0; i < count; i++)
+  {
+    char* record = records + i * record_size;
+    int cmp = 1;
+    while(j < closed_count && (cmp = memcmp(closed_states + j * struct_size, record, struct_size)) < 0)
+    {
+      j++;
+    }
+
+    if(j < closed_count && cmp == 0)
+    {
+      a_star->duplicates_removed++;
+      continue;
+    }
+
+    if(kept != i)
+      memcpy(records + kept * record_size, record, record_size);
+    kept++;
+  }
+
+  free(closed_states);
+  return kept;
+}
+
+// Liberta os baldes fechados que já não podem ser utilizados para remover duplicados
+static void a_star_external_forget_closed(a_star_external_t* a_star, int f)
+{
+  while(a_star->closed_first != NULL && a_star->closed_first->g + a_star->closed_first->h < f - 2)
+  {
+    a_star_external_bucket_t* bucket = a_star->closed_first;
+    a_star->closed_first = bucket->next_closed;
+    if(a_star->closed_first == NULL)
+      a_star->closed_last = NULL;
+    a_star_external_release(a_star, bucket);
+  }
+}
+
+// Expande um balde, retorna verdadeiro se encontrou o objetivo, cujo estado é copiado para goal_record
+static bool a_star_external_expand(a_star_external_t* a_star, a_star_external_bucket_t* bucket, char* goal_record)
+{
+  a_star_t* common = a_star->common;
+  size_t struct_size = common->state_allocator->struct_size;
+  size_t record_size = 2 * struct_size;
+
+  // Lemos o balde e libertamos o seu ficheiro, o conteúdo passa a ser o conjunto fechado
+  size_t bytes;
+  char* records = a_star_external_read(a_star, bucket, &bytes);
+  a_star_external_unlink(a_star, bucket);
+  bucket->used = 0;
+  if(records == NULL)
+  {
+    a_star->failed = true;
+    return false;
+  }
+
+  // Duplicados dentro do balde e nos dois baldes fechados anteriores com a mesma heurística
+  size_t count = bytes / record_size;
+  a_star_external_sort_size = struct_size;
+  qsort(records, count, record_size, a_star_external_compare);
+
+  size_t unique = 0;
+  for(size_t i = 0; i < count; i++)
+  {
+    if(unique > 0 && memcmp(records + (unique - 1) * record_size, records + i * record_size, struct_size) == 0)
+    {
+      a_star->duplicates_removed++;
+      continue;
+    }
+    if(unique != i)
+      memcpy(records + unique * record_size, records + i * record_size, record_size);
+    unique++;
+  }
+  count = a_star_external_subtract(a_star, records, unique, record_size, bucket->g - 1, bucket->h);
+  count = a_star_external_subtract(a_star, records, count, record_size, bucket->g - 2, bucket->h);
+
+  if(common->max_min_heap_size < count)
+    common->max_min_heap_size = count;
+
+  // O balde passa a conter apenas os estados, ordenados, para remover os duplicados dos seguintes
+  bucket->closed = true;
+  if(a_star->closed_last != NULL)
+    a_star->closed_last->next_closed = bucket;
+  else
+    a_star->closed_first = bucket;
+  a_star->closed_last = bucket;
+
+  bool found = false;
+  state_t current_view;
+  for(size_t i = 0; i < count && !found; i++)
+  {
+    char* record = records + i * record_size;
+    a_star_external_append(a_star, bucket, record, struct_size);
+
+    // Registo do estado expandido, com o pai e o custo
+    fwrite(record, 1, record_size, a_star->trace);
+    fwrite(&bucket->g, sizeof(int), 1, a_star->trace);
+    a_star->trace_records++;
+    a_star->bytes_written += record_size + sizeof(int);
+    a_star_external_disk(a_star, record_size + sizeof(int), 0);
+
+    a_star_external_view(a_star, record, &current_view);
+    if(common->goal_func(&current_view, common->goal_state))
+    {
+      memcpy(goal_record, record, struct_size);
+      found = true;
+      break;
+    }
+
+    common->expanded++;
+    common->visit_func(&current_view, a_star->scratch, a_star->neighbors);
+    while(linked_list_size(a_star->neighbors))
+    {
+      state_t* neighbor = (state_t*)linked_list_pop_back(a_star->neighbors);
+
+      // O pai não volta a ser gerado, é um duplicado removido sem passar pelo disco
+      if(memcmp(neighbor->data, record + struct_size, struct_size) == 0 && bucket->g > 0)
+      {
+        a_star->duplicates_removed++;
+        continue;
+      }
+
+      int g = bucket->g + common->d_func(&current_view, neighbor);
+      int h = common->h_func(neighbor, common->goal_state);
+      a_star_external_bucket_t* child_bucket = a_star_external_bucket(a_star, g, h, true);
+
+      // Sem memória para o balde o filho perdia-se e a procura podia terminar sem solução
+      if(child_bucket == NULL)
+      {
+        a_star->failed = true;
+        break;
+      }
+
+      // Um balde já expandido só recebe nós com uma heurística inconsistente, que não é suportada
+      if(child_bucket->closed)
+      {
+        continue;
+      }
+
+      // O registo de um filho é o seu estado seguido do estado do pai
+      char child_record[record_size];
+      memcpy(child_record, neighbor->data, struct_size);
+      memcpy(child_record + struct_size, record, struct_size);
+      if(!a_star_external_append(a_star, child_bucket, child_record, record_size))
+      {
+        a_star->failed = true;
+        break;
+      }
+      common->generated++;
+      common->nodes_new++;
+    }
+    state_allocator_scratch_reset(a_star->scratch);
+
+    if(a_star->failed)
+    {
+      // Os vizinhos por tratar são descartados
+      while(linked_list_size(a_star->neighbors))
+        linked_list_pop_back(a_star->neighbors);
+      break;
+    }
+  }
+
+  free(records);
+  return found;
+}
+
+// Recupera o caminho percorrendo o ficheiro de registo do fim para o início
+static void a_star_external_build_solution(a_star_external_t* a_star, const char* goal_record, int goal_g)
+{
+  a_star_t* common = a_star->common;
+  size_t struct_size = common->state_allocator->struct_size;
+  size_t trace_size = 2 * struct_size + sizeof(int);
+
+  fflush(a_star->trace);
+  char* chunk = (char*)malloc(EXTERNAL_TRACE_CHUNK * trace_size);
+  char* path = NULL;
+  size_t path_length = 0;
+  size_t path_capacity = 0;
+
+  // Estado procurado e o seu custo, cada antecessor foi expandido antes dos seus descendentes
+  char target[struct_size];
+  memcpy(target, goal_record, struct_size);
+  int target_g = goal_g;
+  bool done = false;
+
+  size_t remaining = a_star->trace_records;
+  while(remaining > 0 && !done && chunk != NULL)
+  {
+    size_t records = remaining < EXTERNAL_TRACE_CHUNK ? remaining : EXTERNAL_TRACE_CHUNK;
+    remaining -= records;
+    if(fseeko(a_star->trace, (off_t)(remaining * trace_size), SEEK_SET) != 0 ||
+       fread(chunk, trace_size, records, a_star->trace) != records)
+    {
+      break;
+    }
+    a_star->bytes_read += records * trace_size;
+
+    for(size_t i = records; i-- > 0 && !done;)
+    {
+      char* record = chunk + i * trace_size;
+      int g;
+      memcpy(&g, record + 2 * struct_size, sizeof(int));
+      if(g != target_g || memcmp(record, target, struct_size) != 0)
+      {
+        continue;
+      }
+
+      if(path_length == path_capacity)
+      {
+        path_capacity = path_capacity > 0 ? path_capacity * 2 : 256;
+        char* new_path = (char*)realloc(path, path_capacity * struct_size);
+        if(new_path == NULL)
+        {
+          done = true;
+          break;
+        }
+        path = new_path;
+      }
+      memcpy(path + path_length++ * struct_size, record, struct_size);
+
+      if(g == 0)
+      {
+        done = true;
+        break;
+      }
+
+      // O próximo estado procurado é o pai, com o custo g menos o custo da aresta
+      state_t parent_view, current_view;
+      a_star_external_view(a_star, record + struct_size, &parent_view);
+      a_star_external_view(a_star, record, &current_view);
+      target_g = g - common->d_func(&parent_view, &current_view);
+      memcpy(target, record + struct_size, struct_size);
+    }
+  }
+  fseeko(a_star->trace, 0, SEEK_END);
+
+  // O caminho foi recolhido do objetivo para o início
+  if(done && path_length > 0)
+  {
+    a_star_node_t* parent = NULL;
+    for(size_t i = path_length; i-- > 0;)
+    {
+      state_t* state = state_allocator_new(common->state_allocator, path + i * struct_size);
+      a_star_node_t* node = node_allocator_new(common->node_allocator, state);
+      if(node == NULL)
+      {
+        break;
+      }
+
+      node->parent = parent;
+      node->g = parent != NULL ? parent->g + common->d_func(parent->state, state) : 0;
+      node->h = common->h_func(state, common->goal_state);
+      node->index_in_open_set = SIZE_MAX;
+      parent = node;
+    }
+
+    common->solution = parent;
+    common->num_solutions = common->num_better_solutions = 1;
+  }
+
+  free(path);
+  free(chunk);
+}
+
+// Resolve o problema através do uso do algoritmo A* em memória externa
+void a_star_external_solve(a_star_external_t* a_star, void* initial, void* goal)
+{
+  if(a_star == NULL)
+  {
+    return;
+  }
+
+  // Limpamos a procura anterior
+  if(a_star->common->expanded > 0 || a_star->common->goal_state != NULL || a_star->common->solution != NULL)
+  {
+    if(!a_star_reset(a_star->common))
+    {
+      return;
+    }
+  }
+  a_star_external_clear(a_star);
+  a_star->trace_records = 0;
+  a_star->max_disk_in_use = 0;
+  a_star->bytes_written = 0;
+  a_star->bytes_read = 0;
+  a_star->max_layer_io = 0;
+  a_star->layer_io_start = 0;
+  a_star->num_layers = 0;
+  a_star->files_created = 0;
+  a_star->duplicates_removed = 0;
+  a_star->failed = false;
+
+  if(goal)
+  {
+    a_star->common->goal_state = state_allocator_new(a_star->common->state_allocator, goal);
+    if(a_star->common->goal_state == NULL)
+    {
+      return;
+    }
+  }
+
+  // Diretório próprio para os ficheiros desta procura
+  size_t length = strlen(a_star->directory) + sizeof("/astar_external_XXXXXX");
+  a_star->work_directory = (char*)malloc(length);
+  if(a_star->work_directory == NULL)
+  {
+    return;
+  }
+  snprintf(a_star->work_directory, length, "%s/astar_external_XXXXXX", a_star->directory);
+  if(mkdtemp(a_star->work_directory) == NULL)
+  {
+    printf("Erro: não foi possível criar o diretório temporário em %s.\n", a_star->directory);
+    free(a_star->work_directory);
+    a_star->work_directory = NULL;
+    return;
+  }
+
+  char path[PATH_MAX];
+  a_star_external_path(a_star, NULL, path, sizeof(path));
+  a_star->trace = fopen(path, "w+b");
+  if(a_star->trace == NULL)
+  {
+    a_star_external_clear(a_star);
+    return;
+  }
+  setvbuf(a_star->trace, NULL, _IOFBF, a_star->buffer_size);
+
+  // O estado inicial é o único registo do primeiro balde, sendo o seu próprio pai
+  size_t struct_size = a_star->common->state_allocator->struct_size;
+  state_t* initial_state = state_allocator_new(a_star->scratch, initial);
+  int initial_h = a_star->common->h_func(initial_state, a_star->common->goal_state);
+  char initial_record[2 * struct_size];
+  memcpy(initial_record, initial, struct_size);
+  memcpy(initial_record + struct_size, initial, struct_size);
+  state_allocator_scratch_reset(a_star->scratch);
+  a_star_external_append(a_star, a_star_external_bucket(a_star, 0, initial_h, true), initial_record, sizeof(initial_record));
+
+  clock_gettime(CLOCK_MONOTONIC, &(a_star->common->start_time));
+
+  char goal_record[struct_size];
+  int goal_g = -1;
+  int layer_f = -1;
+  int buckets_expanded = 0;
+  while(a_star->open_size > 0)
+  {
+    if(buckets_expanded++ % EXTERNAL_CANCEL_INTERVAL == 0 && a_star_cancel_requested(a_star->common))
+    {
+      a_star->common->cancelled = true;
+      break;
+    }
+
+    a_star_external_bucket_t* bucket = a_star_external_pop(a_star);
+    int f = bucket->g + bucket->h;
+
+    // Nova camada f: os baldes fechados antigos já não são precisos
+    if(f != layer_f)
+    {
+      size_t io = a_star->bytes_written + a_star->bytes_read;
+      if(layer_f >= 0 && a_star->max_layer_io < io - a_star->layer_io_start)
+        a_star->max_layer_io = io - a_star->layer_io_start;
+      a_star->layer_io_start = io;
+      a_star->num_layers++;
+      layer_f = f;
+      a_star_external_forget_closed(a_star, f);
+    }
+
+    if(a_star_external_expand(a_star, bucket, goal_record))
+    {
+      goal_g = bucket->g;
+      break;
+    }
+
+    if(a_star->failed)
+    {
+      printf("Erro: procura interrompida por falta de memória ou erro de leitura/escrita em %s.\n", a_star->work_directory);
+      break;
+    }
+  }
+
+  size_t io = a_star->bytes_written + a_star->bytes_read;
+  if(a_star->max_layer_io < io - a_star->layer_io_start)
+    a_star->max_layer_io = io - a_star->layer_io_start;
+
+  if(goal_g >= 0 && !a_star->common->cancelled)
+  {
+    a_star_external_build_solution(a_star, goal_record, goal_g);
+  }
+
+  // Os ficheiros da procura são removidos, a solução já está em memória
+  a_star_external_clear(a_star);
+
+  clock_gettime(CLOCK_MONOTONIC, &(a_star->common->end_time));
+  // Calculamos o tempo de execução
+  a_star->common->execution_time = (a_star->common->end_time.tv_sec - a_star->common->start_time.tv_sec);
+  a_star->common->execution_time += (a_star->common->end_time.tv_nsec - a_star->common->start_time.tv_nsec) / 1000000000.0;
+}
+
+// Imprime estatísticas do algoritmo A* em memória externa no formato desejado
+void a_star_external_print_statistics(a_star_external_t* a_star, bool csv, bool show_solution)
+{
+  if(!csv && !show_solution)
+  {
+    double mb = 1024.0 * 1024.0;
+    printf("Disco: máximo %.2f MB em uso, %.2f MB escritos, %.2f MB lidos, %d ficheiros de baldes\n",
+           a_star->max_disk_in_use / mb,
+           a_star->bytes_written / mb,
+           a_star->bytes_read / mb,
+           a_star->files_created);
+    printf("Camadas f: %d, máximo de %.2f MB lidos e escritos numa camada, duplicados removidos: %ld\n",
+           a_star->num_layers,
+           a_star->max_layer_io / mb,
+           a_star->duplicates_removed);
+  }
+
+  a_star_print_statistics(a_star->common, csv, show_solution);
+}
@@ -0,0 +1,275 @@
+#include "astar_fringe.h"
+#include <limits.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+// Número de expansões entre verificações do pedido de cancelamento
+#define FRINGE_CANCEL_INTERVAL 1024
+
+// Cria uma nova instância para resolver um problema
+a_star_fringe_t* a_star_fringe_create(size_t struct_size,
+                                      goal_function goal_func,
+                                      visit_function visit_func,
+                                      heuristic_function h_func,
+                                      distance_function d_func,
+                                      print_function print_func)
+{
+  a_star_fringe_t* a_star = (a_star_fringe_t*)calloc(1, sizeof(a_star_fringe_t));
+  if(a_star == NULL)
+  {
+    return NULL; // Erro de alocação
+  }
+
+  // Inicializamos a parte comum do nosso algoritmo, a lista cresce durante a procura
+  a_star->common = a_star_create(struct_size, goal_func, visit_func, h_func, d_func, print_func);
+  a_star->head = a_star->tail = a_star->free_link = SIZE_MAX;
+
+  if(a_star->common == NULL)
+  {
+    a_star_fringe_destroy(a_star);
+    return NULL;
+  }
+
+  return a_star;
+}
+
+// Liberta uma instância do algoritmo Fringe Search
+void a_star_fringe_destroy(a_star_fringe_t* a_star)
+{
+  if(a_star == NULL)
+  {
+    return;
+  }
+
+  free(a_star->links);
+
+  // Invocamos o destroy da parte comum
+  a_star_destroy(a_star->common);
+
+  free(a_star);
+}
+
+// Insere um nó na lista a seguir à posição after (SIZE_MAX: no fim da lista)
+static bool a_star_fringe_insert(a_star_fringe_t* a_star, a_star_node_t* node, size_t after)
+{
+  size_t index = a_star->free_link;
+  if(index != SIZE_MAX)
+  {
+    a_star->free_link = a_star->links[index].next;
+  }
+  else
+  {
+    if(a_star->links_used == a_star->links_capacity)
+    {
+      size_t new_capacity = a_star->links_capacity > 0 ? a_star->links_capacity * 2 : 1024;
+      a_star_fringe_link_t* new_links =
+          (a_star_fringe_link_t*)realloc(a_star->links, new_capacity * sizeof(a_star_fringe_link_t));
+      if(new_links == NULL)
+      {
+        return false;
+      }
+      a_star->links = new_links;
+      a_star->links_capacity = new_capacity;
+    }
+    index = a_star->links_used++;
+  }
+
+  a_star_fringe_link_t* link = &a_star->links[index];
+  link->node = node;
+  link->prev = after != SIZE_MAX ? after : a_star->tail;
+  link->next = after != SIZE_MAX ? a_star->links[after].next : SIZE_MAX;
+  if(link->prev != SIZE_MAX)
+    a_star->links[link->prev].next = index;
+  else
+    a_star->head = index;
+  if(link->next != SIZE_MAX)
+    a_star->links[link->next].prev = index;
+  else
+    a_star->tail = index;
+
+  node->index_in_open_set = index;
+  if(++a_star->size > a_star->common->max_min_heap_size)
+    a_star->common->max_min_heap_size = a_star->size;
+  return true;
+}
+
+// Retira um nó da lista, a posição fica livre para ser reutilizada
+static void a_star_fringe_remove(a_star_fringe_t* a_star, a_star_node_t* node)
+{
+  size_t index = node->index_in_open_set;
+  a_star_fringe_link_t* link = &a_star->links[index];
+  if(link->prev != SIZE_MAX)
+    a_star->links[link->prev].next = link->next;
+  else
+    a_star->head = link->next;
+  if(link->next != SIZE_MAX)
+    a_star->links[link->next].prev = link->prev;
+  else
+    a_star->tail = link->prev;
+
+  link->next = a_star->free_link;
+  a_star->free_link = index;
+  node->index_in_open_set = SIZE_MAX;
+  a_star->size--;
+}
+
+// Expande um nó, os filhos novos ou melhorados ficam a seguir a ele na lista
+static void a_star_fringe_expand(a_star_fringe_t* a_star, a_star_node_t* current_node, linked_list_t* neighbors)
+{
+  a_star_t* common = a_star->common;
+  common->visit_func(current_node->state, common->state_allocator, neighbors);
+  while(linked_list_size(neighbors))
+  {
+    state_t* neighbor = (state_t*)linked_list_pop_back(neighbors);
+    int g_attempt = current_node->g + common->d_func(current_node->state, neighbor);
+
+    a_star_node_t* child_node = node_allocator_get(common->node_allocator, neighbor);
+    if(!child_node)
+    {
+      // Este nó ainda não existe, criamos um novo nó
+      child_node = node_allocator_new(common->node_allocator, neighbor);
+      child_node->h = common->h_func(child_node->state, common->goal_state);
+      common->generated++;
+      common->nodes_new++;
+    }
+    else if(g_attempt >= child_node->g)
+    {
+      // Existe outro caminho mais curto para este nó
+      common->paths_worst_or_equals++;
+      continue;
+    }
+    else
+    {
+      // O nó atual é o caminho mais curto para este vizinho, o nó muda de posição na lista
+      common->paths_better++;
+      if(child_node->index_in_open_set != SIZE_MAX)
+        a_star_fringe_remove(a_star, child_node);
+      else
+        common->nodes_reinserted++;
+    }
+
+    child_node->parent = current_node;
+    child_node->g = g_attempt;
+    a_star_fringe_insert(a_star, child_node, current_node->index_in_open_set);
+  }
+}
+
+// Resolve o problema através do uso do algoritmo Fringe Search
+void a_star_fringe_solve(a_star_fringe_t* a_star, void* initial, void* goal)
+{
+  if(a_star == NULL)
+  {
+    return;
+  }
+
+  // Limpamos a procura anterior
+  if(a_star->common->expanded > 0 || a_star->common->goal_state != NULL || a_star->common->solution != NULL)
+  {
+    if(!a_star_reset(a_star->common))
+    {
+      return;
+    }
+  }
+  a_star->links_used = 0;
+  a_star->size = 0;
+  a_star->head = a_star->tail = a_star->free_link = SIZE_MAX;
+  a_star->passes = 0;
+  a_star->revisits = 0;
+  a_star->final_threshold = 0;
+
+  if(goal)
+  {
+    a_star->common->goal_state = state_allocator_new(a_star->common->state_allocator, goal);
+    if(a_star->common->goal_state == NULL)
+    {
+      return;
+    }
+  }
+
+  // O estado inicial é o único nó da lista, o primeiro limite é a sua heurística
+  state_t* initial_state = state_allocator_new(a_star->common->state_allocator, initial);
+  a_star_node_t* initial_node = node_allocator_new(a_star->common->node_allocator, initial_state);
+  if(initial_node == NULL)
+  {
+    return;
+  }
+  initial_node->g = 0;
+  initial_node->h = a_star->common->h_func(initial_node->state, a_star->common->goal_state);
+  a_star_fringe_insert(a_star, initial_node, SIZE_MAX);
+
+  // Esta lista irá receber os vizinhos de um nó
+  linked_list_t* neighbors = linked_list_create();
+
+  clock_gettime(CLOCK_MONOTONIC, &(a_star->common->start_time));
+
+  int threshold = initial_node->h;
+  while(a_star->size > 0 && a_star->common->solution == NULL && !a_star->common->cancelled)
+  {
+    int next_threshold = INT_MAX;
+    a_star->passes++;
+
+    size_t index = a_star->head;
+    while(index != SIZE_MAX)
+    {
+      a_star_node_t* current_node = a_star->links[index].node;
+      int f = current_node->g + current_node->h;
+
+      // Acima do limite o nó fica para a próxima passagem
+      if(f > threshold)
+      {
+        if(f < next_threshold)
+          next_threshold = f;
+        a_star->revisits++;
+        index = a_star->links[index].next;
+        continue;
+      }
+
+      // Se encontramos o objetivo saímos e guardamos o nó
+      if(a_star->common->goal_func(current_node->state, a_star->common->goal_state))
+      {
+        a_star->common->num_solutions = a_star->common->num_better_solutions = 1;
+        a_star->common->solution = current_node;
+        break;
+      }
+
+      if(++a_star->common->expanded % FRINGE_CANCEL_INTERVAL == 0 && a_star_cancel_requested(a_star->common))
+      {
+        a_star->common->cancelled = true;
+        break;
+      }
+
+      // Os filhos ficam logo a seguir ao nó e são visitados ainda nesta passagem
+      a_star_fringe_expand(a_star, current_node, neighbors);
+      index = a_star->links[index].next;
+      a_star_fringe_remove(a_star, current_node);
+    }
+
+    a_star->final_threshold = threshold;
+    if(next_threshold == INT_MAX)
+      break;
+    threshold = next_threshold;
+  }
+
+  // Liberta a lista de vizinhos
+  linked_list_destroy(neighbors);
+
+  clock_gettime(CLOCK_MONOTONIC, &(a_star->common->end_time));
+  // Calculamos o tempo de execução
+  a_star->common->execution_time = (a_star->common->end_time.tv_sec - a_star->common->start_time.tv_sec);
+  a_star->common->execution_time += (a_star->common->end_time.tv_nsec - a_star->common->start_time.tv_nsec) / 1000000000.0;
+}
+
+// Imprime estatísticas do algoritmo Fringe Search no formato desejado
+void a_star_fringe_print_statistics(a_star_fringe_t* a_star, bool csv, bool show_solution)
+{
+  if(!csv && !show_solution)
+  {
+    printf("Fringe: %d passagens, limite final de f: %d, nós adiados para a passagem seguinte: %ld\n",
+           a_star->passes,
+           a_star->final_threshold,
+           a_star->revisits);
+  }
+
+  a_star_print_statistics(a_star->common, csv, show_solution);
+}
@@ -0,0 +1,635 @@
+#include "astar_frontier.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// Número de posições do gestor temporário, tem de ser maior que o número de vizinhos de um estado
+#define FRONTIER_SCRATCH_CAPACITY 256
+
+// Capacidade inicial da tabela, da lista aberta e das camadas de retransmissão
+#define FRONTIER_INITIAL_CAPACITY 1024
+
+// Número máximo de operadores marcados por nó
+#define FRONTIER_MAX_OPERATORS 64
+
+// Número de expansões entre verificações do pedido de cancelamento
+#define FRONTIER_CANCEL_INTERVAL 1024
+
+// Cria uma nova instância para resolver um problema
+a_star_frontier_t* a_star_frontier_create(size_t struct_size,
+                                          goal_function goal_func,
+                                          visit_function visit_func,
+                                          heuristic_function h_func,
+                                          distance_function d_func,
+                                          print_function print_func)
+{
+  a_star_frontier_t* a_star = (a_star_frontier_t*)calloc(1, sizeof(a_star_frontier_t));
+  if(a_star == NULL)
+  {
+    return NULL; // Erro de alocação
+  }
+
+  // Inicializamos a parte comum do nosso algoritmo e as estruturas da fronteira
+  a_star->common = a_star_create(struct_size, goal_func, visit_func, h_func, d_func, print_func);
+  a_star->scratch = state_allocator_create_scratch(struct_size, FRONTIER_SCRATCH_CAPACITY);
+  a_star->neighbors = linked_list_create();
+  a_star->buckets = (a_star_frontier_entry_t**)calloc(FRONTIER_INITIAL_CAPACITY, sizeof(a_star_frontier_entry_t*));
+  a_star->heap = (a_star_frontier_entry_t**)malloc(FRONTIER_INITIAL_CAPACITY * sizeof(a_star_frontier_entry_t*));
+  a_star->relays = (a_star_frontier_relay_t*)malloc(FRONTIER_INITIAL_CAPACITY * sizeof(a_star_frontier_relay_t));
+  a_star->relay_data = (char*)malloc(FRONTIER_INITIAL_CAPACITY * struct_size);
+  a_star->num_buckets = FRONTIER_INITIAL_CAPACITY;
+  a_star->heap_capacity = FRONTIER_INITIAL_CAPACITY;
+  a_star->relays_capacity = FRONTIER_INITIAL_CAPACITY;
+  a_star->relay_interval = FRONTIER_RELAY_INTERVAL;
+
+  if(a_star->common == NULL || a_star->scratch == NULL || a_star->neighbors == NULL || a_star->buckets == NULL ||
+     a_star->heap == NULL || a_star->relays == NULL || a_star->relay_data == NULL)
+  {
+    a_star_frontier_destroy(a_star);
+    return NULL;
+  }
+
+  return a_star;
+}
+
+// Define a distância (em passos) entre camadas de retransmissão
+void a_star_frontier_set_relay_interval(a_star_frontier_t* a_star, int relay_interval)
+{
+  if(a_star == NULL || relay_interval < 1)
+  {
+    return;
+  }
+
+  a_star->relay_interval = relay_interval;
+}
+
+// Liberta todos os nós abertos da tabela
+static void a_star_frontier_clear(a_star_frontier_t* a_star)
+{
+  for(size_t i = 0; i < a_star->num_buckets; i++)
+  {
+    a_star_frontier_entry_t* entry = a_star->buckets[i];
+    while(entry != NULL)
+    {
+      a_star_frontier_entry_t* next = entry->next;
+      free(entry);
+      entry = next;
+    }
+    a_star->buckets[i] = NULL;
+  }
+
+  a_star->num_entries = 0;
+  a_star->heap_size = 0;
+  a_star->num_relays = 0;
+}
+
+// Liberta uma instância do algoritmo A* de fronteira
+void a_star_frontier_destroy(a_star_frontier_t* a_star)
+{
+  if(a_star == NULL)
+  {
+    return;
+  }
+
+  if(a_star->buckets != NULL)
+  {
+    a_star_frontier_clear(a_star);
+    free(a_star->buckets);
+  }
+  free(a_star->heap);
+  free(a_star->relays);
+  free(a_star->relay_data);
+  free(a_star->children);
+  free(a_star->reverse_children);
+  if(a_star->neighbors != NULL)
+    linked_list_destroy(a_star->neighbors);
+  state_allocator_destroy(a_star->scratch);
+
+  // Invocamos o destroy da parte comum
+  a_star_destroy(a_star->common);
+
+  free(a_star);
+}
+
+// Procura um estado entre os nós abertos
+static a_star_frontier_entry_t* a_star_frontier_find(a_star_frontier_t* a_star, const void* data, size_t hash)
+{
+  size_t struct_size = a_star->common->state_allocator->struct_size;
+  a_star_frontier_entry_t* entry = a_star->buckets[hash & (a_star->num_buckets - 1)];
+  while(entry != NULL)
+  {
+    if(entry->hash == hash && memcmp(entry->data, data, struct_size) == 0)
+    {
+      return entry;
+    }
+    entry = entry->next;
+  }
+  return NULL;
+}
+
+// Acrescenta um nó à tabela, duplicando o número de posições quando fica cheia
+static bool a_star_frontier_insert(a_star_frontier_t* a_star, a_star_frontier_entry_t* entry)
+{
+  if(a_star->num_entries >= a_star->num_buckets)
+  {
+    size_t num_buckets = a_star->num_buckets * 2;
+    a_star_frontier_entry_t** buckets = (a_star_frontier_entry_t**)calloc(num_buckets, sizeof(a_star_frontier_entry_t*));
+    if(buckets == NULL)
+    {
+      return false;
+    }
+
+    for(size_t i = 0; i < a_star->num_buckets; i++)
+    {
+      a_star_frontier_entry_t* current = a_star->buckets[i];
+      while(current != NULL)
+      {
+        a_star_frontier_entry_t* next = current->next;
+        size_t index = current->hash & (num_buckets - 1);
+        current->next = buckets[index];
+        buckets[index] = current;
+        current = next;
+      }
+    }
+
+    free(a_star->buckets);
+    a_star->buckets = buckets;
+    a_star->num_buckets = num_buckets;
+  }
+
+  size_t index = entry->hash & (a_star->num_buckets - 1);
+  entry->next = a_star->buckets[index];
+  a_star->buckets[index] = entry;
+  a_star->num_entries++;
+  if(a_star->max_entries < a_star->num_entries)
+    a_star->max_entries = a_star->num_entries;
+  return true;
+}
+
+// Retira um nó da tabela e liberta a sua memória
+static void a_star_frontier_release(a_star_frontier_t* a_star, a_star_frontier_entry_t* entry)
+{
+  a_star_frontier_entry_t** link = &a_star->buckets[entry->hash & (a_star->num_buckets - 1)];
+  while(*link != NULL && *link != entry)
+  {
+    link = &(*link)->next;
+  }
+
+  if(*link == entry)
+  {
+    *link = entry->next;
+    a_star->num_entries--;
+  }
+  free(entry);
+}
+
+// Ordem da lista aberta: menor f primeiro e, em caso de empate, maior g
+static inline bool a_star_frontier_before(const a_star_frontier_entry_t* a, const a_star_frontier_entry_t* b)
+{
+  int fa = a->g + a->h;
+  int fb = b->g + b->h;
+  return fa < fb || (fa == fb && a->g > b->g);
+}
+
+// Coloca um nó da lista aberta numa posição
+static inline void a_star_frontier_heap_set(a_star_frontier_t* a_star, size_t index, a_star_frontier_entry_t* entry)
+{
+  a_star->heap[index] = entry;
+  entry->heap_index = index;
+}
+
+// Sobe um nó da lista aberta até à sua posição
+static void a_star_frontier_sift_up(a_star_frontier_t* a_star, size_t index)
+{
+  a_star_frontier_entry_t* entry = a_star->heap[index];
+  while(index > 0)
+  {
+    size_t parent = (index - 1) / 2;
+    if(!a_star_frontier_before(entry, a_star->heap[parent]))
+      break;
+    a_star_frontier_heap_set(a_star, index, a_star->heap[parent]);
+    index = parent;
+  }
+  a_star_frontier_heap_set(a_star, index, entry);
+}
+
+// Desce um nó da lista aberta até à sua posição
+static void a_star_frontier_sift_down(a_star_frontier_t* a_star, size_t index)
+{
+  a_star_frontier_entry_t* entry = a_star->heap[index];
+  while(true)
+  {
+    size_t child = 2 * index + 1;
+    if(child >= a_star->heap_size)
+      break;
+    if(child + 1 < a_star->heap_size && a_star_frontier_before(a_star->heap[child + 1], a_star->heap[child]))
+      child++;
+    if(!a_star_frontier_before(a_star->heap[child], entry))
+      break;
+    a_star_frontier_heap_set(a_star, index, a_star->heap[child]);
+    index = child;
+  }
+  a_star_frontier_heap_set(a_star, index, entry);
+}
+
+// Insere um nó na lista aberta
+static bool a_star_frontier_push(a_star_frontier_t* a_star, a_star_frontier_entry_t* entry)
+{
+  if(a_star->heap_size == a_star->heap_capacity)
+  {
+    size_t capacity = a_star->heap_capacity * 2;
+    a_star_frontier_entry_t** heap = (a_star_frontier_entry_t**)realloc(a_star->heap, capacity * sizeof(a_star_frontier_entry_t*));
+    if(heap == NULL)
+    {
+      return false;
+    }
+    a_star->heap = heap;
+    a_star->heap_capacity = capacity;
+  }
+
+  a_star_frontier_heap_set(a_star, a_star->heap_size++, entry);
+  a_star_frontier_sift_up(a_star, entry->heap_index);
+  return true;
+}
+
+// Retira o melhor nó da lista aberta
+static a_star_frontier_entry_t* a_star_frontier_pop(a_star_frontier_t* a_star)
+{
+  a_star_frontier_entry_t* top = a_star->heap[0];
+  a_star->heap_size--;
+  if(a_star->heap_size > 0)
+  {
+    a_star_frontier_heap_set(a_star, 0, a_star->heap[a_star->heap_size]);
+    a_star_frontier_sift_down(a_star, 0);
+  }
+  return top;
+}
+
+// Preenche um estado que aponta para dados fora do gestor de estados
+static inline state_t* a_star_frontier_view(a_star_frontier_t* a_star, const void* data, state_t* view)
+{
+  view->hash = 0;
+  view->struct_size = a_star->common->state_allocator->struct_size;
+  view->data = (void*)data;
+  return view;
+}
+
+// Gera os vizinhos de um estado e copia-os para buffer, pela ordem em que são numerados os operadores
+static size_t a_star_frontier_generate(a_star_frontier_t* a_star, const void* data, char** buffer, size_t* capacity)
+{
+  size_t struct_size = a_star->common->state_allocator->struct_size;
+  state_t view;
+  a_star->common->visit_func(a_star_frontier_view(a_star, data, &view), a_star->scratch, a_star->neighbors);
+
+  size_t count = 0;
+  while(linked_list_size(a_star->neighbors))
+  {
+    state_t* neighbor = (state_t*)linked_list_pop_back(a_star->neighbors);
+    if(count == *capacity)
+    {
+      size_t new_capacity = *capacity > 0 ? *capacity * 2 : 16;
+      char* new_buffer = (char*)realloc(*buffer, new_capacity * struct_size);
+      if(new_buffer == NULL)
+      {
+        continue;
+      }
+      *buffer = new_buffer;
+      *capacity = new_capacity;
+    }
+    memcpy(*buffer + count * struct_size, neighbor->data, struct_size);
+    count++;
+  }
+
+  // Os vizinhos já foram copiados, as posições temporárias podem ser reutilizadas
+  state_allocator_scratch_reset(a_star->scratch);
+  return count;
+}
+
+// Marca no nó o operador que leva de volta ao estado indicado (já expandido)
+static void a_star_frontier_mark_used(a_star_frontier_t* a_star, a_star_frontier_entry_t* entry, const void* expanded)
+{
+  size_t struct_size = a_star->common->state_allocator->struct_size;
+  size_t count = a_star_frontier_generate(a_star, entry->data, &a_star->reverse_children, &a_star->reverse_capacity);
+  for(size_t i = 0; i < count && i < FRONTIER_MAX_OPERATORS; i++)
+  {
+    if(memcmp(a_star->reverse_children + i * struct_size, expanded, struct_size) == 0)
+    {
+      entry->used |= (uint64_t)1 << i;
+      return;
+    }
+  }
+}
+
+// Guarda um nó expandido numa camada de retransmissão, retorna a sua posição
+static size_t a_star_frontier_add_relay(a_star_frontier_t* a_star, a_star_frontier_entry_t* entry)
+{
+  size_t struct_size = a_star->common->state_allocator->struct_size;
+  if(a_star->num_relays == a_star->relays_capacity)
+  {
+    size_t capacity = a_star->relays_capacity * 2;
+    a_star_frontier_relay_t* relays = (a_star_frontier_relay_t*)realloc(a_star->relays, capacity * sizeof(a_star_frontier_relay_t));
+    if(relays == NULL)
+    {
+      return entry->relay;
+    }
+    a_star->relays = relays;
+
+    char* relay_data = (char*)realloc(a_star->relay_data, capacity * struct_size);
+    if(relay_data == NULL)
+    {
+      return entry->relay;
+    }
+    a_star->relay_data = relay_data;
+    a_star->relays_capacity = capacity;
+  }
+
+  size_t index = a_star->num_relays++;
+  a_star->relays[index].parent = entry->relay;
+  a_star->relays[index].g = entry->g;
+  a_star->relays[index].depth = entry->depth;
+  memcpy(a_star->relay_data + index * struct_size, entry->data, struct_size);
+  return index;
+}
+
+// Expande um nó: os vizinhos abertos são atualizados, os novos são criados, e os operadores que
+// levam a nós já expandidos não são aplicados
+static bool a_star_frontier_expand(a_star_frontier_t* a_star, a_star_frontier_entry_t* current)
+{
+  a_star_t* common = a_star->common;
+  size_t struct_size = common->state_allocator->struct_size;
+
+  // Os filhos guardam o último antecessor de retransmissão
+  size_t relay = current->relay;
+  if(current->depth % a_star->relay_interval == 0)
+  {
+    relay = a_star_frontier_add_relay(a_star, current);
+  }
+
+  size_t count = a_star_frontier_generate(a_star, current->data, &a_star->children, &a_star->children_capacity);
+  for(size_t i = 0; i < count; i++)
+  {
+    if(i < FRONTIER_MAX_OPERATORS && (current->used & ((uint64_t)1 << i)))
+    {
+      a_star->operators_skipped++;
+      continue;
+    }
+
+    const char* data = a_star->children + i * struct_size;
+    state_t current_view, child_view;
+    int g_attempt = current->g + common->d_func(a_star_frontier_view(a_star, current->data, &current_view),
+                                                a_star_frontier_view(a_star, data, &child_view));
+
+    size_t hash = (size_t)hash_fnv1a(data, struct_size);
+    a_star_frontier_entry_t* child = a_star_frontier_find(a_star, data, hash);
+    if(child == NULL)
+    {
+      // Este nó ainda não existe (ou já foi expandido por um operador não marcado)
+      child = (a_star_frontier_entry_t*)malloc(sizeof(a_star_frontier_entry_t) + struct_size);
+      if(child == NULL)
+      {
+        return false;
+      }
+
+      memcpy(child->data, data, struct_size);
+      child->hash = hash;
+      child->g = g_attempt;
+      child->h = common->h_func(&child_view, common->goal_state);
+      child->depth = current->depth + 1;
+      child->relay = relay;
+      child->used = 0;
+      if(!a_star_frontier_insert(a_star, child) || !a_star_frontier_push(a_star, child))
+      {
+        return false;
+      }
+      common->generated++;
+      common->nodes_new++;
+    }
+    else if(g_attempt < child->g)
+    {
+      // Caminho melhor para um nó aberto
+      child->g = g_attempt;
+      child->depth = current->depth + 1;
+      child->relay = relay;
+      a_star_frontier_sift_up(a_star, child->heap_index);
+      common->paths_better++;
+    }
+    else
+    {
+      common->paths_worst_or_equals++;
+    }
+
+    // O nó atual vai ser libertado, o filho não o pode voltar a gerar
+    a_star_frontier_mark_used(a_star, child, current->data);
+  }
+
+  return true;
+}
+
+// Procura em profundidade o caminho de from até to com exatamente steps passos e custo cost,
+// os estados intermédios e o destino são escritos em path. O estado anterior (previous) não é
+// repetido, o que nos corredores dos labirintos reduz a procura a um único caminho
+static bool a_star_frontier_segment(
+    a_star_frontier_t* a_star, const void* previous, const void* from, const void* to, int steps, int cost, char* path, int* g_path)
+{
+  size_t struct_size = a_star->common->state_allocator->struct_size;
+  if(steps == 0)
+  {
+    return cost == 0 && memcmp(from, to, struct_size) == 0;
+  }
+
+  // Cada nível precisa da sua cópia dos vizinhos
+  char* children = NULL;
+  size_t capacity = 0;
+  size_t count = a_star_frontier_generate(a_star, from, &children, &capacity);
+
+  bool found = false;
+  for(size_t i = 0; i < count && !found; i++)
+  {
+    const char* child = children + i * struct_size;
+    if(previous != NULL && memcmp(child, previous, struct_size) == 0)
+    {
+      continue;
+    }
+
+    state_t from_view, child_view;
+    int d = a_star->common->d_func(a_star_frontier_view(a_star, from, &from_view), a_star_frontier_view(a_star, child, &child_view));
+    if(d > cost)
+    {
+      continue;
+    }
+
+    memcpy(path, child, struct_size);
+    *g_path = d;
+    found = a_star_frontier_segment(a_star, from, child, to, steps - 1, cost - d, path + struct_size, g_path + 1);
+  }
+
+  free(children);
+  return found;
+}
+
+// Reconstrói o caminho até ao objetivo a partir das camadas de retransmissão e guarda-o nos
+// gestores da parte comum
+static void a_star_frontier_build_solution(a_star_frontier_t* a_star, a_star_frontier_entry_t* goal_entry)
+{
+  a_star_t* common = a_star->common;
+  size_t struct_size = common->state_allocator->struct_size;
+  size_t length = (size_t)goal_entry->depth + 1;
+
+  char* path = (char*)malloc(length * struct_size);
+  int* costs = (int*)calloc(length, sizeof(int));
+  if(path == NULL || costs == NULL)
+  {
+    free(path);
+    free(costs);
+    return;
+  }
+
+  // Cada troço liga um nó de retransmissão ao seguinte, o último termina no objetivo
+  memcpy(path + goal_entry->depth * struct_size, goal_entry->data, struct_size);
+  const char* to = goal_entry->data;
+  int to_g = goal_entry->g;
+  int to_depth = goal_entry->depth;
+  bool complete = true;
+  for(size_t relay = goal_entry->relay; relay != SIZE_MAX && complete; relay = a_star->relays[relay].parent)
+  {
+    a_star_frontier_relay_t* from = &a_star->relays[relay];
+    const char* from_data = a_star->relay_data + relay * struct_size;
+    memcpy(path + from->depth * struct_size, from_data, struct_size);
+
+    complete = a_star_frontier_segment(a_star,
+                                       NULL,
+                                       from_data,
+                                       to,
+                                       to_depth - from->depth,
+                                       to_g - from->g,
+                                       path + (from->depth + 1) * struct_size,
+                                       costs + from->depth + 1);
+    to = from_data;
+    to_g = from->g;
+    to_depth = from->depth;
+  }
+
+  // O caminho é recriado nos gestores da parte comum
+  a_star_node_t* parent = NULL;
+  for(size_t i = 0; complete && i < length; i++)
+  {
+    state_t* state = state_allocator_new(common->state_allocator, path + i * struct_size);
+    a_star_node_t* node = node_allocator_new(common->node_allocator, state);
+    node->parent = parent;
+    node->g = parent != NULL ? parent->g + costs[i] : 0;
+    node->h = common->h_func(state, common->goal_state);
+    parent = node;
+  }
+
+  if(complete)
+  {
+    common->solution = parent;
+    common->num_solutions = common->num_better_solutions = 1;
+    a_star->solution_length = length;
+  }
+
+  free(path);
+  free(costs);
+}
+
+// Resolve o problema através do uso do algoritmo A* de fronteira
+void a_star_frontier_solve(a_star_frontier_t* a_star, void* initial, void* goal)
+{
+  if(a_star == NULL)
+  {
+    return;
+  }
+
+  // Limpamos a procura anterior
+  if(a_star->common->expanded > 0 || a_star->common->goal_state != NULL || a_star->common->solution != NULL)
+  {
+    if(!a_star_reset(a_star->common))
+    {
+      return;
+    }
+  }
+  a_star_frontier_clear(a_star);
+  a_star->max_entries = 0;
+  a_star->operators_skipped = 0;
+  a_star->solution_length = 0;
+
+  if(goal)
+  {
+    a_star->common->goal_state = state_allocator_new(a_star->common->state_allocator, goal);
+    if(a_star->common->goal_state == NULL)
+    {
+      return;
+    }
+  }
+
+  size_t struct_size = a_star->common->state_allocator->struct_size;
+  a_star_frontier_entry_t* root = (a_star_frontier_entry_t*)malloc(sizeof(a_star_frontier_entry_t) + struct_size);
+  if(root == NULL)
+  {
+    return;
+  }
+
+  state_t view;
+  memcpy(root->data, initial, struct_size);
+  root->hash = (size_t)hash_fnv1a(root->data, struct_size);
+  root->g = 0;
+  root->h = a_star->common->h_func(a_star_frontier_view(a_star, root->data, &view), a_star->common->goal_state);
+  root->depth = 0;
+  root->relay = SIZE_MAX;
+  root->used = 0;
+  a_star_frontier_insert(a_star, root);
+  a_star_frontier_push(a_star, root);
+
+  clock_gettime(CLOCK_MONOTONIC, &(a_star->common->start_time));
+
+  while(a_star->heap_size)
+  {
+    if(a_star->common->expanded % FRONTIER_CANCEL_INTERVAL == 0 && a_star_cancel_requested(a_star->common))
+    {
+      a_star->common->cancelled = true;
+      break;
+    }
+
+    if(a_star->common->max_min_heap_size < a_star->heap_size)
+      a_star->common->max_min_heap_size = a_star->heap_size;
+
+    a_star_frontier_entry_t* current = a_star_frontier_pop(a_star);
+    a_star->common->expanded++;
+
+    // Se encontramos o objetivo reconstruímos o caminho e saímos do ciclo
+    if(a_star->common->goal_func(a_star_frontier_view(a_star, current->data, &view), a_star->common->goal_state))
+    {
+      a_star_frontier_build_solution(a_star, current);
+      a_star_frontier_release(a_star, current);
+      break;
+    }
+
+    bool expanded = a_star_frontier_expand(a_star, current);
+
+    // O nó expandido deixa de ser necessário
+    a_star_frontier_release(a_star, current);
+    if(!expanded)
+    {
+      break;
+    }
+  }
+
+  clock_gettime(CLOCK_MONOTONIC, &(a_star->common->end_time));
+  // Calculamos o tempo de execução
+  a_star->common->execution_time = (a_star->common->end_time.tv_sec - a_star->common->start_time.tv_sec);
+  a_star->common->execution_time += (a_star->common->end_time.tv_nsec - a_star->common->start_time.tv_nsec) / 1000000000.0;
+}
+
+// Imprime estatísticas do algoritmo A* de fronteira no formato desejado
+void a_star_frontier_print_statistics(a_star_frontier_t* a_star, bool csv, bool show_solution)
+{
+  if(!csv && !show_solution)
+  {
+    printf("Máximo de nós em memória: %ld, Nós de retransmissão: %ld, Operadores ignorados: %ld\n",
+           a_star->max_entries,
+           a_star->num_relays,
+           a_star->operators_skipped);
+  }
+
+  a_star_print_statistics(a_star->common, csv, show_solution);
+}
@@ -0,0 +1,384 @@
+#include "astar_lpa.h"
+#include <limits.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// Custo de um índice por alcançar
+#define LPA_INFINITY INT_MAX
+
+// Número de expansões entre verificações do pedido de cancelamento
+#define LPA_CANCEL_INTERVAL 1024
+
+// Cria uma nova instância para resolver um problema
+a_star_lpa_t* a_star_lpa_create(size_t struct_size,
+                                size_t num_indices,
+                                size_t max_neighbors,
+                                index_neighbors_function neighbors_func,
+                                index_state_function state_func,
+                                index_heuristic_function h_func,
+                                void* context,
+                                print_function print_func)
+{
+  a_star_lpa_t* a_star = (a_star_lpa_t*)calloc(1, sizeof(a_star_lpa_t));
+  if(a_star == NULL)
+  {
+    return NULL; // Erro de alocação
+  }
+
+  // A parte comum serve apenas para guardar a solução, não tem funções sobre estados
+  a_star->common = a_star_create(struct_size, NULL, NULL, NULL, NULL, print_func);
+  a_star->num_indices = num_indices;
+  a_star->max_neighbors = max_neighbors;
+  a_star->neighbors_func = neighbors_func;
+  a_star->state_func = state_func;
+  a_star->h_func = h_func;
+  a_star->context = context;
+
+  // Os vetores por índice só são preenchidos na primeira consulta
+  a_star->g = (int*)malloc(num_indices * sizeof(int));
+  a_star->rhs = (int*)malloc(num_indices * sizeof(int));
+  a_star->heap_position = (size_t*)malloc(num_indices * sizeof(size_t));
+  a_star->heap = (a_star_lpa_entry_t*)malloc(num_indices * sizeof(a_star_lpa_entry_t));
+  a_star->neighbors = (size_t*)malloc(max_neighbors * sizeof(size_t));
+  a_star->changed_neighbors = (size_t*)malloc(max_neighbors * sizeof(size_t));
+  a_star->state_data = (char*)malloc(struct_size);
+
+  if(a_star->common == NULL || a_star->g == NULL || a_star->rhs == NULL || a_star->heap_position == NULL ||
+     a_star->heap == NULL || a_star->neighbors == NULL || a_star->changed_neighbors == NULL || a_star->state_data == NULL)
+  {
+    a_star_lpa_destroy(a_star);
+    return NULL;
+  }
+
+  return a_star;
+}
+
+// Liberta uma instância do algoritmo LPA*
+void a_star_lpa_destroy(a_star_lpa_t* a_star)
+{
+  if(a_star == NULL)
+  {
+    return;
+  }
+
+  free(a_star->g);
+  free(a_star->rhs);
+  free(a_star->heap_position);
+  free(a_star->heap);
+  free(a_star->neighbors);
+  free(a_star->changed_neighbors);
+  free(a_star->state_data);
+
+  // Invocamos o destroy da parte comum
+  a_star_destroy(a_star->common);
+
+  free(a_star);
+}
+
+// Chave de um índice: [min(g, rhs) + h, min(g, rhs)]
+static inline a_star_lpa_entry_t a_star_lpa_key(a_star_lpa_t* a_star, size_t index)
+{
+  int m = a_star->g[index] < a_star->rhs[index] ? a_star->g[index] : a_star->rhs[index];
+  a_star_lpa_entry_t entry = { m, m, index };
+  if(m != LPA_INFINITY)
+    entry.k1 = m + a_star->h_func(index, a_star->context);
+  return entry;
+}
+
+// Ordem das chaves, lexicográfica
+static inline bool a_star_lpa_less(const a_star_lpa_entry_t* a, const a_star_lpa_entry_t* b)
+{
+  return a->k1 < b->k1 || (a->k1 == b->k1 && a->k2 < b->k2);
+}
+
+// Coloca a entrada na posição indicada e atualiza a posição guardada do índice
+static inline void a_star_lpa_place(a_star_lpa_t* a_star, size_t position, a_star_lpa_entry_t entry)
+{
+  a_star->heap[position] = entry;
+  a_star->heap_position[entry.index] = position;
+}
+
+// Repõe a ordem da lista a partir de uma posição, para cima ou para baixo
+static void a_star_lpa_sift(a_star_lpa_t* a_star, size_t position)
+{
+  a_star_lpa_entry_t entry = a_star->heap[position];
+  while(position > 0 && a_star_lpa_less(&entry, &a_star->heap[(position - 1) / 2]))
+  {
+    a_star_lpa_place(a_star, position, a_star->heap[(position - 1) / 2]);
+    position = (position - 1) / 2;
+  }
+
+  while(true)
+  {
+    size_t child = 2 * position + 1;
+    if(child >= a_star->heap_size)
+      break;
+    if(child + 1 < a_star->heap_size && a_star_lpa_less(&a_star->heap[child + 1], &a_star->heap[child]))
+      child++;
+    if(!a_star_lpa_less(&a_star->heap[child], &entry))
+      break;
+    a_star_lpa_place(a_star, position, a_star->heap[child]);
+    position = child;
+  }
+  a_star_lpa_place(a_star, position, entry);
+}
+
+// Retira um índice da lista aberta
+static void a_star_lpa_remove(a_star_lpa_t* a_star, size_t index)
+{
+  size_t position = a_star->heap_position[index];
+  a_star->heap_position[index] = SIZE_MAX;
+  if(--a_star->heap_size > position)
+  {
+    a_star->heap[position] = a_star->heap[a_star->heap_size];
+    a_star_lpa_sift(a_star, position);
+  }
+}
+
+// Recalcula o rhs de um índice e coloca-o na lista aberta se ficar inconsistente
+static void a_star_lpa_update_vertex(a_star_lpa_t* a_star, size_t index)
+{
+  a_star->vertex_updates++;
+
+  // O rhs do objetivo é sempre 0, os restantes são o melhor custo através dos vizinhos
+  if(index != a_star->goal_index)
+  {
+    int rhs = LPA_INFINITY;
+    size_t count = a_star->neighbors_func(index, a_star->neighbors, a_star->context);
+    for(size_t i = 0; i < count; i++)
+    {
+      int g = a_star->g[a_star->neighbors[i]];
+      if(g != LPA_INFINITY && g + 1 < rhs)
+        rhs = g + 1;
+    }
+    a_star->rhs[index] = rhs;
+  }
+
+  if(a_star->heap_position[index] != SIZE_MAX)
+  {
+    if(a_star->g[index] == a_star->rhs[index])
+    {
+      a_star_lpa_remove(a_star, index);
+    }
+    else
+    {
+      a_star->heap[a_star->heap_position[index]] = a_star_lpa_key(a_star, index);
+      a_star_lpa_sift(a_star, a_star->heap_position[index]);
+    }
+  }
+  else if(a_star->g[index] != a_star->rhs[index])
+  {
+    a_star->heap[a_star->heap_size] = a_star_lpa_key(a_star, index);
+    a_star->heap_position[index] = a_star->heap_size;
+    a_star_lpa_sift(a_star, a_star->heap_size++);
+    if(a_star->common->max_min_heap_size < a_star->heap_size)
+      a_star->common->max_min_heap_size = a_star->heap_size;
+  }
+}
+
+// Atualiza os vizinhos de um índice cujo custo g mudou
+static void a_star_lpa_update_neighbors(a_star_lpa_t* a_star, size_t index)
+{
+  // A lista de vizinhos é reutilizada por update_vertex, guardamos uma cópia
+  size_t count = a_star->neighbors_func(index, a_star->changed_neighbors, a_star->context);
+  for(size_t i = 0; i < count; i++)
+  {
+    a_star_lpa_update_vertex(a_star, a_star->changed_neighbors[i]);
+    a_star->common->generated++;
+  }
+}
+
+// Altera o problema no índice indicado e marca os índices afetados
+bool a_star_lpa_change(a_star_lpa_t* a_star, size_t index, index_change_function change_func)
+{
+  if(a_star == NULL || index >= a_star->num_indices)
+  {
+    return false;
+  }
+
+  // Vizinhos antes da alteração, um índice bloqueado deixa de os ter
+  size_t before[a_star->max_neighbors];
+  size_t count_before = a_star->neighbors_func(index, before, a_star->context);
+  if(!change_func(index, a_star->context))
+  {
+    return false;
+  }
+  a_star->changes++;
+
+  if(!a_star->initialized)
+  {
+    return true;
+  }
+
+  // O próprio índice, os vizinhos de antes e os de depois da alteração
+  a_star_lpa_update_vertex(a_star, index);
+  for(size_t i = 0; i < count_before; i++)
+  {
+    a_star_lpa_update_vertex(a_star, before[i]);
+  }
+  a_star_lpa_update_neighbors(a_star, index);
+  return true;
+}
+
+// Reinicia os vetores para uma procura desde o início
+static void a_star_lpa_initialize(a_star_lpa_t* a_star, size_t initial, size_t goal)
+{
+  for(size_t i = 0; i < a_star->num_indices; i++)
+  {
+    a_star->g[i] = LPA_INFINITY;
+    a_star->rhs[i] = LPA_INFINITY;
+    a_star->heap_position[i] = SIZE_MAX;
+  }
+  a_star->heap_size = 0;
+  a_star->initial_index = initial;
+  a_star->goal_index = goal;
+  a_star->initialized = true;
+
+  // A procura começa no objetivo
+  a_star->rhs[goal] = 0;
+  a_star->heap[0] = a_star_lpa_key(a_star, goal);
+  a_star->heap_position[goal] = 0;
+  a_star->heap_size = 1;
+}
+
+// Processa os índices inconsistentes até o custo do início ser conhecido
+static void a_star_lpa_compute(a_star_lpa_t* a_star)
+{
+  size_t initial = a_star->initial_index;
+  while(a_star->heap_size > 0)
+  {
+    a_star_lpa_entry_t initial_key = a_star_lpa_key(a_star, initial);
+    if(!a_star_lpa_less(&a_star->heap[0], &initial_key) && a_star->g[initial] == a_star->rhs[initial])
+    {
+      break;
+    }
+
+    if(++a_star->common->expanded % LPA_CANCEL_INTERVAL == 0 && a_star_cancel_requested(a_star->common))
+    {
+      a_star->common->cancelled = true;
+      break;
+    }
+
+    size_t index = a_star->heap[0].index;
+    if(a_star->g[index] > a_star->rhs[index])
+    {
+      // O índice ficou mais barato, o novo custo passa para os vizinhos
+      a_star_lpa_remove(a_star, index);
+      a_star->g[index] = a_star->rhs[index];
+      a_star_lpa_update_neighbors(a_star, index);
+    }
+    else
+    {
+      // O índice ficou mais caro, é invalidado juntamente com os vizinhos que dependiam dele
+      a_star->g[index] = LPA_INFINITY;
+      a_star_lpa_update_vertex(a_star, index);
+      a_star_lpa_update_neighbors(a_star, index);
+    }
+  }
+}
+
+// Converte o caminho do início até ao objetivo em nós da parte comum
+static void a_star_lpa_build_solution(a_star_lpa_t* a_star)
+{
+  a_star_t* common = a_star->common;
+  size_t index = a_star->initial_index;
+  if(a_star->g[index] == LPA_INFINITY)
+  {
+    return;
+  }
+
+  a_star_node_t* parent = NULL;
+  int steps = 0;
+  while(true)
+  {
+    a_star->state_func(index, a_star->state_data, a_star->context);
+    state_t* state = state_allocator_new(common->state_allocator, a_star->state_data);
+    a_star_node_t* node = node_allocator_new(common->node_allocator, state);
+    if(node == NULL)
+    {
+      return;
+    }
+
+    node->parent = parent;
+    node->g = steps++;
+    node->h = a_star->g[index];
+    node->index_in_open_set = SIZE_MAX;
+    parent = node;
+
+    if(index == a_star->goal_index)
+      break;
+
+    // O próximo passo é o vizinho mais próximo do objetivo
+    size_t count = a_star->neighbors_func(index, a_star->neighbors, a_star->context);
+    size_t best = SIZE_MAX;
+    for(size_t i = 0; i < count; i++)
+    {
+      if(best == SIZE_MAX || a_star->g[a_star->neighbors[i]] < a_star->g[best])
+        best = a_star->neighbors[i];
+    }
+    if(best == SIZE_MAX || a_star->g[best] >= a_star->g[index])
+    {
+      return;
+    }
+    index = best;
+  }
+
+  common->solution = parent;
+  common->num_solutions = common->num_better_solutions = 1;
+}
+
+// Resolve o problema entre o índice inicial e o objetivo
+void a_star_lpa_solve(a_star_lpa_t* a_star, size_t initial, size_t goal)
+{
+  if(a_star == NULL || initial >= a_star->num_indices || goal >= a_star->num_indices)
+  {
+    return;
+  }
+
+  // Limpamos a solução e as estatísticas anteriores, os custos de cada índice mantêm-se
+  if(a_star->common->expanded > 0 || a_star->common->solution != NULL || a_star->common->generated > 0)
+  {
+    if(!a_star_reset(a_star->common))
+    {
+      return;
+    }
+  }
+  a_star->queries++;
+
+  clock_gettime(CLOCK_MONOTONIC, &(a_star->common->start_time));
+
+  // Com outro início ou objetivo a árvore anterior não serve, a procura recomeça
+  if(!a_star->initialized || a_star->initial_index != initial || a_star->goal_index != goal)
+  {
+    a_star_lpa_initialize(a_star, initial, goal);
+  }
+
+  a_star_lpa_compute(a_star);
+  if(!a_star->common->cancelled)
+  {
+    a_star_lpa_build_solution(a_star);
+  }
+  a_star->query_vertex_updates = a_star->vertex_updates - a_star->vertex_updates_before;
+  a_star->vertex_updates_before = a_star->vertex_updates;
+
+  clock_gettime(CLOCK_MONOTONIC, &(a_star->common->end_time));
+  // Calculamos o tempo de execução
+  a_star->common->execution_time = (a_star->common->end_time.tv_sec - a_star->common->start_time.tv_sec);
+  a_star->common->execution_time += (a_star->common->end_time.tv_nsec - a_star->common->start_time.tv_nsec) / 1000000000.0;
+}
+
+// Imprime estatísticas da última consulta do algoritmo LPA* no formato desejado
+void a_star_lpa_print_statistics(a_star_lpa_t* a_star, bool csv, bool show_solution)
+{
+  if(!csv && !show_solution)
+  {
+    printf("LPA*: consulta %d, %d alterações até agora, %ld índices atualizados nesta consulta\n",
+           a_star->queries,
+           a_star->changes,
+           a_star->query_vertex_updates);
+  }
+
+  a_star_print_statistics(a_star->common, csv, show_solution);
+}
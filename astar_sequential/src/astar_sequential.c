@@ -1,4 +1,5 @@
 #include "astar_sequential.h"
+#include <limits.h>
 #include <stdint.h>
 #include <stdlib.h>
 #include <string.h>
@@ -62,6 +63,21 @@ void a_star_sequential_destroy(a_star_sequential_t* a_star)
   free(a_star);
 }
 
+// Guarda um nó objetivo como a solução da procura
+static void a_star_sequential_accept(a_star_sequential_t* a_star, a_star_node_t* goal_node)
+{
+  a_star->common->num_solutions = a_star->common->num_better_solutions = 1;
+  a_star->common->solution = goal_node;
+#ifdef STATS_GEN
+  a_star_node_t* solution_path = a_star->common->solution;
+  while(solution_path != NULL)
+  {
+    search_data_add_entry(0, solution_path->state, ACTION_GOAL);
+    solution_path = solution_path->parent;
+  }
+#endif
+}
+
 // Resolve o problema através do uso do algoritmo A*;
 void a_star_sequential_solve(a_star_sequential_t* a_star, void* initial, void* goal)
 {
@@ -99,7 +115,18 @@ void a_star_sequential_solve(a_star_sequential_t* a_star, void* initial, void* g
   initial_node->h = a_star->common->h_func(initial_node->state, a_star->common->goal_state);
 
   // Inserimos o nó inicial na nossa fila prioritária
-  min_heap_insert(a_star->open_set, initial_node->g + initial_node->h, initial_node);
+  initial_node->index_in_open_set = min_heap_insert(a_star->open_set, a_star_priority(a_star->common, initial_node), initial_node);
+
+  // O objetivo é testado quando os nós são gerados se o teste for barato (resumo do objetivo) ou se a
+  // heurística for consistente. O melhor objetivo gerado fica como incumbente até nenhum nó da lista
+  // aberta o poder melhorar, os nós com f acima do limite superior ou do incumbente não são inseridos
+  bool goal_on_generation = a_star->common->goal_hash_set || a_star->common->consistent;
+  int upper_bound = a_star->common->upper_bound > 0 ? a_star->common->upper_bound : INT_MAX;
+  a_star_node_t* incumbent = NULL;
+  if(goal_on_generation && a_star_goal(a_star->common, initial_node->state))
+  {
+    incumbent = initial_node;
+  }
 
   // Esta lista irá receber os vizinhos de um nó
   linked_list_t* neighbors = linked_list_create();
@@ -113,6 +140,13 @@ void a_star_sequential_solve(a_star_sequential_t* a_star, void* initial, void* g
 #ifdef STATS_GEN
     search_data_tick();
 #endif
+    // Foi pedido o cancelamento da procura (por exemplo por outra configuração de um portfólio)
+    if(a_star_cancel_requested(a_star->common))
+    {
+      a_star->common->cancelled = true;
+      break;
+    }
+
     if(a_star->common->max_min_heap_size < a_star->open_set->size)
       a_star->common->max_min_heap_size = a_star->open_set->size;
 
@@ -120,27 +154,33 @@ void a_star_sequential_solve(a_star_sequential_t* a_star, void* initial, void* g
     // se nosAbertos é um min-heap ou uma queue prioritária
     heap_node_t top_element = min_heap_pop(a_star->open_set);
 
-    // Nó atual na nossa árvore
+    // Nó atual na nossa árvore, caso o custo já não corresponda ao do nó esta entrada foi
+    // substituída por um caminho melhor e é ignorada
     a_star_node_t* current_node = (a_star_node_t*)top_element.data;
+    if(top_element.cost != a_star_priority(a_star->common, current_node))
+    {
+      continue;
+    }
+
+    // O f do nó retirado é um limite inferior do custo ótimo, o incumbente já não pode ser melhorado
+    int f_current = current_node->g + current_node->h;
+    if(incumbent != NULL && incumbent->g <= f_current)
+    {
+      a_star_sequential_accept(a_star, incumbent);
+      break;
+    }
+
     current_node->index_in_open_set = SIZE_MAX;
     a_star->common->expanded++;
 #ifdef STATS_GEN
     search_data_add_entry(0, current_node->state, ACTION_VISITED);
 #endif
-    // Se encontramos o objetivo saímos e retornamos o nó
-    if(a_star->common->goal_func(current_node->state, a_star->common->goal_state))
+    // Se encontramos o objetivo saímos e retornamos o nó, quando o objetivo é testado na geração
+    // o nó já foi testado
+    if(!goal_on_generation && a_star->common->goal_func(current_node->state, a_star->common->goal_state))
     {
       // Guardamos a solução e saímos do ciclo
-      a_star->common->num_solutions = a_star->common->num_better_solutions = 1;
-      a_star->common->solution = current_node;
-#ifdef STATS_GEN
-      a_star_node_t* solution_path = a_star->common->solution;
-      while(solution_path != NULL)
-      {
-        search_data_add_entry(0, solution_path->state, ACTION_GOAL);
-        solution_path = solution_path->parent;
-      }
-#endif
+      a_star_sequential_accept(a_star, current_node);
       break;
     }
     // Executa a função que visita os vizinhos deste nó
@@ -153,20 +193,31 @@ void a_star_sequential_solve(a_star_sequential_t* a_star, void* initial, void* g
       // Verifica se o nó para este estado já se encontra na nossa lista de nós
       a_star_node_t* child_node = node_allocator_get(a_star->common->node_allocator, neighbor);
 
+      // Limite do f dos filhos, apenas os que podem melhorar o incumbente são inseridos
+      int f_limit = incumbent != NULL && incumbent->g - 1 < upper_bound ? incumbent->g - 1 : upper_bound;
+
       if(!child_node)
       {
+        // Encontra o custo de chegar do nó a este vizinho e calcula a heurística para chegar ao objetivo
+        int g = current_node->g + a_star->common->d_func(current_node->state, neighbor);
+        int h = a_star->common->h_func(neighbor, a_star->common->goal_state);
+        if(g + h > f_limit)
+        {
+          a_star->common->paths_worst_or_equals++;
+          continue;
+        }
+
         // Este nó ainda não existe, criamos um novo nó
         child_node = node_allocator_new(a_star->common->node_allocator, neighbor);
         child_node->parent = current_node;
 #ifdef STATS_GEN
         search_data_add_entry(0, child_node->state, ACTION_SUCESSOR);
 #endif
-        // Encontra o custo de chegar do nó a este vizinho e calcula a heurística para chegar ao objetivo
-        child_node->g = current_node->g + a_star->common->d_func(current_node->state, child_node->state);
-        child_node->h = a_star->common->h_func(child_node->state, a_star->common->goal_state);
+        child_node->g = g;
+        child_node->h = h;
 
         // Calculamos o custo
-        int cost = child_node->g + child_node->h;
+        int64_t cost = a_star_priority(a_star->common, child_node);
 
         // Inserimos o nó na nossa fila
         child_node->index_in_open_set = min_heap_insert(a_star->open_set, cost, child_node);
@@ -175,12 +226,19 @@ void a_star_sequential_solve(a_star_sequential_t* a_star, void* initial, void* g
       }
       else
       {
+        // Com uma heurística consistente um nó fechado já tem o menor custo, não é reaberto
+        if(a_star->common->consistent && child_node->index_in_open_set == SIZE_MAX)
+        {
+          a_star->common->paths_worst_or_equals++;
+          continue;
+        }
+
         // Encontra o custo de chegar do nó a este vizinho
         int g_attempt = current_node->g + a_star->common->d_func(current_node->state, child_node->state);
 
         // Se o custo for maior do que o nó já tem, não faz sentido atualizar
         // existe outro caminho mais curto para este nó
-        if(g_attempt >= child_node->g)
+        if(g_attempt >= child_node->g || g_attempt + child_node->h > f_limit)
         {
           a_star->common->paths_worst_or_equals++;
           continue;
@@ -189,27 +247,44 @@ void a_star_sequential_solve(a_star_sequential_t* a_star, void* initial, void* g
         // O nó atual é o caminho mais curto para este vizinho, atualizamos
         child_node->parent = current_node;
 
-        // Atualizamos os parâmetros do nó
+        // Atualizamos os parâmetros do nó, a heurística depende apenas do estado e mantém-se
         child_node->g = g_attempt;
-        child_node->h = a_star->common->h_func(child_node->state, a_star->common->goal_state);
 
         // Calculamos o novo custo
-        int cost = child_node->g + child_node->h;
+        int64_t cost = a_star_priority(a_star->common, child_node);
 
         a_star->common->paths_better++;
         if(child_node->index_in_open_set == SIZE_MAX)
         {
-          // Inserimos o nó na nossa fila novamente
-          child_node->index_in_open_set = min_heap_insert(a_star->open_set, cost, child_node);
           a_star->common->nodes_reinserted++;
         }
-        else
-        {
-          // Atualizamos a nossa fila prioritária
-          min_heap_update_cost(a_star->open_set, child_node->index_in_open_set, cost);
-        }
+
+        // Inserimos o nó na nossa fila com o novo custo. O índice devolvido pela min_heap deixa de ser
+        // válido após as trocas internas, pelo que a entrada antiga fica na fila e é ignorada quando for
+        // retirada, tal como no algoritmo paralelo
+        child_node->index_in_open_set = min_heap_insert(a_star->open_set, cost, child_node);
+      }
+
+      // Um objetivo gerado é o novo incumbente, o f abaixo do limite garante que é melhor do que o anterior
+      if(goal_on_generation && child_node != incumbent && a_star_goal(a_star->common, child_node->state))
+      {
+        incumbent = child_node;
       }
     }
+
+    // Sem nenhum nó na lista aberta com f menor do que o do nó expandido, um incumbente com custo até
+    // esse f é ótimo e evita expandir o resto da camada de f
+    if(incumbent != NULL && incumbent->g <= f_current)
+    {
+      a_star_sequential_accept(a_star, incumbent);
+      break;
+    }
+  }
+
+  // A lista aberta esvaziou-se sem que o incumbente tenha sido aceite, nenhum outro nó o melhora
+  if(a_star->common->solution == NULL && incumbent != NULL && !a_star->common->cancelled)
+  {
+    a_star_sequential_accept(a_star, incumbent);
   }
 
   // Liberta a lista de vizinhos
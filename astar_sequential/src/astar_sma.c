@@ -0,0 +1,756 @@
+#include "astar_sma.h"
+#include <limits.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// Número de posições do gestor temporário de estados
+#define SMA_SCRATCH_CAPACITY 256
+
+// Número de expansões entre verificações do pedido de cancelamento
+#define SMA_CANCEL_INTERVAL 1024
+
+// Número inicial de posições da tabela de estados, duplica quando fica cheia
+#define SMA_INITIAL_BUCKETS 1024
+
+static void a_star_sma_clear(a_star_sma_t* a_star);
+
+// Cria uma nova instância para resolver um problema
+a_star_sma_t* a_star_sma_create(size_t struct_size,
+                                goal_function goal_func,
+                                visit_function visit_func,
+                                heuristic_function h_func,
+                                distance_function d_func,
+                                print_function print_func,
+                                size_t max_nodes)
+{
+  a_star_sma_t* a_star = (a_star_sma_t*)calloc(1, sizeof(a_star_sma_t));
+  if(a_star == NULL)
+  {
+    return NULL; // Erro de alocação
+  }
+
+  // Inicializamos a parte comum do nosso algoritmo e o alocador dos nós, com o estado no fim de cada nó
+  a_star->common = a_star_create(struct_size, goal_func, visit_func, h_func, d_func, print_func);
+  a_star->nodes = allocator_create(sizeof(a_star_sma_node_t) + struct_size);
+  a_star->scratch = state_allocator_create_scratch(struct_size, SMA_SCRATCH_CAPACITY);
+  a_star->neighbors = linked_list_create();
+  a_star->max_nodes = max_nodes > 1 ? max_nodes : 2;
+  a_star->buckets = (a_star_sma_node_t**)calloc(SMA_INITIAL_BUCKETS, sizeof(a_star_sma_node_t*));
+  a_star->num_buckets = SMA_INITIAL_BUCKETS;
+
+  if(a_star->common == NULL || a_star->nodes == NULL || a_star->scratch == NULL || a_star->neighbors == NULL ||
+     a_star->buckets == NULL)
+  {
+    a_star_sma_destroy(a_star);
+    return NULL;
+  }
+
+  return a_star;
+}
+
+// Liberta uma instância do algoritmo SMA*
+void a_star_sma_destroy(a_star_sma_t* a_star)
+{
+  if(a_star == NULL)
+  {
+    return;
+  }
+
+  // Os estados dos nós em memória são libertados antes dos próprios nós
+  if(a_star->buckets != NULL)
+    a_star_sma_clear(a_star);
+  free(a_star->buckets);
+  if(a_star->nodes != NULL)
+    allocator_destroy(a_star->nodes);
+  state_allocator_destroy(a_star->scratch);
+  linked_list_destroy(a_star->neighbors);
+  free(a_star->open.data);
+  free(a_star->leaves.data);
+  free(a_star->children);
+  free(a_star->children_f);
+  free(a_star->kept);
+
+  // Invocamos o destroy da parte comum
+  a_star_destroy(a_star->common);
+
+  free(a_star);
+}
+
+// Indica a função que liberta a memória associada a um estado
+void a_star_sma_set_release(a_star_sma_t* a_star, release_function release_func)
+{
+  if(a_star != NULL)
+  {
+    a_star->release_func = release_func;
+  }
+}
+
+// Liberta a memória que o problema associou aos dados de um estado
+static inline void a_star_sma_release(a_star_sma_t* a_star, void* data)
+{
+  if(a_star->release_func != NULL)
+  {
+    state_t state = { .hash = 0, .struct_size = a_star->common->state_allocator->struct_size, .data = data };
+    a_star->release_func(&state);
+  }
+}
+
+// Procura o nó em memória com o estado indicado
+static a_star_sma_node_t* a_star_sma_find(a_star_sma_t* a_star, const void* data, size_t hash)
+{
+  size_t struct_size = a_star->common->state_allocator->struct_size;
+  a_star_sma_node_t* node = a_star->buckets[hash & (a_star->num_buckets - 1)];
+  while(node != NULL)
+  {
+    if(node->hash == hash && memcmp(node->data, data, struct_size) == 0)
+    {
+      return node;
+    }
+    node = node->next_in_bucket;
+  }
+  return NULL;
+}
+
+// Acrescenta um nó à tabela, duplicando o número de posições quando fica cheia. Se não houver
+// memória para crescer a tabela fica com mais nós por posição
+static void a_star_sma_table_insert(a_star_sma_t* a_star, a_star_sma_node_t* node)
+{
+  if(a_star->num_nodes > a_star->num_buckets)
+  {
+    size_t num_buckets = a_star->num_buckets * 2;
+    a_star_sma_node_t** buckets = (a_star_sma_node_t**)calloc(num_buckets, sizeof(a_star_sma_node_t*));
+    if(buckets != NULL)
+    {
+      for(size_t i = 0; i < a_star->num_buckets; i++)
+      {
+        a_star_sma_node_t* current = a_star->buckets[i];
+        while(current != NULL)
+        {
+          a_star_sma_node_t* next = current->next_in_bucket;
+          size_t index = current->hash & (num_buckets - 1);
+          current->next_in_bucket = buckets[index];
+          buckets[index] = current;
+          current = next;
+        }
+      }
+
+      free(a_star->buckets);
+      a_star->buckets = buckets;
+      a_star->num_buckets = num_buckets;
+    }
+  }
+
+  size_t index = node->hash & (a_star->num_buckets - 1);
+  node->next_in_bucket = a_star->buckets[index];
+  a_star->buckets[index] = node;
+}
+
+// Retira um nó da tabela
+static void a_star_sma_table_remove(a_star_sma_t* a_star, a_star_sma_node_t* node)
+{
+  a_star_sma_node_t** link = &a_star->buckets[node->hash & (a_star->num_buckets - 1)];
+  while(*link != NULL && *link != node)
+  {
+    link = &(*link)->next_in_bucket;
+  }
+
+  if(*link == node)
+  {
+    *link = node->next_in_bucket;
+  }
+}
+
+// Liberta os estados de todos os nós em memória e esvazia a tabela, os nós continuam no alocador
+static void a_star_sma_clear(a_star_sma_t* a_star)
+{
+  for(size_t i = 0; i < a_star->num_buckets; i++)
+  {
+    for(a_star_sma_node_t* node = a_star->buckets[i]; node != NULL; node = node->next_in_bucket)
+    {
+      a_star_sma_release(a_star, node->data);
+    }
+  }
+  memset(a_star->buckets, 0, a_star->num_buckets * sizeof(a_star_sma_node_t*));
+}
+
+// Prioridade de um nó na lista aberta: as folhas pelo seu custo, os nós internos pelos filhos esquecidos
+static inline int a_star_sma_open_key(const a_star_sma_node_t* node)
+{
+  return node->num_children == 0 ? node->f : node->forgotten_f;
+}
+
+// Posição do nó na lista indicada
+static inline size_t* a_star_sma_index(a_star_sma_node_t* node, bool leaves)
+{
+  return leaves ? &node->leaf_index : &node->open_index;
+}
+
+// Ordem das listas: menor f e mais profundo na lista aberta, maior f e menos profundo nas folhas
+static inline bool a_star_sma_before(const a_star_sma_node_t* a, const a_star_sma_node_t* b, bool leaves)
+{
+  if(leaves)
+  {
+    if(a->f != b->f)
+      return a->f > b->f;
+    return a->depth < b->depth;
+  }
+
+  int key_a = a_star_sma_open_key(a);
+  int key_b = a_star_sma_open_key(b);
+  if(key_a != key_b)
+    return key_a < key_b;
+  return a->depth > b->depth;
+}
+
+static void a_star_sma_heap_swap(a_star_sma_heap_t* heap, size_t i, size_t j, bool leaves)
+{
+  a_star_sma_node_t* tmp = heap->data[i];
+  heap->data[i] = heap->data[j];
+  heap->data[j] = tmp;
+  *a_star_sma_index(heap->data[i], leaves) = i;
+  *a_star_sma_index(heap->data[j], leaves) = j;
+}
+
+static void a_star_sma_heap_sift(a_star_sma_heap_t* heap, size_t i, bool leaves)
+{
+  while(i > 0 && a_star_sma_before(heap->data[i], heap->data[(i - 1) / 2], leaves))
+  {
+    a_star_sma_heap_swap(heap, i, (i - 1) / 2, leaves);
+    i = (i - 1) / 2;
+  }
+
+  while(true)
+  {
+    size_t best = i;
+    size_t left = 2 * i + 1;
+    size_t right = left + 1;
+    if(left < heap->size && a_star_sma_before(heap->data[left], heap->data[best], leaves))
+      best = left;
+    if(right < heap->size && a_star_sma_before(heap->data[right], heap->data[best], leaves))
+      best = right;
+    if(best == i)
+      break;
+    a_star_sma_heap_swap(heap, i, best, leaves);
+    i = best;
+  }
+}
+
+static bool a_star_sma_heap_push(a_star_sma_heap_t* heap, a_star_sma_node_t* node, bool leaves)
+{
+  if(heap->size == heap->capacity)
+  {
+    size_t new_capacity = heap->capacity > 0 ? heap->capacity * 2 : 1024;
+    a_star_sma_node_t** new_data = (a_star_sma_node_t**)realloc(heap->data, new_capacity * sizeof(a_star_sma_node_t*));
+    if(new_data == NULL)
+    {
+      return false;
+    }
+    heap->data = new_data;
+    heap->capacity = new_capacity;
+  }
+
+  heap->data[heap->size] = node;
+  *a_star_sma_index(node, leaves) = heap->size++;
+  a_star_sma_heap_sift(heap, heap->size - 1, leaves);
+  return true;
+}
+
+static void a_star_sma_heap_remove(a_star_sma_heap_t* heap, a_star_sma_node_t* node, bool leaves)
+{
+  size_t i = *a_star_sma_index(node, leaves);
+  if(i == SIZE_MAX)
+  {
+    return;
+  }
+
+  *a_star_sma_index(node, leaves) = SIZE_MAX;
+  heap->size--;
+  if(i < heap->size)
+  {
+    heap->data[i] = heap->data[heap->size];
+    *a_star_sma_index(heap->data[i], leaves) = i;
+    a_star_sma_heap_sift(heap, i, leaves);
+  }
+}
+
+// Coloca, atualiza ou retira o nó da lista aberta conforme a sua prioridade
+static void a_star_sma_open_refresh(a_star_sma_t* a_star, a_star_sma_node_t* node)
+{
+  if(a_star_sma_open_key(node) == INT_MAX)
+  {
+    a_star_sma_heap_remove(&a_star->open, node, false);
+  }
+  else if(node->open_index == SIZE_MAX)
+  {
+    a_star_sma_heap_push(&a_star->open, node, false);
+  }
+  else
+  {
+    a_star_sma_heap_sift(&a_star->open, node->open_index, false);
+  }
+}
+
+// Atualiza o custo f dos antecessores com o melhor custo dos filhos
+static void a_star_sma_backup(a_star_sma_node_t* node)
+{
+  for(; node != NULL && node->num_children > 0; node = node->parent)
+  {
+    int f = node->forgotten_f;
+    for(a_star_sma_node_t* child = node->first_child; child != NULL; child = child->next_sibling)
+    {
+      if(child->f < f)
+        f = child->f;
+    }
+
+    if(f == node->f)
+    {
+      break;
+    }
+    node->f = f;
+  }
+}
+
+// Retira um nó sem filhos da árvore, das listas e da tabela, e liberta o nó e o seu estado
+static void a_star_sma_remove(a_star_sma_t* a_star, a_star_sma_node_t* node)
+{
+  a_star_sma_node_t* parent = node->parent;
+  a_star_sma_heap_remove(&a_star->leaves, node, true);
+  a_star_sma_heap_remove(&a_star->open, node, false);
+  a_star_sma_table_remove(a_star, node);
+
+  // Retiramos o nó da lista de filhos do pai
+  if(node->prev_sibling != NULL)
+    node->prev_sibling->next_sibling = node->next_sibling;
+  else
+    parent->first_child = node->next_sibling;
+  if(node->next_sibling != NULL)
+    node->next_sibling->prev_sibling = node->prev_sibling;
+  parent->num_children--;
+
+  a_star_sma_release(a_star, node->data);
+  allocator_free(a_star->nodes, node);
+  a_star->num_nodes--;
+}
+
+// Um pai sem filhos em memória volta a ser uma folha, com o melhor custo dos filhos esquecidos
+static void a_star_sma_become_leaf(a_star_sma_t* a_star, a_star_sma_node_t* parent)
+{
+  if(parent->num_children == 0)
+  {
+    parent->f = parent->forgotten_f;
+    parent->forgotten_f = INT_MAX;
+    a_star_sma_heap_push(&a_star->leaves, parent, true);
+  }
+  a_star_sma_open_refresh(a_star, parent);
+}
+
+// Esquece uma folha, o seu custo passa para o pai
+static void a_star_sma_forget(a_star_sma_t* a_star, a_star_sma_node_t* leaf)
+{
+  a_star_sma_node_t* parent = leaf->parent;
+  if(leaf->f < parent->forgotten_f)
+    parent->forgotten_f = leaf->f;
+
+  a_star_sma_remove(a_star, leaf);
+  a_star->nodes_forgotten++;
+  a_star_sma_become_leaf(a_star, parent);
+}
+
+// Descarta um nó e a sua subárvore porque o estado foi alcançado por um caminho mais barato. O custo
+// não passa para o pai, o pai só volta a gerar o estado se o novo caminho também for esquecido
+static void a_star_sma_discard(a_star_sma_t* a_star, a_star_sma_node_t* node)
+{
+  a_star_sma_node_t* parent = node->parent;
+
+  // Os descendentes são retirados das folhas para cima
+  a_star_sma_node_t* current = node;
+  while(true)
+  {
+    while(current->first_child != NULL)
+    {
+      current = current->first_child;
+    }
+
+    a_star_sma_node_t* next = current->parent;
+    bool last = current == node;
+    a_star_sma_remove(a_star, current);
+    if(last)
+    {
+      break;
+    }
+    current = next;
+  }
+  a_star->duplicates_replaced++;
+
+  a_star_sma_become_leaf(a_star, parent);
+  a_star_sma_backup(parent->num_children > 0 ? parent : parent->parent);
+}
+
+// Esquece as piores folhas até existir memória para needed nós, nunca esquecendo o nó em expansão
+// nem os seus filhos. Retorna o número de nós que cabem em memória
+static size_t a_star_sma_make_room(a_star_sma_t* a_star, a_star_sma_node_t* current, size_t needed)
+{
+  size_t num_kept = 0;
+  while(a_star->num_nodes + needed > a_star->max_nodes && a_star->leaves.size > 0)
+  {
+    a_star_sma_node_t* worst = a_star->leaves.data[0];
+    if(worst == current || worst->parent == current || worst->parent == NULL)
+    {
+      // Guardamos o nó de parte e voltamos a colocá-lo na lista no fim
+      if(num_kept == a_star->kept_capacity)
+      {
+        size_t new_capacity = a_star->kept_capacity > 0 ? a_star->kept_capacity * 2 : 16;
+        a_star_sma_node_t** new_kept = (a_star_sma_node_t**)realloc(a_star->kept, new_capacity * sizeof(a_star_sma_node_t*));
+        if(new_kept == NULL)
+        {
+          break;
+        }
+        a_star->kept = new_kept;
+        a_star->kept_capacity = new_capacity;
+      }
+      a_star->kept[num_kept++] = worst;
+      a_star_sma_heap_remove(&a_star->leaves, worst, true);
+      continue;
+    }
+
+    a_star_sma_forget(a_star, worst);
+  }
+
+  for(size_t i = 0; i < num_kept; i++)
+  {
+    a_star_sma_heap_push(&a_star->leaves, a_star->kept[i], true);
+  }
+
+  if(a_star->num_nodes >= a_star->max_nodes)
+  {
+    return 0;
+  }
+  size_t room = a_star->max_nodes - a_star->num_nodes;
+  return room < needed ? room : needed;
+}
+
+// Estado de um nó para as funções do problema
+static inline state_t* a_star_sma_view(a_star_sma_t* a_star, a_star_sma_node_t* node, state_t* view)
+{
+  view->hash = 0;
+  view->struct_size = a_star->common->state_allocator->struct_size;
+  view->data = node->data;
+  return view;
+}
+
+// Gera os sucessores do nó que não estão em memória com um custo g menor ou igual e calcula o seu
+// custo, retorna quantos são
+static size_t a_star_sma_generate(a_star_sma_t* a_star, a_star_sma_node_t* node, int base_f)
+{
+  a_star_t* common = a_star->common;
+  size_t struct_size = common->state_allocator->struct_size;
+  state_t view;
+  common->visit_func(a_star_sma_view(a_star, node, &view), a_star->scratch, a_star->neighbors);
+
+  size_t count = 0;
+  while(linked_list_size(a_star->neighbors))
+  {
+    state_t* neighbor = (state_t*)linked_list_pop_back(a_star->neighbors);
+    int g = node->g + common->d_func(&view, neighbor);
+
+    // Inclui o pai e os filhos em memória do nó, que nunca têm custo maior. Os antecessores têm
+    // sempre custo menor, pelo que o nó descartado nunca está no caminho do nó em expansão
+    a_star_sma_node_t* resident = a_star_sma_find(a_star, neighbor->data, (size_t)hash_fnv1a(neighbor->data, struct_size));
+    if(resident != NULL)
+    {
+      if(resident->g <= g)
+      {
+        a_star_sma_release(a_star, neighbor->data);
+        a_star->duplicates_dropped++;
+        continue;
+      }
+      a_star_sma_discard(a_star, resident);
+    }
+
+    if(count == a_star->children_capacity)
+    {
+      size_t new_capacity = a_star->children_capacity > 0 ? a_star->children_capacity * 2 : 16;
+      char* new_children = (char*)realloc(a_star->children, new_capacity * struct_size);
+      int* new_children_f = (int*)realloc(a_star->children_f, new_capacity * sizeof(int));
+      if(new_children != NULL)
+        a_star->children = new_children;
+      if(new_children_f != NULL)
+        a_star->children_f = new_children_f;
+      if(new_children == NULL || new_children_f == NULL)
+      {
+        a_star_sma_release(a_star, neighbor->data);
+        continue;
+      }
+      a_star->children_capacity = new_capacity;
+    }
+
+    // O custo de um filho nunca é menor do que o custo conhecido do pai (pathmax)
+    int f = g + common->h_func(neighbor, common->goal_state);
+    memcpy(a_star->children + count * struct_size, neighbor->data, struct_size);
+    a_star->children_f[count++] = f > base_f ? f : base_f;
+  }
+  state_allocator_scratch_reset(a_star->scratch);
+
+  // Ordenamos os sucessores pelo custo, os melhores ficam em memória se não houver espaço para todos
+  char tmp[struct_size];
+  for(size_t i = 1; i < count; i++)
+  {
+    for(size_t j = i; j > 0 && a_star->children_f[j] < a_star->children_f[j - 1]; j--)
+    {
+      int f = a_star->children_f[j];
+      a_star->children_f[j] = a_star->children_f[j - 1];
+      a_star->children_f[j - 1] = f;
+      memcpy(tmp, a_star->children + j * struct_size, struct_size);
+      memcpy(a_star->children + j * struct_size, a_star->children + (j - 1) * struct_size, struct_size);
+      memcpy(a_star->children + (j - 1) * struct_size, tmp, struct_size);
+    }
+  }
+
+  return count;
+}
+
+// Cria um nó na árvore, filho de parent
+static a_star_sma_node_t* a_star_sma_new_node(a_star_sma_t* a_star, a_star_sma_node_t* parent, const void* data)
+{
+  a_star_sma_node_t* node = (a_star_sma_node_t*)allocator_alloc(a_star->nodes);
+  memcpy(node->data, data, a_star->common->state_allocator->struct_size);
+  node->parent = parent;
+  node->first_child = NULL;
+  node->prev_sibling = NULL;
+  node->next_sibling = NULL;
+  node->forgotten_f = INT_MAX;
+  node->num_children = 0;
+  node->open_index = SIZE_MAX;
+  node->leaf_index = SIZE_MAX;
+  node->depth = parent != NULL ? parent->depth + 1 : 0;
+
+  if(parent != NULL)
+  {
+    node->next_sibling = parent->first_child;
+    if(parent->first_child != NULL)
+      parent->first_child->prev_sibling = node;
+    parent->first_child = node;
+    parent->num_children++;
+  }
+
+  a_star->num_nodes++;
+  if(a_star->max_nodes_used < a_star->num_nodes)
+    a_star->max_nodes_used = a_star->num_nodes;
+
+  node->hash = (size_t)hash_fnv1a(node->data, a_star->common->state_allocator->struct_size);
+  a_star_sma_table_insert(a_star, node);
+
+  return node;
+}
+
+// Expande o melhor nó aberto: uma folha gera todos os sucessores, um nó interno gera os filhos esquecidos
+static void a_star_sma_expand(a_star_sma_t* a_star, a_star_sma_node_t* current)
+{
+  a_star_t* common = a_star->common;
+  size_t struct_size = common->state_allocator->struct_size;
+  bool regenerate = current->num_children > 0;
+  common->expanded++;
+
+  // Os filhos esquecidos têm pelo menos o custo guardado no pai
+  int base_f = regenerate ? current->forgotten_f : current->f;
+  size_t count = a_star_sma_generate(a_star, current, base_f);
+
+  // Uma folha em expansão deixa de poder ser esquecida
+  if(!regenerate)
+  {
+    a_star_sma_heap_remove(&a_star->leaves, current, true);
+  }
+
+  size_t room = count > 0 ? a_star_sma_make_room(a_star, current, count) : 0;
+  state_t current_view, child_view;
+  a_star_sma_view(a_star, current, &current_view);
+  for(size_t i = 0; i < room; i++)
+  {
+    a_star_sma_node_t* child = a_star_sma_new_node(a_star, current, a_star->children + i * struct_size);
+    a_star_sma_view(a_star, child, &child_view);
+    child->g = current->g + common->d_func(&current_view, &child_view);
+    child->h = common->h_func(&child_view, common->goal_state);
+    child->f = a_star->children_f[i];
+    common->generated++;
+    if(regenerate)
+      a_star->nodes_regenerated++;
+    else
+      common->nodes_new++;
+    a_star_sma_heap_push(&a_star->leaves, child, true);
+    a_star_sma_heap_push(&a_star->open, child, false);
+  }
+
+  // Os sucessores que não couberam deixam de estar em memória
+  for(size_t i = room; i < count; i++)
+  {
+    a_star_sma_release(a_star, a_star->children + i * struct_size);
+  }
+
+  if(room < count)
+  {
+    if(room == 0)
+    {
+      // Não há memória para nenhum sucessor, o caminho por este nó é abandonado
+      a_star->paths_abandoned++;
+      if(regenerate)
+        current->forgotten_f = INT_MAX;
+      else
+        current->f = INT_MAX;
+    }
+    else
+    {
+      // Os sucessores que não couberam ficam esquecidos desde já
+      current->forgotten_f = a_star->children_f[room];
+    }
+  }
+  else
+  {
+    current->forgotten_f = INT_MAX;
+  }
+
+  // Sem sucessores em memória o nó é um beco sem saída
+  if(current->num_children == 0)
+  {
+    if(count == 0)
+      current->f = INT_MAX;
+    a_star_sma_heap_push(&a_star->leaves, current, true);
+  }
+
+  a_star_sma_open_refresh(a_star, current);
+  a_star_sma_backup(current->num_children > 0 ? current : current->parent);
+}
+
+// Converte o caminho da raiz até ao objetivo em nós da parte comum
+static void a_star_sma_build_solution(a_star_sma_t* a_star, a_star_sma_node_t* goal_node)
+{
+  a_star_t* common = a_star->common;
+
+  // Invertemos o caminho para o percorrer a partir da raiz
+  a_star_sma_node_t* reversed = NULL;
+  for(a_star_sma_node_t* node = goal_node; node != NULL;)
+  {
+    a_star_sma_node_t* parent = node->parent;
+    node->next_sibling = reversed;
+    reversed = node;
+    node = parent;
+  }
+
+  a_star_node_t* parent = NULL;
+  for(a_star_sma_node_t* node = reversed; node != NULL; node = node->next_sibling)
+  {
+    state_t* state = state_allocator_new(common->state_allocator, node->data);
+    a_star_node_t* solution_node = node_allocator_new(common->node_allocator, state);
+    if(solution_node == NULL)
+    {
+      return;
+    }
+
+    solution_node->parent = parent;
+    solution_node->g = node->g;
+    solution_node->h = node->h;
+    solution_node->index_in_open_set = SIZE_MAX;
+    parent = solution_node;
+  }
+
+  common->solution = parent;
+  common->num_solutions = common->num_better_solutions = 1;
+}
+
+// Resolve o problema através do uso do algoritmo SMA*
+void a_star_sma_solve(a_star_sma_t* a_star, void* initial, void* goal)
+{
+  if(a_star == NULL)
+  {
+    return;
+  }
+
+  // Limpamos a procura anterior
+  if(a_star->common->expanded > 0 || a_star->common->goal_state != NULL || a_star->common->solution != NULL)
+  {
+    a_star_sma_clear(a_star);
+    allocator_destroy(a_star->nodes);
+    a_star->nodes = allocator_create(sizeof(a_star_sma_node_t) + a_star->common->state_allocator->struct_size);
+    if(!a_star_reset(a_star->common) || a_star->nodes == NULL)
+    {
+      return;
+    }
+  }
+  a_star->open.size = 0;
+  a_star->leaves.size = 0;
+  a_star->num_nodes = 0;
+  a_star->max_nodes_used = 0;
+  a_star->nodes_forgotten = 0;
+  a_star->nodes_regenerated = 0;
+  a_star->paths_abandoned = 0;
+  a_star->duplicates_dropped = 0;
+  a_star->duplicates_replaced = 0;
+
+  if(goal)
+  {
+    a_star->common->goal_state = state_allocator_new(a_star->common->state_allocator, goal);
+    if(a_star->common->goal_state == NULL)
+    {
+      return;
+    }
+  }
+
+  // A raiz da árvore é o estado inicial
+  a_star_sma_node_t* root = a_star_sma_new_node(a_star, NULL, initial);
+  state_t view;
+  root->g = 0;
+  root->h = a_star->common->h_func(a_star_sma_view(a_star, root, &view), a_star->common->goal_state);
+  root->f = root->h;
+  a_star_sma_heap_push(&a_star->open, root, false);
+  a_star_sma_heap_push(&a_star->leaves, root, true);
+
+  clock_gettime(CLOCK_MONOTONIC, &(a_star->common->start_time));
+
+  while(a_star->open.size > 0)
+  {
+    if(a_star->common->expanded % SMA_CANCEL_INTERVAL == 0 && a_star_cancel_requested(a_star->common))
+    {
+      a_star->common->cancelled = true;
+      break;
+    }
+
+    if(a_star->common->max_min_heap_size < a_star->open.size)
+      a_star->common->max_min_heap_size = a_star->open.size;
+
+    a_star_sma_node_t* current = a_star->open.data[0];
+
+    // O melhor nó aberto é um objetivo, nenhum outro caminho pode ser melhor
+    if(current->num_children == 0 && a_star->common->goal_func(a_star_sma_view(a_star, current, &view), a_star->common->goal_state))
+    {
+      a_star_sma_build_solution(a_star, current);
+      break;
+    }
+
+    a_star_sma_expand(a_star, current);
+  }
+
+  clock_gettime(CLOCK_MONOTONIC, &(a_star->common->end_time));
+  // Calculamos o tempo de execução
+  a_star->common->execution_time = (a_star->common->end_time.tv_sec - a_star->common->start_time.tv_sec);
+  a_star->common->execution_time += (a_star->common->end_time.tv_nsec - a_star->common->start_time.tv_nsec) / 1000000000.0;
+}
+
+// Imprime estatísticas do algoritmo SMA* no formato desejado
+void a_star_sma_print_statistics(a_star_sma_t* a_star, bool csv, bool show_solution)
+{
+  if(!csv && !show_solution)
+  {
+    printf("Nós em memória: máximo %zu de %zu, nós esquecidos: %d, nós regenerados: %d, caminhos abandonados: %d\n",
+           a_star->max_nodes_used,
+           a_star->max_nodes,
+           a_star->nodes_forgotten,
+           a_star->nodes_regenerated,
+           a_star->paths_abandoned);
+    printf("Estados repetidos: %d descartados, %d substituídos por um caminho mais barato\n",
+           a_star->duplicates_dropped,
+           a_star->duplicates_replaced);
+  }
+
+  a_star_print_statistics(a_star->common, csv, show_solution);
+}
@@ -184,11 +184,8 @@ def create_video(problem, instance, stats_data, measurements, speed, output_name
         exec_time = float(stats["execution_time"])
         # We want to match our measurements, so get the scaler
         try:
-            if i == 0:
-                scaler = float(measurements[i][-1])/exec_time
-            else:
-                scaler = float(measurements[i][-2])/exec_time
-        except IndexError:
+            scaler = measured_time(measurements[i], i == 0)/exec_time
+        except (IndexError, ValueError, ZeroDivisionError):
             # Defaults to no scale
             scaler = 1
 
@@ -431,18 +428,37 @@ def draw_solutions(piece_size, off_x, frame, entries, goal):
         ), outline=sol_colors[c_idx], fill=sol_colors[c_idx])
 
 
+def measured_time(row, sequential):
+    # Rows end with the execution time and the reason why the search did not
+    # run, parallel rows also have the speed-up after them
+    time_index = -2 if sequential else -3
+    if row[time_index + 1] != "":
+        raise ValueError("Procura não executada")
+    return float(row[time_index])
+
+
+def measurement_cell(value):
+    # Numbers use a decimal comma, text cells (e.g. the reason why the search
+    # did not run) are kept as they are
+    cell = str(value).strip().replace("\"", "")
+    if cell.replace(",", "", 1).isdigit():
+        cell = cell.replace(",", ".")
+    return cell
+
+
 def load_measurements(problem, instance, threads, in_file):
 
     measurements = []
     try:
         with open(in_file) as fd:
             for line in fd.readlines():
-                cells = [str(value).strip().replace("\"", "").replace(",", ".")
-                         for value in line.split(";")]
+                cells = [measurement_cell(value) for value in line.split(";")]
                 # Must be our instance and if not sequencial the threads
-                # number must match
+                # number must match, fringe rows are not part of the video
                 if f"{problem}-{instance}" not in cells:
                     continue
+                if cells[1] == "fringe":
+                    continue
                 if cells[1] != "sequencial" and int(cells[2]) != threads:
                     continue
 
@@ -2,6 +2,8 @@
 #define NUMBER_LINK_H
 #include "allocator.h"
 #include "hashtable.h"
+#include "landmarks.h"
+#include <stdint.h>
 
 typedef struct
 {
@@ -17,6 +19,8 @@ typedef struct
   int rows;
   size_t struct_size;
   size_t board_len;
+  int32_t* distances; // Distâncias exatas de cada célula até à saída, NULL se não foram calculadas
+  landmarks_t* landmarks; // Marcos da heurística ALT, NULL se não foram calculados
 } maze_solver_t;
 
 
@@ -16,12 +16,54 @@ typedef struct
 
 int heuristic(const state_t*, const state_t*);
 
+// Heurística inversa, distância euclidiana até à posição do estado indicado
+int heuristic_reverse(const state_t*, const state_t*);
+
 void visit(state_t*, state_allocator_t*, linked_list_t*);
 
 bool goal(const state_t*, const state_t*);
 
 int distance(const state_t*, const state_t*);
 
+// Vizinhos por pontos de salto (Jump Point Search): cada corredor é percorrido de uma só vez até ao
+// próximo cruzamento, curva ou saída, o custo de cada salto é dado por distance_jump
+void visit_jump(state_t*, state_allocator_t*, linked_list_t*);
+
+int distance_jump(const state_t*, const state_t*);
+
+// Funções sobre o índice de cada célula (linha * colunas + coluna), utilizadas pela procura em
+// largura paralela, o contexto é o maze_solver_t
+size_t grid_index(const maze_solver_t*, coord);
+
+size_t grid_neighbors(size_t, size_t*, void*);
+
+int grid_heuristic(size_t, void*);
+
+void grid_state(size_t, void*, void*);
+
+// Heurística de uma célula até à entrada, para as procuras feitas da saída para a entrada
+int grid_heuristic_entry(size_t, void*);
+
+// Abre uma parede ou fecha uma célula livre do interior, retorna falso para as células da margem
+bool maze_toggle_cell(maze_solver_t*, coord);
+
+bool grid_toggle(size_t, void*);
+
+// Heurística exata: uma procura em largura a partir da saída calcula a distância de cada célula,
+// utilizada depois pelas funções heuristic e grid_heuristic. As células sem caminho até à saída
+// ficam com MAZE_UNREACHABLE
+#define MAZE_UNREACHABLE INT32_MAX
+
+bool maze_compute_distances(maze_solver_t*);
+
+// Guarda e lê as distâncias num ficheiro, a leitura falha se o ficheiro for de outro labirinto
+bool maze_save_distances(const maze_solver_t*, const char*);
+
+bool maze_load_distances(maze_solver_t*, const char*);
+
+// Resumo do tabuleiro, identifica o labirinto nos ficheiros de distâncias e de marcos
+uint64_t maze_board_hash(const maze_solver_t*);
+
 #ifdef STATS_GEN
 size_t maze_serialize_function(char*, const search_data_entry_t*);
 #endif
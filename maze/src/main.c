@@ -1,11 +1,25 @@
+#include "astar_distributed.h"
+#include "astar_ara.h"
+#include "astar_bfs.h"
+#include "astar_bidirectional.h"
+#include "astar_external.h"
+#include "astar_fringe.h"
+#include "astar_frontier.h"
+#include "astar_lpa.h"
 #include "astar_parallel.h"
+#include "astar_portfolio.h"
 #include "astar_sequential.h"
 #include "maze_logic.h"
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <time.h>
 #define MAX_MAZE_SIZE 20000
 
+// Funções de vizinhos e de custo utilizadas pelos algoritmos, por pontos de salto com a opção -J
+visit_function maze_visit = visit;
+distance_function maze_distance = distance;
+
 maze_solver_t* init_maze_solver_puzzle(const char* filename)
 {
   FILE* file = fopen(filename, "r");
@@ -76,6 +90,18 @@ void print_solution(a_star_node_t* solution)
     int y = solution_state->position.row;
     int index = y * maze_solver->cols + x;
     board[index] = 'c';
+
+    // Com pontos de salto o pai pode estar a várias células, preenchemos o corredor até ele
+    if(solution_path->parent != NULL)
+    {
+      maze_solver_state_t* parent_state = (maze_solver_state_t*)solution_path->parent->state->data;
+      int dx = (parent_state->position.col > x) - (parent_state->position.col < x);
+      int dy = (parent_state->position.row > y) - (parent_state->position.row < y);
+      for(x += dx, y += dy; x != parent_state->position.col || y != parent_state->position.row; x += dx, y += dy)
+      {
+        board[y * maze_solver->cols + x] = 'c';
+      }
+    }
     solution_path = solution_path->parent;
   }
 
@@ -92,11 +118,8 @@ void print_solution(a_star_node_t* solution)
 }
 
 // Resolve o problema utilizando a versão paralela do algoritmo
-void solve_parallel(maze_solver_t* maze_solver, int num_threads, bool first, bool csv, bool show_solution)
+void solve_parallel(a_star_parallel_t* a_star, maze_solver_t* maze_solver, bool csv, bool show_solution)
 {
-  // Criamos a instância do algoritmo A*
-  a_star_parallel_t* a_star =
-      a_star_parallel_create(sizeof(maze_solver_state_t), goal, visit, heuristic, distance, print_solution, num_threads, first);
   // Criamos o nosso estado inicial para lançar o algoritmo
   maze_solver_state_t initial = { maze_solver, maze_solver->entry_coord };
   // Tentamos resolver o problema
@@ -107,16 +130,323 @@ void solve_parallel(maze_solver_t* maze_solver, int num_threads, bool first, boo
   // Imprime as estatísticas da execução
   a_star_parallel_print_statistics(a_star, csv, show_solution);
 #endif
+}
+
+// Resolve o problema utilizando a versão distribuída do algoritmo, com um processo por trabalhador
+void solve_distributed(
+    maze_solver_t* maze_solver, int num_workers, bool first, transport_kind_e transport, bool csv, bool show_solution)
+{
+  // Criamos a instância do algoritmo A*, os processos partilham o labirinto através do fork
+  a_star_distributed_t* a_star = a_star_distributed_create(
+      sizeof(maze_solver_state_t), goal, maze_visit, heuristic, maze_distance, print_solution, num_workers, first, transport);
+  // Criamos o nosso estado inicial para lançar o algoritmo
+  maze_solver_state_t initial = { maze_solver, maze_solver->entry_coord };
+  // Tentamos resolver o problema
+  a_star_distributed_solve(a_star, &initial, NULL);
+  // Imprime as estatísticas da execução
+  a_star_distributed_print_statistics(a_star, csv, show_solution);
   // Limpamos a memória
-  a_star_parallel_destroy(a_star);
+  a_star_distributed_destroy(a_star);
+}
+
+// Resolve o problema com um portfólio de configurações do algoritmo em simultâneo
+void solve_portfolio(
+    maze_solver_t* maze_solver, a_star_portfolio_config_t* configs, size_t num_configs, int core_budget, bool csv, bool show_solution)
+{
+  // Sem orçamento indicado utilizamos todos os núcleos físicos
+  if(core_budget <= 0)
+  {
+    cpu_topology_t* topology = cpu_topology_create();
+    core_budget = (int)cpu_topology_physical_cores(topology);
+    cpu_topology_destroy(topology);
+  }
+
+  a_star_portfolio_t* a_star = a_star_portfolio_create(
+      sizeof(maze_solver_state_t), goal, maze_visit, heuristic, maze_distance, print_solution, configs, num_configs, (size_t)core_budget);
+  // Criamos o nosso estado inicial para lançar o algoritmo
+  maze_solver_state_t initial = { maze_solver, maze_solver->entry_coord };
+  // Tentamos resolver o problema
+  a_star_portfolio_solve(a_star, &initial, NULL);
+  // Imprime as estatísticas da execução
+  a_star_portfolio_print_statistics(a_star, csv, show_solution);
+  // Limpamos a memória
+  a_star_portfolio_destroy(a_star);
+}
+
+// Resolve o problema com o algoritmo A* bidirecional, a partir do início e do objetivo em simultâneo
+void solve_bidirectional(maze_solver_t* maze_solver, bool csv, bool show_solution)
+{
+  // Criamos a instância do algoritmo, o problema não é dirigido e a procura para trás utiliza os mesmos vizinhos
+  a_star_bidirectional_t* a_star =
+      a_star_bidirectional_create(sizeof(maze_solver_state_t), goal, visit, heuristic, distance, print_solution);
+  a_star_bidirectional_set_reverse(a_star, NULL, heuristic_reverse);
+
+  // Estados inicial e objetivo, a entrada e a saída do labirinto
+  maze_solver_state_t initial = { maze_solver, maze_solver->entry_coord };
+  maze_solver_state_t target = { maze_solver, maze_solver->exit_coord };
+
+  // Tentamos resolver o problema
+  a_star_bidirectional_solve(a_star, &initial, &target);
+
+  // Imprime as estatísticas da execução
+  a_star_bidirectional_print_statistics(a_star, csv, show_solution);
+
+  // Limpamos a memória
+  a_star_bidirectional_destroy(a_star);
+}
+
+// Resolve o problema com o algoritmo A* de fronteira, que liberta os nós expandidos
+void solve_frontier(maze_solver_t* maze_solver, bool csv, bool show_solution)
+{
+  // Criamos a instância do algoritmo A* de fronteira
+  a_star_frontier_t* a_star = a_star_frontier_create(sizeof(maze_solver_state_t), goal, visit, heuristic, distance, print_solution);
+
+  // Criamos o nosso estado inicial para lançar o algoritmo
+  maze_solver_state_t initial = { maze_solver, maze_solver->entry_coord };
+
+  // Tentamos resolver o problema
+  a_star_frontier_solve(a_star, &initial, NULL);
+
+  // Imprime as estatísticas da execução
+  a_star_frontier_print_statistics(a_star, csv, show_solution);
+
+  // Limpamos a memória
+  a_star_frontier_destroy(a_star);
+}
+
+// Resolve o problema com o algoritmo A* em memória externa, com os baldes guardados em disco
+void solve_external(maze_solver_t* maze_solver, size_t buffer_size, bool csv, bool show_solution)
+{
+  // Criamos a instância do algoritmo A* em memória externa, os ficheiros ficam em TMPDIR
+  a_star_external_t* a_star =
+      a_star_external_create(sizeof(maze_solver_state_t), goal, maze_visit, heuristic, maze_distance, print_solution, NULL);
+  a_star_external_set_buffer_size(a_star, buffer_size);
+
+  // Criamos o nosso estado inicial para lançar o algoritmo
+  maze_solver_state_t initial = { maze_solver, maze_solver->entry_coord };
+
+  // Tentamos resolver o problema
+  a_star_external_solve(a_star, &initial, NULL);
+
+  // Imprime as estatísticas da execução
+  a_star_external_print_statistics(a_star, csv, show_solution);
+
+  // Limpamos a memória
+  a_star_external_destroy(a_star);
+}
+
+// Resolve o problema utilizando o algoritmo ARA*, a partir do peso indicado até à solução ótima
+// ou até se esgotar o tempo limite
+void solve_ara(maze_solver_t* maze_solver, double weight, double time_limit, bool csv, bool show_solution)
+{
+  // Criamos a instância do algoritmo ARA*
+  a_star_ara_t* a_star = a_star_ara_create(sizeof(maze_solver_state_t), goal, maze_visit, heuristic, maze_distance, print_solution, weight);
+  a_star_ara_set_time_limit(a_star, time_limit);
+
+  // Criamos o nosso estado inicial para lançar o algoritmo
+  maze_solver_state_t initial = { maze_solver, maze_solver->entry_coord };
+
+  // Tentamos resolver o problema
+  a_star_ara_solve(a_star, &initial, NULL);
+
+  // Imprime as estatísticas da execução
+  a_star_ara_print_statistics(a_star, csv, show_solution);
+
+  // Limpamos a memória
+  a_star_ara_destroy(a_star);
+}
+
+// Resolve o problema com a procura em largura paralela por camadas sobre as células do labirinto
+void solve_bfs(maze_solver_t* maze_solver, int num_workers, int upper_bound, bool csv, bool show_solution)
+{
+  // Criamos a instância da procura, cada célula tem no máximo 4 vizinhos
+  a_star_bfs_t* a_star = a_star_bfs_create(sizeof(maze_solver_state_t),
+                                           maze_solver->board_len,
+                                           4,
+                                           grid_neighbors,
+                                           grid_state,
+                                           grid_heuristic,
+                                           maze_solver,
+                                           print_solution,
+                                           num_workers);
+  a_star_bfs_set_upper_bound(a_star, upper_bound);
+
+  // Tentamos resolver o problema entre a entrada e a saída do labirinto
+  a_star_bfs_solve(a_star, grid_index(maze_solver, maze_solver->entry_coord), grid_index(maze_solver, maze_solver->exit_coord));
+
+  // Imprime as estatísticas da execução
+  a_star_bfs_print_statistics(a_star, csv, show_solution);
+
+  // Limpamos a memória
+  a_star_bfs_destroy(a_star);
+}
+
+// Resolve o problema utilizando o algoritmo Fringe Search, sem fila prioritária
+void solve_fringe(maze_solver_t* maze_solver, bool csv, bool show_solution)
+{
+  // Criamos a instância do algoritmo Fringe Search
+  a_star_fringe_t* a_star =
+      a_star_fringe_create(sizeof(maze_solver_state_t), goal, maze_visit, heuristic, maze_distance, print_solution);
+
+  // Criamos o nosso estado inicial para lançar o algoritmo
+  maze_solver_state_t initial = { maze_solver, maze_solver->entry_coord };
+
+  // Tentamos resolver o problema
+  a_star_fringe_solve(a_star, &initial, NULL);
+
+  // Imprime as estatísticas da execução
+  a_star_fringe_print_statistics(a_star, csv, show_solution);
+
+  // Limpamos a memória
+  a_star_fringe_destroy(a_star);
+}
+
+// Resolve o problema com o algoritmo LPA* e volta a resolvê-lo depois de cada uma de num_changes
+// alterações aleatórias de uma célula, reparando apenas a parte afetada da procura anterior
+void solve_lpa(maze_solver_t* maze_solver, int num_changes, bool csv, bool show_solution)
+{
+  // Criamos a instância do algoritmo, a procura parte da saída e a heurística é calculada até à entrada
+  a_star_lpa_t* a_star = a_star_lpa_create(sizeof(maze_solver_state_t),
+                                           maze_solver->board_len,
+                                           4,
+                                           grid_neighbors,
+                                           grid_state,
+                                           grid_heuristic_entry,
+                                           maze_solver,
+                                           print_solution);
+  size_t entry = grid_index(maze_solver, maze_solver->entry_coord);
+  size_t exit = grid_index(maze_solver, maze_solver->exit_coord);
+
+  // Primeira consulta, sem procura anterior
+  a_star_lpa_solve(a_star, entry, exit);
+  a_star_lpa_print_statistics(a_star, csv, show_solution);
+
+  // As alterações são sempre as mesmas para o mesmo labirinto
+  srand(1);
+  for(int i = 0; i < num_changes; i++)
+  {
+    size_t index = (size_t)rand() % maze_solver->board_len;
+    if(!a_star_lpa_change(a_star, index, grid_toggle))
+    {
+      i--;
+      continue;
+    }
+
+    if(!csv && !show_solution)
+    {
+      printf("Célula (%d, %d) %s\n",
+             (int)(index % maze_solver->cols),
+             (int)(index / maze_solver->cols),
+             maze_solver->initial_board[index] == '.' ? "aberta" : "fechada");
+    }
+    a_star_lpa_solve(a_star, entry, exit);
+    a_star_lpa_print_statistics(a_star, csv, show_solution);
+  }
+
+  // Limpamos a memória
+  a_star_lpa_destroy(a_star);
+}
+
+// Prepara a heurística exata, lida do ficheiro <instância>.dist quando existe e é deste labirinto,
+// caso contrário calculada e guardada no ficheiro para as execuções seguintes
+bool prepare_distances(maze_solver_t* maze_solver, const char* filename, bool csv, bool show_solution)
+{
+  char* cache = malloc(strlen(filename) + sizeof(".dist"));
+  if(cache == NULL)
+  {
+    return false;
+  }
+  sprintf(cache, "%s.dist", filename);
+
+  struct timespec start, end;
+  clock_gettime(CLOCK_MONOTONIC, &start);
+  bool loaded = maze_load_distances(maze_solver, cache);
+  bool saved = false;
+  if(!loaded)
+  {
+    if(!maze_compute_distances(maze_solver))
+    {
+      free(cache);
+      return false;
+    }
+    saved = maze_save_distances(maze_solver, cache);
+  }
+  clock_gettime(CLOCK_MONOTONIC, &end);
+
+  if(!csv && !show_solution)
+  {
+    double elapsed = (end.tv_sec - start.tv_sec) + (end.tv_nsec - start.tv_nsec) / 1000000000.0;
+    printf("Heurística exata: %s em %.6f segundos%s\n",
+           loaded ? "lida do ficheiro" : "calculada",
+           elapsed,
+           loaded || saved ? "" : " (não foi possível guardar o ficheiro)");
+  }
+  free(cache);
+  return true;
+}
+
+// Prepara a heurística ALT com num_landmarks marcos, mapeados do ficheiro <instância>.alt quando existe
+// e é deste labirinto, caso contrário calculados a partir da entrada e guardados no ficheiro
+bool prepare_landmarks(maze_solver_t* maze_solver, const char* filename, size_t num_landmarks, bool csv, bool show_solution)
+{
+  char* cache = malloc(strlen(filename) + sizeof(".alt"));
+  if(cache == NULL)
+  {
+    return false;
+  }
+  sprintf(cache, "%s.alt", filename);
+
+  struct timespec start, end;
+  clock_gettime(CLOCK_MONOTONIC, &start);
+  uint64_t key = maze_board_hash(maze_solver);
+  landmarks_t* landmarks = landmarks_load(cache, maze_solver->board_len, key);
+  bool loaded = landmarks != NULL && landmarks->num_landmarks == num_landmarks;
+  bool saved = false;
+  if(!loaded)
+  {
+    landmarks_destroy(landmarks);
+    landmarks = landmarks_create(maze_solver->board_len,
+                                 4,
+                                 grid_neighbors,
+                                 maze_solver,
+                                 num_landmarks,
+                                 grid_index(maze_solver, maze_solver->entry_coord));
+    if(landmarks == NULL)
+    {
+      free(cache);
+      return false;
+    }
+    saved = landmarks_save(landmarks, cache, key);
+  }
+  clock_gettime(CLOCK_MONOTONIC, &end);
+  maze_solver->landmarks = landmarks;
+
+  if(!csv && !show_solution)
+  {
+    double elapsed = (end.tv_sec - start.tv_sec) + (end.tv_nsec - start.tv_nsec) / 1000000000.0;
+    printf("Heurística ALT: %zu marcos de %zu bits %s em %.6f segundos%s\n",
+           landmarks->num_landmarks,
+           landmarks->width * 8,
+           loaded ? "lidos do ficheiro" : "calculados",
+           elapsed,
+           loaded || saved ? "" : " (não foi possível guardar o ficheiro)");
+  }
+  free(cache);
+  return true;
 }
 
 // Resolve o problema utilizando a versão sequencial do algoritmo
-void solve_sequential(maze_solver_t* maze_solver, bool csv, bool show_solution)
+void solve_sequential(maze_solver_t* maze_solver, int upper_bound, bool csv, bool show_solution)
 {
   // Criamos a instância do algoritmo A*
   a_star_sequential_t* a_star =
-      a_star_sequential_create(sizeof(maze_solver_state_t), goal, visit, heuristic, distance, print_solution);
+      a_star_sequential_create(sizeof(maze_solver_state_t), goal, maze_visit, heuristic, maze_distance, print_solution);
+  // As heurísticas do labirinto (euclidiana, ALT e exata) são consistentes
+  a_star_set_consistent(a_star->common, true);
+  // O objetivo é a célula de saída, as restantes são excluídas pelo resumo
+  maze_solver_state_t exit = { maze_solver, maze_solver->exit_coord };
+  a_star_set_goal_hash(a_star->common, &exit);
+  a_star_set_upper_bound(a_star->common, upper_bound);
   // Criamos o nosso estado inicial para lançar o algoritmo
   maze_solver_state_t initial = { maze_solver, maze_solver->entry_coord };
   // Tentamos resolver o problema
@@ -136,11 +466,30 @@ int main(int argc, char* argv[])
   // Verificar se o nome do arquivo foi fornecido como argumento
   if(argc < 2)
   {
-    printf("Uso: %s [-n <num. trabalhadores>] [-p] [-r] <ficheiro_instâncias>\n", argv[0]);
+    printf("Uso: %s [-n <num. trabalhadores|auto>] [-a <none|compact|scatter>] [-w <k>] [-k <k|auto>] [-D <shm|unix|tcp>] [-P <configurações|auto>] [-W <peso>] [-T <segundos>] [-B] [-F] [-G] [-U <limite>] [-J] [-X <KB>] [-R <alterações>] [-H] [-L <marcos>] [-f] [-p] [-r] <ficheiro_instâncias> [...]\n", argv[0]);
     printf("Opções:\n");
-    printf("-n : Número de trabalhadores (threads), defeito: 0 (algoritmo sequencial)\n");
+    printf("-n : Número de trabalhadores (threads), defeito: 0 (algoritmo sequencial), auto: número de núcleos físicos\n");
+    printf("-a : Afinidade dos trabalhadores aos CPUs (none, compact ou scatter), defeito: none (sem afinidade)\n");
+    printf("-w : Aquecimento sequencial até existirem k nós por trabalhador, defeito: 0 (sem aquecimento)\n");
+    printf("-k : Nós expandidos por iteração de cada trabalhador, auto: adaptativo até %d, defeito: 1\n", BATCH_AUTO_MAX);
+    printf("-D : Algoritmo distribuído com -n processos, comunicação por memória partilhada, sockets unix ou tcp\n");
+    printf("-P : Portfólio de configurações em simultâneo (seq, seq-deep, par, par-first, par-deep), separadas por vírgulas,\n");
+    printf("     a primeira a provar o resultado cancela as restantes, -n é o orçamento de núcleos, auto: %s\n", "seq,par-first,par-deep");
+    printf("-W : Algoritmo ARA* com o peso inicial da heurística indicado, reduzido até 1 (solução ótima)\n");
+    printf("-T : Tempo limite em segundos do algoritmo ARA*, termina com a melhor solução encontrada\n");
+    printf("-B : Algoritmo A* bidirecional (MM), procura a partir do início e do objetivo em simultâneo\n");
+    printf("-F : Algoritmo A* de fronteira, liberta os nós expandidos e guarda apenas a lista aberta\n");
+    printf("-G : Procura em largura paralela por camadas sobre as células, com -n trabalhadores (defeito: 1)\n");
+    printf("-U : Limite superior de g + h da procura em largura e do A* sequencial, os nós acima do limite são podados\n");
+    printf("-J : Vizinhos por pontos de salto (Jump Point Search), não aplicável com -B, -F, -G ou -R\n");
+    printf("-X : Algoritmo A* em memória externa, baldes (g, h) em disco com um buffer de KB por balde (ficheiros em TMPDIR)\n");
+    printf("-R : Algoritmo LPA*, volta a resolver após cada uma das alterações aleatórias de células indicadas\n");
+    printf("-H : Heurística exata, distâncias até à saída calculadas por uma procura em largura e guardadas em <ficheiro>.dist\n");
+    printf("-L : Heurística ALT com os marcos indicados, distâncias calculadas por procuras em largura e guardadas em <ficheiro>.alt\n");
+    printf("-f : Algoritmo Fringe Search, lista da fronteira percorrida com um limite de f crescente, sem fila prioritária\n");
     printf("-p : Termina à primeira solução encontrada, defeito: falso (utilizado no algoritmo paralelo apenas)\n");
     printf("-r : Relatório em formato compatível com CSV \n");
+    printf("Podem ser indicados vários ficheiros, as instâncias são resolvidas pela ordem indicada\n");
     return 0;
   }
 
@@ -149,6 +498,25 @@ int main(int argc, char* argv[])
   bool first = false;
   bool csv = false;
   bool show_solution = false;
+  affinity_policy_e affinity = AFFINITY_NONE;
+  int warmup = 0;
+  int batch_size = 1;
+  bool batch_adaptive = false;
+  bool distributed = false;
+  transport_kind_e transport = TRANSPORT_SHM;
+  a_star_portfolio_config_t portfolio[PORTFOLIO_MAX_CONFIGS];
+  size_t num_configs = 0;
+  double weight = 0;
+  double time_limit = 0;
+  bool bidirectional = false;
+  bool frontier = false;
+  bool bfs = false;
+  int upper_bound = 0;
+  size_t external_buffer = 0;
+  bool fringe = false;
+  int replans = -1;
+  bool exact_heuristic = false;
+  int num_landmarks = 0;
 
   // Verificamos se mais opções foram passadas
   int filename_arg = 1;
@@ -158,7 +526,14 @@ int main(int argc, char* argv[])
 
     if(strcmp(opt, "-n") == 0)
     {
-      if(++i < argc)
+      if(++i < argc && strcmp(argv[i], "auto") == 0)
+      {
+        // Utilizamos um trabalhador por núcleo físico
+        cpu_topology_t* topology = cpu_topology_create();
+        num_threads = (int)cpu_topology_physical_cores(topology);
+        cpu_topology_destroy(topology);
+      }
+      else if(i < argc)
       {
         num_threads = atoi(argv[i]);
       }
@@ -171,6 +546,180 @@ int main(int argc, char* argv[])
       continue;
     }
 
+    if(strcmp(opt, "-a") == 0)
+    {
+      if(++i >= argc || !affinity_from_str(argv[i], &affinity))
+      {
+        printf("Erro: a afinidade tem de ser none, compact ou scatter.\n");
+        return 1;
+      }
+      filename_arg += 2;
+      continue;
+    }
+
+    if(strcmp(opt, "-w") == 0)
+    {
+      if(++i >= argc || (warmup = atoi(argv[i])) < 0)
+      {
+        printf("Erro: o aquecimento tem de ser um número de nós por trabalhador.\n");
+        return 1;
+      }
+      filename_arg += 2;
+      continue;
+    }
+
+    if(strcmp(opt, "-k") == 0)
+    {
+      if(++i < argc && strcmp(argv[i], "auto") == 0)
+      {
+        // O lote adapta-se ao tamanho da lista aberta de cada trabalhador
+        batch_size = BATCH_AUTO_MAX;
+        batch_adaptive = true;
+      }
+      else if(i >= argc || (batch_size = atoi(argv[i])) < 1)
+      {
+        printf("Erro: o tamanho do lote tem de ser um número positivo ou auto.\n");
+        return 1;
+      }
+      filename_arg += 2;
+      continue;
+    }
+
+    if(strcmp(opt, "-D") == 0)
+    {
+      if(++i >= argc || !transport_from_str(argv[i], &transport))
+      {
+        printf("Erro: o transporte tem de ser shm, unix ou tcp.\n");
+        return 1;
+      }
+      distributed = true;
+      filename_arg += 2;
+      continue;
+    }
+
+    if(strcmp(opt, "-P") == 0)
+    {
+      if(++i >= argc || !a_star_portfolio_parse(argv[i], portfolio, &num_configs))
+      {
+        printf("Erro: configuração do portfólio desconhecida.\n");
+        return 1;
+      }
+      filename_arg += 2;
+      continue;
+    }
+
+    if(strcmp(opt, "-W") == 0)
+    {
+      if(++i >= argc || (weight = atof(argv[i])) < 1.0)
+      {
+        printf("Erro: o peso da heurística tem de ser um número maior ou igual a 1.\n");
+        return 1;
+      }
+      filename_arg += 2;
+      continue;
+    }
+
+    if(strcmp(opt, "-T") == 0)
+    {
+      if(++i >= argc || (time_limit = atof(argv[i])) <= 0)
+      {
+        printf("Erro: o tempo limite tem de ser um número positivo de segundos.\n");
+        return 1;
+      }
+      filename_arg += 2;
+      continue;
+    }
+
+    if(strcmp(opt, "-B") == 0)
+    {
+      bidirectional = true;
+      filename_arg++;
+      continue;
+    }
+
+    if(strcmp(opt, "-F") == 0)
+    {
+      frontier = true;
+      filename_arg++;
+      continue;
+    }
+
+    if(strcmp(opt, "-G") == 0)
+    {
+      bfs = true;
+      filename_arg++;
+      continue;
+    }
+
+    if(strcmp(opt, "-U") == 0)
+    {
+      if(++i >= argc || (upper_bound = atoi(argv[i])) <= 0)
+      {
+        printf("Erro: o limite superior tem de ser um número positivo.\n");
+        return 1;
+      }
+      filename_arg += 2;
+      continue;
+    }
+
+    if(strcmp(opt, "-J") == 0)
+    {
+      // Cada corredor é percorrido num só salto, com o custo igual ao número de células
+      maze_visit = visit_jump;
+      maze_distance = distance_jump;
+      filename_arg++;
+      continue;
+    }
+
+    if(strcmp(opt, "-X") == 0)
+    {
+      int kilobytes = 0;
+      if(++i >= argc || (kilobytes = atoi(argv[i])) <= 0)
+      {
+        printf("Erro: o buffer de cada balde tem de ser um número positivo de KB.\n");
+        return 1;
+      }
+      external_buffer = (size_t)kilobytes * 1024;
+      filename_arg += 2;
+      continue;
+    }
+
+    if(strcmp(opt, "-R") == 0)
+    {
+      if(++i >= argc || (replans = atoi(argv[i])) < 0)
+      {
+        printf("Erro: o número de alterações tem de ser um número positivo ou 0.\n");
+        return 1;
+      }
+      filename_arg += 2;
+      continue;
+    }
+
+    if(strcmp(opt, "-H") == 0)
+    {
+      exact_heuristic = true;
+      filename_arg++;
+      continue;
+    }
+
+    if(strcmp(opt, "-L") == 0)
+    {
+      if(++i >= argc || (num_landmarks = atoi(argv[i])) <= 0)
+      {
+        printf("Erro: o número de marcos tem de ser um número positivo.\n");
+        return 1;
+      }
+      filename_arg += 2;
+      continue;
+    }
+
+    if(strcmp(opt, "-f") == 0)
+    {
+      fringe = true;
+      filename_arg++;
+      continue;
+    }
+
     if(strcmp(opt, "-p") == 0)
     {
       first = true;
@@ -193,44 +742,123 @@ int main(int argc, char* argv[])
     }
   }
 
+  if(maze_visit == visit_jump && (bidirectional || frontier || bfs || replans >= 0))
+  {
+    printf("Erro: os pontos de salto não são suportados pelos algoritmos bidirecional, de fronteira, em largura e LPA*.\n");
+    return 1;
+  }
+
   if(filename_arg >= argc)
   {
     printf("Erro: o falta nome do ficheiro com dados .\n");
     return 1;
   }
 
-  maze_solver_t* maze_solver = init_maze_solver_puzzle(argv[filename_arg]);
-
-  // Inicializa o nosso puzzle
-  if(!maze_solver)
+  // O algoritmo paralelo é criado uma única vez, os trabalhadores são reutilizados por todas as instâncias
+  a_star_parallel_t* a_star = NULL;
+  if(num_threads > 0 && !distributed && weight == 0 && !bidirectional && !frontier && !bfs && external_buffer == 0 && !fringe &&
+     replans < 0 && num_configs == 0)
   {
-    printf("Erro a inicializar o puzzle, verifique o ficheiro com os dados\n");
-    return 1;
+    a_star = a_star_parallel_create(
+        sizeof(maze_solver_state_t), goal, maze_visit, heuristic, maze_distance, print_solution, num_threads, first);
+
+    // Fixamos os trabalhadores aos CPUs caso tenha sido pedido
+    a_star_parallel_set_affinity(a_star, affinity);
+
+    // Fase de aquecimento para que todos os trabalhadores comecem com nós
+    a_star_parallel_set_warmup(a_star, (size_t)warmup);
+
+    // Expansão de lotes de nós por iteração
+    a_star_parallel_set_batch(a_star, (size_t)batch_size, batch_adaptive);
   }
-  if(num_threads > 0)
+
+  // Cada ficheiro indicado é uma instância a resolver
+  for(int f = filename_arg; f < argc; f++)
   {
- #ifdef STATS_GEN
-    if(first)
+    maze_solver_t* maze_solver = init_maze_solver_puzzle(argv[f]);
+
+    // Inicializa o nosso puzzle
+    if(!maze_solver)
     {
-      search_data_create("maze", argv[filename_arg], ALGO_PARALLEL_FIRST, num_threads, maze_serialize_function);
+      printf("Erro a inicializar o puzzle, verifique o ficheiro com os dados\n");
+      continue;
     }
-    else
+    if(exact_heuristic && !prepare_distances(maze_solver, argv[f], csv, show_solution))
+    {
+      printf("Erro a calcular as distâncias até à saída\n");
+      maze_solver_destroy(maze_solver);
+      continue;
+    }
+    if(num_landmarks > 0 && !prepare_landmarks(maze_solver, argv[f], (size_t)num_landmarks, csv, show_solution))
+    {
+      printf("Erro a calcular os marcos da heurística ALT\n");
+      maze_solver_destroy(maze_solver);
+      continue;
+    }
+    if(replans >= 0)
+    {
+      solve_lpa(maze_solver, replans, csv, show_solution);
+    }
+    else if(fringe)
+    {
+      solve_fringe(maze_solver, csv, show_solution);
+    }
+    else if(bfs)
+    {
+      solve_bfs(maze_solver, num_threads > 0 ? num_threads : 1, upper_bound, csv, show_solution);
+    }
+    else if(external_buffer > 0)
+    {
+      solve_external(maze_solver, external_buffer, csv, show_solution);
+    }
+    else if(frontier)
+    {
+      solve_frontier(maze_solver, csv, show_solution);
+    }
+    else if(bidirectional)
     {
-      search_data_create("maze", argv[filename_arg], ALGO_PARALLEL_EXHAUSTIVE, num_threads, maze_serialize_function);
+      solve_bidirectional(maze_solver, csv, show_solution);
     }
+    else if(weight > 0)
+    {
+      solve_ara(maze_solver, weight, time_limit, csv, show_solution);
+    }
+    else if(num_configs > 0)
+    {
+      solve_portfolio(maze_solver, portfolio, num_configs, num_threads, csv, show_solution);
+    }
+    else if(distributed)
+    {
+      solve_distributed(maze_solver, num_threads > 0 ? num_threads : 1, first, transport, csv, show_solution);
+    }
+    else if(a_star != NULL)
+    {
+#ifdef STATS_GEN
+      if(first)
+      {
+        search_data_create("maze", argv[f], ALGO_PARALLEL_FIRST, num_threads, maze_serialize_function);
+      }
+      else
+      {
+        search_data_create("maze", argv[f], ALGO_PARALLEL_EXHAUSTIVE, num_threads, maze_serialize_function);
+      }
 #endif
-   solve_parallel(maze_solver, num_threads, first, csv, show_solution);
-  }
-  else
-  {
+      solve_parallel(a_star, maze_solver, csv, show_solution);
+    }
+    else
+    {
 #ifdef STATS_GEN
-    search_data_create("maze", argv[filename_arg], ALGO_SEQUENTIAL, 1, maze_serialize_function);
+      search_data_create("maze", argv[f], ALGO_SEQUENTIAL, 1, maze_serialize_function);
 #endif
-    solve_sequential(maze_solver, csv, show_solution);
-  }
+      solve_sequential(maze_solver, upper_bound, csv, show_solution);
+    }
 #ifdef STATS_GEN
-  search_data_destroy();
+    search_data_destroy();
 #endif
-  maze_solver_destroy(maze_solver);
+    maze_solver_destroy(maze_solver);
+  }
+
+  // Limpamos a memória
+  a_star_parallel_destroy(a_star);
   return 0;
 }
\ No newline at end of file
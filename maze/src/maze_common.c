@@ -18,6 +18,8 @@ maze_solver_t* maze_solver_init(int rows, int cols, const char* board)
 
   // Garante a memoria limpa
   maze_solver->initial_board = NULL;
+  maze_solver->distances = NULL;
+  maze_solver->landmarks = NULL;
   maze_solver->entry_coord = (coord){ 1, 0 };
   maze_solver->exit_coord = (coord){ cols - 2, rows - 1 };
 
@@ -52,6 +54,9 @@ void maze_solver_destroy(maze_solver_t* maze_solver)
     free(maze_solver->initial_board);
   }
 
+  free(maze_solver->distances);
+  landmarks_destroy(maze_solver->landmarks);
+
   free(maze_solver);
   maze_solver = NULL;
 }
@@ -32,8 +32,44 @@ int heuristic(const state_t* current_state, const state_t*)
   maze_solver_state_t* state = (maze_solver_state_t*)(current_state->data);
   maze_solver_t* maze_solver = state->maze_solver;
 
+  // Com a tabela de distâncias a heurística é exata
+  if(maze_solver->distances != NULL)
+  {
+    return grid_heuristic(grid_index(maze_solver, state->position), maze_solver);
+  }
+
   int h = (int)sqrt(pow(state->position.col - maze_solver->exit_coord.col, 2) +
                     pow(state->position.row - maze_solver->exit_coord.row, 2));
+
+  // Com marcos a heurística é a maior das duas, ambas são admissíveis
+  if(maze_solver->landmarks != NULL)
+  {
+    int h_alt = landmarks_heuristic(maze_solver->landmarks,
+                                    grid_index(maze_solver, state->position),
+                                    grid_index(maze_solver, maze_solver->exit_coord));
+    if(h_alt > h)
+      h = h_alt;
+  }
+  return h;
+}
+
+// Distância euclidiana até à posição do estado indicado, utilizada pela procura para trás
+int heuristic_reverse(const state_t* current_state, const state_t* target_state)
+{
+  maze_solver_state_t* state = (maze_solver_state_t*)(current_state->data);
+  maze_solver_state_t* target = (maze_solver_state_t*)(target_state->data);
+
+  int h = (int)sqrt(pow(state->position.col - target->position.col, 2) + pow(state->position.row - target->position.row, 2));
+
+  // Os marcos servem para qualquer objetivo, também para a procura até ao início
+  maze_solver_t* maze_solver = state->maze_solver;
+  if(maze_solver->landmarks != NULL)
+  {
+    int h_alt = landmarks_heuristic(
+        maze_solver->landmarks, grid_index(maze_solver, state->position), grid_index(maze_solver, target->position));
+    if(h_alt > h)
+      h = h_alt;
+  }
   return h;
 }
 
@@ -81,6 +117,67 @@ void visit(state_t* current_state, state_allocator_t* allocator, linked_list_t*
   }
 }
 
+// Verifica se uma posição está dentro do tabuleiro e livre
+static bool open_cell(const maze_solver_t* maze_solver, coord position)
+{
+  if(position.row < 0 || position.row >= maze_solver->rows || position.col < 0 || position.col >= maze_solver->cols)
+  {
+    return false;
+  }
+
+  return maze_solver->initial_board[position.row * maze_solver->cols + position.col] == '.';
+}
+
+// Avança em linha reta até ao próximo ponto de salto: a saída ou uma célula com uma célula livre
+// perpendicular ao movimento (um cruzamento ou uma curva). Retorna falso se o corredor termina
+// sem nenhum ponto de salto, um beco sem saída que nunca faz parte de um caminho ótimo
+static bool jump(const maze_solver_t* maze_solver, coord* position, int dcol, int drow)
+{
+  coord current = *position;
+  while(true)
+  {
+    current.col += dcol;
+    current.row += drow;
+    if(!open_cell(maze_solver, current))
+    {
+      return false;
+    }
+
+    if(current.col == maze_solver->exit_coord.col && current.row == maze_solver->exit_coord.row)
+    {
+      break;
+    }
+
+    coord side_a = { current.col + drow, current.row + dcol };
+    coord side_b = { current.col - drow, current.row - dcol };
+    if(open_cell(maze_solver, side_a) || open_cell(maze_solver, side_b))
+    {
+      break;
+    }
+  }
+
+  *position = current;
+  return true;
+}
+
+// Gera os pontos de salto a partir do estado atual, pela mesma ordem da função visit. As células
+// intermédias de um salto têm apenas a célula seguinte e a anterior livres, pelo que qualquer
+// caminho que as atravesse segue em linha reta e o caminho ótimo é mantido
+void visit_jump(state_t* current_state, state_allocator_t* allocator, linked_list_t* neighbors)
+{
+  maze_solver_state_t* state = (maze_solver_state_t*)current_state->data;
+  static const int directions[4][2] = { { 0, 1 }, { 0, -1 }, { -1, 0 }, { 1, 0 } };
+
+  for(int d = 0; d < 4; d++)
+  {
+    coord new_position = state->position;
+    if(jump(state->maze_solver, &new_position, directions[d][0], directions[d][1]))
+    {
+      update_neighbors(state->maze_solver, new_position, allocator, neighbors);
+    }
+  }
+}
+
 // Verifica se um estado é um objetivo do problema number link
 bool goal(const state_t* state_a, const state_t*)
 {
@@ -94,6 +191,255 @@ int distance(const state_t*, const state_t*)
   return 1;
 }
 
+// Custo de um salto, o número de células percorridas em linha reta
+int distance_jump(const state_t* state_a, const state_t* state_b)
+{
+  maze_solver_state_t* a = (maze_solver_state_t*)state_a->data;
+  maze_solver_state_t* b = (maze_solver_state_t*)state_b->data;
+
+  return abs(a->position.col - b->position.col) + abs(a->position.row - b->position.row);
+}
+
+// Índice de uma célula no tabuleiro
+size_t grid_index(const maze_solver_t* maze_solver, coord position)
+{
+  return (size_t)position.row * maze_solver->cols + position.col;
+}
+
+// Verifica se a célula de um índice é livre, a entrada está marcada no tabuleiro mas é livre
+static inline bool grid_free(const maze_solver_t* maze_solver, size_t index)
+{
+  return maze_solver->initial_board[index] == '.' || index == grid_index(maze_solver, maze_solver->entry_coord);
+}
+
+// Índices das células livres vizinhas, pela mesma ordem da função visit. Uma parede não tem vizinhos
+size_t grid_neighbors(size_t index, size_t* neighbors, void* context)
+{
+  maze_solver_t* maze_solver = (maze_solver_t*)context;
+  size_t cols = (size_t)maze_solver->cols;
+  size_t row = index / cols;
+  size_t col = index % cols;
+  size_t count = 0;
+
+  if(!grid_free(maze_solver, index))
+    return 0;
+
+  if(row + 1 < (size_t)maze_solver->rows && grid_free(maze_solver, index + cols))
+    neighbors[count++] = index + cols;
+
+  if(row > 0 && grid_free(maze_solver, index - cols))
+    neighbors[count++] = index - cols;
+
+  if(col > 0 && grid_free(maze_solver, index - 1))
+    neighbors[count++] = index - 1;
+
+  if(col + 1 < cols && grid_free(maze_solver, index + 1))
+    neighbors[count++] = index + 1;
+
+  return count;
+}
+
+// Heurística de uma célula, a mesma distância até à saída da função heuristic
+int grid_heuristic(size_t index, void* context)
+{
+  maze_solver_t* maze_solver = (maze_solver_t*)context;
+  if(maze_solver->distances != NULL)
+  {
+    // Uma célula sem caminho até à saída tem uma heurística maior do que qualquer caminho
+    int32_t d = maze_solver->distances[index];
+    return d != MAZE_UNREACHABLE ? (int)d : (int)maze_solver->board_len;
+  }
+
+  int row = (int)(index / maze_solver->cols);
+  int col = (int)(index % maze_solver->cols);
+
+  int h = (int)sqrt(pow(col - maze_solver->exit_coord.col, 2) + pow(row - maze_solver->exit_coord.row, 2));
+  if(maze_solver->landmarks != NULL)
+  {
+    int h_alt = landmarks_heuristic(maze_solver->landmarks, index, grid_index(maze_solver, maze_solver->exit_coord));
+    if(h_alt > h)
+      h = h_alt;
+  }
+  return h;
+}
+
+// Heurística de uma célula até à entrada, para as procuras feitas da saída para a entrada
+int grid_heuristic_entry(size_t index, void* context)
+{
+  maze_solver_t* maze_solver = (maze_solver_t*)context;
+  int row = (int)(index / maze_solver->cols);
+  int col = (int)(index % maze_solver->cols);
+
+  int h = (int)sqrt(pow(col - maze_solver->entry_coord.col, 2) + pow(row - maze_solver->entry_coord.row, 2));
+  return h;
+}
+
+// Abre uma parede ou fecha uma célula livre do interior do labirinto, a entrada e a saída estão na
+// margem e não podem ser alteradas
+bool maze_toggle_cell(maze_solver_t* maze_solver, coord position)
+{
+  if(position.row < 1 || position.row >= maze_solver->rows - 1 || position.col < 1 || position.col >= maze_solver->cols - 1)
+  {
+    return false;
+  }
+
+  char* cell = &maze_solver->initial_board[grid_index(maze_solver, position)];
+  *cell = *cell == '.' ? 'X' : '.';
+
+  // As distâncias até à saída e aos marcos deixam de ser válidas, voltamos à distância euclidiana
+  free(maze_solver->distances);
+  maze_solver->distances = NULL;
+  landmarks_destroy(maze_solver->landmarks);
+  maze_solver->landmarks = NULL;
+  return true;
+}
+
+// Alteração de uma célula pelo seu índice, o contexto é o maze_solver_t
+bool grid_toggle(size_t index, void* context)
+{
+  maze_solver_t* maze_solver = (maze_solver_t*)context;
+  coord position = { (int)(index % maze_solver->cols), (int)(index / maze_solver->cols) };
+  return maze_toggle_cell(maze_solver, position);
+}
+
+// Procura em largura a partir da saída sobre as células livres, o custo de cada passo é 1 pelo que
+// a distância de cada célula é exata
+bool maze_compute_distances(maze_solver_t* maze_solver)
+{
+  int32_t* distances = (int32_t*)malloc(maze_solver->board_len * sizeof(int32_t));
+  size_t* queue = (size_t*)malloc(maze_solver->board_len * sizeof(size_t));
+  if(distances == NULL || queue == NULL)
+  {
+    free(distances);
+    free(queue);
+    return false;
+  }
+
+  for(size_t i = 0; i < maze_solver->board_len; i++)
+    distances[i] = MAZE_UNREACHABLE;
+
+  // O labirinto não é dirigido, os vizinhos de uma célula são também os seus predecessores
+  size_t head = 0, tail = 0;
+  size_t exit_index = grid_index(maze_solver, maze_solver->exit_coord);
+  distances[exit_index] = 0;
+  queue[tail++] = exit_index;
+  while(head < tail)
+  {
+    size_t index = queue[head++];
+    size_t neighbors[4];
+    size_t count = grid_neighbors(index, neighbors, maze_solver);
+    for(size_t i = 0; i < count; i++)
+    {
+      if(distances[neighbors[i]] == MAZE_UNREACHABLE)
+      {
+        distances[neighbors[i]] = distances[index] + 1;
+        queue[tail++] = neighbors[i];
+      }
+    }
+  }
+  free(queue);
+
+  free(maze_solver->distances);
+  maze_solver->distances = distances;
+  return true;
+}
+
+// Cabeçalho do ficheiro de distâncias, o resumo do tabuleiro deteta um ficheiro de outro labirinto
+typedef struct
+{
+  char magic[8];
+  int32_t rows;
+  int32_t cols;
+  coord exit_coord;
+  uint64_t board_hash;
+} maze_distances_header_t;
+
+static const char MAZE_DISTANCES_MAGIC[8] = "MAZEDST";
+
+// Resumo FNV-1a do tabuleiro
+uint64_t maze_board_hash(const maze_solver_t* maze_solver)
+{
+  return hash_fnv1a(maze_solver->initial_board, maze_solver->board_len);
+}
+
+static void maze_distances_header(const maze_solver_t* maze_solver, maze_distances_header_t* header)
+{
+  memset(header, 0, sizeof(maze_distances_header_t));
+  memcpy(header->magic, MAZE_DISTANCES_MAGIC, sizeof(header->magic));
+  header->rows = maze_solver->rows;
+  header->cols = maze_solver->cols;
+  header->exit_coord = maze_solver->exit_coord;
+  header->board_hash = maze_board_hash(maze_solver);
+}
+
+// Guarda as distâncias num ficheiro binário, o cabeçalho seguido de uma distância por célula
+bool maze_save_distances(const maze_solver_t* maze_solver, const char* filename)
+{
+  if(maze_solver->distances == NULL)
+  {
+    return false;
+  }
+
+  FILE* file = fopen(filename, "wb");
+  if(file == NULL)
+  {
+    return false;
+  }
+
+  maze_distances_header_t header;
+  maze_distances_header(maze_solver, &header);
+  bool ok = fwrite(&header, sizeof(header), 1, file) == 1 &&
+            fwrite(maze_solver->distances, sizeof(int32_t), maze_solver->board_len, file) == maze_solver->board_len;
+  ok = fclose(file) == 0 && ok;
+  if(!ok)
+  {
+    remove(filename);
+  }
+  return ok;
+}
+
+// Lê as distâncias de um ficheiro guardado por maze_save_distances para o mesmo labirinto
+bool maze_load_distances(maze_solver_t* maze_solver, const char* filename)
+{
+  FILE* file = fopen(filename, "rb");
+  if(file == NULL)
+  {
+    return false;
+  }
+
+  maze_distances_header_t header, expected;
+  maze_distances_header(maze_solver, &expected);
+  int32_t* distances = NULL;
+  bool ok = fread(&header, sizeof(header), 1, file) == 1 && memcmp(&header, &expected, sizeof(header)) == 0;
+  if(ok)
+  {
+    distances = (int32_t*)malloc(maze_solver->board_len * sizeof(int32_t));
+    ok = distances != NULL && fread(distances, sizeof(int32_t), maze_solver->board_len, file) == maze_solver->board_len;
+  }
+  fclose(file);
+
+  if(!ok)
+  {
+    free(distances);
+    return false;
+  }
+
+  free(maze_solver->distances);
+  maze_solver->distances = distances;
+  return true;
+}
+
+// Converte o índice de uma célula no estado do labirinto
+void grid_state(size_t index, void* state_data, void* context)
+{
+  maze_solver_t* maze_solver = (maze_solver_t*)context;
+  maze_solver_state_t* state = (maze_solver_state_t*)state_data;
+
+  state->maze_solver = maze_solver;
+  state->position.row = (int)(index / maze_solver->cols);
+  state->position.col = (int)(index % maze_solver->cols);
+}
+
 #ifdef STATS_GEN
 size_t maze_serialize_function(char* buffer, const search_data_entry_t* entry)
 {
@@ -2,6 +2,7 @@
 #include "state.h"
 #include <check.h>
 #include <stdlib.h>
+#include <unistd.h>
 
 // Teste unitário para a função visit
 START_TEST(test_visit_case_1)
@@ -136,6 +137,167 @@ START_TEST(test_heuristic) {
 }
 END_TEST
 
+// Teste unitário para a função heuristic_reverse
+START_TEST(test_heuristic_reverse) {
+  int rows = 5;
+  int cols = 5;
+  char board[25] = "X.XXXX.XXXX...XX.X.XXXX.X";
+  coord position = { 1, 2 };
+  coord target = { 4, 2 };
+
+  maze_solver_t* maze_solver = maze_solver_init(rows, cols, board);
+
+  maze_solver_state_t current_state = { maze_solver, position };
+  maze_solver_state_t target_state = { maze_solver, target };
+  state_t current_ptr = { 0, sizeof(maze_solver_state_t), &current_state };
+  state_t target_ptr = { 0, sizeof(maze_solver_state_t), &target_state };
+
+  // A distância é calculada até à posição do estado indicado e não até à saída
+  ck_assert_int_eq(heuristic_reverse(&current_ptr, &target_ptr), 3);
+  ck_assert_int_eq(heuristic_reverse(&target_ptr, &target_ptr), 0);
+
+  maze_solver_destroy(maze_solver);
+}
+END_TEST
+
+// Teste unitário para as funções sobre o índice das células
+START_TEST(test_grid_neighbors) {
+  int rows = 5;
+  int cols = 5;
+  char board[25] = "X.XXXX.XXXX...XX.X.XXXX.X";
+  coord position = { 1, 2 };
+
+  maze_solver_t* maze_solver = maze_solver_init(rows, cols, board);
+  size_t index = grid_index(maze_solver, position);
+  ck_assert_uint_eq(index, 11);
+
+  // Os vizinhos livres são gerados pela ordem da função visit: baixo, cima, esquerda, direita
+  size_t neighbors[4];
+  size_t num_neighbors = grid_neighbors(index, neighbors, maze_solver);
+  ck_assert_uint_eq(num_neighbors, 3);
+  ck_assert_uint_eq(neighbors[0], 16);
+  ck_assert_uint_eq(neighbors[1], 6);
+  ck_assert_uint_eq(neighbors[2], 12);
+
+  // A entrada só tem a célula de baixo livre
+  ck_assert_uint_eq(grid_neighbors(grid_index(maze_solver, maze_solver->entry_coord), neighbors, maze_solver), 1);
+
+  maze_solver_state_t state;
+  grid_state(neighbors[2], &state, maze_solver);
+  ck_assert_int_eq(state.position.col, 2);
+  ck_assert_int_eq(state.position.row, 2);
+  ck_assert_ptr_eq(state.maze_solver, maze_solver);
+
+  ck_assert_int_eq(grid_heuristic(grid_index(maze_solver, maze_solver->exit_coord), maze_solver), 0);
+  ck_assert_int_eq(grid_heuristic_entry(grid_index(maze_solver, maze_solver->entry_coord), maze_solver), 0);
+
+  // Uma parede não tem vizinhos, ao ser aberta passa a ligar as células livres à sua volta
+  coord wall = { 2, 1 };
+  ck_assert_uint_eq(grid_neighbors(grid_index(maze_solver, wall), neighbors, maze_solver), 0);
+  ck_assert(maze_toggle_cell(maze_solver, wall));
+  ck_assert_uint_eq(grid_neighbors(grid_index(maze_solver, wall), neighbors, maze_solver), 2);
+  ck_assert_uint_eq(grid_neighbors(6, neighbors, maze_solver), 3);
+  ck_assert(grid_toggle(grid_index(maze_solver, wall), maze_solver));
+  ck_assert_uint_eq(grid_neighbors(6, neighbors, maze_solver), 2);
+
+  // As células da margem, onde estão a entrada e a saída, não são alteradas
+  ck_assert(!maze_toggle_cell(maze_solver, maze_solver->entry_coord));
+  ck_assert(!maze_toggle_cell(maze_solver, maze_solver->exit_coord));
+
+  maze_solver_destroy(maze_solver);
+}
+END_TEST
+
+// Teste unitário para a heurística exata e para o ficheiro de distâncias
+START_TEST(test_distances) {
+  int rows = 5;
+  int cols = 5;
+  char board[25] = "X.XXXX.XXXX...XX.X.XXXX.X";
+
+  maze_solver_t* maze_solver = maze_solver_init(rows, cols, board);
+  ck_assert(maze_compute_distances(maze_solver));
+
+  // Distâncias pelo caminho do labirinto, uma parede tem uma heurística maior do que qualquer caminho
+  coord position = { 1, 2 };
+  coord dead_end = { 1, 3 };
+  coord wall = { 0, 0 };
+  ck_assert_int_eq(grid_heuristic(grid_index(maze_solver, maze_solver->exit_coord), maze_solver), 0);
+  ck_assert_int_eq(grid_heuristic(grid_index(maze_solver, maze_solver->entry_coord), maze_solver), 6);
+  ck_assert_int_eq(grid_heuristic(grid_index(maze_solver, position), maze_solver), 4);
+  ck_assert_int_eq(grid_heuristic(grid_index(maze_solver, dead_end), maze_solver), 5);
+  ck_assert_int_eq(grid_heuristic(grid_index(maze_solver, wall), maze_solver), 25);
+
+  state_allocator_t* allocator = state_allocator_create(sizeof(maze_solver_state_t));
+  maze_solver_state_t entry_state = { maze_solver, maze_solver->entry_coord };
+  ck_assert_int_eq(heuristic(state_allocator_new(allocator, &entry_state), NULL), 6);
+
+  // O ficheiro guardado é lido para o mesmo labirinto e recusado para outro
+  char filename[] = "/tmp/test_maze_distances_XXXXXX";
+  int fd = mkstemp(filename);
+  ck_assert_int_ne(fd, -1);
+  close(fd);
+  ck_assert(maze_save_distances(maze_solver, filename));
+
+  maze_solver_t* loaded = maze_solver_init(rows, cols, board);
+  ck_assert(maze_load_distances(loaded, filename));
+  ck_assert_mem_eq(loaded->distances, maze_solver->distances, 25 * sizeof(int32_t));
+
+  board[12] = 'X';
+  maze_solver_t* other = maze_solver_init(rows, cols, board);
+  ck_assert(!maze_load_distances(other, filename));
+  ck_assert_ptr_null(other->distances);
+  remove(filename);
+
+  // Uma alteração do labirinto invalida as distâncias
+  ck_assert(maze_toggle_cell(maze_solver, position));
+  ck_assert_ptr_null(maze_solver->distances);
+
+  state_allocator_destroy(allocator);
+  maze_solver_destroy(other);
+  maze_solver_destroy(loaded);
+  maze_solver_destroy(maze_solver);
+}
+END_TEST
+
+// Teste unitário para as funções visit_jump e distance_jump
+START_TEST(test_visit_jump) {
+  int rows = 5;
+  int cols = 5;
+  char board[25] = "X.XXXX.XXXX...XX.X.XXXX.X";
+  coord position = { 1, 2 };
+
+  maze_solver_t* maze_solver = maze_solver_init(rows, cols, board);
+  state_allocator_t* allocator = state_allocator_create(sizeof(maze_solver_state_t));
+  linked_list_t* neighbors = linked_list_create();
+
+  maze_solver_state_t initial_state = { maze_solver, position };
+  state_t* initial_state_ptr = state_allocator_new(allocator, &initial_state);
+
+  // Para baixo e para cima os corredores são becos sem saída, para a direita o salto termina na curva
+  visit_jump(initial_state_ptr, allocator, neighbors);
+  ck_assert_int_eq(linked_list_size(neighbors), 1);
+  state_t* corner_ptr = linked_list_get(neighbors, 0);
+  linked_list_remove(neighbors, 0);
+  maze_solver_state_t* corner = (maze_solver_state_t*)corner_ptr->data;
+  ck_assert_int_eq(corner->position.col, 3);
+  ck_assert_int_eq(corner->position.row, 2);
+  ck_assert_int_eq(distance_jump(initial_state_ptr, corner_ptr), 2);
+
+  // Da curva salta-se para a saída e de volta ao cruzamento
+  visit_jump(corner_ptr, allocator, neighbors);
+  ck_assert_int_eq(linked_list_size(neighbors), 2);
+  maze_solver_state_t* exit_state = (maze_solver_state_t*)((state_t*)linked_list_get(neighbors, 0))->data;
+  ck_assert_int_eq(exit_state->position.col, maze_solver->exit_coord.col);
+  ck_assert_int_eq(exit_state->position.row, maze_solver->exit_coord.row);
+  ck_assert_ptr_eq(linked_list_get(neighbors, 1), initial_state_ptr);
+
+  // Liberta a memória utilizada
+  linked_list_destroy(neighbors);
+  state_allocator_destroy(allocator);
+  maze_solver_destroy(maze_solver);
+}
+END_TEST
+
 // Função auxiliar para criação da suíte de testes
 Suite* create_suite()
 {
@@ -145,6 +307,10 @@ Suite* create_suite()
   tcase_add_test(tcase, test_goal);
   tcase_add_test(tcase, test_distance);
   tcase_add_test(tcase, test_heuristic);
+  tcase_add_test(tcase, test_heuristic_reverse);
+  tcase_add_test(tcase, test_grid_neighbors);
+  tcase_add_test(tcase, test_distances);
+  tcase_add_test(tcase, test_visit_jump);
   suite_add_tcase(suite, tcase);
   return suite;
 }
@@ -0,0 +1,89 @@
+/*
+   Problema N-puzzle (8, 15 e 24 puzzle)
+
+   Generalização do puzzle 8 para tabuleiros de largura 3 a 5. Cada estado guarda o tabuleiro
+   compactado em palavras de 64 bits, com 4 bits por posição até à largura 4 (o puzzle 15 ocupa uma
+   única palavra) e 5 bits na largura 5 (o puzzle 24 ocupa duas palavras). O valor de uma posição é
+   a peça que lá está e o espaço vazio é o 0.
+
+   - A largura é definida por npuzzle_init antes de criar os algoritmos, que prepara as tabelas das
+     distâncias de Manhattan de cada peça em cada posição e dos movimentos de cada posição.
+   - Os estados não têm ponteiros e ocupam npuzzle_state_size() bytes, pelo que os algoritmos
+     (incluindo o distribuído) os utilizam tal como os do puzzle 8.
+   - As funções do problema têm a mesma forma das do puzzle 8.
+*/
+#ifndef NPUZZLE_LOGIC_H
+#define NPUZZLE_LOGIC_H
+#include "linked_list.h"
+#include "state.h"
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#define NPUZZLE_MIN_WIDTH 3
+#define NPUZZLE_MAX_WIDTH 5
+#define NPUZZLE_MAX_CELLS (NPUZZLE_MAX_WIDTH * NPUZZLE_MAX_WIDTH)
+#define NPUZZLE_MAX_WORDS 2
+
+// Estrutura do que contem o estado do nosso N-puzzle, só as primeiras palavras são utilizadas
+typedef struct
+{
+  uint64_t words[NPUZZLE_MAX_WORDS];
+} npuzzle_state_t;
+
+// Bases de dados de padrões, definidas em npuzzle_pdb.h
+typedef struct npuzzle_pdb_t npuzzle_pdb_t;
+
+// Define a largura do tabuleiro e prepara as tabelas, retorna falso para uma largura não suportada
+bool npuzzle_init(int width);
+
+// Largura e número de posições do tabuleiro atual
+int npuzzle_width(void);
+
+int npuzzle_cells(void);
+
+// Número de bytes utilizados por um estado, o tamanho indicado aos algoritmos
+size_t npuzzle_state_size(void);
+
+// Peça numa posição do tabuleiro
+int npuzzle_get(const npuzzle_state_t*, int);
+
+// Coloca uma peça numa posição do tabuleiro
+void npuzzle_set(npuzzle_state_t*, int, int);
+
+// Posição do espaço vazio
+int npuzzle_blank(const npuzzle_state_t*);
+
+// Constrói um estado a partir das peças de cada posição, retorna falso se não forem uma permutação
+bool npuzzle_from_tiles(npuzzle_state_t*, const int*, int);
+
+// Verifica se o tabuleiro tem solução. Um movimento horizontal não altera as inversões das peças e um
+// vertical altera-as em largura - 1: com largura ímpar a paridade das inversões é invariante, com
+// largura par é invariante a paridade das inversões somadas à linha do espaço vazio
+bool npuzzle_solvable(const npuzzle_state_t*);
+
+// Distância de Manhattan de um estado até ao objetivo
+int npuzzle_manhattan(const npuzzle_state_t*);
+
+// Utiliza as bases de dados de padrões na heurística, NULL volta à distância de Manhattan
+void npuzzle_set_pdb(const npuzzle_pdb_t*);
+
+// Implementa a heurística do problema N-puzzle
+int heuristic(const state_t*, const state_t*);
+
+// Heurística inversa do problema N-puzzle, distância de Manhattan até ao tabuleiro indicado
+int heuristic_reverse(const state_t*, const state_t*);
+
+// Copia o tabuleiro objetivo do problema N-puzzle
+void goal_board(npuzzle_state_t*);
+
+// Encontra os vizinhos de um estado no problema N-puzzle
+void visit(state_t*, state_allocator_t*, linked_list_t*);
+
+// Verifica se um estado é um objetivo do problema N-puzzle
+bool goal(const state_t*, const state_t*);
+
+// Retorna a distância de um estado anterior para o proximo, sempre 1
+int distance(const state_t*, const state_t*);
+
+#endif // NPUZZLE_LOGIC_H
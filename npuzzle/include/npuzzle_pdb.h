@@ -0,0 +1,86 @@
+/*
+   Bases de dados de padrões aditivas para o N-puzzle
+
+   As peças são divididas em padrões disjuntos (por exemplo 6-6-3 no puzzle 15). Para cada padrão é
+   calculado, para todas as posições das suas peças, o número mínimo de movimentos dessas peças até
+   ao objetivo, ignorando as restantes. Como só são contados os movimentos das peças de cada padrão,
+   a soma dos padrões é uma heurística admissível e consistente, e as peças fora de todos os padrões
+   contribuem com a distância de Manhattan.
+
+   - Cada padrão é calculado por uma procura em largura para trás a partir do objetivo sobre as
+     posições das peças do padrão e do espaço vazio, numeradas por permutações parciais. Os
+     movimentos do espaço vazio para posições livres não têm custo e são fechados antes de cada
+     camada, os movimentos das peças do padrão passam à camada seguinte. As camadas são divididas
+     pelos trabalhadores em blocos de índices, um estado é reclamado com uma troca atómica da sua
+     distância e as camadas são separadas por uma barreira.
+   - A tabela guarda o mínimo sobre as posições do espaço vazio. Cada movimento de uma peça altera a
+     sua distância de Manhattan em 1, pelo que o valor de um padrão é a distância de Manhattan das
+     suas peças mais um número par: é guardado apenas metade desse excesso, com 4 bits por entrada
+     quando todos os excessos cabem em 4 bits e 8 bits caso contrário.
+   - As tabelas podem ser guardadas num ficheiro e lidas através de mmap, sem copiar os dados. O
+     ficheiro guarda a largura e os padrões, pelo que pode ser reutilizado por todas as instâncias
+     da mesma largura.
+
+   O espaço da procura de um padrão de k peças tem N! / (N - k - 1)! estados de um byte, com N o
+   número de posições: cerca de 58 MB para um padrão de 6 peças do puzzle 15.
+*/
+#ifndef NPUZZLE_PDB_H
+#define NPUZZLE_PDB_H
+#include "npuzzle_logic.h"
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#define NPUZZLE_PDB_MAX_PATTERNS 8
+
+// Divisão das peças em padrões disjuntos
+typedef struct
+{
+  int num_patterns;
+  int num_tiles[NPUZZLE_PDB_MAX_PATTERNS];
+  int tiles[NPUZZLE_PDB_MAX_PATTERNS][NPUZZLE_MAX_CELLS];
+} npuzzle_partition_t;
+
+// Estrutura com as tabelas de todos os padrões de uma largura
+struct npuzzle_pdb_t
+{
+  int width;
+  npuzzle_partition_t partition;
+  size_t sizes[NPUZZLE_PDB_MAX_PATTERNS]; // Entradas de cada tabela
+  int bits[NPUZZLE_PDB_MAX_PATTERNS]; // Bits por entrada, 4 ou 8
+  const uint8_t* tables[NPUZZLE_PDB_MAX_PATTERNS];
+
+  // Ficheiro mapeado em memória, NULL quando as tabelas foram calculadas
+  void* mapping;
+  size_t mapping_size;
+};
+
+// Divisão por defeito de cada largura: 4-4 no puzzle 8, 6-6-3 no puzzle 15 e 6 padrões de 4 peças
+// no puzzle 24
+void npuzzle_pdb_default_partition(int width, npuzzle_partition_t* partition);
+
+// Lê uma divisão no formato "1,2,3,4/5,6,7,8", retorna falso se as peças não forem válidas para a
+// largura ou se repetirem
+bool npuzzle_pdb_parse_partition(const char* text, int width, npuzzle_partition_t* partition);
+
+// Calcula as tabelas de todos os padrões com o número de trabalhadores indicado, retorna NULL se não
+// existir memória suficiente
+npuzzle_pdb_t* npuzzle_pdb_create(int width, const npuzzle_partition_t* partition, int num_threads);
+
+// Lê as tabelas de um ficheiro guardado por npuzzle_pdb_save, retorna NULL se o ficheiro não existir
+// ou não for da largura indicada
+npuzzle_pdb_t* npuzzle_pdb_load(const char* filename, int width);
+
+// Guarda as tabelas num ficheiro que pode ser mapeado em memória
+bool npuzzle_pdb_save(const npuzzle_pdb_t* pdb, const char* filename);
+
+// Liberta a memória ou o mapeamento das tabelas
+void npuzzle_pdb_destroy(npuzzle_pdb_t* pdb);
+
+// Verifica se as tabelas são da divisão indicada
+bool npuzzle_pdb_same_partition(const npuzzle_pdb_t* pdb, const npuzzle_partition_t* partition);
+
+// Valor que os padrões somam à distância de Manhattan, a partir da posição de cada peça
+int npuzzle_pdb_extra(const npuzzle_pdb_t* pdb, const int* positions);
+
+#endif // NPUZZLE_PDB_H
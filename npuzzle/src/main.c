@@ -0,0 +1,740 @@
+#ifdef STATS_GEN
+#include <stdio.h>
+
+int main(int argc, char* argv[])
+{
+  printf("Funcionalidade não implementada para o problema N-puzzle.\n");
+  return 0;
+}
+#else
+#include "npuzzle_logic.h"
+#include "npuzzle_pdb.h"
+#include "astar_distributed.h"
+#include "astar_ida.h"
+#include "astar_ara.h"
+#include "astar_beam.h"
+#include "astar_bidirectional.h"
+#include "astar_fringe.h"
+#include "astar_frontier.h"
+#include "astar_parallel.h"
+#include "astar_portfolio.h"
+#include "astar_sequential.h"
+#include "astar_sma.h"
+#include <ctype.h>
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+// Lê uma instância com as peças de cada posição separadas por espaços, o espaço vazio é '-' ou 0. A
+// largura do tabuleiro é a raiz do número de peças
+bool load_npuzzle(const char* filename, npuzzle_state_t* puzzle, int* width)
+{
+  FILE* file = fopen(filename, "r");
+  if(file == NULL)
+  {
+    printf("Erro ao abrir o arquivo.\n");
+    return false;
+  }
+
+  int tiles[NPUZZLE_MAX_CELLS];
+  int num_tiles = 0;
+  char token[16];
+  while(fscanf(file, "%15s", token) == 1)
+  {
+    if(num_tiles == NPUZZLE_MAX_CELLS || (strcmp(token, "-") != 0 && !isdigit((unsigned char)token[0])))
+    {
+      printf("Erro ao ler o tabuleiro do arquivo.\n");
+      fclose(file);
+      return false;
+    }
+    tiles[num_tiles++] = strcmp(token, "-") == 0 ? 0 : atoi(token);
+  }
+  fclose(file);
+
+  *width = (int)lround(sqrt(num_tiles));
+  if(*width * *width != num_tiles || !npuzzle_init(*width) || !npuzzle_from_tiles(puzzle, tiles, num_tiles))
+  {
+    printf("Erro: o tabuleiro tem de ser uma permutação de 0 a N-1 com N = 9, 16 ou 25.\n");
+    return false;
+  }
+
+  return true;
+}
+
+void print_solution(a_star_node_t* solution)
+{
+  npuzzle_state_t* puzzle = (npuzzle_state_t*)(solution->state->data);
+  for(int cell = 0; cell < npuzzle_cells(); cell++)
+  {
+    int tile = npuzzle_get(puzzle, cell);
+    if(tile == 0)
+      printf(" -");
+    else
+      printf("%2d", tile);
+    printf(cell % npuzzle_width() == npuzzle_width() - 1 ? "\n" : " ");
+  }
+}
+
+// Resolve a instância utilizando a versão paralela do algoritmo A*, a instância do algoritmo
+// é partilhada por todos os ficheiros para que os trabalhadores sejam reutilizados
+void solve_parallel(a_star_parallel_t* a_star, npuzzle_state_t instance, bool csv, bool show_solution)
+{
+  // Tentamos resolver o problema
+  a_star_parallel_solve(a_star, &instance, NULL);
+
+  // Imprime as estatísticas da execução
+  a_star_parallel_print_statistics(a_star, csv, show_solution);
+}
+
+// Resolve a instância utilizando a versão distribuída do algoritmo A*, com um processo por trabalhador
+void solve_distributed(npuzzle_state_t instance, int num_workers, bool first, transport_kind_e transport, bool csv, bool show_solution)
+{
+  // Criamos a instância do algoritmo A*, os estados não têm ponteiros e são enviados tal como estão
+  a_star_distributed_t* a_star = a_star_distributed_create(
+      npuzzle_state_size(), goal, visit, heuristic, distance, print_solution, num_workers, first, transport);
+
+  // Tentamos resolver o problema
+  a_star_distributed_solve(a_star, &instance, NULL);
+
+  // Imprime as estatísticas da execução
+  a_star_distributed_print_statistics(a_star, csv, show_solution);
+
+  // Limpamos a memória
+  a_star_distributed_destroy(a_star);
+}
+
+// Resolve a instância com um portfólio de configurações do algoritmo A* em simultâneo
+void solve_portfolio(
+    npuzzle_state_t instance, a_star_portfolio_config_t* configs, size_t num_configs, int core_budget, bool csv, bool show_solution)
+{
+  // Sem orçamento indicado utilizamos todos os núcleos físicos
+  if(core_budget <= 0)
+  {
+    cpu_topology_t* topology = cpu_topology_create();
+    core_budget = (int)cpu_topology_physical_cores(topology);
+    cpu_topology_destroy(topology);
+  }
+
+  a_star_portfolio_t* a_star = a_star_portfolio_create(
+      npuzzle_state_size(), goal, visit, heuristic, distance, print_solution, configs, num_configs, (size_t)core_budget);
+
+  // Tentamos resolver o problema
+  a_star_portfolio_solve(a_star, &instance, NULL);
+
+  // Imprime as estatísticas da execução
+  a_star_portfolio_print_statistics(a_star, csv, show_solution);
+
+  // Limpamos a memória
+  a_star_portfolio_destroy(a_star);
+}
+
+// Resolve a instância utilizando o algoritmo SMA*, com no máximo max_nodes nós em memória
+void solve_sma(npuzzle_state_t instance, size_t max_nodes, bool csv, bool show_solution)
+{
+  // Criamos a instância do algoritmo SMA*
+  a_star_sma_t* a_star = a_star_sma_create(npuzzle_state_size(), goal, visit, heuristic, distance, print_solution, max_nodes);
+
+  // Tentamos resolver o problema
+  a_star_sma_solve(a_star, &instance, NULL);
+
+  // Imprime as estatísticas da execução
+  a_star_sma_print_statistics(a_star, csv, show_solution);
+
+  // Limpamos a memória
+  a_star_sma_destroy(a_star);
+}
+
+// Resolve a instância com a procura em feixe, que guarda apenas os width melhores nós de cada camada
+void solve_beam(npuzzle_state_t instance, size_t width, bool csv, bool show_solution)
+{
+  // Criamos a instância da procura em feixe
+  a_star_beam_t* a_star = a_star_beam_create(npuzzle_state_size(), goal, visit, heuristic, distance, print_solution, width);
+
+  // Tentamos resolver o problema
+  a_star_beam_solve(a_star, &instance, NULL);
+
+  // Imprime as estatísticas da execução
+  a_star_beam_print_statistics(a_star, csv, show_solution);
+
+  // Limpamos a memória
+  a_star_beam_destroy(a_star);
+}
+
+// Resolve a instância utilizando o algoritmo IDA*, com uma tabela de transposições de table_size entradas
+void solve_ida(npuzzle_state_t instance, size_t table_size, bool csv, bool show_solution)
+{
+  // Criamos a instância do algoritmo IDA*
+  a_star_ida_t* a_star = a_star_ida_create(npuzzle_state_size(), goal, visit, heuristic, distance, print_solution);
+  a_star_ida_set_transposition(a_star, table_size);
+
+  // Tentamos resolver o problema
+  a_star_ida_solve(a_star, &instance, NULL);
+
+  // Imprime as estatísticas da execução
+  a_star_ida_print_statistics(a_star, csv, show_solution);
+
+  // Limpamos a memória
+  a_star_ida_destroy(a_star);
+}
+
+// Resolve a instância com o algoritmo A* bidirecional, a partir do início e do objetivo em simultâneo
+void solve_bidirectional(npuzzle_state_t instance, bool csv, bool show_solution)
+{
+  // Criamos a instância do algoritmo, o problema não é dirigido e a procura para trás utiliza os mesmos vizinhos
+  a_star_bidirectional_t* a_star =
+      a_star_bidirectional_create(npuzzle_state_size(), goal, visit, heuristic, distance, print_solution);
+  a_star_bidirectional_set_reverse(a_star, NULL, heuristic_reverse);
+
+  // O objetivo do puzzle é um tabuleiro fixo
+  npuzzle_state_t target;
+  goal_board(&target);
+
+  // Tentamos resolver o problema
+  a_star_bidirectional_solve(a_star, &instance, &target);
+
+  // Imprime as estatísticas da execução
+  a_star_bidirectional_print_statistics(a_star, csv, show_solution);
+
+  // Limpamos a memória
+  a_star_bidirectional_destroy(a_star);
+}
+
+// Resolve a instância com o algoritmo A* de fronteira, que liberta os nós expandidos
+void solve_frontier(npuzzle_state_t instance, bool csv, bool show_solution)
+{
+  // Criamos a instância do algoritmo A* de fronteira
+  a_star_frontier_t* a_star = a_star_frontier_create(npuzzle_state_size(), goal, visit, heuristic, distance, print_solution);
+
+  // Tentamos resolver o problema
+  a_star_frontier_solve(a_star, &instance, NULL);
+
+  // Imprime as estatísticas da execução
+  a_star_frontier_print_statistics(a_star, csv, show_solution);
+
+  // Limpamos a memória
+  a_star_frontier_destroy(a_star);
+}
+
+// Resolve a instância utilizando o algoritmo ARA*, a partir do peso indicado até à solução ótima
+// ou até se esgotar o tempo limite
+void solve_ara(npuzzle_state_t instance, double weight, double time_limit, bool csv, bool show_solution)
+{
+  // Criamos a instância do algoritmo ARA*
+  a_star_ara_t* a_star = a_star_ara_create(npuzzle_state_size(), goal, visit, heuristic, distance, print_solution, weight);
+  a_star_ara_set_time_limit(a_star, time_limit);
+
+  // Tentamos resolver o problema
+  a_star_ara_solve(a_star, &instance, NULL);
+
+  // Imprime as estatísticas da execução
+  a_star_ara_print_statistics(a_star, csv, show_solution);
+
+  // Limpamos a memória
+  a_star_ara_destroy(a_star);
+}
+
+// Resolve a instância utilizando o algoritmo Fringe Search, sem fila prioritária
+void solve_fringe(npuzzle_state_t instance, bool csv, bool show_solution)
+{
+  // Criamos a instância do algoritmo Fringe Search
+  a_star_fringe_t* a_star = a_star_fringe_create(npuzzle_state_size(), goal, visit, heuristic, distance, print_solution);
+
+  // Tentamos resolver o problema
+  a_star_fringe_solve(a_star, &instance, NULL);
+
+  // Imprime as estatísticas da execução
+  a_star_fringe_print_statistics(a_star, csv, show_solution);
+
+  // Limpamos a memória
+  a_star_fringe_destroy(a_star);
+}
+
+// Verifica se a instância tem solução antes da procura. Sem solução apresenta as estatísticas de uma
+// procura vazia, com o motivo, e retorna falso
+bool check_solvable(npuzzle_state_t instance, bool csv, bool show_solution)
+{
+  struct timespec start, end;
+  clock_gettime(CLOCK_MONOTONIC, &start);
+  bool solvable = npuzzle_solvable(&instance);
+  clock_gettime(CLOCK_MONOTONIC, &end);
+  if(solvable)
+  {
+    return true;
+  }
+
+  a_star_t* a_star = a_star_create(npuzzle_state_size(), goal, visit, heuristic, distance, print_solution);
+  a_star->execution_time = (end.tv_sec - start.tv_sec) + (end.tv_nsec - start.tv_nsec) / 1000000000.0;
+  a_star_set_skipped(a_star,
+                    npuzzle_width() % 2 == 1 ? "a paridade das inversões do tabuleiro é diferente da do objetivo"
+                                                     : "a paridade das inversões e da linha do espaço vazio é diferente da do objetivo");
+  a_star_print_statistics(a_star, csv, show_solution);
+  a_star_destroy(a_star);
+  return false;
+}
+
+// Resolve a instância utilizando a versão sequencial do algoritmo A*
+void solve_sequential(npuzzle_state_t instance, bool csv, bool show_solution)
+{
+  // Criamos a instância do algoritmo A*
+  a_star_sequential_t* a_star = a_star_sequential_create(npuzzle_state_size(), goal, visit, heuristic, distance, print_solution);
+
+  // A distância de Manhattan e as bases de dados de padrões são consistentes
+  a_star_set_consistent(a_star->common, true);
+
+  // O objetivo é um único tabuleiro, os restantes são excluídos pelo resumo
+  npuzzle_state_t goal_puzzle;
+  goal_board(&goal_puzzle);
+  a_star_set_goal_hash(a_star->common, &goal_puzzle);
+
+  // Tentamos resolver o problema
+  a_star_sequential_solve(a_star, &instance, NULL);
+
+  // Imprime as estatísticas da execução
+  a_star_sequential_print_statistics(a_star, csv, show_solution);
+
+  // Limpamos a memória
+  a_star_sequential_destroy(a_star);
+}
+
+// Lê as bases de dados de padrões do ficheiro indicado ou calcula-as e guarda-as no ficheiro, caso não
+// exista ou seja de outra divisão das peças
+npuzzle_pdb_t* prepare_pdb(const char* filename, const char* partition_text, int width, int num_threads, bool csv, bool show_solution)
+{
+  npuzzle_partition_t partition;
+  if(partition_text == NULL)
+  {
+    npuzzle_pdb_default_partition(width, &partition);
+  }
+  else if(!npuzzle_pdb_parse_partition(partition_text, width, &partition))
+  {
+    printf("Erro: os padrões têm de ser peças distintas de 1 a %d, por exemplo 1,2,3,4/5,6,7,8.\n", width * width - 1);
+    return NULL;
+  }
+
+  struct timespec start, end;
+  clock_gettime(CLOCK_MONOTONIC, &start);
+  npuzzle_pdb_t* pdb = npuzzle_pdb_load(filename, width);
+  bool loaded = pdb != NULL && npuzzle_pdb_same_partition(pdb, &partition);
+  bool saved = false;
+  if(!loaded)
+  {
+    // Sem trabalhadores indicados as tabelas são calculadas com um trabalhador por núcleo físico
+    if(num_threads < 1)
+    {
+      cpu_topology_t* topology = cpu_topology_create();
+      num_threads = (int)cpu_topology_physical_cores(topology);
+      cpu_topology_destroy(topology);
+    }
+
+    npuzzle_pdb_destroy(pdb);
+    pdb = npuzzle_pdb_create(width, &partition, num_threads);
+    if(pdb == NULL)
+    {
+      printf("Erro a calcular as bases de dados de padrões\n");
+      return NULL;
+    }
+    saved = npuzzle_pdb_save(pdb, filename);
+  }
+  clock_gettime(CLOCK_MONOTONIC, &end);
+
+  if(!csv && !show_solution)
+  {
+    double elapsed = (end.tv_sec - start.tv_sec) + (end.tv_nsec - start.tv_nsec) / 1000000000.0;
+    printf("Heurística de padrões: %d padrões %s em %.6f segundos%s\n",
+           pdb->partition.num_patterns,
+           loaded ? "lidos do ficheiro" : "calculados",
+           elapsed,
+           loaded || saved ? "" : " (não foi possível guardar o ficheiro)");
+  }
+  return pdb;
+}
+
+int main(int argc, char* argv[])
+{
+  // Verificar se o nome do arquivo foi fornecido como argumento
+  if(argc < 2)
+  {
+    printf("Uso: %s [-n <num. trabalhadores|auto>] [-a <none|compact|scatter>] [-w <k>] [-k <k|auto>] [-D <shm|unix|tcp>] [-P <configurações|auto>] [-I <entradas>] [-W <peso>] [-T <segundos>] [-M <nós>] [-b <largura>] [-B] [-F] [-f] [-H <ficheiro>] [-G <padrões>] [-p] [-r] <ficheiro_instâncias> [...]\n", argv[0]);
+    printf("Opções:\n");
+    printf("-n : Número de trabalhadores (threads), defeito: 0 (algoritmo sequencial), auto: número de núcleos físicos\n");
+    printf("-a : Afinidade dos trabalhadores aos CPUs (none, compact ou scatter), defeito: none (sem afinidade)\n");
+    printf("-w : Aquecimento sequencial até existirem k nós por trabalhador, defeito: 0 (sem aquecimento)\n");
+    printf("-k : Nós expandidos por iteração de cada trabalhador, auto: adaptativo até %d, defeito: 1\n", BATCH_AUTO_MAX);
+    printf("-D : Algoritmo distribuído com -n processos, comunicação por memória partilhada, sockets unix ou tcp\n");
+    printf("-P : Portfólio de configurações em simultâneo (seq, seq-deep, par, par-first, par-deep), separadas por vírgulas,\n");
+    printf("     a primeira a provar o resultado cancela as restantes, -n é o orçamento de núcleos, auto: %s\n", "seq,par-first,par-deep");
+    printf("-I : Algoritmo IDA* com uma tabela de transposições com o número de entradas indicado (0: sem tabela)\n");
+    printf("-W : Algoritmo ARA* com o peso inicial da heurística indicado, reduzido até 1 (solução ótima)\n");
+    printf("-T : Tempo limite em segundos do algoritmo ARA*, termina com a melhor solução encontrada\n");
+    printf("-M : Algoritmo SMA* com o número máximo de nós em memória indicado, esquece os piores nós quando o atinge\n");
+    printf("-B : Algoritmo A* bidirecional (MM), procura a partir do início e do objetivo em simultâneo\n");
+    printf("-F : Algoritmo A* de fronteira, liberta os nós expandidos e guarda apenas a lista aberta\n");
+    printf("-b : Procura em feixe com a largura indicada, rápida mas sem garantia de solução ótima\n");
+    printf("-f : Algoritmo Fringe Search, lista da fronteira percorrida com um limite de f crescente, sem fila prioritária\n");
+    printf("-H : Heurística de bases de dados de padrões aditivas, lidas do ficheiro indicado ou calculadas e guardadas nele\n");
+    printf("-G : Padrões da heurística -H, peças separadas por vírgulas e padrões por /, defeito: 4-4, 6-6-3 ou 6 padrões de 4\n");
+    printf("-p : Termina à primeira solução encontrada, defeito: falso (utilizado no algoritmo paralelo apenas)\n");
+    printf("-r : Relatório em formato compatível com CSV \n");
+    printf("Podem ser indicados vários ficheiros, as instâncias são resolvidas pela ordem indicada\n");
+    return 0;
+  }
+
+  // Valores por defeito
+  int num_threads = 0;
+  bool first = false;
+  bool csv = false;
+  bool show_solution = false;
+  affinity_policy_e affinity = AFFINITY_NONE;
+  int warmup = 0;
+  int batch_size = 1;
+  bool batch_adaptive = false;
+  bool distributed = false;
+  transport_kind_e transport = TRANSPORT_SHM;
+  a_star_portfolio_config_t portfolio[PORTFOLIO_MAX_CONFIGS];
+  size_t num_configs = 0;
+  double weight = 0;
+  double time_limit = 0;
+  int max_nodes = 0;
+  int beam_width = 0;
+  bool fringe = false;
+  bool bidirectional = false;
+  bool frontier = false;
+  bool ida = false;
+  int table_size = 0;
+  const char* pdb_file = NULL;
+  const char* partition_text = NULL;
+
+  // Verificamos se mais opções foram passadas
+  int filename_arg = 1;
+  for(int i = 1; i < argc; i++)
+  {
+    char* opt = argv[i];
+
+    if(strcmp(opt, "-n") == 0)
+    {
+      if(++i < argc && strcmp(argv[i], "auto") == 0)
+      {
+        // Utilizamos um trabalhador por núcleo físico
+        cpu_topology_t* topology = cpu_topology_create();
+        num_threads = (int)cpu_topology_physical_cores(topology);
+        cpu_topology_destroy(topology);
+      }
+      else if(i < argc)
+      {
+        num_threads = atoi(argv[i]);
+      }
+      else
+      {
+        printf("Erro: o número de trabalhadores não é um valor válido.\n");
+        return 1;
+      }
+      filename_arg += 2;
+      continue;
+    }
+
+    if(strcmp(opt, "-a") == 0)
+    {
+      if(++i >= argc || !affinity_from_str(argv[i], &affinity))
+      {
+        printf("Erro: a afinidade tem de ser none, compact ou scatter.\n");
+        return 1;
+      }
+      filename_arg += 2;
+      continue;
+    }
+
+    if(strcmp(opt, "-w") == 0)
+    {
+      if(++i >= argc || (warmup = atoi(argv[i])) < 0)
+      {
+        printf("Erro: o aquecimento tem de ser um número de nós por trabalhador.\n");
+        return 1;
+      }
+      filename_arg += 2;
+      continue;
+    }
+
+    if(strcmp(opt, "-k") == 0)
+    {
+      if(++i < argc && strcmp(argv[i], "auto") == 0)
+      {
+        // O lote adapta-se ao tamanho da lista aberta de cada trabalhador
+        batch_size = BATCH_AUTO_MAX;
+        batch_adaptive = true;
+      }
+      else if(i >= argc || (batch_size = atoi(argv[i])) < 1)
+      {
+        printf("Erro: o tamanho do lote tem de ser um número positivo ou auto.\n");
+        return 1;
+      }
+      filename_arg += 2;
+      continue;
+    }
+
+    if(strcmp(opt, "-D") == 0)
+    {
+      if(++i >= argc || !transport_from_str(argv[i], &transport))
+      {
+        printf("Erro: o transporte tem de ser shm, unix ou tcp.\n");
+        return 1;
+      }
+      distributed = true;
+      filename_arg += 2;
+      continue;
+    }
+
+    if(strcmp(opt, "-P") == 0)
+    {
+      if(++i >= argc || !a_star_portfolio_parse(argv[i], portfolio, &num_configs))
+      {
+        printf("Erro: configuração do portfólio desconhecida.\n");
+        return 1;
+      }
+      filename_arg += 2;
+      continue;
+    }
+
+    if(strcmp(opt, "-I") == 0)
+    {
+      if(++i >= argc || (table_size = atoi(argv[i])) < 0)
+      {
+        printf("Erro: o tamanho da tabela de transposições tem de ser um número positivo ou 0.\n");
+        return 1;
+      }
+      ida = true;
+      filename_arg += 2;
+      continue;
+    }
+
+    if(strcmp(opt, "-W") == 0)
+    {
+      if(++i >= argc || (weight = atof(argv[i])) < 1.0)
+      {
+        printf("Erro: o peso da heurística tem de ser um número maior ou igual a 1.\n");
+        return 1;
+      }
+      filename_arg += 2;
+      continue;
+    }
+
+    if(strcmp(opt, "-M") == 0)
+    {
+      if(++i >= argc || (max_nodes = atoi(argv[i])) < 2)
+      {
+        printf("Erro: o número máximo de nós tem de ser pelo menos 2.\n");
+        return 1;
+      }
+      filename_arg += 2;
+      continue;
+    }
+
+    if(strcmp(opt, "-b") == 0)
+    {
+      if(++i >= argc || (beam_width = atoi(argv[i])) < 1)
+      {
+        printf("Erro: a largura do feixe tem de ser um número positivo.\n");
+        return 1;
+      }
+      filename_arg += 2;
+      continue;
+    }
+
+    if(strcmp(opt, "-T") == 0)
+    {
+      if(++i >= argc || (time_limit = atof(argv[i])) <= 0)
+      {
+        printf("Erro: o tempo limite tem de ser um número positivo de segundos.\n");
+        return 1;
+      }
+      filename_arg += 2;
+      continue;
+    }
+
+    if(strcmp(opt, "-H") == 0)
+    {
+      if(++i >= argc)
+      {
+        printf("Erro: falta o ficheiro das bases de dados de padrões.\n");
+        return 1;
+      }
+      pdb_file = argv[i];
+      filename_arg += 2;
+      continue;
+    }
+
+    if(strcmp(opt, "-G") == 0)
+    {
+      if(++i >= argc)
+      {
+        printf("Erro: faltam os padrões da heurística.\n");
+        return 1;
+      }
+      partition_text = argv[i];
+      filename_arg += 2;
+      continue;
+    }
+
+    if(strcmp(opt, "-B") == 0)
+    {
+      bidirectional = true;
+      filename_arg++;
+      continue;
+    }
+
+    if(strcmp(opt, "-F") == 0)
+    {
+      frontier = true;
+      filename_arg++;
+      continue;
+    }
+
+    if(strcmp(opt, "-f") == 0)
+    {
+      fringe = true;
+      filename_arg++;
+      continue;
+    }
+
+    if(strcmp(opt, "-p") == 0)
+    {
+      first = true;
+      filename_arg++;
+      continue;
+    }
+
+    if(strcmp(opt, "-r") == 0)
+    {
+      csv = true;
+      filename_arg++;
+      continue;
+    }
+
+    if(strcmp(opt, "-s") == 0) {
+      show_solution = true;
+      filename_arg++;
+      continue;
+    }
+  }
+
+  if(filename_arg >= argc)
+  {
+    printf("Erro: o falta nome do ficheiro com dados .\n");
+    return 1;
+  }
+
+  // O algoritmo paralelo é criado uma única vez, os trabalhadores são reutilizados por todas as instâncias.
+  // O tamanho dos estados depende da largura, pelo que é criado com a primeira instância e todas as
+  // instâncias têm de ter a mesma largura
+  a_star_parallel_t* a_star = NULL;
+  bool parallel = num_threads > 0 && !distributed && weight == 0 && !bidirectional && !frontier && !ida && max_nodes == 0 &&
+                  beam_width == 0 && !fringe && num_configs == 0;
+  int width = 0;
+  npuzzle_pdb_t* pdb = NULL;
+
+  // Cada ficheiro indicado é uma instância a resolver
+  for(int f = filename_arg; f < argc; f++)
+  {
+    // Ler as instâncias do arquivo
+    npuzzle_state_t puzzle;
+    int puzzle_width = 0;
+
+    // Verificar se o puzzle foi lido corretamente
+    if(!load_npuzzle(argv[f], &puzzle, &puzzle_width))
+    {
+      printf("Erro ao ler o puzzle do arquivo.\n");
+      continue;
+    }
+
+    if(width != 0 && puzzle_width != width)
+    {
+      printf("Erro: todas as instâncias têm de ter a mesma largura (%d).\n", width);
+      npuzzle_init(width);
+      continue;
+    }
+    width = puzzle_width;
+
+    // Metade dos tabuleiros não tem solução, o que a paridade das inversões indica sem procurar
+    if(!check_solvable(puzzle, csv, show_solution))
+    {
+      continue;
+    }
+
+    // As bases de dados de padrões dependem apenas da largura, são preparadas com a primeira instância
+    if(pdb_file != NULL && pdb == NULL)
+    {
+      pdb = prepare_pdb(pdb_file, partition_text, width, num_threads, csv, show_solution);
+      if(pdb == NULL)
+      {
+        break;
+      }
+      npuzzle_set_pdb(pdb);
+    }
+
+    if(parallel && a_star == NULL)
+    {
+      a_star = a_star_parallel_create(npuzzle_state_size(), goal, visit, heuristic, distance, print_solution, num_threads, first);
+
+      // Fixamos os trabalhadores aos CPUs caso tenha sido pedido
+      a_star_parallel_set_affinity(a_star, affinity);
+
+      // Fase de aquecimento para que todos os trabalhadores comecem com nós
+      a_star_parallel_set_warmup(a_star, (size_t)warmup);
+
+      // Expansão de lotes de nós por iteração
+      a_star_parallel_set_batch(a_star, (size_t)batch_size, batch_adaptive);
+    }
+
+    if(fringe)
+    {
+      solve_fringe(puzzle, csv, show_solution);
+    }
+    else if(beam_width > 0)
+    {
+      solve_beam(puzzle, (size_t)beam_width, csv, show_solution);
+    }
+    else if(max_nodes > 0)
+    {
+      solve_sma(puzzle, (size_t)max_nodes, csv, show_solution);
+    }
+    else if(frontier)
+    {
+      solve_frontier(puzzle, csv, show_solution);
+    }
+    else if(bidirectional)
+    {
+      solve_bidirectional(puzzle, csv, show_solution);
+    }
+    else if(weight > 0)
+    {
+      solve_ara(puzzle, weight, time_limit, csv, show_solution);
+    }
+    else if(ida)
+    {
+      solve_ida(puzzle, (size_t)table_size, csv, show_solution);
+    }
+    else if(num_configs > 0)
+    {
+      solve_portfolio(puzzle, portfolio, num_configs, num_threads, csv, show_solution);
+    }
+    else if(distributed)
+    {
+      solve_distributed(puzzle, num_threads > 0 ? num_threads : 1, first, transport, csv, show_solution);
+    }
+    else if(a_star != NULL)
+    {
+      solve_parallel(a_star, puzzle, csv, show_solution);
+    }
+    else
+    {
+      solve_sequential(puzzle, csv, show_solution);
+    }
+  }
+
+  // Limpamos a memória
+  a_star_parallel_destroy(a_star);
+  npuzzle_pdb_destroy(pdb);
+  return 0;
+}
+#endif
\ No newline at end of file
@@ -0,0 +1,280 @@
+#include "npuzzle_logic.h"
+#include "npuzzle_pdb.h"
+#include <stdlib.h>
+#include <string.h>
+
+// Configuração do tabuleiro atual, definida por npuzzle_init
+static int width = 0;
+static int cells = 0;
+static int bits = 0;
+static size_t num_words = 0;
+static uint64_t cell_mask = 0;
+
+// Distância de Manhattan de cada peça em cada posição
+static int manhattan_table[NPUZZLE_MAX_CELLS][NPUZZLE_MAX_CELLS];
+
+// Posições para onde o espaço vazio se pode mover a partir de cada posição, pela ordem do puzzle 8:
+// cima, baixo, esquerda e direita
+static int moves_table[NPUZZLE_MAX_CELLS][4];
+static int num_moves_table[NPUZZLE_MAX_CELLS];
+
+static npuzzle_state_t goal_puzzle;
+
+// Bases de dados de padrões utilizadas pela heurística
+static const npuzzle_pdb_t* pdb = NULL;
+
+// Define a largura do tabuleiro e prepara as tabelas
+bool npuzzle_init(int new_width)
+{
+  if(new_width < NPUZZLE_MIN_WIDTH || new_width > NPUZZLE_MAX_WIDTH)
+  {
+    return false;
+  }
+
+  width = new_width;
+  cells = width * width;
+  bits = cells <= 16 ? 4 : 5;
+  num_words = ((size_t)cells * bits + 63) / 64;
+  cell_mask = ((uint64_t)1 << bits) - 1;
+
+  for(int tile = 0; tile < cells; tile++)
+  {
+    // A peça t fica na posição t - 1, o espaço vazio não conta para a distância
+    int goal_row = (tile - 1) / width;
+    int goal_col = (tile - 1) % width;
+    for(int cell = 0; cell < cells; cell++)
+    {
+      manhattan_table[tile][cell] = tile == 0 ? 0 : abs(cell / width - goal_row) + abs(cell % width - goal_col);
+    }
+  }
+
+  for(int cell = 0; cell < cells; cell++)
+  {
+    int row = cell / width;
+    int col = cell % width;
+    int count = 0;
+    if(row > 0)
+      moves_table[cell][count++] = cell - width;
+    if(row < width - 1)
+      moves_table[cell][count++] = cell + width;
+    if(col > 0)
+      moves_table[cell][count++] = cell - 1;
+    if(col < width - 1)
+      moves_table[cell][count++] = cell + 1;
+    num_moves_table[cell] = count;
+  }
+
+  memset(&goal_puzzle, 0, sizeof(goal_puzzle));
+  for(int cell = 0; cell < cells - 1; cell++)
+  {
+    npuzzle_set(&goal_puzzle, cell, cell + 1);
+  }
+
+  return true;
+}
+
+int npuzzle_width(void)
+{
+  return width;
+}
+
+int npuzzle_cells(void)
+{
+  return cells;
+}
+
+size_t npuzzle_state_size(void)
+{
+  return num_words * sizeof(uint64_t);
+}
+
+// Peça numa posição, com 5 bits uma posição pode ocupar o fim de uma palavra e o início da seguinte
+int npuzzle_get(const npuzzle_state_t* puzzle, int cell)
+{
+  int position = cell * bits;
+  int word = position >> 6;
+  int offset = position & 63;
+  uint64_t value = puzzle->words[word] >> offset;
+  if(offset + bits > 64)
+    value |= puzzle->words[word + 1] << (64 - offset);
+  return (int)(value & cell_mask);
+}
+
+// Troca os bits de uma posição pelo ou exclusivo com o valor indicado
+static inline void npuzzle_xor(npuzzle_state_t* puzzle, int cell, uint64_t value)
+{
+  int position = cell * bits;
+  int word = position >> 6;
+  int offset = position & 63;
+  puzzle->words[word] ^= value << offset;
+  if(offset + bits > 64)
+    puzzle->words[word + 1] ^= value >> (64 - offset);
+}
+
+void npuzzle_set(npuzzle_state_t* puzzle, int cell, int tile)
+{
+  npuzzle_xor(puzzle, cell, (uint64_t)(npuzzle_get(puzzle, cell) ^ tile));
+}
+
+// Posição do espaço vazio. Com 4 bits a primeira posição a 0 é encontrada sem percorrer o tabuleiro:
+// a subtração deixa o bit mais alto ligado em cada posição a 0 e a primeira não tem falsos positivos
+int npuzzle_blank(const npuzzle_state_t* puzzle)
+{
+  if(bits == 4)
+  {
+    uint64_t x = puzzle->words[0];
+    uint64_t zero = (x - 0x1111111111111111ULL) & ~x & 0x8888888888888888ULL;
+    return __builtin_ctzll(zero) >> 2;
+  }
+
+  for(int cell = 0; cell < cells; cell++)
+  {
+    if(npuzzle_get(puzzle, cell) == 0)
+      return cell;
+  }
+  return -1;
+}
+
+// Constrói um estado a partir das peças de cada posição
+bool npuzzle_from_tiles(npuzzle_state_t* puzzle, const int* tiles, int num_tiles)
+{
+  if(num_tiles != cells)
+  {
+    return false;
+  }
+
+  bool seen[NPUZZLE_MAX_CELLS] = { false };
+  memset(puzzle, 0, sizeof(npuzzle_state_t));
+  for(int cell = 0; cell < cells; cell++)
+  {
+    if(tiles[cell] < 0 || tiles[cell] >= cells || seen[tiles[cell]])
+    {
+      return false;
+    }
+    seen[tiles[cell]] = true;
+    npuzzle_set(puzzle, cell, tiles[cell]);
+  }
+  return true;
+}
+
+// Compara com o objetivo, sem inversões e com o espaço vazio na última linha
+bool npuzzle_solvable(const npuzzle_state_t* puzzle)
+{
+  int tiles[NPUZZLE_MAX_CELLS];
+  int inversions = 0;
+  for(int cell = 0; cell < cells; cell++)
+  {
+    tiles[cell] = npuzzle_get(puzzle, cell);
+    for(int previous = 0; previous < cell; previous++)
+    {
+      if(tiles[cell] != 0 && tiles[previous] > tiles[cell])
+        inversions++;
+    }
+  }
+
+  if(width % 2 == 1)
+  {
+    return inversions % 2 == 0;
+  }
+  return (inversions + npuzzle_blank(puzzle) / width) % 2 == (width - 1) % 2;
+}
+
+// Distância de Manhattan, uma consulta da tabela por posição
+int npuzzle_manhattan(const npuzzle_state_t* puzzle)
+{
+  int h = 0;
+  for(int cell = 0; cell < cells; cell++)
+  {
+    h += manhattan_table[npuzzle_get(puzzle, cell)][cell];
+  }
+  return h;
+}
+
+void npuzzle_set_pdb(const npuzzle_pdb_t* new_pdb)
+{
+  pdb = new_pdb;
+}
+
+// Função de heurística para o N-puzzle, com as bases de dados de padrões a distância de Manhattan é
+// calculada na mesma passagem que encontra a posição de cada peça
+int heuristic(const state_t* current_state, const state_t*)
+{
+  const npuzzle_state_t* puzzle = (const npuzzle_state_t*)current_state->data;
+  if(pdb == NULL)
+  {
+    return npuzzle_manhattan(puzzle);
+  }
+
+  int positions[NPUZZLE_MAX_CELLS];
+  int h = 0;
+  for(int cell = 0; cell < cells; cell++)
+  {
+    int tile = npuzzle_get(puzzle, cell);
+    positions[tile] = cell;
+    h += manhattan_table[tile][cell];
+  }
+  return h + npuzzle_pdb_extra(pdb, positions);
+}
+
+// Distância de Manhattan até ao tabuleiro indicado, utilizada pela procura para trás
+int heuristic_reverse(const state_t* current_state, const state_t* target_state)
+{
+  const npuzzle_state_t* current = (const npuzzle_state_t*)current_state->data;
+  const npuzzle_state_t* target = (const npuzzle_state_t*)target_state->data;
+
+  // Posição de cada peça no tabuleiro indicado
+  int target_cell[NPUZZLE_MAX_CELLS];
+  for(int cell = 0; cell < cells; cell++)
+  {
+    target_cell[npuzzle_get(target, cell)] = cell;
+  }
+
+  int h = 0;
+  for(int cell = 0; cell < cells; cell++)
+  {
+    int tile = npuzzle_get(current, cell);
+    if(tile == 0)
+      continue;
+    h += abs(cell / width - target_cell[tile] / width) + abs(cell % width - target_cell[tile] % width);
+  }
+  return h;
+}
+
+// Copia o tabuleiro objetivo do N-puzzle
+void goal_board(npuzzle_state_t* puzzle)
+{
+  memcpy(puzzle, &goal_puzzle, sizeof(npuzzle_state_t));
+}
+
+// Função para visitar um estado do N-puzzle. Como o espaço vazio é o 0, mover a peça t da posição c
+// para o espaço vazio em b é apenas o ou exclusivo de t nas duas posições
+void visit(state_t* current_state, state_allocator_t* allocator, linked_list_t* neighbors)
+{
+  const npuzzle_state_t* puzzle = (const npuzzle_state_t*)(current_state->data);
+  int blank = npuzzle_blank(puzzle);
+
+  for(int i = 0; i < num_moves_table[blank]; i++)
+  {
+    int cell = moves_table[blank][i];
+    uint64_t tile = (uint64_t)npuzzle_get(puzzle, cell);
+
+    // Os dados do estado têm apenas npuzzle_state_size() bytes
+    npuzzle_state_t new_puzzle = { { 0 } };
+    memcpy(&new_puzzle, puzzle, npuzzle_state_size());
+    npuzzle_xor(&new_puzzle, cell, tile);
+    npuzzle_xor(&new_puzzle, blank, tile);
+    linked_list_append(neighbors, state_allocator_new(allocator, &new_puzzle));
+  }
+}
+
+// Verifica se o estado é o tabuleiro objetivo
+bool goal(const state_t* state_a, const state_t*)
+{
+  return memcmp(state_a->data, &goal_puzzle, npuzzle_state_size()) == 0;
+}
+
+// Retorna a distância de um estado anterior para o proximo, apenas se move uma peça de cada vez
+int distance(const state_t*, const state_t*)
+{
+  return 1;
+}
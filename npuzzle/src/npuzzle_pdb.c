@@ -0,0 +1,645 @@
+#include "npuzzle_pdb.h"
+#include <fcntl.h>
+#include <pthread.h>
+#include <stdatomic.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+// Distância dos estados ainda não alcançados pela procura
+#define NPUZZLE_PDB_UNSEEN 0xFF
+
+// Cabeçalho do ficheiro das tabelas, seguido das tabelas de cada padrão
+typedef struct
+{
+  char magic[8];
+  uint64_t width;
+  uint64_t num_patterns;
+  uint8_t num_tiles[NPUZZLE_PDB_MAX_PATTERNS];
+  uint8_t bits[NPUZZLE_PDB_MAX_PATTERNS];
+  uint8_t tiles[32]; // Peças dos padrões seguidas
+} npuzzle_pdb_header_t;
+
+static const char NPUZZLE_PDB_MAGIC[8] = "NPZPDB1";
+
+// Estado da procura em largura de um padrão, partilhado pelos trabalhadores
+typedef struct
+{
+  _Atomic uint8_t* distances;
+  size_t size;
+  int width;
+  int cells;
+  int num_tiles; // O espaço vazio é o item seguinte às peças
+  int num_workers;
+  pthread_barrier_t barrier;
+  uint8_t depth;
+  _Atomic size_t claimed;
+  bool stop;
+} npuzzle_pdb_search_t;
+
+typedef struct
+{
+  npuzzle_pdb_search_t* search;
+  int id;
+} npuzzle_pdb_worker_args_t;
+
+// Pilha de índices de cada trabalhador para o fecho dos movimentos sem custo
+typedef struct
+{
+  size_t* data;
+  size_t count;
+  size_t capacity;
+} npuzzle_pdb_stack_t;
+
+// Número de permutações parciais de count itens em cells posições
+static size_t npuzzle_pdb_permutations(int cells, int count)
+{
+  size_t size = 1;
+  for(int i = 0; i < count; i++)
+    size *= (size_t)(cells - i);
+  return size;
+}
+
+// Índice das posições de count itens, cada posição é contada entre as posições ainda livres
+static size_t npuzzle_pdb_rank(const int* positions, int count, int cells)
+{
+  size_t rank = 0;
+  uint32_t used = 0;
+  for(int i = 0; i < count; i++)
+  {
+    int position = positions[i];
+    rank = rank * (size_t)(cells - i) + (size_t)(position - __builtin_popcount(used & ((1u << position) - 1)));
+    used |= 1u << position;
+  }
+  return rank;
+}
+
+// Posições de count itens a partir do índice
+static void npuzzle_pdb_unrank(size_t rank, int count, int cells, int* positions)
+{
+  int digits[NPUZZLE_MAX_CELLS];
+  for(int i = count - 1; i >= 0; i--)
+  {
+    size_t radix = (size_t)(cells - i);
+    digits[i] = (int)(rank % radix);
+    rank /= radix;
+  }
+
+  uint32_t used = 0;
+  for(int i = 0; i < count; i++)
+  {
+    // A posição livre de ordem digits[i]
+    uint32_t free_cells = ~used;
+    for(int j = 0; j < digits[i]; j++)
+      free_cells &= free_cells - 1;
+    positions[i] = __builtin_ctz(free_cells);
+    used |= 1u << positions[i];
+  }
+}
+
+// Posições para onde o espaço vazio se pode mover
+static int npuzzle_pdb_moves(int width, int cell, int* moves)
+{
+  int count = 0;
+  if(cell >= width)
+    moves[count++] = cell - width;
+  if(cell < width * (width - 1))
+    moves[count++] = cell + width;
+  if(cell % width > 0)
+    moves[count++] = cell - 1;
+  if(cell % width < width - 1)
+    moves[count++] = cell + 1;
+  return count;
+}
+
+// Reclama um estado ainda não alcançado, apenas um trabalhador o consegue
+static inline bool npuzzle_pdb_claim(_Atomic uint8_t* distances, size_t index, uint8_t depth)
+{
+  uint8_t expected = NPUZZLE_PDB_UNSEEN;
+  if(atomic_load_explicit(&distances[index], memory_order_relaxed) != NPUZZLE_PDB_UNSEEN)
+  {
+    return false;
+  }
+  return atomic_compare_exchange_strong_explicit(&distances[index], &expected, depth, memory_order_relaxed, memory_order_relaxed);
+}
+
+static void npuzzle_pdb_push(npuzzle_pdb_stack_t* stack, size_t index)
+{
+  if(stack->count == stack->capacity)
+  {
+    stack->capacity = stack->capacity == 0 ? 1024 : stack->capacity * 2;
+    stack->data = realloc(stack->data, stack->capacity * sizeof(size_t));
+  }
+  stack->data[stack->count++] = index;
+}
+
+// Fecha a camada atual dos índices [begin, end) pelos movimentos do espaço vazio para posições livres,
+// que não têm custo. Os estados reclamados por um trabalhador são fechados por esse trabalhador
+static void npuzzle_pdb_close(npuzzle_pdb_search_t* search, size_t begin, size_t end, npuzzle_pdb_stack_t* stack)
+{
+  int items = search->num_tiles + 1;
+  int positions[NPUZZLE_MAX_CELLS];
+  int moves[4];
+
+  for(size_t index = begin; index < end; index++)
+  {
+    if(atomic_load_explicit(&search->distances[index], memory_order_relaxed) != search->depth)
+      continue;
+
+    npuzzle_pdb_push(stack, index);
+    while(stack->count > 0)
+    {
+      npuzzle_pdb_unrank(stack->data[--stack->count], items, search->cells, positions);
+      uint32_t occupied = 0;
+      for(int i = 0; i < search->num_tiles; i++)
+        occupied |= 1u << positions[i];
+
+      int blank = positions[search->num_tiles];
+      int num_moves = npuzzle_pdb_moves(search->width, blank, moves);
+      for(int m = 0; m < num_moves; m++)
+      {
+        if(occupied & (1u << moves[m]))
+          continue;
+
+        positions[search->num_tiles] = moves[m];
+        size_t next = npuzzle_pdb_rank(positions, items, search->cells);
+        if(npuzzle_pdb_claim(search->distances, next, search->depth))
+          npuzzle_pdb_push(stack, next);
+      }
+    }
+  }
+}
+
+// Move as peças do padrão para o espaço vazio a partir dos estados da camada atual dos índices
+// [begin, end), retorna o número de estados reclamados para a camada seguinte
+static size_t npuzzle_pdb_expand(npuzzle_pdb_search_t* search, size_t begin, size_t end)
+{
+  int items = search->num_tiles + 1;
+  uint8_t next_depth = (uint8_t)(search->depth + 1);
+  int positions[NPUZZLE_MAX_CELLS];
+  int moves[4];
+  size_t claimed = 0;
+
+  for(size_t index = begin; index < end; index++)
+  {
+    if(atomic_load_explicit(&search->distances[index], memory_order_relaxed) != search->depth)
+      continue;
+
+    npuzzle_pdb_unrank(index, items, search->cells, positions);
+    int blank = positions[search->num_tiles];
+    int num_moves = npuzzle_pdb_moves(search->width, blank, moves);
+    for(int m = 0; m < num_moves; m++)
+    {
+      for(int i = 0; i < search->num_tiles; i++)
+      {
+        if(positions[i] != moves[m])
+          continue;
+
+        positions[i] = blank;
+        positions[search->num_tiles] = moves[m];
+        if(npuzzle_pdb_claim(search->distances, npuzzle_pdb_rank(positions, items, search->cells), next_depth))
+          claimed++;
+        positions[i] = moves[m];
+        positions[search->num_tiles] = blank;
+        break;
+      }
+    }
+  }
+
+  return claimed;
+}
+
+// Ciclo de cada trabalhador, o trabalhador 0 é o coordenador e corre na tarefa que chamou a procura
+static void* npuzzle_pdb_worker(void* arg)
+{
+  npuzzle_pdb_worker_args_t* args = (npuzzle_pdb_worker_args_t*)arg;
+  npuzzle_pdb_search_t* search = args->search;
+  size_t begin = search->size * (size_t)args->id / (size_t)search->num_workers;
+  size_t end = search->size * (size_t)(args->id + 1) / (size_t)search->num_workers;
+  npuzzle_pdb_stack_t stack = { NULL, 0, 0 };
+
+  while(true)
+  {
+    npuzzle_pdb_close(search, begin, end, &stack);
+    pthread_barrier_wait(&search->barrier);
+
+    atomic_fetch_add_explicit(&search->claimed, npuzzle_pdb_expand(search, begin, end), memory_order_relaxed);
+    pthread_barrier_wait(&search->barrier);
+
+    if(args->id == 0)
+    {
+      // A última distância representável fica reservada para os estados não alcançados
+      bool empty = atomic_exchange_explicit(&search->claimed, 0, memory_order_relaxed) == 0;
+      search->depth++;
+      search->stop = empty || search->depth == NPUZZLE_PDB_UNSEEN;
+    }
+    pthread_barrier_wait(&search->barrier);
+
+    if(search->stop)
+    {
+      break;
+    }
+  }
+
+  free(stack.data);
+  return NULL;
+}
+
+// Calcula a tabela de um padrão, com a metade do excesso sobre a distância de Manhattan de cada
+// posição das peças
+static uint8_t* npuzzle_pdb_build(int width, const int* tiles, int num_tiles, int num_threads, size_t* size, int* bits)
+{
+  int cells = width * width;
+  npuzzle_pdb_search_t search;
+  search.size = npuzzle_pdb_permutations(cells, num_tiles + 1);
+  search.distances = malloc(search.size);
+  if(search.distances == NULL)
+  {
+    return NULL; // Erro de alocação
+  }
+
+  search.width = width;
+  search.cells = cells;
+  search.num_tiles = num_tiles;
+  search.num_workers = num_threads;
+  search.depth = 0;
+  search.stop = false;
+  atomic_init(&search.claimed, 0);
+  memset((void*)search.distances, NPUZZLE_PDB_UNSEEN, search.size);
+
+  // A procura começa no objetivo, a peça t na posição t - 1 e o espaço vazio na última posição
+  int positions[NPUZZLE_MAX_CELLS];
+  for(int i = 0; i < num_tiles; i++)
+    positions[i] = tiles[i] - 1;
+  positions[num_tiles] = cells - 1;
+  search.distances[npuzzle_pdb_rank(positions, num_tiles + 1, cells)] = 0;
+
+  pthread_t* threads = malloc((size_t)num_threads * sizeof(pthread_t));
+  npuzzle_pdb_worker_args_t* args = malloc((size_t)num_threads * sizeof(npuzzle_pdb_worker_args_t));
+  pthread_barrier_init(&search.barrier, NULL, (unsigned)num_threads);
+  for(int i = 0; i < num_threads; i++)
+  {
+    args[i].search = &search;
+    args[i].id = i;
+    if(i > 0)
+      pthread_create(&threads[i], NULL, npuzzle_pdb_worker, &args[i]);
+  }
+
+  npuzzle_pdb_worker(&args[0]);
+
+  for(int i = 1; i < num_threads; i++)
+  {
+    pthread_join(threads[i], NULL);
+  }
+  pthread_barrier_destroy(&search.barrier);
+  free(threads);
+  free(args);
+
+  // O valor de cada posição das peças é o mínimo sobre as posições do espaço vazio, que são os
+  // últimos índices. A posição escrita nunca está à frente da posição lida
+  uint8_t* table = (uint8_t*)search.distances;
+  size_t blanks = (size_t)(cells - num_tiles);
+  *size = search.size / blanks;
+  int max_extra = 0;
+  for(size_t rank = 0; rank < *size; rank++)
+  {
+    uint8_t best = NPUZZLE_PDB_UNSEEN;
+    for(size_t j = 0; j < blanks; j++)
+    {
+      if(table[rank * blanks + j] < best)
+        best = table[rank * blanks + j];
+    }
+
+    int extra = 0;
+    if(best != NPUZZLE_PDB_UNSEEN)
+    {
+      npuzzle_pdb_unrank(rank, num_tiles, cells, positions);
+      int manhattan = 0;
+      for(int i = 0; i < num_tiles; i++)
+        manhattan += abs(positions[i] / width - (tiles[i] - 1) / width) + abs(positions[i] % width - (tiles[i] - 1) % width);
+      extra = (best - manhattan) / 2;
+    }
+    table[rank] = (uint8_t)extra;
+    if(extra > max_extra)
+      max_extra = extra;
+  }
+
+  // Duas entradas por byte quando todos os excessos cabem em 4 bits, a primeira nos bits baixos
+  *bits = max_extra < 16 ? 4 : 8;
+  size_t bytes = *size;
+  if(*bits == 4)
+  {
+    for(size_t rank = 0; rank < *size; rank++)
+    {
+      if(rank % 2 == 0)
+        table[rank / 2] = table[rank];
+      else
+        table[rank / 2] |= (uint8_t)(table[rank] << 4);
+    }
+    bytes = (*size + 1) / 2;
+  }
+
+  uint8_t* packed = realloc(table, bytes);
+  return packed != NULL ? packed : table;
+}
+
+// Bytes de uma tabela
+static size_t npuzzle_pdb_table_bytes(size_t size, int bits)
+{
+  return bits == 4 ? (size + 1) / 2 : size;
+}
+
+// Verifica que os padrões são disjuntos e têm apenas peças da largura indicada
+static bool npuzzle_pdb_valid_partition(const npuzzle_partition_t* partition, int width)
+{
+  int cells = width * width;
+  bool seen[NPUZZLE_MAX_CELLS] = { false };
+  if(width < NPUZZLE_MIN_WIDTH || width > NPUZZLE_MAX_WIDTH || partition->num_patterns < 1 ||
+     partition->num_patterns > NPUZZLE_PDB_MAX_PATTERNS)
+  {
+    return false;
+  }
+
+  for(int p = 0; p < partition->num_patterns; p++)
+  {
+    if(partition->num_tiles[p] < 1 || partition->num_tiles[p] >= cells)
+      return false;
+
+    for(int i = 0; i < partition->num_tiles[p]; i++)
+    {
+      int tile = partition->tiles[p][i];
+      if(tile < 1 || tile >= cells || seen[tile])
+        return false;
+      seen[tile] = true;
+    }
+  }
+  return true;
+}
+
+void npuzzle_pdb_default_partition(int width, npuzzle_partition_t* partition)
+{
+  static const int partition_8[2][4] = { { 1, 2, 3, 4 }, { 5, 6, 7, 8 } };
+  static const int partition_15[3][6] = { { 1, 5, 6, 9, 10, 13 }, { 7, 8, 11, 12, 14, 15 }, { 2, 3, 4 } };
+  static const int partition_24[6][4] = { { 1, 2, 6, 7 },     { 3, 4, 8, 9 },     { 5, 10, 15, 20 },
+                                          { 11, 12, 16, 17 }, { 13, 14, 18, 19 }, { 21, 22, 23, 24 } };
+
+  memset(partition, 0, sizeof(npuzzle_partition_t));
+  if(width == 3)
+  {
+    partition->num_patterns = 2;
+    for(int p = 0; p < 2; p++)
+    {
+      partition->num_tiles[p] = 4;
+      memcpy(partition->tiles[p], partition_8[p], sizeof(partition_8[p]));
+    }
+  }
+  else if(width == 4)
+  {
+    partition->num_patterns = 3;
+    for(int p = 0; p < 3; p++)
+    {
+      partition->num_tiles[p] = p < 2 ? 6 : 3;
+      memcpy(partition->tiles[p], partition_15[p], (size_t)partition->num_tiles[p] * sizeof(int));
+    }
+  }
+  else if(width == 5)
+  {
+    partition->num_patterns = 6;
+    for(int p = 0; p < 6; p++)
+    {
+      partition->num_tiles[p] = 4;
+      memcpy(partition->tiles[p], partition_24[p], sizeof(partition_24[p]));
+    }
+  }
+}
+
+bool npuzzle_pdb_parse_partition(const char* text, int width, npuzzle_partition_t* partition)
+{
+  memset(partition, 0, sizeof(npuzzle_partition_t));
+  partition->num_patterns = 1;
+  const char* cursor = text;
+  while(*cursor != '\0')
+  {
+    char* end;
+    long tile = strtol(cursor, &end, 10);
+    int p = partition->num_patterns - 1;
+    if(end == cursor || tile < 1 || tile >= NPUZZLE_MAX_CELLS || partition->num_tiles[p] == NPUZZLE_MAX_CELLS)
+    {
+      return false;
+    }
+    partition->tiles[p][partition->num_tiles[p]++] = (int)tile;
+
+    cursor = end;
+    if(*cursor == '/')
+    {
+      if(partition->num_patterns == NPUZZLE_PDB_MAX_PATTERNS)
+        return false;
+      partition->num_patterns++;
+    }
+    else if(*cursor != ',' && *cursor != '\0')
+    {
+      return false;
+    }
+    if(*cursor != '\0')
+      cursor++;
+  }
+
+  return npuzzle_pdb_valid_partition(partition, width);
+}
+
+// Calcula a tabela de cada padrão, um padrão de cada vez com todos os trabalhadores
+npuzzle_pdb_t* npuzzle_pdb_create(int width, const npuzzle_partition_t* partition, int num_threads)
+{
+  if(!npuzzle_pdb_valid_partition(partition, width))
+  {
+    return NULL;
+  }
+
+  npuzzle_pdb_t* pdb = (npuzzle_pdb_t*)calloc(1, sizeof(npuzzle_pdb_t));
+  if(pdb == NULL)
+  {
+    return NULL; // Erro de alocação
+  }
+
+  pdb->width = width;
+  pdb->partition = *partition;
+  for(int p = 0; p < partition->num_patterns; p++)
+  {
+    pdb->tables[p] = npuzzle_pdb_build(width,
+                                       partition->tiles[p],
+                                       partition->num_tiles[p],
+                                       num_threads > 0 ? num_threads : 1,
+                                       &pdb->sizes[p],
+                                       &pdb->bits[p]);
+    if(pdb->tables[p] == NULL)
+    {
+      npuzzle_pdb_destroy(pdb);
+      return NULL;
+    }
+  }
+  return pdb;
+}
+
+// Lê as tabelas mapeando o ficheiro em memória
+npuzzle_pdb_t* npuzzle_pdb_load(const char* filename, int width)
+{
+  int fd = open(filename, O_RDONLY);
+  if(fd < 0)
+  {
+    return NULL;
+  }
+
+  struct stat st;
+  if(fstat(fd, &st) != 0 || (size_t)st.st_size < sizeof(npuzzle_pdb_header_t))
+  {
+    close(fd);
+    return NULL;
+  }
+
+  size_t size = (size_t)st.st_size;
+  void* mapping = mmap(NULL, size, PROT_READ, MAP_SHARED, fd, 0);
+  close(fd);
+  if(mapping == MAP_FAILED)
+  {
+    return NULL;
+  }
+
+  // O cabeçalho tem de ser desta versão e desta largura, com padrões válidos
+  const npuzzle_pdb_header_t* header = (const npuzzle_pdb_header_t*)mapping;
+  npuzzle_pdb_t* pdb = NULL;
+  if(memcmp(header->magic, NPUZZLE_PDB_MAGIC, sizeof(header->magic)) == 0 && header->width == (uint64_t)width &&
+     header->num_patterns >= 1 && header->num_patterns <= NPUZZLE_PDB_MAX_PATTERNS)
+  {
+    pdb = (npuzzle_pdb_t*)calloc(1, sizeof(npuzzle_pdb_t));
+  }
+  if(pdb == NULL)
+  {
+    munmap(mapping, size);
+    return NULL;
+  }
+
+  pdb->width = width;
+  pdb->mapping = mapping;
+  pdb->mapping_size = size;
+  pdb->partition.num_patterns = (int)header->num_patterns;
+  size_t tile = 0;
+  size_t offset = sizeof(npuzzle_pdb_header_t);
+  bool valid = true;
+  for(int p = 0; valid && p < pdb->partition.num_patterns; p++)
+  {
+    pdb->partition.num_tiles[p] = header->num_tiles[p];
+    valid = tile + header->num_tiles[p] <= sizeof(header->tiles) && (header->bits[p] == 4 || header->bits[p] == 8);
+    for(int i = 0; valid && i < header->num_tiles[p]; i++)
+      pdb->partition.tiles[p][i] = header->tiles[tile++];
+
+    pdb->sizes[p] = npuzzle_pdb_permutations(width * width, header->num_tiles[p]);
+    pdb->bits[p] = header->bits[p];
+    pdb->tables[p] = (const uint8_t*)mapping + offset;
+    offset += npuzzle_pdb_table_bytes(pdb->sizes[p], pdb->bits[p]);
+  }
+
+  // O tamanho do ficheiro tem de ser o das tabelas indicadas
+  if(!valid || !npuzzle_pdb_valid_partition(&pdb->partition, width) || offset != size)
+  {
+    npuzzle_pdb_destroy(pdb);
+    return NULL;
+  }
+  return pdb;
+}
+
+// Guarda o cabeçalho e as tabelas tal como estão em memória
+bool npuzzle_pdb_save(const npuzzle_pdb_t* pdb, const char* filename)
+{
+  npuzzle_pdb_header_t header;
+  memset(&header, 0, sizeof(header));
+  memcpy(header.magic, NPUZZLE_PDB_MAGIC, sizeof(header.magic));
+  header.width = (uint64_t)pdb->width;
+  header.num_patterns = (uint64_t)pdb->partition.num_patterns;
+  size_t tile = 0;
+  for(int p = 0; p < pdb->partition.num_patterns; p++)
+  {
+    header.num_tiles[p] = (uint8_t)pdb->partition.num_tiles[p];
+    header.bits[p] = (uint8_t)pdb->bits[p];
+    for(int i = 0; i < pdb->partition.num_tiles[p]; i++)
+      header.tiles[tile++] = (uint8_t)pdb->partition.tiles[p][i];
+  }
+
+  FILE* file = fopen(filename, "wb");
+  if(file == NULL)
+  {
+    return false;
+  }
+
+  bool ok = fwrite(&header, sizeof(header), 1, file) == 1;
+  for(int p = 0; ok && p < pdb->partition.num_patterns; p++)
+  {
+    size_t bytes = npuzzle_pdb_table_bytes(pdb->sizes[p], pdb->bits[p]);
+    ok = fwrite(pdb->tables[p], 1, bytes, file) == bytes;
+  }
+  ok = fclose(file) == 0 && ok;
+  if(!ok)
+  {
+    remove(filename);
+  }
+  return ok;
+}
+
+// Liberta a memória ou o mapeamento das tabelas
+void npuzzle_pdb_destroy(npuzzle_pdb_t* pdb)
+{
+  if(pdb == NULL)
+  {
+    return;
+  }
+
+  if(pdb->mapping != NULL)
+  {
+    munmap(pdb->mapping, pdb->mapping_size);
+  }
+  else
+  {
+    for(int p = 0; p < pdb->partition.num_patterns; p++)
+      free((void*)pdb->tables[p]);
+  }
+
+  free(pdb);
+}
+
+bool npuzzle_pdb_same_partition(const npuzzle_pdb_t* pdb, const npuzzle_partition_t* partition)
+{
+  if(pdb->partition.num_patterns != partition->num_patterns)
+  {
+    return false;
+  }
+
+  for(int p = 0; p < partition->num_patterns; p++)
+  {
+    if(pdb->partition.num_tiles[p] != partition->num_tiles[p] ||
+       memcmp(pdb->partition.tiles[p], partition->tiles[p], (size_t)partition->num_tiles[p] * sizeof(int)) != 0)
+      return false;
+  }
+  return true;
+}
+
+// Soma o excesso de cada padrão, lido da posição das suas peças
+int npuzzle_pdb_extra(const npuzzle_pdb_t* pdb, const int* positions)
+{
+  int cells = pdb->width * pdb->width;
+  int extra = 0;
+  for(int p = 0; p < pdb->partition.num_patterns; p++)
+  {
+    int pattern_positions[NPUZZLE_MAX_CELLS];
+    for(int i = 0; i < pdb->partition.num_tiles[p]; i++)
+      pattern_positions[i] = positions[pdb->partition.tiles[p][i]];
+    size_t rank = npuzzle_pdb_rank(pattern_positions, pdb->partition.num_tiles[p], cells);
+
+    if(pdb->bits[p] == 4)
+      extra += (pdb->tables[p][rank / 2] >> ((rank % 2) * 4)) & 0xF;
+    else
+      extra += pdb->tables[p][rank];
+  }
+  return 2 * extra;
+}
@@ -0,0 +1,156 @@
+#include "npuzzle_logic.h"
+#include "linked_list.h"
+#include "state.h"
+#include <check.h>
+#include <stdlib.h>
+#include <string.h>
+
+// Teste unitário da compactação do tabuleiro, com 5 bits a posição 12 ocupa duas palavras
+START_TEST(test_packing)
+{
+  ck_assert(npuzzle_init(5));
+  ck_assert_uint_eq(npuzzle_state_size(), 2 * sizeof(uint64_t));
+
+  npuzzle_state_t puzzle = { { 0 } };
+  for(int cell = 0; cell < 25; cell++)
+  {
+    npuzzle_set(&puzzle, cell, (cell * 7) % 25);
+  }
+  for(int cell = 0; cell < 25; cell++)
+  {
+    ck_assert_int_eq(npuzzle_get(&puzzle, cell), (cell * 7) % 25);
+  }
+  ck_assert_int_eq(npuzzle_blank(&puzzle), 0);
+
+  // Com 4 bits o puzzle 15 ocupa uma única palavra
+  ck_assert(npuzzle_init(4));
+  ck_assert_uint_eq(npuzzle_state_size(), sizeof(uint64_t));
+  int tiles[16] = { 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 0, 11, 13, 14, 15, 12 };
+  ck_assert(npuzzle_from_tiles(&puzzle, tiles, 16));
+  ck_assert_int_eq(npuzzle_blank(&puzzle), 10);
+  ck_assert_int_eq(npuzzle_get(&puzzle, 15), 12);
+
+  // Peças repetidas, fora do intervalo ou em número errado são recusadas
+  tiles[0] = 2;
+  ck_assert(!npuzzle_from_tiles(&puzzle, tiles, 16));
+  tiles[0] = 16;
+  ck_assert(!npuzzle_from_tiles(&puzzle, tiles, 16));
+  ck_assert(!npuzzle_from_tiles(&puzzle, tiles, 9));
+  ck_assert(!npuzzle_init(6));
+}
+END_TEST
+
+// Teste unitário para a função visit, os vizinhos são gerados pela ordem do puzzle 8
+START_TEST(test_visit)
+{
+  ck_assert(npuzzle_init(4));
+  int tiles[16] = { 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 0, 11, 13, 14, 15, 12 };
+  npuzzle_state_t initial_state;
+  ck_assert(npuzzle_from_tiles(&initial_state, tiles, 16));
+
+  state_allocator_t* allocator = state_allocator_create(npuzzle_state_size());
+  linked_list_t* neighbors = linked_list_create();
+  state_t* initial_state_ptr = state_allocator_new(allocator, &initial_state);
+  visit(initial_state_ptr, allocator, neighbors);
+  ck_assert_int_eq(linked_list_size(neighbors), 4);
+
+  // Espaço moveu para cima, baixo, esquerda e direita
+  int expected_blank[4] = { 6, 14, 9, 11 };
+  for(int i = 0; i < 4; i++)
+  {
+    npuzzle_state_t* neighbor = (npuzzle_state_t*)((state_t*)linked_list_get(neighbors, i))->data;
+    ck_assert_int_eq(npuzzle_blank(neighbor), expected_blank[i]);
+    ck_assert_int_eq(npuzzle_get(neighbor, 10), tiles[expected_blank[i]]);
+  }
+
+  // Num canto existem apenas dois movimentos
+  linked_list_destroy(neighbors);
+  neighbors = linked_list_create();
+  state_t* goal_state = state_allocator_new(allocator, &initial_state);
+  goal_board((npuzzle_state_t*)goal_state->data);
+  visit(goal_state, allocator, neighbors);
+  ck_assert_int_eq(linked_list_size(neighbors), 2);
+
+  linked_list_destroy(neighbors);
+  state_allocator_destroy(allocator);
+}
+END_TEST
+
+// Teste unitário para as funções goal e heuristic
+START_TEST(test_goal_heuristic)
+{
+  ck_assert(npuzzle_init(5));
+  npuzzle_state_t puzzle;
+  goal_board(&puzzle);
+  state_t goal_state = { .data = &puzzle };
+  ck_assert(goal(&goal_state, NULL));
+  ck_assert_int_eq(heuristic(&goal_state, NULL), 0);
+  ck_assert_int_eq(npuzzle_get(&puzzle, 24), 0);
+
+  // Trocar a peça 1 com a 24 afasta ambas 7 posições
+  npuzzle_set(&puzzle, 0, 24);
+  npuzzle_set(&puzzle, 23, 1);
+  ck_assert(!goal(&goal_state, NULL));
+  ck_assert_int_eq(heuristic(&goal_state, NULL), 14);
+
+  // A heurística inversa até ao objetivo é a distância de Manhattan
+  npuzzle_state_t target;
+  goal_board(&target);
+  state_t target_state = { .data = &target };
+  ck_assert_int_eq(heuristic_reverse(&goal_state, &target_state), 14);
+  ck_assert_int_eq(heuristic_reverse(&target_state, &goal_state), 14);
+  ck_assert_int_eq(distance(&goal_state, &target_state), 1);
+}
+END_TEST
+
+// Teste unitário da verificação de solução, com largura par conta também a linha do espaço vazio
+START_TEST(test_solvable)
+{
+  ck_assert(npuzzle_init(4));
+  npuzzle_state_t puzzle;
+  goal_board(&puzzle);
+  ck_assert(npuzzle_solvable(&puzzle));
+
+  // O puzzle 15 com as peças 14 e 15 trocadas não tem solução
+  npuzzle_set(&puzzle, 13, 15);
+  npuzzle_set(&puzzle, 14, 14);
+  ck_assert(!npuzzle_solvable(&puzzle));
+
+  // Mover o espaço vazio para cima altera as inversões em 3 e a linha em 1
+  goal_board(&puzzle);
+  npuzzle_set(&puzzle, 15, 12);
+  npuzzle_set(&puzzle, 11, 0);
+  ck_assert(npuzzle_solvable(&puzzle));
+
+  // No puzzle 8 conta apenas a paridade das inversões
+  ck_assert(npuzzle_init(3));
+  int impossible[9] = { 2, 3, 5, 0, 8, 7, 1, 4, 6 };
+  int hard[9] = { 8, 6, 7, 2, 5, 4, 3, 0, 1 };
+  ck_assert(npuzzle_from_tiles(&puzzle, impossible, 9));
+  ck_assert(!npuzzle_solvable(&puzzle));
+  ck_assert(npuzzle_from_tiles(&puzzle, hard, 9));
+  ck_assert(npuzzle_solvable(&puzzle));
+}
+END_TEST
+
+Suite* create_suite()
+{
+  Suite* suite = suite_create("npuzzle_logic");
+  TCase* tcase = tcase_create("Core");
+  tcase_add_test(tcase, test_packing);
+  tcase_add_test(tcase, test_visit);
+  tcase_add_test(tcase, test_goal_heuristic);
+  tcase_add_test(tcase, test_solvable);
+  suite_add_tcase(suite, tcase);
+  return suite;
+}
+
+int main()
+{
+  Suite* suite = create_suite();
+  SRunner* runner = srunner_create(suite);
+  srunner_run_all(runner, CK_NORMAL);
+  int failures = srunner_ntests_failed(runner);
+  srunner_free(runner);
+  return (failures == 0) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
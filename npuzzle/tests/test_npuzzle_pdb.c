@@ -0,0 +1,128 @@
+#include "npuzzle_pdb.h"
+#include "state.h"
+#include <check.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+// Tabuleiro 8puzzle_hard_1, a solução ótima tem custo 31
+static const int hard_1[9] = { 8, 6, 7, 2, 5, 4, 3, 0, 1 };
+
+// Heurística de um tabuleiro dado pelas peças de cada posição
+static int pdb_heuristic(const npuzzle_pdb_t* pdb, const int* tiles)
+{
+  npuzzle_state_t puzzle;
+  ck_assert(npuzzle_from_tiles(&puzzle, tiles, 9));
+  npuzzle_set_pdb(pdb);
+  state_t state = { .data = &puzzle };
+  int h = heuristic(&state, NULL);
+  npuzzle_set_pdb(NULL);
+  return h;
+}
+
+START_TEST(test_partition)
+{
+  npuzzle_partition_t partition;
+  ck_assert(npuzzle_pdb_parse_partition("1,2,3/4,5", 3, &partition));
+  ck_assert_int_eq(partition.num_patterns, 2);
+  ck_assert_int_eq(partition.num_tiles[0], 3);
+  ck_assert_int_eq(partition.tiles[1][1], 5);
+
+  // Peças repetidas, fora do tabuleiro ou padrões vazios são recusados
+  ck_assert(!npuzzle_pdb_parse_partition("1,2/2", 3, &partition));
+  ck_assert(!npuzzle_pdb_parse_partition("1,9", 3, &partition));
+  ck_assert(!npuzzle_pdb_parse_partition("1,2//3", 3, &partition));
+  ck_assert(!npuzzle_pdb_parse_partition("1,a", 3, &partition));
+
+  npuzzle_pdb_default_partition(4, &partition);
+  ck_assert_int_eq(partition.num_patterns, 3);
+  ck_assert_int_eq(partition.num_tiles[0] + partition.num_tiles[1] + partition.num_tiles[2], 15);
+}
+END_TEST
+
+// Com um único padrão de todas as peças a tabela é a distância exata
+START_TEST(test_exact)
+{
+  ck_assert(npuzzle_init(3));
+  npuzzle_partition_t partition;
+  ck_assert(npuzzle_pdb_parse_partition("1,2,3,4,5,6,7,8", 3, &partition));
+  npuzzle_pdb_t* pdb = npuzzle_pdb_create(3, &partition, 2);
+  ck_assert_msg(pdb != NULL, "Falha no cálculo das tabelas");
+  ck_assert_uint_eq(pdb->sizes[0], 181440 * 2);
+
+  ck_assert_int_eq(pdb_heuristic(pdb, hard_1), 31);
+  int goal_tiles[9] = { 1, 2, 3, 4, 5, 6, 7, 8, 0 };
+  ck_assert_int_eq(pdb_heuristic(pdb, goal_tiles), 0);
+  npuzzle_pdb_destroy(pdb);
+}
+END_TEST
+
+START_TEST(test_additive)
+{
+  ck_assert(npuzzle_init(3));
+  npuzzle_partition_t partition;
+  npuzzle_pdb_default_partition(3, &partition);
+
+  // O número de trabalhadores não altera as tabelas
+  npuzzle_pdb_t* pdb = npuzzle_pdb_create(3, &partition, 1);
+  npuzzle_pdb_t* parallel = npuzzle_pdb_create(3, &partition, 4);
+  ck_assert(pdb != NULL && parallel != NULL);
+  for(int p = 0; p < partition.num_patterns; p++)
+  {
+    ck_assert_uint_eq(pdb->sizes[p], 3024);
+    ck_assert_int_eq(pdb->bits[p], 4);
+    ck_assert(memcmp(pdb->tables[p], parallel->tables[p], (pdb->sizes[p] + 1) / 2) == 0);
+  }
+
+  // Admissível e pelo menos a distância de Manhattan
+  npuzzle_state_t puzzle;
+  ck_assert(npuzzle_from_tiles(&puzzle, hard_1, 9));
+  int h = pdb_heuristic(pdb, hard_1);
+  ck_assert_int_ge(h, npuzzle_manhattan(&puzzle));
+  ck_assert_int_le(h, 31);
+
+  // O ficheiro é lido com a mesma divisão e recusado com outra largura
+  char filename[] = "/tmp/test_npuzzle_pdb_XXXXXX";
+  int fd = mkstemp(filename);
+  ck_assert_int_ne(fd, -1);
+  close(fd);
+  ck_assert(npuzzle_pdb_save(pdb, filename));
+
+  npuzzle_pdb_t* loaded = npuzzle_pdb_load(filename, 3);
+  ck_assert_msg(loaded != NULL, "Falha na leitura das tabelas");
+  ck_assert(npuzzle_pdb_same_partition(loaded, &partition));
+  ck_assert_int_eq(pdb_heuristic(loaded, hard_1), h);
+  ck_assert(npuzzle_pdb_load(filename, 4) == NULL);
+  remove(filename);
+
+  npuzzle_partition_t other;
+  ck_assert(npuzzle_pdb_parse_partition("1,2,3/4,5,6,7,8", 3, &other));
+  ck_assert(!npuzzle_pdb_same_partition(loaded, &other));
+
+  npuzzle_pdb_destroy(loaded);
+  npuzzle_pdb_destroy(parallel);
+  npuzzle_pdb_destroy(pdb);
+}
+END_TEST
+
+Suite* create_suite()
+{
+  Suite* suite = suite_create("npuzzle_pdb");
+  TCase* tcase = tcase_create("Core");
+  tcase_add_test(tcase, test_partition);
+  tcase_add_test(tcase, test_exact);
+  tcase_add_test(tcase, test_additive);
+  suite_add_tcase(suite, tcase);
+  return suite;
+}
+
+int main()
+{
+  Suite* suite = create_suite();
+  SRunner* runner = srunner_create(suite);
+  srunner_run_all(runner, CK_NORMAL);
+  int failures = srunner_ntests_failed(runner);
+  srunner_free(runner);
+  return (failures == 0) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -50,7 +50,11 @@ void number_link_destroy(number_link_t* number_link);
 // Converte a zona de memória para o formato de fácil acesso
 board_data_t number_link_wrap_board(number_link_t* number_link, char* data);
 
-// Cria um novo tabuleiro
+// Cria um novo tabuleiro ou retorna o tabuleiro igual já existente, contando mais uma referência
 void* number_link_create_board(number_link_t* number_link, const char* board, const coord* coords);
 
+// Liberta uma referência a um tabuleiro, o tabuleiro é libertado quando deixa de ter referências.
+// Apenas necessário em algoritmos que não guardam todos os estados (ex: SMA*)
+void number_link_release_board(number_link_t* number_link, void* board);
+
 #endif
\ No newline at end of file
@@ -26,4 +26,13 @@ bool goal(const state_t*, const state_t*);
 // mover uma peça de cada vez para o espaço livre
 int distance(const state_t*, const state_t*);
 
+// Liberta a referência do estado ao seu tabuleiro, para algoritmos que esquecem estados (SMA*)
+void release(const state_t*);
+
+// Converte um estado em bytes para o algoritmo distribuído (context não é utilizado)
+size_t serialize(const state_t*, void*, void*);
+
+// Recria um estado a partir dos bytes, context é o number_link_t do processo atual
+void deserialize(const void*, size_t, void*, void*);
+
 #endif
\ No newline at end of file
@@ -7,8 +7,14 @@ int main(int argc, char* argv[])
   return 0;
 }
 #else
+#include "astar_distributed.h"
+#include "astar_ara.h"
+#include "astar_beam.h"
+#include "astar_fringe.h"
 #include "astar_parallel.h"
+#include "astar_portfolio.h"
 #include "astar_sequential.h"
+#include "astar_sma.h"
 #include "numberlink_logic.h"
 #include <stdio.h>
 #include <stdlib.h>
@@ -82,12 +88,8 @@ void print_solution(a_star_node_t* solution)
 }
 
 // Resolve o problema utilizando a versão paralela do algoritmo
-void solve_parallel(number_link_t* number_link, int num_threads, bool first, bool csv, bool show_solution)
+void solve_parallel(a_star_parallel_t* a_star, number_link_t* number_link, bool csv, bool show_solution)
 {
-  // Criamos a instância do algoritmo A*
-  a_star_parallel_t* a_star =
-      a_star_parallel_create(sizeof(number_link_state_t), goal, visit, heuristic, distance, print_solution, num_threads, first);
-
   // Criamos o nosso estado inicial para lançar o algoritmo
   number_link_state_t initial = { number_link,
                                   number_link_create_board(number_link, number_link->initial_board, number_link->initial_coords),
@@ -98,9 +100,155 @@ void solve_parallel(number_link_t* number_link, int num_threads, bool first, boo
 
   // Imprime as estatísticas da execução
   a_star_parallel_print_statistics(a_star, csv, show_solution);
+}
+
+// Resolve o problema utilizando a versão distribuída do algoritmo, com um processo por trabalhador
+void solve_distributed(
+    number_link_t* number_link, int num_workers, bool first, transport_kind_e transport, bool csv, bool show_solution)
+{
+  // Criamos a instância do algoritmo A*
+  a_star_distributed_t* a_star = a_star_distributed_create(
+      sizeof(number_link_state_t), goal, visit, heuristic, distance, print_solution, num_workers, first, transport);
+
+  // Os tabuleiros são indexados em cada processo, os estados viajam com o tabuleiro completo
+  a_star_distributed_set_codec(a_star, serialize, deserialize, number_link, sizeof(int) + number_link->struct_size);
+
+  // Criamos o nosso estado inicial para lançar o algoritmo
+  number_link_state_t initial;
+  memset(&initial, 0, sizeof(number_link_state_t));
+  initial.number_link = number_link;
+  initial.board_data = number_link_create_board(number_link, number_link->initial_board, number_link->initial_coords);
+
+  // Tentamos resolver o problema
+  a_star_distributed_solve(a_star, &initial, NULL);
+
+  // Imprime as estatísticas da execução
+  a_star_distributed_print_statistics(a_star, csv, show_solution);
 
   // Limpamos a memória
-  a_star_parallel_destroy(a_star);
+  a_star_distributed_destroy(a_star);
+}
+
+// Resolve o problema com um portfólio de configurações do algoritmo em simultâneo
+void solve_portfolio(
+    number_link_t* number_link, a_star_portfolio_config_t* configs, size_t num_configs, int core_budget, bool csv, bool show_solution)
+{
+  // Sem orçamento indicado utilizamos todos os núcleos físicos
+  if(core_budget <= 0)
+  {
+    cpu_topology_t* topology = cpu_topology_create();
+    core_budget = (int)cpu_topology_physical_cores(topology);
+    cpu_topology_destroy(topology);
+  }
+
+  a_star_portfolio_t* a_star = a_star_portfolio_create(
+      sizeof(number_link_state_t), goal, visit, heuristic, distance, print_solution, configs, num_configs, (size_t)core_budget);
+
+  // Criamos o nosso estado inicial para lançar o algoritmo, todas as configurações partilham o tabuleiro
+  number_link_state_t initial;
+  memset(&initial, 0, sizeof(number_link_state_t));
+  initial.number_link = number_link;
+  initial.board_data = number_link_create_board(number_link, number_link->initial_board, number_link->initial_coords);
+
+  // Tentamos resolver o problema
+  a_star_portfolio_solve(a_star, &initial, NULL);
+
+  // Imprime as estatísticas da execução
+  a_star_portfolio_print_statistics(a_star, csv, show_solution);
+
+  // Limpamos a memória
+  a_star_portfolio_destroy(a_star);
+}
+
+// Resolve o problema utilizando o algoritmo ARA*, a partir do peso indicado até à solução ótima
+// ou até se esgotar o tempo limite
+void solve_ara(number_link_t* number_link, double weight, double time_limit, bool csv, bool show_solution)
+{
+  // Criamos a instância do algoritmo ARA*
+  a_star_ara_t* a_star = a_star_ara_create(sizeof(number_link_state_t), goal, visit, heuristic, distance, print_solution, weight);
+  a_star_ara_set_time_limit(a_star, time_limit);
+
+  // Criamos o nosso estado inicial para lançar o algoritmo
+  number_link_state_t initial = { number_link,
+                                  number_link_create_board(number_link, number_link->initial_board, number_link->initial_coords),
+                                  0 };
+
+  // Tentamos resolver o problema
+  a_star_ara_solve(a_star, &initial, NULL);
+
+  // Imprime as estatísticas da execução
+  a_star_ara_print_statistics(a_star, csv, show_solution);
+
+  // Limpamos a memória
+  a_star_ara_destroy(a_star);
+}
+
+// Resolve o problema utilizando o algoritmo SMA*, com no máximo max_nodes nós em memória
+void solve_sma(number_link_t* number_link, size_t max_nodes, bool csv, bool show_solution)
+{
+  // Criamos a instância do algoritmo SMA*
+  a_star_sma_t* a_star = a_star_sma_create(sizeof(number_link_state_t), goal, visit, heuristic, distance, print_solution, max_nodes);
+
+  // Os tabuleiros dos nós esquecidos são libertados, ficando também limitados pelo número de nós
+  a_star_sma_set_release(a_star, release);
+
+  // Criamos o nosso estado inicial para lançar o algoritmo, sem lixo no alinhamento porque os
+  // estados em memória são comparados byte a byte
+  number_link_state_t initial;
+  memset(&initial, 0, sizeof(number_link_state_t));
+  initial.number_link = number_link;
+  initial.board_data = number_link_create_board(number_link, number_link->initial_board, number_link->initial_coords);
+
+  // Tentamos resolver o problema
+  a_star_sma_solve(a_star, &initial, NULL);
+
+  // Imprime as estatísticas da execução
+  a_star_sma_print_statistics(a_star, csv, show_solution);
+
+  // Limpamos a memória
+  a_star_sma_destroy(a_star);
+}
+
+// Resolve o problema com a procura em feixe, que guarda apenas os width melhores nós de cada camada
+void solve_beam(number_link_t* number_link, size_t width, bool csv, bool show_solution)
+{
+  // Criamos a instância da procura em feixe
+  a_star_beam_t* a_star = a_star_beam_create(sizeof(number_link_state_t), goal, visit, heuristic, distance, print_solution, width);
+
+  // Criamos o nosso estado inicial para lançar o algoritmo
+  number_link_state_t initial = { number_link,
+                                  number_link_create_board(number_link, number_link->initial_board, number_link->initial_coords),
+                                  0 };
+
+  // Tentamos resolver o problema
+  a_star_beam_solve(a_star, &initial, NULL);
+
+  // Imprime as estatísticas da execução
+  a_star_beam_print_statistics(a_star, csv, show_solution);
+
+  // Limpamos a memória
+  a_star_beam_destroy(a_star);
+}
+
+// Resolve o problema utilizando o algoritmo Fringe Search, sem fila prioritária
+void solve_fringe(number_link_t* number_link, bool csv, bool show_solution)
+{
+  // Criamos a instância do algoritmo Fringe Search
+  a_star_fringe_t* a_star = a_star_fringe_create(sizeof(number_link_state_t), goal, visit, heuristic, distance, print_solution);
+
+  // Criamos o nosso estado inicial para lançar o algoritmo
+  number_link_state_t initial = { number_link,
+                                  number_link_create_board(number_link, number_link->initial_board, number_link->initial_coords),
+                                  0 };
+
+  // Tentamos resolver o problema
+  a_star_fringe_solve(a_star, &initial, NULL);
+
+  // Imprime as estatísticas da execução
+  a_star_fringe_print_statistics(a_star, csv, show_solution);
+
+  // Limpamos a memória
+  a_star_fringe_destroy(a_star);
 }
 
 // Resolve o problema utilizando a versão sequencial do algoritmo
@@ -130,11 +278,23 @@ int main(int argc, char* argv[])
   // Verificar se o nome do arquivo foi fornecido como argumento
   if(argc < 2)
   {
-    printf("Uso: %s [-n <num. trabalhadores>] [-p] [-r] <ficheiro_instâncias>\n", argv[0]);
+    printf("Uso: %s [-n <num. trabalhadores|auto>] [-a <none|compact|scatter>] [-w <k>] [-k <k|auto>] [-D <shm|unix|tcp>] [-P <configurações|auto>] [-W <peso>] [-T <segundos>] [-M <nós>] [-b <largura>] [-f] [-p] [-r] <ficheiro_instâncias> [...]\n", argv[0]);
     printf("Opções:\n");
-    printf("-n : Número de trabalhadores (threads), defeito: 0 (algoritmo sequencial)\n");
+    printf("-n : Número de trabalhadores (threads), defeito: 0 (algoritmo sequencial), auto: número de núcleos físicos\n");
+    printf("-a : Afinidade dos trabalhadores aos CPUs (none, compact ou scatter), defeito: none (sem afinidade)\n");
+    printf("-w : Aquecimento sequencial até existirem k nós por trabalhador, defeito: 0 (sem aquecimento)\n");
+    printf("-k : Nós expandidos por iteração de cada trabalhador, auto: adaptativo até %d, defeito: 1\n", BATCH_AUTO_MAX);
+    printf("-D : Algoritmo distribuído com -n processos, comunicação por memória partilhada, sockets unix ou tcp\n");
+    printf("-P : Portfólio de configurações em simultâneo (seq, seq-deep, par, par-first, par-deep), separadas por vírgulas,\n");
+    printf("     a primeira a provar o resultado cancela as restantes, -n é o orçamento de núcleos, auto: %s\n", "seq,par-first,par-deep");
+    printf("-W : Algoritmo ARA* com o peso inicial da heurística indicado, reduzido até 1 (solução ótima)\n");
+    printf("-T : Tempo limite em segundos do algoritmo ARA*, termina com a melhor solução encontrada\n");
+    printf("-M : Algoritmo SMA* com o número máximo de nós em memória indicado, esquece os piores nós quando o atinge\n");
+    printf("-b : Procura em feixe com a largura indicada, rápida mas sem garantia de solução ótima\n");
+    printf("-f : Algoritmo Fringe Search, lista da fronteira percorrida com um limite de f crescente, sem fila prioritária\n");
     printf("-p : Termina à primeira solução encontrada, defeito: falso (utilizado no algoritmo paralelo apenas)\n");
     printf("-r : Relatório em formato compatível com CSV \n");
+    printf("Podem ser indicados vários ficheiros, as instâncias são resolvidas pela ordem indicada\n");
     return 0;
   }
 
@@ -143,6 +303,19 @@ int main(int argc, char* argv[])
   bool first = false;
   bool csv = false;
   bool show_solution = false;
+  affinity_policy_e affinity = AFFINITY_NONE;
+  int warmup = 0;
+  int batch_size = 1;
+  bool batch_adaptive = false;
+  bool distributed = false;
+  transport_kind_e transport = TRANSPORT_SHM;
+  a_star_portfolio_config_t portfolio[PORTFOLIO_MAX_CONFIGS];
+  size_t num_configs = 0;
+  double weight = 0;
+  double time_limit = 0;
+  int max_nodes = 0;
+  int beam_width = 0;
+  bool fringe = false;
 
   // Verificamos se mais opções foram passadas
   int filename_arg = 1;
@@ -152,7 +325,14 @@ int main(int argc, char* argv[])
 
     if(strcmp(opt, "-n") == 0)
     {
-      if(++i < argc)
+      if(++i < argc && strcmp(argv[i], "auto") == 0)
+      {
+        // Utilizamos um trabalhador por núcleo físico
+        cpu_topology_t* topology = cpu_topology_create();
+        num_threads = (int)cpu_topology_physical_cores(topology);
+        cpu_topology_destroy(topology);
+      }
+      else if(i < argc)
       {
         num_threads = atoi(argv[i]);
       }
@@ -165,6 +345,119 @@ int main(int argc, char* argv[])
       continue;
     }
 
+    if(strcmp(opt, "-a") == 0)
+    {
+      if(++i >= argc || !affinity_from_str(argv[i], &affinity))
+      {
+        printf("Erro: a afinidade tem de ser none, compact ou scatter.\n");
+        return 1;
+      }
+      filename_arg += 2;
+      continue;
+    }
+
+    if(strcmp(opt, "-w") == 0)
+    {
+      if(++i >= argc || (warmup = atoi(argv[i])) < 0)
+      {
+        printf("Erro: o aquecimento tem de ser um número de nós por trabalhador.\n");
+        return 1;
+      }
+      filename_arg += 2;
+      continue;
+    }
+
+    if(strcmp(opt, "-k") == 0)
+    {
+      if(++i < argc && strcmp(argv[i], "auto") == 0)
+      {
+        // O lote adapta-se ao tamanho da lista aberta de cada trabalhador
+        batch_size = BATCH_AUTO_MAX;
+        batch_adaptive = true;
+      }
+      else if(i >= argc || (batch_size = atoi(argv[i])) < 1)
+      {
+        printf("Erro: o tamanho do lote tem de ser um número positivo ou auto.\n");
+        return 1;
+      }
+      filename_arg += 2;
+      continue;
+    }
+
+    if(strcmp(opt, "-D") == 0)
+    {
+      if(++i >= argc || !transport_from_str(argv[i], &transport))
+      {
+        printf("Erro: o transporte tem de ser shm, unix ou tcp.\n");
+        return 1;
+      }
+      distributed = true;
+      filename_arg += 2;
+      continue;
+    }
+
+    if(strcmp(opt, "-P") == 0)
+    {
+      if(++i >= argc || !a_star_portfolio_parse(argv[i], portfolio, &num_configs))
+      {
+        printf("Erro: configuração do portfólio desconhecida.\n");
+        return 1;
+      }
+      filename_arg += 2;
+      continue;
+    }
+
+    if(strcmp(opt, "-W") == 0)
+    {
+      if(++i >= argc || (weight = atof(argv[i])) < 1.0)
+      {
+        printf("Erro: o peso da heurística tem de ser um número maior ou igual a 1.\n");
+        return 1;
+      }
+      filename_arg += 2;
+      continue;
+    }
+
+    if(strcmp(opt, "-M") == 0)
+    {
+      if(++i >= argc || (max_nodes = atoi(argv[i])) < 2)
+      {
+        printf("Erro: o número máximo de nós tem de ser pelo menos 2.\n");
+        return 1;
+      }
+      filename_arg += 2;
+      continue;
+    }
+
+    if(strcmp(opt, "-b") == 0)
+    {
+      if(++i >= argc || (beam_width = atoi(argv[i])) < 1)
+      {
+        printf("Erro: a largura do feixe tem de ser um número positivo.\n");
+        return 1;
+      }
+      filename_arg += 2;
+      continue;
+    }
+
+    if(strcmp(opt, "-T") == 0)
+    {
+      if(++i >= argc || (time_limit = atof(argv[i])) <= 0)
+      {
+        printf("Erro: o tempo limite tem de ser um número positivo de segundos.\n");
+        return 1;
+      }
+      filename_arg += 2;
+      continue;
+    }
+
+    if(strcmp(opt, "-f") == 0)
+    {
+      fringe = true;
+      filename_arg++;
+      continue;
+    }
+
     if(strcmp(opt, "-p") == 0)
     {
       first = true;
@@ -193,25 +486,73 @@ int main(int argc, char* argv[])
     return 1;
   }
 
-  number_link_t* number_link = init_number_link_puzzle(argv[filename_arg]);
-
-  // Inicializa o nosso puzzle
-  if(!number_link)
+  // O algoritmo paralelo é criado uma única vez, os trabalhadores são reutilizados por todas as instâncias
+  a_star_parallel_t* a_star = NULL;
+  if(num_threads > 0 && !distributed && weight == 0 && max_nodes == 0 && beam_width == 0 && !fringe && num_configs == 0)
   {
-    printf("Erro a inicializar o puzzle, verifique o ficheiro com os dados\n");
-    return 1;
-  }
+    a_star = a_star_parallel_create(
+        sizeof(number_link_state_t), goal, visit, heuristic, distance, print_solution, num_threads, first);
 
-  if(num_threads > 0)
-  {
-    solve_parallel(number_link, num_threads, first, csv, show_solution);
+    // Fixamos os trabalhadores aos CPUs caso tenha sido pedido
+    a_star_parallel_set_affinity(a_star, affinity);
+
+    // Fase de aquecimento para que todos os trabalhadores comecem com nós
+    a_star_parallel_set_warmup(a_star, (size_t)warmup);
+
+    // Expansão de lotes de nós por iteração
+    a_star_parallel_set_batch(a_star, (size_t)batch_size, batch_adaptive);
   }
-  else
+
+  // Cada ficheiro indicado é uma instância a resolver
+  for(int f = filename_arg; f < argc; f++)
   {
-    solve_sequential(number_link, csv, show_solution);
+    number_link_t* number_link = init_number_link_puzzle(argv[f]);
+
+    // Inicializa o nosso puzzle
+    if(!number_link)
+    {
+      printf("Erro a inicializar o puzzle, verifique o ficheiro com os dados\n");
+      continue;
+    }
+
+    if(fringe)
+    {
+      solve_fringe(number_link, csv, show_solution);
+    }
+    else if(beam_width > 0)
+    {
+      solve_beam(number_link, (size_t)beam_width, csv, show_solution);
+    }
+    else if(max_nodes > 0)
+    {
+      solve_sma(number_link, (size_t)max_nodes, csv, show_solution);
+    }
+    else if(weight > 0)
+    {
+      solve_ara(number_link, weight, time_limit, csv, show_solution);
+    }
+    else if(num_configs > 0)
+    {
+      solve_portfolio(number_link, portfolio, num_configs, num_threads, csv, show_solution);
+    }
+    else if(distributed)
+    {
+      solve_distributed(number_link, num_threads > 0 ? num_threads : 1, first, transport, csv, show_solution);
+    }
+    else if(a_star != NULL)
+    {
+      solve_parallel(a_star, number_link, csv, show_solution);
+    }
+    else
+    {
+      solve_sequential(number_link, csv, show_solution);
+    }
+
+    number_link_destroy(number_link);
   }
 
-  number_link_destroy(number_link);
+  // Limpamos a memória
+  a_star_parallel_destroy(a_star);
   return 0;
 }
-#endif
\ No newline at end of file
+#endif
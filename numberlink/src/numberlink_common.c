@@ -3,6 +3,9 @@
 #include <stdlib.h>
 #include <string.h>
 
+// Cada tabuleiro é seguido pelo número de referências, que não faz parte da chave da hashtable
+typedef unsigned int board_refs_t;
+
 // Mapeia os caracteres números A,B,C...Z para 0,1,2...
 int letter_to_int(char c)
 {
@@ -145,7 +148,7 @@ number_link_t* number_link_init(int rows, int cols, const char* board)
   }
 
   number_link->struct_size = number_link->board_len * sizeof(char) + number_link->num_pairs * sizeof(coord);
-  number_link->allocator = allocator_create(number_link->struct_size);
+  number_link->allocator = allocator_create(number_link->struct_size + sizeof(board_refs_t));
 
   if(number_link->allocator == NULL)
   {
@@ -241,6 +244,7 @@ void* number_link_create_board(number_link_t* number_link, const char* board_dat
   // Verificamos se a configuração passada já existe em memória, e caso exista
   // retornamos o estado correspondente que aponta para esses locais na memória
   void* board = hashtable_contains(number_link->hashtable, &tmp_board);
+  board_refs_t refs = 0;
 
   if(!board)
   {
@@ -249,6 +253,34 @@ void* number_link_create_board(number_link_t* number_link, const char* board_dat
     memcpy(board, &tmp_board, number_link->struct_size);
     hashtable_insert(number_link->hashtable, board);
   }
+  else
+  {
+    memcpy(&refs, (char*)board + number_link->struct_size, sizeof(board_refs_t));
+  }
+
+  // O contador pode não estar alinhado, é lido e escrito por cópia
+  refs++;
+  memcpy((char*)board + number_link->struct_size, &refs, sizeof(board_refs_t));
 
   return board;
 }
+
+void number_link_release_board(number_link_t* number_link, void* board)
+{
+  if(number_link == NULL || board == NULL)
+  {
+    return;
+  }
+
+  board_refs_t refs;
+  memcpy(&refs, (char*)board + number_link->struct_size, sizeof(board_refs_t));
+  refs--;
+  memcpy((char*)board + number_link->struct_size, &refs, sizeof(board_refs_t));
+
+  // Sem referências o tabuleiro deixa de estar indexado e a memória é reutilizada
+  if(refs == 0)
+  {
+    hashtable_remove(number_link->hashtable, board);
+    allocator_free(number_link->allocator, board);
+  }
+}
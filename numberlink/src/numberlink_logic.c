@@ -22,8 +22,9 @@ void update_neighbors(number_link_t* number_link,
   // Atualizamos a nossa coordenada atual para este par
   tmp_curr[pair] = new_coord;
 
-  // Iniciamos um novo tabuleiro
+  // Iniciamos um novo tabuleiro, sem lixo no alinhamento porque os estados são comparados byte a byte
   number_link_state_t new_board;
+  memset(&new_board, 0, sizeof(number_link_state_t));
   new_board.number_link = number_link;
   new_board.matched_pairs = matched_pairs;
 
@@ -160,3 +161,37 @@ int distance(const state_t* parent, const state_t* neighbor)
   }
   return d;
 }
+
+// Liberta a referência do estado ao seu tabuleiro
+void release(const state_t* state)
+{
+  number_link_state_t* number_link_state = (number_link_state_t*)state->data;
+  number_link_release_board(number_link_state->number_link, number_link_state->board_data);
+}
+
+// Converte um estado em bytes para o algoritmo distribuído, o tabuleiro é copiado porque
+// o ponteiro board_data apenas é válido no processo que o criou
+size_t serialize(const state_t* state, void* buffer, void* context)
+{
+  number_link_state_t* number_link_state = (number_link_state_t*)state->data;
+  number_link_t* number_link = number_link_state->number_link;
+
+  memcpy(buffer, &number_link_state->matched_pairs, sizeof(int));
+  memcpy((char*)buffer + sizeof(int), number_link_state->board_data, number_link->struct_size);
+  return sizeof(int) + number_link->struct_size;
+}
+
+// Recria um estado a partir dos bytes recebidos, indexando o tabuleiro no processo atual
+void deserialize(const void* buffer, size_t len, void* state_data, void* context)
+{
+  number_link_t* number_link = (number_link_t*)context;
+  number_link_state_t* state = (number_link_state_t*)state_data;
+  const char* ptr = (const char*)buffer;
+  coord coords[number_link->num_pairs];
+
+  memcpy(coords, ptr + sizeof(int) + number_link->board_len, number_link->num_pairs * sizeof(coord));
+
+  state->number_link = number_link;
+  memcpy(&state->matched_pairs, ptr, sizeof(int));
+  state->board_data = number_link_create_board(number_link, ptr + sizeof(int), coords);
+}
@@ -104,6 +104,36 @@ START_TEST(test_number_link_board)
 }
 END_TEST
 
+// O tabuleiro só é libertado quando todas as referências criadas são libertadas
+START_TEST(test_number_link_release)
+{
+  char initial_board[9] = "A.AB.BC.C";
+  coord coords[3] = { { 1, 0 }, { 0, 1 }, { 0, 2 } };
+
+  number_link_t* number_link = number_link_init(3, 3, initial_board);
+  ck_assert_ptr_nonnull(number_link);
+  void* data = number_link_create_board(number_link, initial_board, (const coord*)coords);
+  ck_assert_ptr_eq(number_link_create_board(number_link, initial_board, (const coord*)coords), data);
+
+  // Chave da hashtable: o tabuleiro seguido das coordenadas
+  char key[sizeof(initial_board) + sizeof(coords)];
+  memcpy(key, initial_board, sizeof(initial_board));
+  memcpy(key + sizeof(initial_board), coords, sizeof(coords));
+
+  number_link_release_board(number_link, data);
+  ck_assert_ptr_eq(hashtable_contains(number_link->hashtable, key), data);
+  number_link_release_board(number_link, data);
+  ck_assert_ptr_null(hashtable_contains(number_link->hashtable, key));
+
+  // Um novo tabuleiro igual volta a ser indexado
+  data = number_link_create_board(number_link, initial_board, (const coord*)coords);
+  ck_assert_ptr_nonnull(data);
+  ck_assert_ptr_eq(number_link_create_board(number_link, initial_board, (const coord*)coords), data);
+
+  number_link_destroy(number_link);
+}
+END_TEST
+
 // Função auxiliar para criação da suíte de testes
 Suite* create_suite()
 {
@@ -113,6 +143,7 @@ Suite* create_suite()
   tcase_add_test(tcase, test_number_link_init_ok);
   tcase_add_test(tcase, test_number_link_init_fail);
   tcase_add_test(tcase, test_number_link_board);
+  tcase_add_test(tcase, test_number_link_release);
   suite_add_tcase(suite, tcase);
   return suite;
 }
@@ -11,6 +11,7 @@ algo_names = [
     "sequencial",
     "paralelo - procura exaustiva",
     "paralelo - primeira solução",
+    "fringe",
 ]
 
 
@@ -40,11 +41,12 @@ def run_executable(executable, arguments, runs):
 
 def calculate_average(rows):
     num_rows = len(rows)
-    average_row = ['', '', 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0.0]
+    average_row = ['', '', 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0.0, '']
 
     min_cost = sys.maxsize
     max_cost = -sys.maxsize
     solution_found = set()
+    skipped = set()
     for row in rows:
         # Solution found
         solution_found.add(row[0])
@@ -76,6 +78,8 @@ def calculate_average(rows):
         average_row[11] += int(row[11])
         # Execution time
         average_row[12] += float(row[12])
+        # Reason why the search did not run (empty when it ran)
+        skipped.add(row[13] if len(row) > 13 else "\"\"")
 
     # Solution found must be the same always
     if len(solution_found) > 1:
@@ -101,18 +105,40 @@ def calculate_average(rows):
     average_row[10] = average_row[10] // num_rows
     average_row[11] = average_row[11] // num_rows
     average_row[12] = round(average_row[12] / num_rows, 6)
+    average_row[13] = " / ".join(sorted(skipped))
+
 
     return average_row
 
 
+def is_skipped(row: list):
+    # The last column of an average row is the reason why the search did not run
+    return row[-1] != "\"\""
+
+
+def calculate_speed_up(base_exec_time, row: list):
+    # Searches that did not run have no time to compare against
+    exec_time = row[-2]
+    if base_exec_time == 0 or exec_time == 0:
+        return ""
+    return round(base_exec_time/exec_time, 3)
+
+
+def cell_to_str(cell):
+    # Decimal numbers use a comma, text cells (e.g. the reason why the search
+    # did not run) are kept as they are
+    if isinstance(cell, float):
+        return str(cell).replace('.', ',')
+    return str(cell)
+
+
 def row_to_str(row: list):
-    row_str = str(';'.join(map(str, row)))
-    return row_str.replace('.', ',')
+    return ';'.join(map(cell_to_str, row))
 
 
 def run_measurement(problem, instance,
                     num_runs, thread_num=0,
-                    first_solution=False):
+                    first_solution=False, batch=None, fringe=False):
     # Execution arguments
     exec_cmd = f"./{problem}/bin/{problem}"
     # -r flag means we want in CSV format
@@ -122,11 +148,18 @@ def run_measurement(problem, instance,
     # Average result row
     average_row = [f"\"{problem}-{instance}\""]
     if thread_num > 0:
+        # -k flag sets the number of nodes expanded per iteration
+        batch_label = ""
+        if batch is not None:
+            exec_args.append("-k")
+            exec_args.append(batch)
+            batch_label = f" (lotes {batch})"
+
         if first_solution:
             exec_args.append("-p")
-            average_row.append("\"paralelo - primeira solução\"")
+            average_row.append(f"\"paralelo - primeira solução{batch_label}\"")
         else:
-            average_row.append("\"paralelo - procura exaustiva\"")
+            average_row.append(f"\"paralelo - procura exaustiva{batch_label}\"")
 
         # Update execution arguments
         exec_args.append("-n")
@@ -135,6 +168,11 @@ def run_measurement(problem, instance,
         # Update return row
         average_row.append(thread_num)
 
+    elif fringe:
+        # -f flag selects the fringe search engine
+        exec_args.append("-f")
+        average_row.append("\"fringe\"")
+
     else:
         average_row.append("\"sequencial\"")
 
@@ -155,52 +193,70 @@ def run_measurement(problem, instance,
 
 
 def run_measurements(problem, instance, threads, num_runs,
-                     save_csv, output, truncate):
+                     save_csv, output, truncate, batches=None, fringe=False):
 
     # To store measurements
     # 0-> sequential
     # 1-> parallel(exhaustive search))
     # 2-> parallel (first solution)
-    measurements = [[], [], []]
+    # 3-> fringe search (head-to-head with sequential)
+    measurements = [[], [], [], []]
 
     # Sequential
     row = run_measurement(
         problem, instance, num_runs)
     # Base time for calculating speed-up
-    base_exec_time = row[-1]
+    base_exec_time = row[-2]
     # Store row
     measurements[0].append(row)
 
-    # Parallel per thread count
-    for thread_num in threads:
-        # First solution average
-        row = run_measurement(problem, instance,
-                              num_runs, thread_num)
-        # Calculate speed-up and append to row
-        speed_up = round(base_exec_time/row[-1], 3)
-        row.append(speed_up)
-        # Store row
-        measurements[1].append(row)
+    # The instance was solved without a search (e.g. proven unsolvable), the
+    # other algorithms would skip it as well
+    if is_skipped(row):
+        logger.info("Procura não executada: %s", row[-1])
+        fringe = False
+        threads = []
 
-        # First solution average
+    # Fringe search against the sequential A*, without the parallel runs
+    if fringe:
         row = run_measurement(problem, instance,
-                              num_runs, thread_num,
-                              True)
+                              num_runs, fringe=True)
         # Calculate speed-up and append to row
-        speed_up = round(base_exec_time/row[-1], 3)
-        row.append(speed_up)
+        row.append(calculate_speed_up(base_exec_time, row))
         # Store row
-        measurements[2].append(row)
+        measurements[3].append(row)
+        threads = []
+
+    # Parallel per thread count (and per batch size when requested)
+    for batch in (batches or [None]):
+        for thread_num in threads:
+            # Exhaustive search average
+            row = run_measurement(problem, instance,
+                                  num_runs, thread_num,
+                                  False, batch)
+            # Calculate speed-up and append to row
+            row.append(calculate_speed_up(base_exec_time, row))
+            # Store row
+            measurements[1].append(row)
+
+            # First solution average
+            row = run_measurement(problem, instance,
+                                  num_runs, thread_num,
+                                  True, batch)
+            # Calculate speed-up and append to row
+            row.append(calculate_speed_up(base_exec_time, row))
+            # Store row
+            measurements[2].append(row)
 
     if save_csv:
         # Write results to CSV file
         mode = "wt" if truncate else "a"
         with open(output, mode) as f:
-            for algo in range(3):
+            for algo in range(4):
                 for instance in measurements[algo]:
                     f.write(row_to_str(instance)+"\n")
     else:
-        for algo in range(3):
+        for algo in range(4):
             for instance in measurements[algo]:
                 print(row_to_str(instance))
 
@@ -239,6 +295,10 @@ if __name__ == '__main__':
         '-r', '--runs', help='Número de execuções', default=10)
     parser.add_argument('-t', '--threads', type=parse_int_list,
                         help='Número de trabalhadores', default=[2, 4, 6, 8])
+    parser.add_argument('-k', '--batch', type=parse_str_list,
+                        help='Tamanhos de lote a medir (ex: 1,4,16,auto)', default=None)
+    parser.add_argument('-f', '--fringe', action='store_true',
+                        help='Compara o algoritmo fringe com o sequencial (sem paralelo)')
     parser.add_argument('-c', '--csv', help='Saida CSV', action='store_true')
     parser.add_argument('-d', '--debug', action='store_true',
                         help='Ativa mensagens de debug')
@@ -257,4 +317,5 @@ if __name__ == '__main__':
 
     # Run measurements
     run_measurements(args.problem, args.instance, args.threads, int(args.runs),
-                     args.csv, args.output, args.truncate)
+                     args.csv, args.output, args.truncate, args.batch,
+                     args.fringe)